@@ -127,7 +127,8 @@ static const uint8_t g_chunk_to_encode_char_16[] =
 static const uint8_t g_chunk_to_encode_char_16_subst[] =
 {
     'A', 'a',   'B', 'b',   'C', 'c',   'D', 'd',
-    'E', 'e',   'F', 'f',
+    'E', 'e',   'F', 'f',   'i', '1',   'I', '1',
+    'l', '1',   'L', '1',   'o', '0',   'O', '0',
 };
 
 static const uint8_t g_whitespace_16[] =
@@ -284,6 +285,66 @@ void print_chunk_to_char_table()
     printf("\n");
 }
 
+// Two chars per chunk pair, indexed by (first chunk * alphabet size) + second
+// chunk. The codecs whose chunks are bit fields (safe16 and safe64) use this
+// to encode two chunks with a single lookup.
+void print_chunk_pair_to_chars_table()
+{
+    const int pair_count = g_alphabet_size * g_alphabet_size;
+    printf("static const char g_chunk_pair_to_encode_chars[] =");
+    for(int i = 0; i < pair_count; i++)
+    {
+        if((i & 31) == 0)
+        {
+            printf("\n    \"");
+        }
+        printf("%c%c", (char)g_encode_table[i / g_alphabet_size], (char)g_encode_table[i % g_alphabet_size]);
+        if((i & 31) == 31 || i == pair_count - 1)
+        {
+            printf("\"");
+        }
+    }
+    printf(";\n");
+    printf("\n");
+}
+
+// Set in the entries of g_chars_to_chunk_pair that hold a chunk pair.
+#define CHUNK_PAIR_FLAG_VALID 0x8000
+
+// The chunk pair for every pair of chars, indexed by the first char in the low
+// byte and the second in the high byte. Only the pairs of chunk chars are
+// written out, so that the entries for whitespace and invalid chars come out
+// as 0 (without CHUNK_PAIR_FLAG_VALID). The codecs whose chunks are bit fields
+// (safe16 and safe64) use this to decode two chunks with a single lookup.
+void print_chars_to_chunk_pair_table()
+{
+    int bits_per_chunk = 0;
+    while((1 << bits_per_chunk) < g_alphabet_size)
+    {
+        bits_per_chunk++;
+    }
+
+    printf("static const uint16_t g_chars_to_chunk_pair[256 * 256] =\n{");
+    int entry_count = 0;
+    for(int index = 0; index < 256 * 256; index++)
+    {
+        const uint8_t hi = g_decode_table[index & 0xff];
+        const uint8_t lo = g_decode_table[index >> 8];
+        if(hi >= CHUNK_CODE_WHITESPACE || lo >= CHUNK_CODE_WHITESPACE)
+        {
+            continue;
+        }
+        if((entry_count & 3) == 0)
+        {
+            printf("\n   ");
+        }
+        printf(" [0x%04x] = 0x%04x,", index, CHUNK_PAIR_FLAG_VALID | (hi << bits_per_chunk) | lo);
+        entry_count++;
+    }
+    printf("\n};\n");
+    printf("\n");
+}
+
 int count_complete_bytes_inside_chunks(int alphabet_size, int chunk_count)
 {
     __int128 value = 1;
@@ -358,6 +419,34 @@ void print_byte_to_chunk_count()
 // ==================================================================
 // ==================================================================
 
+void print_left_pack_shuffle_table()
+{
+    // Entry n holds the byte indices of the set bits in n, lowest first, for
+    // pshufb. The unused indices at the top are left at 0x80 (zero).
+    printf("static const uint64_t g_left_pack_shuffles[256] =\n{");
+    for(int mask = 0; mask < 256; mask++)
+    {
+        uint64_t shuffle = 0x8080808080808080ULL;
+        int index = 0;
+        for(int bit = 0; bit < 8; bit++)
+        {
+            if(mask & (1 << bit))
+            {
+                shuffle &= ~(0xffULL << (index * 8));
+                shuffle |= (uint64_t)bit << (index * 8);
+                index++;
+            }
+        }
+        if((mask & 3) == 0)
+        {
+            printf("\n   ");
+        }
+        printf(" 0x%016llx,", (unsigned long long)shuffle);
+    }
+    printf("\n};\n");
+    printf("\n");
+}
+
 int main(void)
 {
     // FILL_CHUNK_TABLE(16);
@@ -369,6 +458,9 @@ int main(void)
     print_consts();
     print_char_to_chunk_table();
     print_chunk_to_char_table();
+    // print_chunk_pair_to_chars_table();
+    // print_chars_to_chunk_pair_table();
+    // print_left_pack_shuffle_table();
     print_chunk_to_byte_count();
     print_byte_to_chunk_count();
 }
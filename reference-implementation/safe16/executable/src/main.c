@@ -117,6 +117,7 @@ static void error_unexpected_status_exit(const safe16_status status)
         HANDLE_CASE(SAFE16_ERROR_TRUNCATED_DATA);
         HANDLE_CASE(SAFE16_ERROR_INVALID_LENGTH);
         HANDLE_CASE(SAFE16_ERROR_NOT_ENOUGH_ROOM);
+        HANDLE_CASE(SAFE16_ERROR_SINK_FAILED);
 
         // This should not happen
         HANDLE_CASE(SAFE16_STATUS_OK);
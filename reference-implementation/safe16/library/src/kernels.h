@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Bulk kernels work on complete groups of whitespace-free data only.
+// Each one returns the number of groups it processed, which may be fewer than
+// group_count (for example when a decode block contains whitespace or an
+// invalid character). The per-character loops in library.c take care of
+// whatever is left over, so results are always identical to the scalar code.
+//
+// Compact kernels copy blocks of 16 chars, leaving out whitespace, and return
+// the number of chars written. They always process every block.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SAFE16_HAS_X86_KERNELS 1
+#else
+    #define SAFE16_HAS_X86_KERNELS 0
+#endif
+
+// pdep and pext only have 64-bit forms on x86_64.
+#if SAFE16_HAS_X86_KERNELS && defined(__x86_64__)
+    #define SAFE16_HAS_BMI2_KERNELS 1
+#else
+    #define SAFE16_HAS_BMI2_KERNELS 0
+#endif
+
+// The generic kernels are written with GCC/Clang vector extensions, and assume
+// that vector elements are laid out in memory in little endian order.
+#if defined(__GNUC__) && defined(__has_builtin) && defined(__BYTE_ORDER__)
+    #if __has_builtin(__builtin_convertvector) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        #define SAFE16_HAS_GENERIC_KERNELS 1
+    #endif
+#endif
+#ifndef SAFE16_HAS_GENERIC_KERNELS
+    #define SAFE16_HAS_GENERIC_KERNELS 0
+#endif
+
+#if SAFE16_HAS_X86_KERNELS
+int64_t safe16_avx2_encode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe16_avx2_decode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe16_sse41_encode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe16_sse41_decode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe16_sse41_compact_blocks(const uint8_t* src, uint8_t* dst, int64_t block_count);
+#endif
+
+#if SAFE16_HAS_BMI2_KERNELS
+int64_t safe16_bmi2_encode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe16_bmi2_decode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+#endif
+
+#if SAFE16_HAS_GENERIC_KERNELS
+int64_t safe16_generic_encode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe16_generic_decode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+#endif
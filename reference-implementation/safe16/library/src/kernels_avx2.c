@@ -0,0 +1,99 @@
+#include "kernels.h"
+
+#if SAFE16_HAS_X86_KERNELS
+
+#include <immintrin.h>
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+// Encoding: Each byte is widened to a 16-bit lane, split into its high and
+// low nibbles (high nibble in the low byte so that it gets stored first),
+// and then both nibbles are mapped to characters with a single shuffle.
+
+TARGET_AVX2 static inline __m256i encode_16_bytes(const uint8_t* const src)
+{
+    const __m256i nibble_to_char = _mm256_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i bytes = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)src));
+    const __m256i hi_nibbles = _mm256_srli_epi16(bytes, 4);
+    const __m256i lo_nibbles = _mm256_and_si256(_mm256_slli_epi16(bytes, 8), _mm256_set1_epi16(0x0f00));
+    return _mm256_shuffle_epi8(nibble_to_char, _mm256_or_si256(hi_nibbles, lo_nibbles));
+}
+
+TARGET_AVX2 int64_t safe16_avx2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 1 byte per group
+    const int64_t bytes_per_step = 32;
+    int64_t offset = 0;
+    for(; offset + bytes_per_step <= group_count; offset += bytes_per_step)
+    {
+        _mm256_storeu_si256((__m256i*)(dst + offset * 2), encode_16_bytes(src + offset));
+        _mm256_storeu_si256((__m256i*)(dst + offset * 2 + 32), encode_16_bytes(src + offset + 16));
+    }
+    return offset;
+}
+
+// Decoding: Characters are classified by range. Digits map directly, letters
+// are case folded and then checked against a-f and the substitutions
+// i, l -> 1 and o -> 0. Anything else (including whitespace) aborts the
+// block so that the scalar code can deal with it.
+
+TARGET_AVX2 static inline __m256i is_in_range(const __m256i values, const char lo, const char hi)
+{
+    const __m256i offset_values = _mm256_sub_epi8(values, _mm256_set1_epi8(lo));
+    const __m256i limit = _mm256_set1_epi8((char)(hi - lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(offset_values, limit), offset_values);
+}
+
+TARGET_AVX2 static inline bool decode_32_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const __m256i chars = _mm256_loadu_si256((const __m256i*)src);
+    const __m256i folded = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+
+    const __m256i is_digit = is_in_range(chars, '0', '9');
+    const __m256i is_hex_letter = is_in_range(folded, 'a', 'f');
+    const __m256i is_one = _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('i')),
+                                           _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('l')));
+    const __m256i is_zero = _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('o'));
+
+    const __m256i is_valid = _mm256_or_si256(_mm256_or_si256(is_digit, is_hex_letter),
+                                             _mm256_or_si256(is_one, is_zero));
+    if((uint32_t)_mm256_movemask_epi8(is_valid) != 0xffffffff)
+    {
+        return false;
+    }
+
+    // is_zero contributes nothing, which leaves its chunks at 0.
+    __m256i chunks = _mm256_and_si256(is_digit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0')));
+    chunks = _mm256_or_si256(chunks, _mm256_and_si256(is_hex_letter,
+                                     _mm256_sub_epi8(folded, _mm256_set1_epi8('a' - 10))));
+    chunks = _mm256_or_si256(chunks, _mm256_and_si256(is_one, _mm256_set1_epi8(1)));
+
+    // (hi * 16 + lo) for each pair of chunks, then narrow to bytes.
+    const __m256i words = _mm256_maddubs_epi16(chunks, _mm256_set1_epi16(0x0110));
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), 0x08);
+    _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(packed));
+    return true;
+}
+
+TARGET_AVX2 int64_t safe16_avx2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 2 chars per group
+    const int64_t groups_per_step = 16;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_32_chars(src + offset * 2, dst + offset))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE16_HAS_X86_KERNELS
@@ -0,0 +1,121 @@
+#include "kernels.h"
+
+#if SAFE16_HAS_BMI2_KERNELS
+
+#include <immintrin.h>
+#include <string.h>
+
+#define TARGET_BMI2 __attribute__((target("bmi2")))
+
+// These kernels work in general purpose registers, four groups (32 bits) at a
+// time. pdep spreads the bits out so that every 4-bit chunk gets a byte of its
+// own, and pext packs them back together again. The remaining per-byte work
+// is done on all 8 bytes of the register at once.
+
+static const uint64_t g_chunk_mask = 0x0f0f0f0f0f0f0f0full;
+static const uint64_t g_byte_ones  = 0x0101010101010101ull;
+static const uint64_t g_byte_highs = 0x8080808080808080ull;
+
+static inline uint32_t load_uint32_big_endian(const uint8_t* const src)
+{
+    uint32_t value;
+    memcpy(&value, src, sizeof(value));
+    return __builtin_bswap32(value);
+}
+
+// Adds amount to every byte of chars whose chunk is greater than threshold.
+// Chunks are below 0x10, so adding (0x7f - threshold) sets the high bit of
+// exactly those bytes without carrying into the next one.
+static inline uint64_t add_if_greater(const uint64_t chars, const uint64_t chunks, const int threshold, const int amount)
+{
+    const uint64_t is_greater = ((chunks + g_byte_ones * (0x7f - threshold)) >> 7) & g_byte_ones;
+    return chars + is_greater * amount;
+}
+
+TARGET_BMI2 static inline void encode_4_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    // The first chunk ends up in the lowest byte.
+    const uint64_t groups = load_uint32_big_endian(src);
+    const uint64_t chunks = __builtin_bswap64(_pdep_u64(groups, g_chunk_mask));
+
+    // '0' = 0 + 48, 'a' = 10 + 87
+    uint64_t chars = chunks + g_byte_ones * 48;
+    chars = add_if_greater(chars, chunks, 9, 39);
+    memcpy(dst, &chars, sizeof(chars));
+}
+
+TARGET_BMI2 int64_t safe16_bmi2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 1 byte and 2 chars per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        encode_4_bytes(src + offset, dst + offset * 2);
+    }
+    return offset;
+}
+
+#define ERRR 0xff
+#define WHSP 0xfe
+// g_encode_char_to_chunk from library.c, for the characters 0x00 - 0x7f.
+static const uint8_t g_char_to_chunk[128] =
+{
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, WHSP, WHSP, ERRR, ERRR, WHSP, ERRR, ERRR,
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+    WHSP, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, WHSP, ERRR, ERRR,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+    ERRR, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, ERRR, ERRR, 0x01, ERRR, ERRR, 0x01, ERRR, ERRR, 0x00,
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+    ERRR, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, ERRR, ERRR, 0x01, ERRR, ERRR, 0x01, ERRR, ERRR, 0x00,
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+};
+#undef WHSP
+#undef ERRR
+
+TARGET_BMI2 static inline bool decode_8_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    uint64_t chars;
+    memcpy(&chars, src, sizeof(chars));
+    if((chars & g_byte_highs) != 0)
+    {
+        return false;
+    }
+
+    // The first chunk ends up in the highest byte. Whitespace and invalid
+    // characters both have their high bit set.
+    uint64_t chunks = 0;
+    for(int i = 0; i < 8; i++)
+    {
+        chunks = (chunks << 8) | g_char_to_chunk[src[i]];
+    }
+    if((chunks & g_byte_highs) != 0)
+    {
+        return false;
+    }
+
+    const uint32_t bytes = __builtin_bswap32((uint32_t)_pext_u64(chunks, g_chunk_mask));
+    memcpy(dst, &bytes, sizeof(bytes));
+    return true;
+}
+
+TARGET_BMI2 int64_t safe16_bmi2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 2 chars and 1 byte per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_8_chars(src + offset * 2, dst + offset))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE16_HAS_BMI2_KERNELS
@@ -0,0 +1,109 @@
+#include "kernels.h"
+
+#if SAFE16_HAS_GENERIC_KERNELS
+
+#include <string.h>
+
+// These are the same algorithms as in kernels_sse41.c, written with the
+// compiler's vector extensions rather than intrinsics so that they build for
+// any target. The compiler lowers them to whatever the build's -march allows.
+// 16-byte vectors are native wherever there is SIMD at all (SSE2, NEON, ...),
+// and unlike wider ones they don't change the calling convention.
+
+typedef uint8_t  u8x8   __attribute__((vector_size(8)));
+typedef uint8_t  u8x16  __attribute__((vector_size(16)));
+typedef uint16_t u16x8  __attribute__((vector_size(16)));
+typedef uint64_t u64x2  __attribute__((vector_size(16)));
+
+static inline u8x16 load_u8x16(const uint8_t* const src)
+{
+    u8x16 value;
+    memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+// Comparisons give 0 or -1 in each element.
+static inline bool is_all_set(const u8x16 mask)
+{
+    const u64x2 words = (u64x2)mask;
+    return (words[0] & words[1]) == ~(uint64_t)0;
+}
+
+static inline u8x16 is_in_range(const u8x16 values, const uint8_t lo, const uint8_t hi)
+{
+    return (u8x16)((u8x16)(values - lo) <= (uint8_t)(hi - lo));
+}
+
+static inline void encode_8_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    u8x8 bytes;
+    memcpy(&bytes, src, sizeof(bytes));
+
+    // High nibble in the low byte so that it gets stored first.
+    const u16x8 words = __builtin_convertvector(bytes, u16x8);
+    const u8x16 chunks = (u8x16)((words >> 4) | ((words & 0x0f) << 8));
+
+    // '0' = 0 + 48, 'a' = 10 + 87
+    const u8x16 chars = chunks + 48 + ((u8x16)(chunks > 9) & 39);
+    memcpy(dst, &chars, sizeof(chars));
+}
+
+int64_t safe16_generic_encode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 1 byte per group
+    const int64_t bytes_per_step = 16;
+    int64_t offset = 0;
+    for(; offset + bytes_per_step <= group_count; offset += bytes_per_step)
+    {
+        encode_8_bytes(src + offset, dst + offset * 2);
+        encode_8_bytes(src + offset + 8, dst + offset * 2 + 16);
+    }
+    return offset;
+}
+
+static inline bool decode_16_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const u8x16 chars = load_u8x16(src);
+    const u8x16 folded = chars | 0x20;
+
+    const u8x16 is_digit = is_in_range(chars, '0', '9');
+    const u8x16 is_hex_letter = is_in_range(folded, 'a', 'f');
+    const u8x16 is_one = (u8x16)(folded == 'i') | (u8x16)(folded == 'l');
+    const u8x16 is_zero = (u8x16)(folded == 'o');
+    if(!is_all_set(is_digit | is_hex_letter | is_one | is_zero))
+    {
+        return false;
+    }
+
+    // is_zero contributes nothing, which leaves its chunks at 0.
+    const u8x16 chunks = (is_digit & (chars - '0')) |
+                         (is_hex_letter & (folded - ('a' - 10))) |
+                         (is_one & 1);
+
+    // Each 16-bit lane holds a byte's high nibble in its low byte.
+    const u16x8 words = (u16x8)chunks;
+    const u8x8 bytes = __builtin_convertvector((words << 4) | (words >> 8), u8x8);
+    memcpy(dst, &bytes, sizeof(bytes));
+    return true;
+}
+
+int64_t safe16_generic_decode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 2 chars per group
+    const int64_t groups_per_step = 8;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_16_chars(src + offset * 2, dst + offset))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE16_HAS_GENERIC_KERNELS
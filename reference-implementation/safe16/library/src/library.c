@@ -1,8 +1,15 @@
 #include <safe16/safe16.h>
 
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
 // #define KSLogger_LocalLevel DEBUG
 #include "kslogger.h"
 
+#include "kernels.h"
+#include "thread_pool.h"
+
 #define QUOTE(str) #str
 #define EXPAND_AND_QUOTE(str) QUOTE(str)
 
@@ -61,6 +68,230 @@ static const uint8_t g_chunk_to_encode_char[] =
     '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
 };
 
+static const char g_chunk_pair_to_encode_chars[] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// The scalar decoder looks up two chars at a time in g_chars_to_chunk_pair,
+// which takes up 128 KiB. Builds that can't spare that much can define
+// SAFE16_NO_PAIR_TABLE to get a SWAR decoder instead.
+#ifdef SAFE16_NO_PAIR_TABLE
+    #define SAFE16_HAS_PAIR_TABLE 0
+#else
+    #define SAFE16_HAS_PAIR_TABLE 1
+#endif
+
+#if SAFE16_HAS_PAIR_TABLE
+// Set in the entries of g_chars_to_chunk_pair that hold a chunk pair.
+#define CHUNK_PAIR_FLAG_VALID 0x8000
+
+static const uint16_t g_chars_to_chunk_pair[256 * 256] =
+{
+    [0x3030] = 0x8000, [0x3031] = 0x8010, [0x3032] = 0x8020, [0x3033] = 0x8030,
+    [0x3034] = 0x8040, [0x3035] = 0x8050, [0x3036] = 0x8060, [0x3037] = 0x8070,
+    [0x3038] = 0x8080, [0x3039] = 0x8090, [0x3041] = 0x80a0, [0x3042] = 0x80b0,
+    [0x3043] = 0x80c0, [0x3044] = 0x80d0, [0x3045] = 0x80e0, [0x3046] = 0x80f0,
+    [0x3049] = 0x8010, [0x304c] = 0x8010, [0x304f] = 0x8000, [0x3061] = 0x80a0,
+    [0x3062] = 0x80b0, [0x3063] = 0x80c0, [0x3064] = 0x80d0, [0x3065] = 0x80e0,
+    [0x3066] = 0x80f0, [0x3069] = 0x8010, [0x306c] = 0x8010, [0x306f] = 0x8000,
+    [0x3130] = 0x8001, [0x3131] = 0x8011, [0x3132] = 0x8021, [0x3133] = 0x8031,
+    [0x3134] = 0x8041, [0x3135] = 0x8051, [0x3136] = 0x8061, [0x3137] = 0x8071,
+    [0x3138] = 0x8081, [0x3139] = 0x8091, [0x3141] = 0x80a1, [0x3142] = 0x80b1,
+    [0x3143] = 0x80c1, [0x3144] = 0x80d1, [0x3145] = 0x80e1, [0x3146] = 0x80f1,
+    [0x3149] = 0x8011, [0x314c] = 0x8011, [0x314f] = 0x8001, [0x3161] = 0x80a1,
+    [0x3162] = 0x80b1, [0x3163] = 0x80c1, [0x3164] = 0x80d1, [0x3165] = 0x80e1,
+    [0x3166] = 0x80f1, [0x3169] = 0x8011, [0x316c] = 0x8011, [0x316f] = 0x8001,
+    [0x3230] = 0x8002, [0x3231] = 0x8012, [0x3232] = 0x8022, [0x3233] = 0x8032,
+    [0x3234] = 0x8042, [0x3235] = 0x8052, [0x3236] = 0x8062, [0x3237] = 0x8072,
+    [0x3238] = 0x8082, [0x3239] = 0x8092, [0x3241] = 0x80a2, [0x3242] = 0x80b2,
+    [0x3243] = 0x80c2, [0x3244] = 0x80d2, [0x3245] = 0x80e2, [0x3246] = 0x80f2,
+    [0x3249] = 0x8012, [0x324c] = 0x8012, [0x324f] = 0x8002, [0x3261] = 0x80a2,
+    [0x3262] = 0x80b2, [0x3263] = 0x80c2, [0x3264] = 0x80d2, [0x3265] = 0x80e2,
+    [0x3266] = 0x80f2, [0x3269] = 0x8012, [0x326c] = 0x8012, [0x326f] = 0x8002,
+    [0x3330] = 0x8003, [0x3331] = 0x8013, [0x3332] = 0x8023, [0x3333] = 0x8033,
+    [0x3334] = 0x8043, [0x3335] = 0x8053, [0x3336] = 0x8063, [0x3337] = 0x8073,
+    [0x3338] = 0x8083, [0x3339] = 0x8093, [0x3341] = 0x80a3, [0x3342] = 0x80b3,
+    [0x3343] = 0x80c3, [0x3344] = 0x80d3, [0x3345] = 0x80e3, [0x3346] = 0x80f3,
+    [0x3349] = 0x8013, [0x334c] = 0x8013, [0x334f] = 0x8003, [0x3361] = 0x80a3,
+    [0x3362] = 0x80b3, [0x3363] = 0x80c3, [0x3364] = 0x80d3, [0x3365] = 0x80e3,
+    [0x3366] = 0x80f3, [0x3369] = 0x8013, [0x336c] = 0x8013, [0x336f] = 0x8003,
+    [0x3430] = 0x8004, [0x3431] = 0x8014, [0x3432] = 0x8024, [0x3433] = 0x8034,
+    [0x3434] = 0x8044, [0x3435] = 0x8054, [0x3436] = 0x8064, [0x3437] = 0x8074,
+    [0x3438] = 0x8084, [0x3439] = 0x8094, [0x3441] = 0x80a4, [0x3442] = 0x80b4,
+    [0x3443] = 0x80c4, [0x3444] = 0x80d4, [0x3445] = 0x80e4, [0x3446] = 0x80f4,
+    [0x3449] = 0x8014, [0x344c] = 0x8014, [0x344f] = 0x8004, [0x3461] = 0x80a4,
+    [0x3462] = 0x80b4, [0x3463] = 0x80c4, [0x3464] = 0x80d4, [0x3465] = 0x80e4,
+    [0x3466] = 0x80f4, [0x3469] = 0x8014, [0x346c] = 0x8014, [0x346f] = 0x8004,
+    [0x3530] = 0x8005, [0x3531] = 0x8015, [0x3532] = 0x8025, [0x3533] = 0x8035,
+    [0x3534] = 0x8045, [0x3535] = 0x8055, [0x3536] = 0x8065, [0x3537] = 0x8075,
+    [0x3538] = 0x8085, [0x3539] = 0x8095, [0x3541] = 0x80a5, [0x3542] = 0x80b5,
+    [0x3543] = 0x80c5, [0x3544] = 0x80d5, [0x3545] = 0x80e5, [0x3546] = 0x80f5,
+    [0x3549] = 0x8015, [0x354c] = 0x8015, [0x354f] = 0x8005, [0x3561] = 0x80a5,
+    [0x3562] = 0x80b5, [0x3563] = 0x80c5, [0x3564] = 0x80d5, [0x3565] = 0x80e5,
+    [0x3566] = 0x80f5, [0x3569] = 0x8015, [0x356c] = 0x8015, [0x356f] = 0x8005,
+    [0x3630] = 0x8006, [0x3631] = 0x8016, [0x3632] = 0x8026, [0x3633] = 0x8036,
+    [0x3634] = 0x8046, [0x3635] = 0x8056, [0x3636] = 0x8066, [0x3637] = 0x8076,
+    [0x3638] = 0x8086, [0x3639] = 0x8096, [0x3641] = 0x80a6, [0x3642] = 0x80b6,
+    [0x3643] = 0x80c6, [0x3644] = 0x80d6, [0x3645] = 0x80e6, [0x3646] = 0x80f6,
+    [0x3649] = 0x8016, [0x364c] = 0x8016, [0x364f] = 0x8006, [0x3661] = 0x80a6,
+    [0x3662] = 0x80b6, [0x3663] = 0x80c6, [0x3664] = 0x80d6, [0x3665] = 0x80e6,
+    [0x3666] = 0x80f6, [0x3669] = 0x8016, [0x366c] = 0x8016, [0x366f] = 0x8006,
+    [0x3730] = 0x8007, [0x3731] = 0x8017, [0x3732] = 0x8027, [0x3733] = 0x8037,
+    [0x3734] = 0x8047, [0x3735] = 0x8057, [0x3736] = 0x8067, [0x3737] = 0x8077,
+    [0x3738] = 0x8087, [0x3739] = 0x8097, [0x3741] = 0x80a7, [0x3742] = 0x80b7,
+    [0x3743] = 0x80c7, [0x3744] = 0x80d7, [0x3745] = 0x80e7, [0x3746] = 0x80f7,
+    [0x3749] = 0x8017, [0x374c] = 0x8017, [0x374f] = 0x8007, [0x3761] = 0x80a7,
+    [0x3762] = 0x80b7, [0x3763] = 0x80c7, [0x3764] = 0x80d7, [0x3765] = 0x80e7,
+    [0x3766] = 0x80f7, [0x3769] = 0x8017, [0x376c] = 0x8017, [0x376f] = 0x8007,
+    [0x3830] = 0x8008, [0x3831] = 0x8018, [0x3832] = 0x8028, [0x3833] = 0x8038,
+    [0x3834] = 0x8048, [0x3835] = 0x8058, [0x3836] = 0x8068, [0x3837] = 0x8078,
+    [0x3838] = 0x8088, [0x3839] = 0x8098, [0x3841] = 0x80a8, [0x3842] = 0x80b8,
+    [0x3843] = 0x80c8, [0x3844] = 0x80d8, [0x3845] = 0x80e8, [0x3846] = 0x80f8,
+    [0x3849] = 0x8018, [0x384c] = 0x8018, [0x384f] = 0x8008, [0x3861] = 0x80a8,
+    [0x3862] = 0x80b8, [0x3863] = 0x80c8, [0x3864] = 0x80d8, [0x3865] = 0x80e8,
+    [0x3866] = 0x80f8, [0x3869] = 0x8018, [0x386c] = 0x8018, [0x386f] = 0x8008,
+    [0x3930] = 0x8009, [0x3931] = 0x8019, [0x3932] = 0x8029, [0x3933] = 0x8039,
+    [0x3934] = 0x8049, [0x3935] = 0x8059, [0x3936] = 0x8069, [0x3937] = 0x8079,
+    [0x3938] = 0x8089, [0x3939] = 0x8099, [0x3941] = 0x80a9, [0x3942] = 0x80b9,
+    [0x3943] = 0x80c9, [0x3944] = 0x80d9, [0x3945] = 0x80e9, [0x3946] = 0x80f9,
+    [0x3949] = 0x8019, [0x394c] = 0x8019, [0x394f] = 0x8009, [0x3961] = 0x80a9,
+    [0x3962] = 0x80b9, [0x3963] = 0x80c9, [0x3964] = 0x80d9, [0x3965] = 0x80e9,
+    [0x3966] = 0x80f9, [0x3969] = 0x8019, [0x396c] = 0x8019, [0x396f] = 0x8009,
+    [0x4130] = 0x800a, [0x4131] = 0x801a, [0x4132] = 0x802a, [0x4133] = 0x803a,
+    [0x4134] = 0x804a, [0x4135] = 0x805a, [0x4136] = 0x806a, [0x4137] = 0x807a,
+    [0x4138] = 0x808a, [0x4139] = 0x809a, [0x4141] = 0x80aa, [0x4142] = 0x80ba,
+    [0x4143] = 0x80ca, [0x4144] = 0x80da, [0x4145] = 0x80ea, [0x4146] = 0x80fa,
+    [0x4149] = 0x801a, [0x414c] = 0x801a, [0x414f] = 0x800a, [0x4161] = 0x80aa,
+    [0x4162] = 0x80ba, [0x4163] = 0x80ca, [0x4164] = 0x80da, [0x4165] = 0x80ea,
+    [0x4166] = 0x80fa, [0x4169] = 0x801a, [0x416c] = 0x801a, [0x416f] = 0x800a,
+    [0x4230] = 0x800b, [0x4231] = 0x801b, [0x4232] = 0x802b, [0x4233] = 0x803b,
+    [0x4234] = 0x804b, [0x4235] = 0x805b, [0x4236] = 0x806b, [0x4237] = 0x807b,
+    [0x4238] = 0x808b, [0x4239] = 0x809b, [0x4241] = 0x80ab, [0x4242] = 0x80bb,
+    [0x4243] = 0x80cb, [0x4244] = 0x80db, [0x4245] = 0x80eb, [0x4246] = 0x80fb,
+    [0x4249] = 0x801b, [0x424c] = 0x801b, [0x424f] = 0x800b, [0x4261] = 0x80ab,
+    [0x4262] = 0x80bb, [0x4263] = 0x80cb, [0x4264] = 0x80db, [0x4265] = 0x80eb,
+    [0x4266] = 0x80fb, [0x4269] = 0x801b, [0x426c] = 0x801b, [0x426f] = 0x800b,
+    [0x4330] = 0x800c, [0x4331] = 0x801c, [0x4332] = 0x802c, [0x4333] = 0x803c,
+    [0x4334] = 0x804c, [0x4335] = 0x805c, [0x4336] = 0x806c, [0x4337] = 0x807c,
+    [0x4338] = 0x808c, [0x4339] = 0x809c, [0x4341] = 0x80ac, [0x4342] = 0x80bc,
+    [0x4343] = 0x80cc, [0x4344] = 0x80dc, [0x4345] = 0x80ec, [0x4346] = 0x80fc,
+    [0x4349] = 0x801c, [0x434c] = 0x801c, [0x434f] = 0x800c, [0x4361] = 0x80ac,
+    [0x4362] = 0x80bc, [0x4363] = 0x80cc, [0x4364] = 0x80dc, [0x4365] = 0x80ec,
+    [0x4366] = 0x80fc, [0x4369] = 0x801c, [0x436c] = 0x801c, [0x436f] = 0x800c,
+    [0x4430] = 0x800d, [0x4431] = 0x801d, [0x4432] = 0x802d, [0x4433] = 0x803d,
+    [0x4434] = 0x804d, [0x4435] = 0x805d, [0x4436] = 0x806d, [0x4437] = 0x807d,
+    [0x4438] = 0x808d, [0x4439] = 0x809d, [0x4441] = 0x80ad, [0x4442] = 0x80bd,
+    [0x4443] = 0x80cd, [0x4444] = 0x80dd, [0x4445] = 0x80ed, [0x4446] = 0x80fd,
+    [0x4449] = 0x801d, [0x444c] = 0x801d, [0x444f] = 0x800d, [0x4461] = 0x80ad,
+    [0x4462] = 0x80bd, [0x4463] = 0x80cd, [0x4464] = 0x80dd, [0x4465] = 0x80ed,
+    [0x4466] = 0x80fd, [0x4469] = 0x801d, [0x446c] = 0x801d, [0x446f] = 0x800d,
+    [0x4530] = 0x800e, [0x4531] = 0x801e, [0x4532] = 0x802e, [0x4533] = 0x803e,
+    [0x4534] = 0x804e, [0x4535] = 0x805e, [0x4536] = 0x806e, [0x4537] = 0x807e,
+    [0x4538] = 0x808e, [0x4539] = 0x809e, [0x4541] = 0x80ae, [0x4542] = 0x80be,
+    [0x4543] = 0x80ce, [0x4544] = 0x80de, [0x4545] = 0x80ee, [0x4546] = 0x80fe,
+    [0x4549] = 0x801e, [0x454c] = 0x801e, [0x454f] = 0x800e, [0x4561] = 0x80ae,
+    [0x4562] = 0x80be, [0x4563] = 0x80ce, [0x4564] = 0x80de, [0x4565] = 0x80ee,
+    [0x4566] = 0x80fe, [0x4569] = 0x801e, [0x456c] = 0x801e, [0x456f] = 0x800e,
+    [0x4630] = 0x800f, [0x4631] = 0x801f, [0x4632] = 0x802f, [0x4633] = 0x803f,
+    [0x4634] = 0x804f, [0x4635] = 0x805f, [0x4636] = 0x806f, [0x4637] = 0x807f,
+    [0x4638] = 0x808f, [0x4639] = 0x809f, [0x4641] = 0x80af, [0x4642] = 0x80bf,
+    [0x4643] = 0x80cf, [0x4644] = 0x80df, [0x4645] = 0x80ef, [0x4646] = 0x80ff,
+    [0x4649] = 0x801f, [0x464c] = 0x801f, [0x464f] = 0x800f, [0x4661] = 0x80af,
+    [0x4662] = 0x80bf, [0x4663] = 0x80cf, [0x4664] = 0x80df, [0x4665] = 0x80ef,
+    [0x4666] = 0x80ff, [0x4669] = 0x801f, [0x466c] = 0x801f, [0x466f] = 0x800f,
+    [0x4930] = 0x8001, [0x4931] = 0x8011, [0x4932] = 0x8021, [0x4933] = 0x8031,
+    [0x4934] = 0x8041, [0x4935] = 0x8051, [0x4936] = 0x8061, [0x4937] = 0x8071,
+    [0x4938] = 0x8081, [0x4939] = 0x8091, [0x4941] = 0x80a1, [0x4942] = 0x80b1,
+    [0x4943] = 0x80c1, [0x4944] = 0x80d1, [0x4945] = 0x80e1, [0x4946] = 0x80f1,
+    [0x4949] = 0x8011, [0x494c] = 0x8011, [0x494f] = 0x8001, [0x4961] = 0x80a1,
+    [0x4962] = 0x80b1, [0x4963] = 0x80c1, [0x4964] = 0x80d1, [0x4965] = 0x80e1,
+    [0x4966] = 0x80f1, [0x4969] = 0x8011, [0x496c] = 0x8011, [0x496f] = 0x8001,
+    [0x4c30] = 0x8001, [0x4c31] = 0x8011, [0x4c32] = 0x8021, [0x4c33] = 0x8031,
+    [0x4c34] = 0x8041, [0x4c35] = 0x8051, [0x4c36] = 0x8061, [0x4c37] = 0x8071,
+    [0x4c38] = 0x8081, [0x4c39] = 0x8091, [0x4c41] = 0x80a1, [0x4c42] = 0x80b1,
+    [0x4c43] = 0x80c1, [0x4c44] = 0x80d1, [0x4c45] = 0x80e1, [0x4c46] = 0x80f1,
+    [0x4c49] = 0x8011, [0x4c4c] = 0x8011, [0x4c4f] = 0x8001, [0x4c61] = 0x80a1,
+    [0x4c62] = 0x80b1, [0x4c63] = 0x80c1, [0x4c64] = 0x80d1, [0x4c65] = 0x80e1,
+    [0x4c66] = 0x80f1, [0x4c69] = 0x8011, [0x4c6c] = 0x8011, [0x4c6f] = 0x8001,
+    [0x4f30] = 0x8000, [0x4f31] = 0x8010, [0x4f32] = 0x8020, [0x4f33] = 0x8030,
+    [0x4f34] = 0x8040, [0x4f35] = 0x8050, [0x4f36] = 0x8060, [0x4f37] = 0x8070,
+    [0x4f38] = 0x8080, [0x4f39] = 0x8090, [0x4f41] = 0x80a0, [0x4f42] = 0x80b0,
+    [0x4f43] = 0x80c0, [0x4f44] = 0x80d0, [0x4f45] = 0x80e0, [0x4f46] = 0x80f0,
+    [0x4f49] = 0x8010, [0x4f4c] = 0x8010, [0x4f4f] = 0x8000, [0x4f61] = 0x80a0,
+    [0x4f62] = 0x80b0, [0x4f63] = 0x80c0, [0x4f64] = 0x80d0, [0x4f65] = 0x80e0,
+    [0x4f66] = 0x80f0, [0x4f69] = 0x8010, [0x4f6c] = 0x8010, [0x4f6f] = 0x8000,
+    [0x6130] = 0x800a, [0x6131] = 0x801a, [0x6132] = 0x802a, [0x6133] = 0x803a,
+    [0x6134] = 0x804a, [0x6135] = 0x805a, [0x6136] = 0x806a, [0x6137] = 0x807a,
+    [0x6138] = 0x808a, [0x6139] = 0x809a, [0x6141] = 0x80aa, [0x6142] = 0x80ba,
+    [0x6143] = 0x80ca, [0x6144] = 0x80da, [0x6145] = 0x80ea, [0x6146] = 0x80fa,
+    [0x6149] = 0x801a, [0x614c] = 0x801a, [0x614f] = 0x800a, [0x6161] = 0x80aa,
+    [0x6162] = 0x80ba, [0x6163] = 0x80ca, [0x6164] = 0x80da, [0x6165] = 0x80ea,
+    [0x6166] = 0x80fa, [0x6169] = 0x801a, [0x616c] = 0x801a, [0x616f] = 0x800a,
+    [0x6230] = 0x800b, [0x6231] = 0x801b, [0x6232] = 0x802b, [0x6233] = 0x803b,
+    [0x6234] = 0x804b, [0x6235] = 0x805b, [0x6236] = 0x806b, [0x6237] = 0x807b,
+    [0x6238] = 0x808b, [0x6239] = 0x809b, [0x6241] = 0x80ab, [0x6242] = 0x80bb,
+    [0x6243] = 0x80cb, [0x6244] = 0x80db, [0x6245] = 0x80eb, [0x6246] = 0x80fb,
+    [0x6249] = 0x801b, [0x624c] = 0x801b, [0x624f] = 0x800b, [0x6261] = 0x80ab,
+    [0x6262] = 0x80bb, [0x6263] = 0x80cb, [0x6264] = 0x80db, [0x6265] = 0x80eb,
+    [0x6266] = 0x80fb, [0x6269] = 0x801b, [0x626c] = 0x801b, [0x626f] = 0x800b,
+    [0x6330] = 0x800c, [0x6331] = 0x801c, [0x6332] = 0x802c, [0x6333] = 0x803c,
+    [0x6334] = 0x804c, [0x6335] = 0x805c, [0x6336] = 0x806c, [0x6337] = 0x807c,
+    [0x6338] = 0x808c, [0x6339] = 0x809c, [0x6341] = 0x80ac, [0x6342] = 0x80bc,
+    [0x6343] = 0x80cc, [0x6344] = 0x80dc, [0x6345] = 0x80ec, [0x6346] = 0x80fc,
+    [0x6349] = 0x801c, [0x634c] = 0x801c, [0x634f] = 0x800c, [0x6361] = 0x80ac,
+    [0x6362] = 0x80bc, [0x6363] = 0x80cc, [0x6364] = 0x80dc, [0x6365] = 0x80ec,
+    [0x6366] = 0x80fc, [0x6369] = 0x801c, [0x636c] = 0x801c, [0x636f] = 0x800c,
+    [0x6430] = 0x800d, [0x6431] = 0x801d, [0x6432] = 0x802d, [0x6433] = 0x803d,
+    [0x6434] = 0x804d, [0x6435] = 0x805d, [0x6436] = 0x806d, [0x6437] = 0x807d,
+    [0x6438] = 0x808d, [0x6439] = 0x809d, [0x6441] = 0x80ad, [0x6442] = 0x80bd,
+    [0x6443] = 0x80cd, [0x6444] = 0x80dd, [0x6445] = 0x80ed, [0x6446] = 0x80fd,
+    [0x6449] = 0x801d, [0x644c] = 0x801d, [0x644f] = 0x800d, [0x6461] = 0x80ad,
+    [0x6462] = 0x80bd, [0x6463] = 0x80cd, [0x6464] = 0x80dd, [0x6465] = 0x80ed,
+    [0x6466] = 0x80fd, [0x6469] = 0x801d, [0x646c] = 0x801d, [0x646f] = 0x800d,
+    [0x6530] = 0x800e, [0x6531] = 0x801e, [0x6532] = 0x802e, [0x6533] = 0x803e,
+    [0x6534] = 0x804e, [0x6535] = 0x805e, [0x6536] = 0x806e, [0x6537] = 0x807e,
+    [0x6538] = 0x808e, [0x6539] = 0x809e, [0x6541] = 0x80ae, [0x6542] = 0x80be,
+    [0x6543] = 0x80ce, [0x6544] = 0x80de, [0x6545] = 0x80ee, [0x6546] = 0x80fe,
+    [0x6549] = 0x801e, [0x654c] = 0x801e, [0x654f] = 0x800e, [0x6561] = 0x80ae,
+    [0x6562] = 0x80be, [0x6563] = 0x80ce, [0x6564] = 0x80de, [0x6565] = 0x80ee,
+    [0x6566] = 0x80fe, [0x6569] = 0x801e, [0x656c] = 0x801e, [0x656f] = 0x800e,
+    [0x6630] = 0x800f, [0x6631] = 0x801f, [0x6632] = 0x802f, [0x6633] = 0x803f,
+    [0x6634] = 0x804f, [0x6635] = 0x805f, [0x6636] = 0x806f, [0x6637] = 0x807f,
+    [0x6638] = 0x808f, [0x6639] = 0x809f, [0x6641] = 0x80af, [0x6642] = 0x80bf,
+    [0x6643] = 0x80cf, [0x6644] = 0x80df, [0x6645] = 0x80ef, [0x6646] = 0x80ff,
+    [0x6649] = 0x801f, [0x664c] = 0x801f, [0x664f] = 0x800f, [0x6661] = 0x80af,
+    [0x6662] = 0x80bf, [0x6663] = 0x80cf, [0x6664] = 0x80df, [0x6665] = 0x80ef,
+    [0x6666] = 0x80ff, [0x6669] = 0x801f, [0x666c] = 0x801f, [0x666f] = 0x800f,
+    [0x6930] = 0x8001, [0x6931] = 0x8011, [0x6932] = 0x8021, [0x6933] = 0x8031,
+    [0x6934] = 0x8041, [0x6935] = 0x8051, [0x6936] = 0x8061, [0x6937] = 0x8071,
+    [0x6938] = 0x8081, [0x6939] = 0x8091, [0x6941] = 0x80a1, [0x6942] = 0x80b1,
+    [0x6943] = 0x80c1, [0x6944] = 0x80d1, [0x6945] = 0x80e1, [0x6946] = 0x80f1,
+    [0x6949] = 0x8011, [0x694c] = 0x8011, [0x694f] = 0x8001, [0x6961] = 0x80a1,
+    [0x6962] = 0x80b1, [0x6963] = 0x80c1, [0x6964] = 0x80d1, [0x6965] = 0x80e1,
+    [0x6966] = 0x80f1, [0x6969] = 0x8011, [0x696c] = 0x8011, [0x696f] = 0x8001,
+    [0x6c30] = 0x8001, [0x6c31] = 0x8011, [0x6c32] = 0x8021, [0x6c33] = 0x8031,
+    [0x6c34] = 0x8041, [0x6c35] = 0x8051, [0x6c36] = 0x8061, [0x6c37] = 0x8071,
+    [0x6c38] = 0x8081, [0x6c39] = 0x8091, [0x6c41] = 0x80a1, [0x6c42] = 0x80b1,
+    [0x6c43] = 0x80c1, [0x6c44] = 0x80d1, [0x6c45] = 0x80e1, [0x6c46] = 0x80f1,
+    [0x6c49] = 0x8011, [0x6c4c] = 0x8011, [0x6c4f] = 0x8001, [0x6c61] = 0x80a1,
+    [0x6c62] = 0x80b1, [0x6c63] = 0x80c1, [0x6c64] = 0x80d1, [0x6c65] = 0x80e1,
+    [0x6c66] = 0x80f1, [0x6c69] = 0x8011, [0x6c6c] = 0x8011, [0x6c6f] = 0x8001,
+    [0x6f30] = 0x8000, [0x6f31] = 0x8010, [0x6f32] = 0x8020, [0x6f33] = 0x8030,
+    [0x6f34] = 0x8040, [0x6f35] = 0x8050, [0x6f36] = 0x8060, [0x6f37] = 0x8070,
+    [0x6f38] = 0x8080, [0x6f39] = 0x8090, [0x6f41] = 0x80a0, [0x6f42] = 0x80b0,
+    [0x6f43] = 0x80c0, [0x6f44] = 0x80d0, [0x6f45] = 0x80e0, [0x6f46] = 0x80f0,
+    [0x6f49] = 0x8010, [0x6f4c] = 0x8010, [0x6f4f] = 0x8000, [0x6f61] = 0x80a0,
+    [0x6f62] = 0x80b0, [0x6f63] = 0x80c0, [0x6f64] = 0x80d0, [0x6f65] = 0x80e0,
+    [0x6f66] = 0x80f0, [0x6f69] = 0x8010, [0x6f6c] = 0x8010, [0x6f6f] = 0x8000,
+};
+#endif
+
 static const int g_chunk_to_byte_count[]   = { 0, 0, 1 };
 
 static const int g_byte_to_chunk_count[]   = { 0, 2 };
@@ -88,6 +319,20 @@ static inline int extract_byte_from_accumulator(const int64_t accumulator, const
     return extracted_byte;
 }
 
+// None of the bulk encoders load past the groups that they encode, so they
+// have nothing to gain from slack.
+static const int g_slack_group_count = 0;
+
+// Writes the low byte_count bytes of the accumulator, high byte first, as one
+// 8-byte store. This writes 8 bytes no matter what byte_count is, so it needs
+// slack after dst.
+static inline void store_accumulator_bytes(uint8_t* const dst, const int64_t accumulator, const int byte_count)
+{
+    const uint64_t value = (uint64_t)accumulator << (64 - byte_count * g_bits_per_byte);
+    const uint64_t bytes = __builtin_bswap64(value);
+    memcpy(dst, &bytes, sizeof(bytes));
+}
+
 static inline int extract_chunk_from_accumulator(const int64_t accumulator, const int chunk_index_lo_first)
 {
     const int chunk_mask = (1 << g_bits_per_chunk) - 1;
@@ -98,6 +343,164 @@ static inline int extract_chunk_from_accumulator(const int64_t accumulator, cons
     return extracted_chunk;
 }
 
+// The scalar bulk encoder works on two chunks (a whole byte) at a time, looking
+// them up in g_chunk_pair_to_encode_chars.
+static inline int64_t encode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    for(int64_t offset = 0; offset < group_count; offset++)
+    {
+        memcpy(dst + offset * g_chunks_per_group, g_chunk_pair_to_encode_chars + src[offset] * 2, 2);
+    }
+    return group_count;
+}
+
+#if SAFE16_HAS_PAIR_TABLE
+
+// With the pair table, the scalar decoder works on two chunks (a whole byte) at a
+// time. Groups that contain whitespace or an invalid character are left to
+// the per-character loop.
+
+static inline uint16_t decode_char_pair(const uint8_t* const src)
+{
+    return g_chars_to_chunk_pair[src[0] | (src[1] << g_bits_per_byte)];
+}
+
+static inline int64_t decode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    // Errors are only checked once per step, so that the lookups don't have
+    // to wait for each other.
+    int64_t offset = 0;
+    for(; offset + 8 <= group_count; offset += 8)
+    {
+        const uint8_t* const step_src = src + offset * g_chunks_per_group;
+        uint8_t bytes[8];
+        uint16_t valid_pairs = CHUNK_PAIR_FLAG_VALID;
+        for(int i = 0; i < 8; i++)
+        {
+            const uint16_t pair = decode_char_pair(step_src + i * g_chunks_per_group);
+            valid_pairs &= pair;
+            bytes[i] = (uint8_t)pair;
+        }
+        if(!(valid_pairs & CHUNK_PAIR_FLAG_VALID))
+        {
+            break;
+        }
+        memcpy(dst + offset, bytes, sizeof(bytes));
+    }
+    return offset;
+}
+
+#else
+
+// Without the pair table, the scalar decoder works on 8 characters at a time
+// in a 64-bit word (SWAR), using plain C so that it's available on every
+// platform. Words that contain whitespace or an invalid character are left to
+// the per-character loop.
+
+static const uint64_t g_swar_ones  = 0x0101010101010101ull;
+static const uint64_t g_swar_highs = 0x8080808080808080ull;
+
+// Written out in full so that compilers turn it into a single load.
+static inline uint64_t load_little_endian(const uint8_t* const src)
+{
+    return (uint64_t)src[0]       | (uint64_t)src[1] << 8  | (uint64_t)src[2] << 16 | (uint64_t)src[3] << 24 |
+           (uint64_t)src[4] << 32 | (uint64_t)src[5] << 40 | (uint64_t)src[6] << 48 | (uint64_t)src[7] << 56;
+}
+
+static inline void store_big_endian(uint8_t* const dst, const uint64_t value, const int byte_count)
+{
+    for(int i = 0; i < byte_count; i++)
+    {
+        dst[i] = (uint8_t)(value >> ((byte_count - 1 - i) * g_bits_per_byte));
+    }
+}
+
+// The comparisons only work on bytes with the high bit clear. They return a
+// word with the high bit set in every byte that matches.
+static inline uint64_t swar_greater_than(const uint64_t chars, const int value)
+{
+    return (chars + g_swar_ones * (0x7f - value)) & g_swar_highs;
+}
+
+static inline uint64_t swar_in_range(const uint64_t chars, const int lo, const int hi)
+{
+    return swar_greater_than(chars, lo - 1) & ~swar_greater_than(chars, hi);
+}
+
+// Puts value into every byte that matches, and 0 into the others.
+static inline uint64_t swar_select(const uint64_t matches, const int value)
+{
+    return (matches >> 7) * value;
+}
+
+// Subtracts a separate offset (below 0x80) from each byte. Setting the high
+// bits first stops the bytes from borrowing from each other.
+static inline uint64_t swar_subtract(const uint64_t chars, const uint64_t offsets)
+{
+    return ((chars | g_swar_highs) - offsets) & ~g_swar_highs;
+}
+
+// Packs 8 chunks (the first one in the lowest byte) into a single value,
+// most significant chunk first.
+static inline uint64_t swar_pack_chunks(const uint64_t chunks)
+{
+    const uint64_t pairs = ((chunks & 0x00ff00ff00ff00ffull) << g_bits_per_chunk) |
+                           ((chunks >> 8) & 0x00ff00ff00ff00ffull);
+    const uint64_t quads = ((pairs & 0x0000ffff0000ffffull) << (g_bits_per_chunk * 2)) |
+                           ((pairs >> 16) & 0x0000ffff0000ffffull);
+    return ((quads & 0xffffffffull) << (g_bits_per_chunk * 4)) | (quads >> 32);
+}
+
+// Returns false if any of the characters is whitespace or invalid.
+static inline bool swar_chars_to_chunks(const uint64_t chars, uint64_t* const chunks)
+{
+    const uint64_t folded = chars | (g_swar_ones * 0x20);
+    const uint64_t is_digit = swar_in_range(chars, '0', '9');
+    const uint64_t is_hex   = swar_in_range(folded, 'a', 'f');
+    // 'i' and 'l' are substitutes for '1', and 'o' for '0'.
+    const uint64_t is_one   = swar_in_range(folded, 'i', 'i') | swar_in_range(folded, 'l', 'l');
+    const uint64_t is_zero  = swar_in_range(folded, 'o', 'o');
+    if((is_digit | is_hex | is_one | is_zero) != g_swar_highs)
+    {
+        return false;
+    }
+
+    // '0' = 0 + 48, 'a' = 10 + 87
+    const uint64_t offsets = swar_select(is_digit, 48) + swar_select(is_hex, 87);
+    *chunks = swar_subtract(folded, offsets) & ~swar_select(is_one | is_zero, 0xff);
+    *chunks |= swar_select(is_one, 1);
+    return true;
+}
+
+// Returns false if any of the characters is whitespace or invalid.
+static inline bool decode_8_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const uint64_t chars = load_little_endian(src);
+    uint64_t chunks;
+    if((chars & g_swar_highs) != 0 || !swar_chars_to_chunks(chars, &chunks))
+    {
+        return false;
+    }
+    store_big_endian(dst, swar_pack_chunks(chunks), 8 * g_bits_per_chunk / g_bits_per_byte);
+    return true;
+}
+
+static inline int64_t decode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    const int64_t groups_per_step = 8 / g_chunks_per_group;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_8_chars(src + offset * g_chunks_per_group, dst + offset * g_bytes_per_group))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif
+
 
 // ===========================================================================
 // Code below this point is the same in all safeXX codecs (with a different
@@ -106,6 +509,212 @@ static inline int extract_chunk_from_accumulator(const int64_t accumulator, cons
 // other codecs.
 // ===========================================================================
 
+// After the bulk decoder stops early (usually because of whitespace), the
+// per-character loop consumes at least this many characters before the bulk
+// decoder is tried again.
+static const int g_bulk_decode_retry_char_count = 32;
+
+// -------
+// Kernels
+// -------
+
+typedef struct
+{
+    const char* name;
+    bool (*is_supported)(void);
+    int64_t (*encode_groups)(const uint8_t* src, uint8_t* dst, int64_t group_count);
+    int64_t (*decode_groups)(const uint8_t* src, uint8_t* dst, int64_t group_count);
+    int64_t (*compact_blocks)(const uint8_t* src, uint8_t* dst, int64_t block_count);
+} bulk_kernel;
+
+static bool is_always_supported(void)
+{
+    return true;
+}
+
+static int64_t no_bulk_kernel(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    (void)src;
+    (void)dst;
+    (void)group_count;
+    return 0;
+}
+
+// Compaction works on blocks of this many chars.
+static const int g_compact_block_size = 16;
+
+static int64_t compact_blocks_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t block_count)
+{
+    // Every char gets written, but only kept ones move the write position on.
+    // This saves a hard to predict branch.
+    uint8_t* next = dst;
+    for(int64_t i = 0; i < block_count * g_compact_block_size; i++)
+    {
+        const uint8_t next_char = src[i];
+        *next = next_char;
+        next += g_encode_char_to_chunk[next_char] != CHUNK_CODE_WHITESPACE;
+    }
+    return next - dst;
+}
+
+#if SAFE16_HAS_X86_KERNELS
+static bool is_avx2_supported(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+static bool is_sse41_supported(void)
+{
+    return __builtin_cpu_supports("sse4.1");
+}
+#endif
+
+#if SAFE16_HAS_BMI2_KERNELS
+// pdep and pext are microcoded on AMD CPUs before Zen 3, but those all support
+// AVX2 anyway, so they never get this far down the list.
+static bool is_bmi2_supported(void)
+{
+    return __builtin_cpu_supports("bmi2");
+}
+#endif
+
+// Fastest first. The scalar kernel leaves everything to encode_groups_scalar()
+// and decode_groups_scalar().
+static const bulk_kernel g_kernels[] =
+{
+#if SAFE16_HAS_X86_KERNELS
+    {"avx2",    is_avx2_supported,   safe16_avx2_encode_groups,     safe16_avx2_decode_groups,    safe16_sse41_compact_blocks},
+    {"sse4.1",  is_sse41_supported,  safe16_sse41_encode_groups,    safe16_sse41_decode_groups,   safe16_sse41_compact_blocks},
+#endif
+#if SAFE16_HAS_BMI2_KERNELS
+    {"bmi2",    is_bmi2_supported,   safe16_bmi2_encode_groups,     safe16_bmi2_decode_groups,    compact_blocks_scalar},
+#endif
+#if SAFE16_HAS_GENERIC_KERNELS
+    {"generic", is_always_supported, safe16_generic_encode_groups,  safe16_generic_decode_groups, compact_blocks_scalar},
+#endif
+    {"scalar",  is_always_supported, no_bulk_kernel,                no_bulk_kernel,               compact_blocks_scalar},
+};
+static const int g_kernel_count = sizeof(g_kernels) / sizeof(*g_kernels);
+
+// Forces a kernel by name (if the CPU supports it).
+static const char* const g_kernel_override_env_var = "SAFE16_KERNEL";
+
+static const bulk_kernel* select_kernel(void)
+{
+    const char* const requested = getenv(g_kernel_override_env_var);
+    if(requested != NULL)
+    {
+        for(int i = 0; i < g_kernel_count; i++)
+        {
+            if(strcmp(g_kernels[i].name, requested) == 0 && g_kernels[i].is_supported())
+            {
+                return &g_kernels[i];
+            }
+        }
+        KSLOG_DEBUG("Kernel %s is unknown or unsupported. Using the default.", requested);
+    }
+
+    for(int i = 0; i < g_kernel_count - 1; i++)
+    {
+        if(g_kernels[i].is_supported())
+        {
+            return &g_kernels[i];
+        }
+    }
+    return &g_kernels[g_kernel_count - 1];
+}
+
+// Selection always gives the same result, so threads that race to initialize
+// this just store the same pointer.
+static _Atomic(const bulk_kernel*) g_active_kernel = NULL;
+
+static inline const bulk_kernel* get_active_kernel(void)
+{
+    const bulk_kernel* kernel = atomic_load_explicit(&g_active_kernel, memory_order_acquire);
+    if(kernel == NULL)
+    {
+        kernel = select_kernel();
+        KSLOG_DEBUG("Selected kernel %s", kernel->name);
+        atomic_store_explicit(&g_active_kernel, kernel, memory_order_release);
+    }
+    return kernel;
+}
+
+// Buffers passed to the *_with_slack() functions can be read and written for
+// this many bytes past their ends, which is enough for g_slack_group_count
+// groups and a store_accumulator_bytes().
+static const int g_required_slack = 64;
+
+// Bulk encoders hold back the last few groups when they load more than they
+// use. extra_group_count tells them how many more groups' worth of src and dst
+// are safe to touch, so that they don't have to.
+static inline int64_t encode_groups(const uint8_t* const src,
+                                    uint8_t* const dst,
+                                    const int64_t group_count,
+                                    const int64_t extra_group_count)
+{
+    int64_t offset = get_active_kernel()->encode_groups(src, dst, group_count + extra_group_count);
+    if(offset > group_count)
+    {
+        offset = group_count;
+    }
+    return offset + encode_groups_scalar(src + offset * g_bytes_per_group,
+                                         dst + offset * g_chunks_per_group,
+                                         group_count - offset);
+}
+
+static inline int64_t decode_groups(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    const int64_t offset = get_active_kernel()->decode_groups(src, dst, group_count);
+    return offset + decode_groups_scalar(src + offset * g_chunks_per_group,
+                                         dst + offset * g_bytes_per_group,
+                                         group_count - offset);
+}
+
+static inline int64_t compact_blocks(const uint8_t* const src, uint8_t* const dst, const int64_t block_count)
+{
+    return get_active_kernel()->compact_blocks(src, dst, block_count);
+}
+
+// Decodes whole groups from source data that has whitespace in it, by
+// compacting as much of it as fits into a scratch buffer first. Moves
+// *src_ptr past the groups that were decoded, and returns how many there were.
+static int64_t decode_compacted_groups(const uint8_t** const src_ptr,
+                                       const uint8_t* const src_end,
+                                       uint8_t* const dst,
+                                       const int64_t max_group_count)
+{
+    uint8_t scratch[1024];
+    const uint8_t* const src = *src_ptr;
+    const int64_t src_length = src_end - src < (int64_t)sizeof(scratch) ? src_end - src : (int64_t)sizeof(scratch);
+    const int64_t block_count = src_length / g_compact_block_size;
+    const int64_t char_count = compact_blocks(src, scratch, block_count);
+    const int64_t src_group_count = char_count / g_chunks_per_group;
+    const int64_t group_count = src_group_count < max_group_count ? src_group_count : max_group_count;
+    const int64_t decoded_group_count = decode_groups(scratch, dst, group_count);
+    KSLOG_DEBUG("Compacted %d chars to %d, and decoded %d of %d groups",
+                block_count * g_compact_block_size, char_count, decoded_group_count, group_count);
+    if(decoded_group_count == 0)
+    {
+        return 0;
+    }
+
+    // Walk back over the chars that weren't decoded (and any whitespace in
+    // front of them) to find where the last decoded one came from.
+    const uint8_t* next = src + block_count * g_compact_block_size;
+    int64_t left_over = char_count - decoded_group_count * g_chunks_per_group;
+    while(left_over > 0 || g_encode_char_to_chunk[next[-1]] == CHUNK_CODE_WHITESPACE)
+    {
+        next--;
+        if(g_encode_char_to_chunk[*next] != CHUNK_CODE_WHITESPACE)
+        {
+            left_over--;
+        }
+    }
+    *src_ptr = next;
+    return decoded_group_count;
+}
+
 static inline int calculate_length_chunk_count(int64_t length)
 {
     int chunk_count = 0;
@@ -126,6 +735,11 @@ const char* safe16_version(void)
     return EXPAND_AND_QUOTE(PROJECT_VERSION);
 }
 
+const char* safe16_get_active_kernel(void)
+{
+    return get_active_kernel()->name;
+}
+
 int64_t safe16_get_decoded_length(const int64_t encoded_length)
 {
     if(encoded_length < 0)
@@ -141,11 +755,12 @@ int64_t safe16_get_decoded_length(const int64_t encoded_length)
     return result;
 }
 
-safe16_status safe16_decode_feed(const uint8_t** const src_buffer_ptr,
+static safe16_status decode_feed(const uint8_t** const src_buffer_ptr,
                                  const int64_t src_length,
                                  uint8_t** const dst_buffer_ptr,
                                  const int64_t dst_length,
-                                 const safe16_stream_state stream_state)
+                                 const safe16_stream_state stream_state,
+                                 const bool has_slack)
 {
     if(src_length < 0 || dst_length < 0)
     {
@@ -164,27 +779,98 @@ safe16_status safe16_decode_feed(const uint8_t** const src_buffer_ptr,
     { \
         const int bytes_to_write = g_chunk_to_byte_count[CHUNK_COUNT]; \
         KSLOG_DEBUG("Writing %d chunks as %d decoded bytes", CHUNK_COUNT, bytes_to_write); \
-        for(int i = bytes_to_write - 1; i >= 0; i--) \
+        if(has_slack && bytes_to_write > 0) \
+        { \
+            store_accumulator_bytes(dst, accumulator, bytes_to_write); \
+            dst += bytes_to_write; \
+        } \
+        else \
         { \
-            *dst++ = extract_byte_from_accumulator(accumulator, i); \
-            KSLOG_DEBUG("Wrote byte %02x to index %d", dst[-1], i); \
+            for(int i = bytes_to_write - 1; i >= 0; i--) \
+            { \
+                *dst++ = extract_byte_from_accumulator(accumulator, i); \
+                KSLOG_DEBUG("Wrote byte %02x to index %d", dst[-1], i); \
+            } \
         } \
     }
 
+    const bool whitespace_is_invalid = stream_state & SAFE16_SRC_HAS_NO_WHITESPACE;
     const uint8_t* last_src = src;
+    const uint8_t* next_bulk_src = src;
     int current_group_chunk_count = 0;
     int64_t accumulator = 0;
 
     while(src < src_end)
     {
+        if(current_group_chunk_count == 0 && src >= next_bulk_src)
+        {
+            // The per-character loop never fills the last byte of dst by
+            // itself (that's left to the end-of-stream handling), so the bulk
+            // decoder must leave it free as well.
+            const int64_t src_group_count = (src_end - src) / g_chunks_per_group;
+            const int64_t dst_group_count = dst < dst_end ? (dst_end - dst - 1) / g_bytes_per_group : 0;
+            const int64_t group_count = src_group_count < dst_group_count ? src_group_count : dst_group_count;
+            const int64_t decoded_group_count = decode_groups(src, dst, group_count);
+            KSLOG_DEBUG("Bulk decoded %d of %d groups", decoded_group_count, group_count);
+            src += decoded_group_count * g_chunks_per_group;
+            dst += decoded_group_count * g_bytes_per_group;
+            if(decoded_group_count > 0)
+            {
+                last_src = src;
+            }
+            // Without whitespace, a group that the bulk decoder stopped on
+            // holds an error, so there's no point in trying again.
+            next_bulk_src = whitespace_is_invalid ? src_end : src + g_bulk_decode_retry_char_count;
+            if(decoded_group_count < group_count && !whitespace_is_invalid)
+            {
+                // Most likely the bulk decoder stopped on whitespace, so give
+                // it another go without.
+                const int64_t compacted_group_count = decode_compacted_groups(&src,
+                                                                              src_end,
+                                                                              dst,
+                                                                              dst_group_count - decoded_group_count);
+                if(compacted_group_count > 0)
+                {
+                    dst += compacted_group_count * g_bytes_per_group;
+                    last_src = src;
+                    next_bulk_src = src;
+                }
+            }
+            continue;
+        }
+        if(current_group_chunk_count == 0 && src_end - src >= g_chunks_per_group && dst_end - dst > g_bytes_per_group)
+        {
+            // There's room for a whole group, so its chunks can skip the
+            // per-character checks below until whitespace or an error turns
+            // up. That character is left to the checks.
+            while(current_group_chunk_count < g_chunks_per_group)
+            {
+                const uint8_t chunk = g_encode_char_to_chunk[*src];
+                if(chunk >= CHUNK_CODE_WHITESPACE)
+                {
+                    break;
+                }
+                accumulator = accumulate_chunk(accumulator, chunk);
+                current_group_chunk_count++;
+                src++;
+            }
+            if(current_group_chunk_count == g_chunks_per_group)
+            {
+                WRITE_BYTES(current_group_chunk_count);
+                current_group_chunk_count = 0;
+                accumulator = 0;
+                last_src = src;
+                continue;
+            }
+        }
         const uint8_t next_char = *src++;
         const uint8_t next_chunk = g_encode_char_to_chunk[next_char];
-        if(next_chunk == CHUNK_CODE_WHITESPACE)
+        if(next_chunk == CHUNK_CODE_WHITESPACE && !whitespace_is_invalid)
         {
             KSLOG_TRACE("Whitespace");
             continue;
         }
-        if(next_chunk == CHUNK_CODE_ERROR)
+        if(next_chunk >= CHUNK_CODE_WHITESPACE)
         {
             KSLOG_DEBUG("Error: Invalid source data: %02x: [%c]", next_char, next_char);
             *src_buffer_ptr = src - 1;
@@ -207,13 +893,27 @@ safe16_status safe16_decode_feed(const uint8_t** const src_buffer_ptr,
         }
     }
 
-    // Skip over any trailing whitespace
-    for(; src < src_end; src++)
+    if(whitespace_is_invalid)
     {
-        if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+        if(src < src_end && g_encode_char_to_chunk[*src] == CHUNK_CODE_WHITESPACE)
         {
-            last_src = src;
-            break;
+            KSLOG_DEBUG("Error: Whitespace in strict source data");
+            *src_buffer_ptr = src;
+            *dst_buffer_ptr = dst;
+            return SAFE16_ERROR_INVALID_SOURCE_DATA;
+        }
+    }
+    else
+    {
+        // Skip over any trailing whitespace. The loop only stops early part
+        // way through a group, so last_src stays at the start of that group
+        // unless it gets written below.
+        for(; src < src_end; src++)
+        {
+            if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+            {
+                break;
+            }
         }
     }
 
@@ -270,87 +970,350 @@ safe16_status safe16_decode_feed(const uint8_t** const src_buffer_ptr,
     #undef WRITE_BYTES
 }
 
-int64_t safe16_read_length_field(const uint8_t* const buffer,
-                                 const int64_t buffer_length,
-                                 int64_t* const length)
+safe16_status safe16_decode_feed(const uint8_t** const src_buffer_ptr,
+                                 const int64_t src_length,
+                                 uint8_t** const dst_buffer_ptr,
+                                 const int64_t dst_length,
+                                 const safe16_stream_state stream_state)
 {
-    if(buffer_length < 0)
+    return decode_feed(src_buffer_ptr, src_length, dst_buffer_ptr, dst_length, stream_state, false);
+}
+
+// A position in a vector of buffers, as if they were one buffer.
+typedef struct
+{
+    const safe16_iovec* vector;
+    int count;
+    int index;
+    int64_t offset;
+    int64_t used;
+} vector_cursor;
+
+static safe16_status init_vector_cursor(vector_cursor* const cursor,
+                                        const safe16_iovec* const vector,
+                                        const int count)
+{
+    if(count < 0)
     {
         return SAFE16_ERROR_INVALID_LENGTH;
     }
-    const int64_t max_pre_append_value = INT64_MAX >> g_bits_per_length_chunk;
-    const int continuation_bit = 1 << g_bits_per_length_chunk;
-    const int max_chunk_value = continuation_bit - 1;
-    const int chunk_mask = continuation_bit - 1;
-    KSLOG_DEBUG("bits %d, continue %02x, mask %02x",
-                g_bits_per_length_chunk, continuation_bit, chunk_mask);
-
-    const uint8_t* buffer_end = buffer + buffer_length;
-    int64_t value = 0;
-    int next_chunk = 0;
-
-    const uint8_t* src = buffer;
-    while(src < buffer_end)
+    for(int i = 0; i < count; i++)
     {
-        next_chunk = g_encode_char_to_chunk[(int)*src];
-        if(next_chunk == CHUNK_CODE_WHITESPACE)
-        {
-            src++;
-            continue;
-        }
-        const int chunk_value = next_chunk & ~continuation_bit;
-        if(chunk_value > max_chunk_value)
-        {
-            KSLOG_DEBUG("Error: Invalid length character: [%c]", *src);
-            return SAFE16_ERROR_INVALID_SOURCE_DATA;
-        }
-        if(value > max_pre_append_value)
-        {
-            KSLOG_DEBUG("Error: Length field too big");
-            return SAFE16_ERROR_INVALID_SOURCE_DATA;            
-        }
-        value = (value << g_bits_per_length_chunk) | (next_chunk & chunk_mask);
-        KSLOG_DEBUG("Chunk %d: '%c' (%d), continue %d, value portion = %d",
-                    src - buffer, *src, next_chunk, next_chunk & continuation_bit,
-                    (next_chunk & chunk_mask));
-        src++;
-        if(!(next_chunk & continuation_bit))
+        if(vector[i].length < 0)
         {
-            break;
+            return SAFE16_ERROR_INVALID_LENGTH;
         }
     }
-    if(next_chunk & continuation_bit)
+    cursor->vector = vector;
+    cursor->count = count;
+    cursor->index = 0;
+    cursor->offset = 0;
+    cursor->used = 0;
+    return SAFE16_STATUS_OK;
+}
+
+// Gives the length left in the current buffer, after moving past any buffers
+// that are used up.
+static int64_t get_contiguous_length(vector_cursor* const cursor)
+{
+    while(cursor->index < cursor->count && cursor->offset >= cursor->vector[cursor->index].length)
     {
-        KSLOG_DEBUG("Error: Unterminated length field");
-        return SAFE16_ERROR_UNTERMINATED_LENGTH_FIELD;
+        cursor->index++;
+        cursor->offset = 0;
     }
-    *length = value;
-    KSLOG_DEBUG("Length = %d, chunks = %d", value, src - buffer);
-    return src - buffer;
+    return cursor->index < cursor->count ? cursor->vector[cursor->index].length - cursor->offset : 0;
 }
 
-int64_t safe16_decode(const uint8_t* const src_buffer,
-                      const int64_t src_length,
-                      uint8_t* const dst_buffer,
-                      const int64_t dst_length)
+static inline uint8_t* get_cursor_pointer(const vector_cursor* const cursor)
 {
-    if(src_length < 0 || dst_length < 0)
+    return (uint8_t*)cursor->vector[cursor->index].base + cursor->offset;
+}
+
+// Gives the total length left in the vector, or limit if that's less.
+static int64_t get_remaining_length(vector_cursor* const cursor, const int64_t limit)
+{
+    int64_t length = get_contiguous_length(cursor);
+    for(int i = cursor->index + 1; i < cursor->count && length < limit; i++)
     {
-        return SAFE16_ERROR_INVALID_LENGTH;
+        length += cursor->vector[i].length;
     }
-    const uint8_t* src = src_buffer;
-    uint8_t* dst = dst_buffer;
-    const safe16_status status = safe16_decode_feed(
-                                    &src,
-                                    src_length,
-                                    &dst,
-                                    dst_length,
-                                    SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM);
-    if(status != SAFE16_STATUS_OK)
+    return length < limit ? length : limit;
+}
+
+// True if nothing comes after the current buffer.
+static bool is_in_last_buffer(vector_cursor* const cursor)
+{
+    get_contiguous_length(cursor);
+    for(int i = cursor->index + 1; i < cursor->count; i++)
     {
-        if(status == SAFE16_STATUS_PARTIALLY_COMPLETE)
+        if(cursor->vector[i].length > 0)
         {
-            return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void advance_cursor(vector_cursor* const cursor, int64_t length)
+{
+    cursor->used += length;
+    while(length > 0)
+    {
+        const int64_t contiguous_length = get_contiguous_length(cursor);
+        const int64_t step = length < contiguous_length ? length : contiguous_length;
+        cursor->offset += step;
+        length -= step;
+    }
+}
+
+// The caller makes sure that there's room for length bytes.
+static void scatter_to_cursor(vector_cursor* const cursor, const uint8_t* src, int64_t length)
+{
+    while(length > 0)
+    {
+        const int64_t contiguous_length = get_contiguous_length(cursor);
+        const int64_t step = length < contiguous_length ? length : contiguous_length;
+        memcpy(get_cursor_pointer(cursor), src, step);
+        src += step;
+        length -= step;
+        advance_cursor(cursor, step);
+    }
+}
+
+// Groups that straddle buffers go through a buffer on the stack. This is big
+// enough for a group in any of the codecs.
+#define STRADDLED_GROUP_SIZE 32
+
+safe16_status safe16_decode_feedv(const safe16_iovec* const src_vector,
+                                  const int src_vector_count,
+                                  const safe16_iovec* const dst_vector,
+                                  const int dst_vector_count,
+                                  int64_t* const src_used,
+                                  int64_t* const dst_used,
+                                  const safe16_stream_state stream_state)
+{
+    vector_cursor src;
+    vector_cursor dst;
+    if(init_vector_cursor(&src, src_vector, src_vector_count) != SAFE16_STATUS_OK ||
+       init_vector_cursor(&dst, dst_vector, dst_vector_count) != SAFE16_STATUS_OK)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const bool whitespace_is_invalid = stream_state & SAFE16_SRC_HAS_NO_WHITESPACE;
+    const int persistent_state = stream_state & (SAFE16_EXPECT_DST_STREAM_TO_END | SAFE16_SRC_HAS_NO_WHITESPACE);
+    safe16_status status = SAFE16_STATUS_PARTIALLY_COMPLETE;
+
+    for(;;)
+    {
+        const int64_t src_length = get_contiguous_length(&src);
+        const int64_t dst_length = get_contiguous_length(&dst);
+        if(src_length > 0 && dst_length > 0)
+        {
+            // The ends of the streams only come into it once both are in
+            // their last buffers. Before that, the group at the end of one
+            // buffer is left for the code below.
+            int current_state = persistent_state;
+            if(is_in_last_buffer(&src) && is_in_last_buffer(&dst))
+            {
+                current_state |= stream_state & (SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM);
+            }
+            const uint8_t* const src_start = get_cursor_pointer(&src);
+            uint8_t* const dst_start = get_cursor_pointer(&dst);
+            const uint8_t* src_ptr = src_start;
+            uint8_t* dst_ptr = dst_start;
+            status = decode_feed(&src_ptr, src_length, &dst_ptr, dst_length, (safe16_stream_state)current_state, false);
+            advance_cursor(&src, src_ptr - src_start);
+            advance_cursor(&dst, dst_ptr - dst_start);
+            if(status != SAFE16_STATUS_PARTIALLY_COMPLETE)
+            {
+                break;
+            }
+            if(src_ptr > src_start || dst_ptr > dst_start)
+            {
+                continue;
+            }
+        }
+
+        // The next group straddles buffers (or is the last one), so gather
+        // its chars, decode them, and scatter the bytes.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        // Where each char is in the source, counting any whitespace that was
+        // skipped, so that errors can be pinned on the right one.
+        int64_t group_offsets[STRADDLED_GROUP_SIZE];
+        int group_length = 0;
+        vector_cursor group_end = src;
+        while(group_length < g_chunks_per_group && get_contiguous_length(&group_end) > 0)
+        {
+            const uint8_t next_char = *get_cursor_pointer(&group_end);
+            const int64_t next_char_offset = group_end.used;
+            advance_cursor(&group_end, 1);
+            if(g_encode_char_to_chunk[next_char] == CHUNK_CODE_WHITESPACE && !whitespace_is_invalid)
+            {
+                continue;
+            }
+            group_offsets[group_length] = next_char_offset;
+            group[group_length++] = next_char;
+        }
+        // Whitespace after the group goes with it, so that the source is seen
+        // to end with the group if that's all there is.
+        while(!whitespace_is_invalid &&
+              get_contiguous_length(&group_end) > 0 &&
+              g_encode_char_to_chunk[*get_cursor_pointer(&group_end)] == CHUNK_CODE_WHITESPACE)
+        {
+            advance_cursor(&group_end, 1);
+        }
+
+        int current_state = persistent_state;
+        if(get_contiguous_length(&group_end) == 0)
+        {
+            current_state |= stream_state & SAFE16_SRC_IS_AT_END_OF_STREAM;
+        }
+        uint8_t bytes[STRADDLED_GROUP_SIZE];
+        int64_t bytes_length = sizeof(bytes);
+        const int64_t dst_remaining_length = get_remaining_length(&dst, bytes_length + 1);
+        if(dst_remaining_length <= bytes_length)
+        {
+            bytes_length = dst_remaining_length;
+            current_state |= stream_state & SAFE16_DST_IS_AT_END_OF_STREAM;
+        }
+        const uint8_t* group_ptr = group;
+        uint8_t* bytes_ptr = bytes;
+        status = decode_feed(&group_ptr, group_length, &bytes_ptr, bytes_length, (safe16_stream_state)current_state, false);
+        if(status == SAFE16_ERROR_INVALID_SOURCE_DATA)
+        {
+            advance_cursor(&src, group_offsets[group_ptr - group] - src.used);
+            break;
+        }
+        if(status != SAFE16_STATUS_OK && status != SAFE16_STATUS_PARTIALLY_COMPLETE)
+        {
+            break;
+        }
+        if(bytes_ptr == bytes && status == SAFE16_STATUS_PARTIALLY_COMPLETE)
+        {
+            // Not enough data or room for the group yet.
+            break;
+        }
+        KSLOG_DEBUG("Decoded a straddling group of %d chars", group_length);
+        scatter_to_cursor(&dst, bytes, bytes_ptr - bytes);
+        advance_cursor(&src, group_end.used - src.used);
+        if(status == SAFE16_STATUS_OK)
+        {
+            break;
+        }
+    }
+
+    *src_used = src.used;
+    *dst_used = dst.used;
+    return status;
+}
+
+// Reads length field chars on top of *value, which holds the value of any
+// chars read before. *is_complete gets set once the last char has been read.
+// Returns the number of chars used, or a status code.
+static int64_t continue_length_field(const uint8_t* const buffer,
+                                     const int64_t buffer_length,
+                                     int64_t* const value,
+                                     bool* const is_complete)
+{
+    const int64_t max_pre_append_value = INT64_MAX >> g_bits_per_length_chunk;
+    const int continuation_bit = 1 << g_bits_per_length_chunk;
+    const int max_chunk_value = continuation_bit - 1;
+    const int chunk_mask = continuation_bit - 1;
+    KSLOG_DEBUG("bits %d, continue %02x, mask %02x",
+                g_bits_per_length_chunk, continuation_bit, chunk_mask);
+
+    const uint8_t* buffer_end = buffer + buffer_length;
+    *is_complete = false;
+
+    const uint8_t* src = buffer;
+    while(src < buffer_end)
+    {
+        const int next_chunk = g_encode_char_to_chunk[(int)*src];
+        if(next_chunk == CHUNK_CODE_WHITESPACE)
+        {
+            src++;
+            continue;
+        }
+        const int chunk_value = next_chunk & ~continuation_bit;
+        if(chunk_value > max_chunk_value)
+        {
+            KSLOG_DEBUG("Error: Invalid length character: [%c]", *src);
+            return SAFE16_ERROR_INVALID_SOURCE_DATA;
+        }
+        if(*value > max_pre_append_value)
+        {
+            KSLOG_DEBUG("Error: Length field too big");
+            return SAFE16_ERROR_INVALID_SOURCE_DATA;            
+        }
+        *value = (*value << g_bits_per_length_chunk) | (next_chunk & chunk_mask);
+        KSLOG_DEBUG("Chunk %d: '%c' (%d), continue %d, value portion = %d",
+                    src - buffer, *src, next_chunk, next_chunk & continuation_bit,
+                    (next_chunk & chunk_mask));
+        src++;
+        if(!(next_chunk & continuation_bit))
+        {
+            *is_complete = true;
+            break;
+        }
+    }
+    return src - buffer;
+}
+
+int64_t safe16_read_length_field(const uint8_t* const buffer,
+                                 const int64_t buffer_length,
+                                 int64_t* const length)
+{
+    if(buffer_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    int64_t value = 0;
+    bool is_complete = false;
+    const int64_t used_length = continue_length_field(buffer, buffer_length, &value, &is_complete);
+    if(used_length < 0)
+    {
+        return used_length;
+    }
+    // An empty buffer reads as a length of 0.
+    if(!is_complete && buffer_length > 0)
+    {
+        KSLOG_DEBUG("Error: Unterminated length field");
+        return SAFE16_ERROR_UNTERMINATED_LENGTH_FIELD;
+    }
+    *length = value;
+    KSLOG_DEBUG("Length = %d, chunks = %d", value, used_length);
+    return used_length;
+}
+
+// Stores the offset of the offending character in *error_offset (if it isn't
+// NULL) when the data is invalid.
+static int64_t decode_completely(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length,
+                                 int64_t* const error_offset)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe16_status status = decode_feed(&src,
+                                             src_length,
+                                             &dst,
+                                             dst_length,
+                                             SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM,
+                                             false);
+    if(status != SAFE16_STATUS_OK)
+    {
+        if(status == SAFE16_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+        }
+        if(status == SAFE16_ERROR_INVALID_SOURCE_DATA && error_offset != NULL)
+        {
+            *error_offset = src - src_buffer;
         }
         return status;
     }
@@ -359,6 +1322,14 @@ int64_t safe16_decode(const uint8_t* const src_buffer,
     return decoded_byte_count;
 }
 
+int64_t safe16_decode(const uint8_t* const src_buffer,
+                      const int64_t src_length,
+                      uint8_t* const dst_buffer,
+                      const int64_t dst_length)
+{
+    return decode_completely(src_buffer, src_length, dst_buffer, dst_length, NULL);
+}
+
 int64_t safe16l_decode(const uint8_t* const src_buffer,
                        const int64_t src_length,
                        uint8_t* const dst_buffer,
@@ -407,6 +1378,168 @@ int64_t safe16l_decode(const uint8_t* const src_buffer,
     return decoded_byte_count;
 }
 
+static inline bool is_indentation(const uint8_t* const src, const uint8_t* const src_end, const int indent_count)
+{
+    if(src_end - src < indent_count)
+    {
+        return false;
+    }
+    for(int i = 0; i < indent_count; i++)
+    {
+        if(src[i] != ' ')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Decodes the payload chars gathered in scratch, and moves any trailing
+// partial group to the front. Returns the number of chars left in scratch, or
+// a status code.
+static int64_t decode_wrapped_payload(uint8_t* const scratch,
+                                      const int64_t scratch_length,
+                                      uint8_t** const dst_ptr,
+                                      const uint8_t* const dst_end,
+                                      const bool is_end_of_data)
+{
+    const uint8_t* src = scratch;
+    const safe16_stream_state stream_state = is_end_of_data ?
+        (safe16_stream_state)(SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM | SAFE16_SRC_HAS_NO_WHITESPACE) :
+        SAFE16_SRC_HAS_NO_WHITESPACE;
+    const safe16_status status = safe16_decode_feed(&src, scratch_length, dst_ptr, dst_end - *dst_ptr, stream_state);
+    if(status == SAFE16_STATUS_PARTIALLY_COMPLETE)
+    {
+        if(is_end_of_data || src == scratch)
+        {
+            return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+        }
+    }
+    else if(status != SAFE16_STATUS_OK)
+    {
+        return status;
+    }
+    const int64_t left_over = scratch + scratch_length - src;
+    memmove(scratch, src, left_over);
+    return left_over;
+}
+
+int64_t safe16_decode_wrapped(const uint8_t* const src_buffer,
+                              const int64_t src_length,
+                              uint8_t* const dst_buffer,
+                              const int64_t dst_length,
+                              const int line_length,
+                              const int indent_count,
+                              const safe16_line_break line_break)
+{
+    if(src_length < 0 || dst_length < 0 || line_length < 0 || indent_count < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    KSLOG_DEBUG("Decode %d chars in lines of %d, indented by %d", src_length, line_length, indent_count);
+    const char* const line_break_chars = line_break == SAFE16_LINE_BREAK_CRLF ? "\r\n" : "\n";
+    const int line_break_length = strlen(line_break_chars);
+
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+    uint8_t* dst = dst_buffer;
+    const uint8_t* const dst_end = dst_buffer + dst_length;
+
+    // The payload is gathered into scratch one line at a time, so that it can
+    // be decoded without looking for whitespace.
+    uint8_t scratch[4096];
+    int64_t scratch_length = 0;
+
+    if(!is_indentation(src, src_end, indent_count))
+    {
+        KSLOG_DEBUG("Error: Expected %d spaces of indentation at offset %d", indent_count, src - src_buffer);
+        return SAFE16_ERROR_INVALID_SOURCE_DATA;
+    }
+    src += indent_count;
+    int64_t line_chars_left = line_length > 0 ? line_length : src_end - src;
+    while(src < src_end)
+    {
+        if(line_chars_left == 0)
+        {
+            if(src_end - src < line_break_length ||
+               memcmp(src, line_break_chars, line_break_length) != 0 ||
+               !is_indentation(src + line_break_length, src_end, indent_count))
+            {
+                KSLOG_DEBUG("Error: Expected a line break and indentation at offset %d", src - src_buffer);
+                return SAFE16_ERROR_INVALID_SOURCE_DATA;
+            }
+            src += line_break_length + indent_count;
+            line_chars_left = line_length;
+            if(src >= src_end)
+            {
+                break;
+            }
+        }
+
+        int64_t copy_count = line_chars_left;
+        if(copy_count > src_end - src)
+        {
+            copy_count = src_end - src;
+        }
+        if(copy_count > (int64_t)sizeof(scratch) - scratch_length)
+        {
+            copy_count = sizeof(scratch) - scratch_length;
+        }
+        memcpy(scratch + scratch_length, src, copy_count);
+        scratch_length += copy_count;
+        src += copy_count;
+        line_chars_left -= copy_count;
+
+        if(scratch_length == sizeof(scratch))
+        {
+            scratch_length = decode_wrapped_payload(scratch, scratch_length, &dst, dst_end, false);
+            if(scratch_length < 0)
+            {
+                return scratch_length;
+            }
+        }
+    }
+
+    const int64_t status = decode_wrapped_payload(scratch, scratch_length, &dst, dst_end, true);
+    if(status < 0)
+    {
+        return status;
+    }
+    int64_t decoded_byte_count = dst - dst_buffer;
+    KSLOG_DEBUG("Decoded %d bytes", decoded_byte_count);
+    return decoded_byte_count;
+}
+
+int64_t safe16_compact(const uint8_t* const src_buffer,
+                       const int64_t src_length,
+                       uint8_t* const dst_buffer,
+                       const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const int64_t block_count = (src_length < dst_length ? src_length : dst_length) / g_compact_block_size;
+    uint8_t* dst = dst_buffer + compact_blocks(src_buffer, dst_buffer, block_count);
+    const uint8_t* const src_end = src_buffer + src_length;
+    const uint8_t* const dst_end = dst_buffer + dst_length;
+    for(const uint8_t* src = src_buffer + block_count * g_compact_block_size; src < src_end; src++)
+    {
+        if(g_encode_char_to_chunk[*src] == CHUNK_CODE_WHITESPACE)
+        {
+            continue;
+        }
+        if(dst >= dst_end)
+        {
+            KSLOG_DEBUG("Error: Not enough room to compact %d chars", src_length);
+            return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+        }
+        *dst++ = *src;
+    }
+    KSLOG_DEBUG("Compacted %d chars to %d", src_length, dst - dst_buffer);
+    return dst - dst_buffer;
+}
+
 int64_t safe16_get_encoded_length(const int64_t decoded_length,
                                   const bool include_length_field)
 {
@@ -427,11 +1560,12 @@ int64_t safe16_get_encoded_length(const int64_t decoded_length,
     return group_count * g_chunks_per_group + chunk_count + length_chunk_count;
 }
 
-safe16_status safe16_encode_feed(const uint8_t** const src_buffer_ptr,
+static safe16_status encode_feed(const uint8_t** const src_buffer_ptr,
                                  const int64_t src_length,
                                  uint8_t** const dst_buffer_ptr,
                                  const int64_t dst_length,
-                                 const bool is_end_of_data)
+                                 const bool is_end_of_data,
+                                 const bool has_slack)
 {
     if(src_length < 0 || dst_length < 0)
     {
@@ -468,6 +1602,17 @@ safe16_status safe16_encode_feed(const uint8_t** const src_buffer_ptr,
     int current_group_byte_count = 0;
     int64_t accumulator = 0;
 
+    {
+        const int64_t src_group_count = (src_end - src) / g_bytes_per_group;
+        const int64_t dst_group_count = (dst_end - dst) / g_chunks_per_group;
+        const int64_t group_count = src_group_count < dst_group_count ? src_group_count : dst_group_count;
+        const int64_t encoded_group_count = encode_groups(src, dst, group_count, has_slack ? g_slack_group_count : 0);
+        KSLOG_DEBUG("Bulk encoded %d of %d groups", encoded_group_count, group_count);
+        src += encoded_group_count * g_bytes_per_group;
+        dst += encoded_group_count * g_chunks_per_group;
+        last_src = src;
+    }
+
     while(src < src_end)
     {
         const uint8_t next_byte = *src++;
@@ -505,6 +1650,87 @@ safe16_status safe16_encode_feed(const uint8_t** const src_buffer_ptr,
 #undef WRITE_CHUNKS
 }
 
+safe16_status safe16_encode_feed(const uint8_t** const src_buffer_ptr,
+                                 const int64_t src_length,
+                                 uint8_t** const dst_buffer_ptr,
+                                 const int64_t dst_length,
+                                 const bool is_end_of_data)
+{
+    return encode_feed(src_buffer_ptr, src_length, dst_buffer_ptr, dst_length, is_end_of_data, false);
+}
+
+safe16_status safe16_encode_feedv(const safe16_iovec* const src_vector,
+                                  const int src_vector_count,
+                                  const safe16_iovec* const dst_vector,
+                                  const int dst_vector_count,
+                                  int64_t* const src_used,
+                                  int64_t* const dst_used,
+                                  const bool is_end_of_data)
+{
+    vector_cursor src;
+    vector_cursor dst;
+    if(init_vector_cursor(&src, src_vector, src_vector_count) != SAFE16_STATUS_OK ||
+       init_vector_cursor(&dst, dst_vector, dst_vector_count) != SAFE16_STATUS_OK)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    safe16_status status = SAFE16_STATUS_OK;
+
+    for(;;)
+    {
+        const int64_t src_length = get_contiguous_length(&src);
+        const int64_t dst_length = get_contiguous_length(&dst);
+        if(src_length > 0 && dst_length > 0)
+        {
+            const uint8_t* const src_start = get_cursor_pointer(&src);
+            uint8_t* const dst_start = get_cursor_pointer(&dst);
+            const uint8_t* src_ptr = src_start;
+            uint8_t* dst_ptr = dst_start;
+            encode_feed(&src_ptr, src_length, &dst_ptr, dst_length, is_end_of_data && is_in_last_buffer(&src), false);
+            advance_cursor(&src, src_ptr - src_start);
+            advance_cursor(&dst, dst_ptr - dst_start);
+            if(src_ptr > src_start)
+            {
+                continue;
+            }
+        }
+
+        // The next group straddles buffers (or is the last one), so gather
+        // its bytes, encode them, and scatter the chars.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        vector_cursor group_end = src;
+        int group_length = 0;
+        while(group_length < g_bytes_per_group && get_contiguous_length(&group_end) > 0)
+        {
+            group[group_length++] = *get_cursor_pointer(&group_end);
+            advance_cursor(&group_end, 1);
+        }
+        if(group_length == 0 || (group_length < g_bytes_per_group && !is_end_of_data))
+        {
+            break;
+        }
+
+        uint8_t chars[STRADDLED_GROUP_SIZE];
+        const uint8_t* group_ptr = group;
+        uint8_t* chars_ptr = chars;
+        encode_feed(&group_ptr, group_length, &chars_ptr, sizeof(chars), true, false);
+        const int64_t char_count = chars_ptr - chars;
+        if(get_remaining_length(&dst, char_count) < char_count)
+        {
+            KSLOG_DEBUG("Error: Need %d chars but only %d available", char_count, get_remaining_length(&dst, char_count));
+            status = SAFE16_STATUS_PARTIALLY_COMPLETE;
+            break;
+        }
+        KSLOG_DEBUG("Encoded a straddling group of %d bytes", group_length);
+        scatter_to_cursor(&dst, chars, char_count);
+        advance_cursor(&src, group_length);
+    }
+
+    *src_used = src.used;
+    *dst_used = dst.used;
+    return status;
+}
+
 int64_t safe16_write_length_field(const int64_t length,
                                   uint8_t* const dst_buffer,
                                   const int64_t dst_buffer_length)
@@ -597,3 +1823,899 @@ int64_t safe16l_encode(const uint8_t* const src_buffer,
     }
     return dst - dst_buffer;
 }
+
+int64_t safe16_required_slack(void)
+{
+    return g_required_slack;
+}
+
+int64_t safe16_encode_with_slack(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe16_status status = encode_feed(&src, src_length, &dst, dst_length, true, true);
+    if(status != SAFE16_STATUS_OK)
+    {
+        if(status == SAFE16_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+        }
+        return status;
+    }
+    return dst - dst_buffer;
+}
+
+int64_t safe16_decode_with_slack(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe16_status status = decode_feed(&src,
+                                             src_length,
+                                             &dst,
+                                             dst_length,
+                                             SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM,
+                                             true);
+    if(status != SAFE16_STATUS_OK)
+    {
+        if(status == SAFE16_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+        }
+        return status;
+    }
+    return dst - dst_buffer;
+}
+
+// Parallel encodes and decodes split the data into shards, with a few for each
+// thread so that threads that finish early can take over some of the work from
+// slower ones. Shards are never smaller than this though, because handing work
+// over has a cost.
+static const int64_t g_min_parallel_shard_size = 1 << 16;
+static const int g_shards_per_thread = 4;
+
+// Gives a shard length that's a multiple of unit_length.
+static int64_t get_parallel_shard_length(const int64_t length, const int thread_count, const int unit_length)
+{
+    int64_t unit_count = length / unit_length / ((int64_t)thread_count * g_shards_per_thread) + 1;
+    if(unit_count < g_min_parallel_shard_size / unit_length)
+    {
+        unit_count = g_min_parallel_shard_size / unit_length;
+    }
+    return unit_count * unit_length;
+}
+
+// Encoding shards are made of whole groups, which encode to known places in
+// dst.
+
+typedef struct
+{
+    const uint8_t* src_buffer;
+    int64_t src_length;
+    uint8_t* dst_buffer;
+    int64_t shard_group_count;
+} parallel_encode;
+
+static void encode_shard(void* const context, const int64_t shard_index)
+{
+    const parallel_encode* const job = (const parallel_encode*)context;
+    const int64_t group_index = shard_index * job->shard_group_count;
+    const int64_t src_offset = group_index * g_bytes_per_group;
+    int64_t src_length = job->shard_group_count * g_bytes_per_group;
+    if(src_length > job->src_length - src_offset)
+    {
+        src_length = job->src_length - src_offset;
+    }
+    const uint8_t* src = job->src_buffer + src_offset;
+    uint8_t* dst = job->dst_buffer + group_index * g_chunks_per_group;
+    // Only the last shard can end in a partial group. The caller has already
+    // made sure that there's room for everything.
+    encode_feed(&src, src_length, &dst, safe16_get_encoded_length(src_length, false), true, false);
+}
+
+int64_t safe16_encode_parallel(const uint8_t* const src_buffer,
+                               const int64_t src_length,
+                               uint8_t* const dst_buffer,
+                               const int64_t dst_length,
+                               int thread_count)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const int64_t encoded_length = safe16_get_encoded_length(src_length, false);
+    if(encoded_length > dst_length)
+    {
+        KSLOG_DEBUG("Error: Need %d chars but only %d available", encoded_length, dst_length);
+        return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+    }
+    if(thread_count <= 0)
+    {
+        thread_count = safe16_get_cpu_count();
+    }
+
+    const int64_t shard_length = get_parallel_shard_length(src_length, thread_count, g_bytes_per_group);
+    const int64_t shard_count = (src_length + shard_length - 1) / shard_length;
+    KSLOG_DEBUG("Encoding %d bytes as %d shards on %d threads", src_length, shard_count, thread_count);
+
+    parallel_encode job =
+    {
+        .src_buffer = src_buffer,
+        .src_length = src_length,
+        .dst_buffer = dst_buffer,
+        .shard_group_count = shard_length / g_bytes_per_group,
+    };
+    safe16_run_parallel(encode_shard, &job, shard_count, thread_count);
+    return encoded_length;
+}
+
+int64_t safe16l_encode_parallel(const uint8_t* const src_buffer,
+                                const int64_t src_length,
+                                uint8_t* const dst_buffer,
+                                const int64_t dst_length,
+                                const int thread_count)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const int64_t bytes_used = safe16_write_length_field(src_length, dst_buffer, dst_length);
+    if(bytes_used < 0)
+    {
+        return bytes_used;
+    }
+    const int64_t encoded_length = safe16_encode_parallel(src_buffer,
+                                                          src_length,
+                                                          dst_buffer + bytes_used,
+                                                          dst_length - bytes_used,
+                                                          thread_count);
+    if(encoded_length < 0)
+    {
+        return encoded_length;
+    }
+    return bytes_used + encoded_length;
+}
+
+// Parallel decodes have to find out where the groups are first, because
+// whitespace moves them around. A first pass counts the chars in each shard
+// (block), which gives the index of the first char of each block, and from
+// that where its groups start and where in dst they decode to. A second pass
+// then decodes the groups that start in each block. Groups that straddle the
+// end of a block are gathered up and decoded on their own.
+
+typedef struct
+{
+    // The number of non-whitespace chars before the block. The first pass
+    // sets this to the number in the block, and the sum is worked out after.
+    int64_t char_index;
+    safe16_status status;
+    int64_t error_offset;
+} parallel_decode_block;
+
+typedef struct
+{
+    const uint8_t* src_buffer;
+    int64_t src_length;
+    uint8_t* dst_buffer;
+    int64_t dst_length;
+    int64_t block_length;
+    int64_t block_count;
+    int64_t char_count;
+    parallel_decode_block* blocks;
+} parallel_decode;
+
+static inline bool is_whitespace(const uint8_t ch)
+{
+    return g_encode_char_to_chunk[ch] == CHUNK_CODE_WHITESPACE;
+}
+
+// Gives one more than the highest whitespace char.
+static uint8_t get_whitespace_limit(void)
+{
+    int limit = 0;
+    for(int ch = 0; ch < 256; ch++)
+    {
+        if(is_whitespace((uint8_t)ch))
+        {
+            limit = ch + 1;
+        }
+    }
+    return (uint8_t)limit;
+}
+
+// Gives the whitespace limit in every byte, for count_word_whitespace().
+static uint64_t get_word_whitespace_limits(void)
+{
+    return 0x0101010101010101 * get_whitespace_limit();
+}
+
+// Whitespace is rare in most data, so chars are checked 8 at a time for any
+// that are below the whitespace limit, and only those are looked up.
+static inline int count_word_whitespace(const uint8_t* const src, const uint64_t limits)
+{
+    const uint64_t top_bits = 0x8080808080808080;
+    uint64_t chars;
+    memcpy(&chars, src, sizeof(chars));
+    // Sets the top bit of each byte that's below the limit. Setting the top
+    // bits first stops borrows from crossing bytes.
+    uint64_t below_limit = ~(((chars | top_bits) - limits) | chars) & top_bits;
+    int whitespace_count = 0;
+    for(; below_limit != 0; below_limit &= below_limit - 1)
+    {
+        const int shift = __builtin_ctzll(below_limit) & ~7;
+        whitespace_count += is_whitespace((uint8_t)(chars >> shift));
+    }
+    return whitespace_count;
+}
+
+static void count_block_chars(void* const context, const int64_t block_index)
+{
+    parallel_decode* const job = (parallel_decode*)context;
+    const int64_t block_offset = block_index * job->block_length;
+    int64_t block_length = job->src_length - block_offset;
+    if(block_length > job->block_length)
+    {
+        block_length = job->block_length;
+    }
+    const uint8_t* const src = job->src_buffer + block_offset;
+    const uint64_t limits = get_word_whitespace_limits();
+    int64_t whitespace_count = 0;
+    int64_t i = 0;
+    for(; i + (int64_t)sizeof(uint64_t) <= block_length; i += sizeof(uint64_t))
+    {
+        whitespace_count += count_word_whitespace(src + i, limits);
+    }
+    for(; i < block_length; i++)
+    {
+        whitespace_count += is_whitespace(src[i]);
+    }
+    job->blocks[block_index].char_index = block_length - whitespace_count;
+}
+
+static void decode_block(void* const context, const int64_t block_index)
+{
+    parallel_decode* const job = (parallel_decode*)context;
+    parallel_decode_block* const block = &job->blocks[block_index];
+    block->status = SAFE16_STATUS_OK;
+    const bool is_last_block = block_index == job->block_count - 1;
+    const uint8_t* const src_end = is_last_block ? job->src_buffer + job->src_length
+                                                 : job->src_buffer + (block_index + 1) * job->block_length;
+    const int64_t end_char_index = is_last_block ? job->char_count : block[1].char_index;
+
+    // Chars before the first group that starts here belong to the previous
+    // block's straddling group.
+    const int64_t first_group_index = (block->char_index + g_chunks_per_group - 1) / g_chunks_per_group;
+    if(first_group_index * g_chunks_per_group >= end_char_index)
+    {
+        KSLOG_DEBUG("Block %d has no groups of its own", block_index);
+        return;
+    }
+    const uint8_t* src = job->src_buffer + block_index * job->block_length;
+    for(int64_t skip_count = first_group_index * g_chunks_per_group - block->char_index; skip_count > 0; src++)
+    {
+        skip_count -= !is_whitespace(*src);
+    }
+
+    // The last block decodes whatever it ends with, the same as the serial
+    // decoder would.
+    const int64_t straddling_char_count = is_last_block ? 0 : (end_char_index - first_group_index * g_chunks_per_group) % g_chunks_per_group;
+    const uint8_t* straddling_src = src_end;
+    for(int64_t skip_count = straddling_char_count; skip_count > 0;)
+    {
+        straddling_src--;
+        skip_count -= !is_whitespace(*straddling_src);
+    }
+    const int64_t straddling_group_index = (end_char_index - straddling_char_count) / g_chunks_per_group;
+
+    const uint8_t* const src_start = src;
+    uint8_t* dst = job->dst_buffer + first_group_index * g_bytes_per_group;
+    uint8_t* const dst_end = is_last_block ? job->dst_buffer + job->dst_length
+                                           : job->dst_buffer + straddling_group_index * g_bytes_per_group;
+    KSLOG_DEBUG("Block %d decodes groups %d to %d", block_index, first_group_index, straddling_group_index);
+    safe16_status status = decode_feed(&src,
+                                       straddling_src - src_start,
+                                       &dst,
+                                       dst_end - dst,
+                                       SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM,
+                                       false);
+    if(status != SAFE16_STATUS_OK)
+    {
+        block->status = status;
+        block->error_offset = src - job->src_buffer;
+        return;
+    }
+    if(straddling_char_count == 0)
+    {
+        return;
+    }
+
+    // The straddling group can run on through any number of blocks that are
+    // all whitespace, and can also be the partial group at the very end.
+    uint8_t group[STRADDLED_GROUP_SIZE];
+    int64_t group_offsets[STRADDLED_GROUP_SIZE];
+    int group_length = 0;
+    const uint8_t* const data_end = job->src_buffer + job->src_length;
+    for(src = straddling_src; src < data_end && group_length < g_chunks_per_group; src++)
+    {
+        if(!is_whitespace(*src))
+        {
+            group_offsets[group_length] = src - job->src_buffer;
+            group[group_length++] = *src;
+        }
+    }
+    const bool is_last_group = straddling_group_index * g_chunks_per_group + group_length >= job->char_count;
+    const uint8_t* group_ptr = group;
+    dst = job->dst_buffer + straddling_group_index * g_bytes_per_group;
+    status = decode_feed(&group_ptr,
+                         group_length,
+                         &dst,
+                         is_last_group ? job->dst_buffer + job->dst_length - dst : g_bytes_per_group,
+                         SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM,
+                         false);
+    if(status != SAFE16_STATUS_OK)
+    {
+        block->status = status;
+        block->error_offset = group_ptr < group + group_length ? group_offsets[group_ptr - group] : src - job->src_buffer;
+    }
+}
+
+int64_t safe16_decode_parallel(const uint8_t* const src_buffer,
+                               const int64_t src_length,
+                               uint8_t* const dst_buffer,
+                               const int64_t dst_length,
+                               int thread_count,
+                               int64_t* const error_offset)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    if(thread_count <= 0)
+    {
+        thread_count = safe16_get_cpu_count();
+    }
+    const int64_t block_length = get_parallel_shard_length(src_length, thread_count, 1);
+    const int64_t block_count = (src_length + block_length - 1) / block_length;
+    if(block_count < 2 || thread_count == 1)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+    parallel_decode_block* const blocks = (parallel_decode_block*)malloc(block_count * sizeof(*blocks));
+    if(blocks == NULL)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+
+    parallel_decode job =
+    {
+        .src_buffer = src_buffer,
+        .src_length = src_length,
+        .dst_buffer = dst_buffer,
+        .dst_length = dst_length,
+        .block_length = block_length,
+        .block_count = block_count,
+        .char_count = 0,
+        .blocks = blocks,
+    };
+    safe16_run_parallel(count_block_chars, &job, block_count, thread_count);
+    for(int64_t i = 0; i < block_count; i++)
+    {
+        const int64_t char_count = blocks[i].char_index;
+        blocks[i].char_index = job.char_count;
+        job.char_count += char_count;
+    }
+
+    const int64_t decoded_length = job.char_count / g_chunks_per_group * g_bytes_per_group +
+                                   g_chunk_to_byte_count[job.char_count % g_chunks_per_group];
+    KSLOG_DEBUG("Decoding %d chars as %d blocks on %d threads", job.char_count, block_count, thread_count);
+    if(decoded_length > dst_length)
+    {
+        // This is going to fail one way or another, and the serial decoder
+        // knows which way.
+        free(blocks);
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+
+    safe16_run_parallel(decode_block, &job, block_count, thread_count);
+
+    // Every char gets checked by exactly one block, so the serial decoder would
+    // stop at the error nearest the start.
+    const parallel_decode_block* first_error = NULL;
+    for(int64_t i = 0; i < block_count; i++)
+    {
+        if(blocks[i].status != SAFE16_STATUS_OK &&
+           (first_error == NULL || blocks[i].error_offset < first_error->error_offset))
+        {
+            first_error = &blocks[i];
+        }
+    }
+    if(first_error == NULL)
+    {
+        free(blocks);
+        return decoded_length;
+    }
+    KSLOG_DEBUG("Error %d at offset %d", first_error->status, first_error->error_offset);
+    const safe16_status status = first_error->status;
+    const int64_t first_error_offset = first_error->error_offset;
+    free(blocks);
+
+    // Invalid chars are counted as well, so dst only fills up before the
+    // first one if it's exactly the length worked out above. In that case the
+    // serial decoder might run out of room first.
+    if(status != SAFE16_ERROR_INVALID_SOURCE_DATA || decoded_length == dst_length)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+    if(error_offset != NULL)
+    {
+        *error_offset = first_error_offset;
+    }
+    return status;
+}
+
+// Groups are a fixed size, so any range of the decoded data comes from a known
+// run of groups. Without whitespace, each group's position follows from its
+// index. With whitespace, the groups are counted off from the nearest
+// checkpoint before the range.
+
+// Skips over *char_count non-whitespace chars, taking off the ones it skipped
+// (which is fewer if it runs out of data first).
+static const uint8_t* skip_chars(const uint8_t* src,
+                                 const uint8_t* const src_end,
+                                 int64_t* const char_count,
+                                 const uint64_t whitespace_limits)
+{
+    while(*char_count >= (int64_t)sizeof(uint64_t) && src_end - src >= (int64_t)sizeof(uint64_t))
+    {
+        *char_count -= sizeof(uint64_t) - count_word_whitespace(src, whitespace_limits);
+        src += sizeof(uint64_t);
+    }
+    for(; *char_count > 0 && src < src_end; src++)
+    {
+        *char_count -= !is_whitespace(*src);
+    }
+    return src;
+}
+
+int64_t safe16_decode_range(const uint8_t* const src_buffer,
+                            const int64_t src_length,
+                            const int64_t byte_offset,
+                            int64_t byte_count,
+                            uint8_t* const dst_buffer,
+                            const safe16_checkpoints* const checkpoints)
+{
+    if(src_length < 0 || byte_offset < 0 || byte_count < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const int64_t decoded_length = checkpoints != NULL ? checkpoints->decoded_length
+                                                       : safe16_get_decoded_length(src_length);
+    if(byte_offset >= decoded_length)
+    {
+        return 0;
+    }
+    if(byte_count > decoded_length - byte_offset)
+    {
+        byte_count = decoded_length - byte_offset;
+    }
+
+    const uint8_t* const src_end = src_buffer + src_length;
+    const int64_t first_group_index = byte_offset / g_bytes_per_group;
+    const uint8_t* src = src_buffer + first_group_index * g_chunks_per_group;
+    safe16_stream_state stream_state = SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM;
+    if(checkpoints != NULL)
+    {
+        const int64_t checkpoint_index = first_group_index / checkpoints->group_interval;
+        if(checkpoint_index >= checkpoints->offset_count || checkpoints->offsets[checkpoint_index] > src_length)
+        {
+            KSLOG_DEBUG("Error: Checkpoint %d is past the end of the %d char sequence", checkpoint_index, src_length);
+            return SAFE16_ERROR_TRUNCATED_DATA;
+        }
+        int64_t skip_count = (first_group_index - checkpoint_index * checkpoints->group_interval) * g_chunks_per_group;
+        src = skip_chars(src_buffer + checkpoints->offsets[checkpoint_index],
+                         src_end,
+                         &skip_count,
+                         get_word_whitespace_limits());
+    }
+    else
+    {
+        stream_state |= SAFE16_SRC_HAS_NO_WHITESPACE;
+    }
+    KSLOG_DEBUG("Decoding %d bytes at %d from group %d at offset %d",
+                byte_count, byte_offset, first_group_index, src - src_buffer);
+
+    uint8_t* dst = dst_buffer;
+    uint8_t* const dst_end = dst_buffer + byte_count;
+    int skip_byte_count = byte_offset % g_bytes_per_group;
+    while(dst < dst_end)
+    {
+        const int64_t whole_group_count = (dst_end - dst) / g_bytes_per_group;
+        if(skip_byte_count == 0 && whole_group_count > 0)
+        {
+            // These groups are all inside the range, so none of them can be
+            // the partial group at the end, and they go straight to dst.
+            const safe16_status status = decode_feed(&src,
+                                                     src_end - src,
+                                                     &dst,
+                                                     whole_group_count * g_bytes_per_group,
+                                                     stream_state | SAFE16_EXPECT_DST_STREAM_TO_END,
+                                                     false);
+            if(status != SAFE16_STATUS_OK)
+            {
+                return status;
+            }
+            continue;
+        }
+
+        // A group that's only partly inside the range gets decoded on the side.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        int group_length = 0;
+        for(; src < src_end && group_length < g_chunks_per_group; src++)
+        {
+            if(checkpoints == NULL || !is_whitespace(*src))
+            {
+                group[group_length++] = *src;
+            }
+        }
+        uint8_t bytes[STRADDLED_GROUP_SIZE];
+        const uint8_t* group_ptr = group;
+        uint8_t* bytes_ptr = bytes;
+        const safe16_status status = decode_feed(&group_ptr,
+                                                 group_length,
+                                                 &bytes_ptr,
+                                                 g_bytes_per_group,
+                                                 stream_state,
+                                                 false);
+        if(status != SAFE16_STATUS_OK)
+        {
+            return status;
+        }
+        int64_t copy_length = bytes_ptr - bytes - skip_byte_count;
+        if(copy_length <= 0)
+        {
+            KSLOG_DEBUG("Error: Ran out of data at offset %d", src - src_buffer);
+            return SAFE16_ERROR_TRUNCATED_DATA;
+        }
+        if(copy_length > dst_end - dst)
+        {
+            copy_length = dst_end - dst;
+        }
+        memcpy(dst, bytes + skip_byte_count, copy_length);
+        dst += copy_length;
+        skip_byte_count = 0;
+    }
+    return byte_count;
+}
+
+int64_t safe16_get_checkpoint_count(const int64_t src_length, const int64_t group_interval)
+{
+    if(src_length < 0 || group_interval < 1)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const int64_t group_count = (src_length + g_chunks_per_group - 1) / g_chunks_per_group;
+    return group_count / group_interval + (group_count % group_interval != 0);
+}
+
+safe16_status safe16_build_checkpoints(const uint8_t* const src_buffer,
+                                       const int64_t src_length,
+                                       const int64_t group_interval,
+                                       int64_t* const offsets,
+                                       const int64_t offset_capacity,
+                                       safe16_checkpoints* const checkpoints)
+{
+    if(src_length < 0 || group_interval < 1 || offset_capacity < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    // An interval longer than the data only ever gets the first checkpoint.
+    const int64_t chars_per_checkpoint = group_interval > src_length ? src_length + 1
+                                                                     : group_interval * g_chunks_per_group;
+    const uint8_t* const src_end = src_buffer + src_length;
+    const uint64_t whitespace_limits = get_word_whitespace_limits();
+    const uint8_t* src = src_buffer;
+    int64_t offset_count = 0;
+    int64_t char_count = 0;
+    for(;;)
+    {
+        while(src < src_end && is_whitespace(*src))
+        {
+            src++;
+        }
+        if(src >= src_end)
+        {
+            break;
+        }
+        if(offset_count >= offset_capacity)
+        {
+            KSLOG_DEBUG("Error: No room for checkpoint %d", offset_count);
+            return SAFE16_ERROR_NOT_ENOUGH_ROOM;
+        }
+        offsets[offset_count++] = src - src_buffer;
+        int64_t skip_count = chars_per_checkpoint;
+        src = skip_chars(src, src_end, &skip_count, whitespace_limits);
+        char_count += chars_per_checkpoint - skip_count;
+    }
+
+    checkpoints->group_interval = group_interval;
+    checkpoints->offsets = offsets;
+    checkpoints->offset_count = offset_count;
+    checkpoints->decoded_length = char_count / g_chunks_per_group * g_bytes_per_group +
+                                  g_chunk_to_byte_count[char_count % g_chunks_per_group];
+    KSLOG_DEBUG("Built %d checkpoints for %d chars", offset_count, char_count);
+    return SAFE16_STATUS_OK;
+}
+
+void safe16_encoder_init(safe16_encoder* const encoder,
+                         const safe16_sink sink,
+                         void* const sink_context)
+{
+    encoder->sink = sink;
+    encoder->sink_context = sink_context;
+    encoder->has_length_field = false;
+    encoder->length_field = 0;
+    encoder->partial_group_length = 0;
+}
+
+void safe16l_encoder_init(safe16_encoder* const encoder,
+                          const int64_t length,
+                          const safe16_sink sink,
+                          void* const sink_context)
+{
+    safe16_encoder_init(encoder, sink, sink_context);
+    encoder->has_length_field = true;
+    encoder->length_field = length;
+}
+
+// Encodes as much of src as it can, handing the results to the sink. Anything
+// left at *src_ptr afterwards is a partial group.
+static safe16_status encode_to_sink(safe16_encoder* const encoder,
+                                    const uint8_t** const src_ptr,
+                                    const uint8_t* const src_end,
+                                    const bool is_end_of_data)
+{
+    uint8_t buffer[4096];
+    safe16_status status = SAFE16_STATUS_PARTIALLY_COMPLETE;
+    while(status == SAFE16_STATUS_PARTIALLY_COMPLETE)
+    {
+        uint8_t* dst = buffer;
+        status = encode_feed(src_ptr, src_end - *src_ptr, &dst, sizeof(buffer), is_end_of_data, false);
+        if(dst > buffer && !encoder->sink(encoder->sink_context, buffer, dst - buffer))
+        {
+            KSLOG_DEBUG("Error: Sink refused %d chars", dst - buffer);
+            return SAFE16_ERROR_SINK_FAILED;
+        }
+    }
+    return status;
+}
+
+safe16_status safe16_encoder_feed(safe16_encoder* const encoder,
+                                  const uint8_t* const src_buffer,
+                                  const int64_t src_length,
+                                  const bool is_end_of_data)
+{
+    if(src_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+
+    if(encoder->has_length_field)
+    {
+        uint8_t length_field[32];
+        const int64_t length_field_length = safe16_write_length_field(encoder->length_field,
+                                                                      length_field,
+                                                                      sizeof(length_field));
+        if(length_field_length < 0)
+        {
+            return length_field_length;
+        }
+        if(!encoder->sink(encoder->sink_context, length_field, length_field_length))
+        {
+            KSLOG_DEBUG("Error: Sink refused the length field");
+            return SAFE16_ERROR_SINK_FAILED;
+        }
+        encoder->has_length_field = false;
+    }
+
+    // A partial group left over from the last feed is topped up and encoded
+    // on its own, so that src doesn't have to be copied anywhere.
+    if(encoder->partial_group_length > 0)
+    {
+        while(encoder->partial_group_length < g_bytes_per_group && src < src_end)
+        {
+            encoder->partial_group[encoder->partial_group_length++] = *src++;
+        }
+        if(encoder->partial_group_length < g_bytes_per_group && !is_end_of_data)
+        {
+            return SAFE16_STATUS_OK;
+        }
+        const uint8_t* group = encoder->partial_group;
+        const safe16_status status = encode_to_sink(encoder,
+                                                    &group,
+                                                    encoder->partial_group + encoder->partial_group_length,
+                                                    is_end_of_data);
+        if(status != SAFE16_STATUS_OK)
+        {
+            return status;
+        }
+        encoder->partial_group_length = 0;
+    }
+
+    const safe16_status status = encode_to_sink(encoder, &src, src_end, is_end_of_data);
+    if(status != SAFE16_STATUS_OK)
+    {
+        return status;
+    }
+    encoder->partial_group_length = src_end - src;
+    memcpy(encoder->partial_group, src, encoder->partial_group_length);
+    KSLOG_DEBUG("Keeping %d bytes for the next feed", encoder->partial_group_length);
+    return SAFE16_STATUS_OK;
+}
+
+void safe16_decoder_init(safe16_decoder* const decoder,
+                         const safe16_sink sink,
+                         void* const sink_context)
+{
+    decoder->sink = sink;
+    decoder->sink_context = sink_context;
+    decoder->is_reading_length_field = false;
+    decoder->length_field = 0;
+    decoder->bytes_left = -1;
+    decoder->partial_group_length = 0;
+}
+
+void safe16l_decoder_init(safe16_decoder* const decoder,
+                          const safe16_sink sink,
+                          void* const sink_context)
+{
+    safe16_decoder_init(decoder, sink, sink_context);
+    decoder->is_reading_length_field = true;
+}
+
+// Decodes as much of src as it can, handing the results to the sink. Anything
+// left at *src_ptr afterwards is a partial group, maybe mixed with whitespace.
+static safe16_status decode_to_sink(safe16_decoder* const decoder,
+                                    const uint8_t** const src_ptr,
+                                    const uint8_t* const src_end,
+                                    const bool is_end_of_data)
+{
+    uint8_t buffer[4096];
+    for(;;)
+    {
+        int64_t dst_length = sizeof(buffer);
+        int stream_state = is_end_of_data ? SAFE16_SRC_IS_AT_END_OF_STREAM : SAFE16_STREAM_STATE_NONE;
+        if(decoder->bytes_left >= 0 && decoder->bytes_left <= dst_length)
+        {
+            // The length field says where the data ends.
+            dst_length = decoder->bytes_left;
+            stream_state |= SAFE16_DST_IS_AT_END_OF_STREAM | SAFE16_EXPECT_DST_STREAM_TO_END;
+        }
+        const uint8_t* const src_start = *src_ptr;
+        uint8_t* dst = buffer;
+        const safe16_status status = decode_feed(src_ptr,
+                                                 src_end - *src_ptr,
+                                                 &dst,
+                                                 dst_length,
+                                                 (safe16_stream_state)stream_state,
+                                                 false);
+        if(dst > buffer && !decoder->sink(decoder->sink_context, buffer, dst - buffer))
+        {
+            KSLOG_DEBUG("Error: Sink refused %d bytes", dst - buffer);
+            return SAFE16_ERROR_SINK_FAILED;
+        }
+        if(decoder->bytes_left >= 0)
+        {
+            decoder->bytes_left -= dst - buffer;
+        }
+        // Running out of room in buffer is the only reason to go around again.
+        if(status != SAFE16_STATUS_PARTIALLY_COMPLETE || (*src_ptr == src_start && dst == buffer))
+        {
+            return status;
+        }
+    }
+}
+
+safe16_status safe16_decoder_feed(safe16_decoder* const decoder,
+                                  const uint8_t* const src_buffer,
+                                  const int64_t src_length,
+                                  const bool is_end_of_data)
+{
+    if(src_length < 0)
+    {
+        return SAFE16_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+
+    if(decoder->is_reading_length_field)
+    {
+        bool is_complete = false;
+        const int64_t used_length = continue_length_field(src, src_end - src, &decoder->length_field, &is_complete);
+        if(used_length < 0)
+        {
+            return used_length;
+        }
+        src += used_length;
+        if(!is_complete)
+        {
+            if(is_end_of_data)
+            {
+                KSLOG_DEBUG("Error: Unterminated length field");
+                return SAFE16_ERROR_UNTERMINATED_LENGTH_FIELD;
+            }
+            return SAFE16_STATUS_OK;
+        }
+        KSLOG_DEBUG("Length = %d", decoder->length_field);
+        decoder->is_reading_length_field = false;
+        decoder->bytes_left = decoder->length_field;
+    }
+
+    // A partial group left over from the last feed is topped up and decoded
+    // on its own, so that src doesn't have to be copied anywhere.
+    if(decoder->partial_group_length > 0)
+    {
+        while(decoder->partial_group_length < g_chunks_per_group && src < src_end)
+        {
+            if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+            {
+                decoder->partial_group[decoder->partial_group_length++] = *src;
+            }
+            src++;
+        }
+        if(decoder->partial_group_length < g_chunks_per_group && !is_end_of_data)
+        {
+            return SAFE16_STATUS_OK;
+        }
+        const uint8_t* group = decoder->partial_group;
+        const safe16_status status = decode_to_sink(decoder,
+                                                    &group,
+                                                    decoder->partial_group + decoder->partial_group_length,
+                                                    is_end_of_data && src >= src_end);
+        if(status != SAFE16_STATUS_OK && status != SAFE16_STATUS_PARTIALLY_COMPLETE)
+        {
+            return status;
+        }
+        decoder->partial_group_length = 0;
+    }
+
+    // Data after the end that the length field gives is ignored.
+    if(decoder->bytes_left == 0)
+    {
+        return SAFE16_STATUS_OK;
+    }
+
+    const safe16_status status = decode_to_sink(decoder, &src, src_end, is_end_of_data);
+    if(status != SAFE16_STATUS_OK && status != SAFE16_STATUS_PARTIALLY_COMPLETE)
+    {
+        return status;
+    }
+    if(is_end_of_data && decoder->bytes_left > 0)
+    {
+        KSLOG_DEBUG("Error: Expected %d more bytes", decoder->bytes_left);
+        return SAFE16_ERROR_TRUNCATED_DATA;
+    }
+    for(; src < src_end && decoder->bytes_left != 0; src++)
+    {
+        if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+        {
+            decoder->partial_group[decoder->partial_group_length++] = *src;
+        }
+    }
+    KSLOG_DEBUG("Keeping %d chars for the next feed", decoder->partial_group_length);
+    return SAFE16_STATUS_OK;
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <thread>
 #include <safe16/safe16.h>
 
 // #define KSLogger_LocalLevel TRACE
@@ -281,6 +282,466 @@ void assert_decode_length(std::string encoded, int64_t expected_length, int64_t
 }
 
 
+void assert_bulk_matches_per_group(int length)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> bulk_encoded(safe16_get_encoded_length(length, false));
+    int64_t bulk_encoded_length = safe16_encode(data.data(), data.size(), bulk_encoded.data(), bulk_encoded.size());
+    ASSERT_EQ((int64_t)bulk_encoded.size(), bulk_encoded_length);
+
+    std::vector<uint8_t> grouped_encoded(bulk_encoded.size());
+    const uint8_t* e_src = data.data();
+    const uint8_t* e_src_end = data.data() + data.size();
+    uint8_t* e_dst = grouped_encoded.data();
+    while(e_src < e_src_end)
+    {
+        int64_t src_length = e_src_end - e_src < g_bytes_per_group ? e_src_end - e_src : g_bytes_per_group;
+        safe16_status status = safe16_encode_feed(&e_src,
+                                                  src_length,
+                                                  &e_dst,
+                                                  grouped_encoded.data() + grouped_encoded.size() - e_dst,
+                                                  e_src + src_length >= e_src_end);
+        ASSERT_EQ(SAFE16_STATUS_OK, status);
+    }
+    ASSERT_EQ(bulk_encoded, grouped_encoded);
+
+    std::vector<uint8_t> bulk_decoded(length);
+    int64_t bulk_decoded_length = safe16_decode(bulk_encoded.data(), bulk_encoded.size(), bulk_decoded.data(), bulk_decoded.size());
+    ASSERT_EQ(length, bulk_decoded_length);
+    ASSERT_EQ(data, bulk_decoded);
+
+    std::vector<uint8_t> grouped_decoded(length);
+    const uint8_t* d_src = bulk_encoded.data();
+    const uint8_t* d_src_end = bulk_encoded.data() + bulk_encoded.size();
+    uint8_t* d_dst = grouped_decoded.data();
+    while(d_src < d_src_end)
+    {
+        int64_t src_length = d_src_end - d_src < g_chunks_per_group ? d_src_end - d_src : g_chunks_per_group;
+        safe16_stream_state stream_state = d_src + src_length >= d_src_end ? SAFE16_SRC_IS_AT_END_OF_STREAM : SAFE16_STREAM_STATE_NONE;
+        safe16_status status = safe16_decode_feed(&d_src,
+                                                  src_length,
+                                                  &d_dst,
+                                                  grouped_decoded.data() + grouped_decoded.size() - d_dst,
+                                                  stream_state);
+        ASSERT_TRUE(status == SAFE16_STATUS_OK || status == SAFE16_STATUS_PARTIALLY_COMPLETE);
+    }
+    ASSERT_EQ(data, grouped_decoded);
+}
+
+void assert_decode_invalid_at_each_position(int length)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    std::vector<uint8_t> decoded(length);
+
+    for(size_t position = 0; position < encoded.size(); position++)
+    {
+        std::vector<uint8_t> corrupted = encoded;
+        corrupted[position] = '.';
+        const uint8_t* src = corrupted.data();
+        uint8_t* dst = decoded.data();
+        safe16_status status = safe16_decode_feed(&src,
+                                                  corrupted.size(),
+                                                  &dst,
+                                                  decoded.size(),
+                                                  SAFE16_SRC_IS_AT_END_OF_STREAM);
+        ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, status);
+        ASSERT_EQ(corrupted.data() + position, src);
+    }
+}
+
+void assert_decode_whitespace_at_each_position(int length)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    std::vector<uint8_t> decoded(length);
+
+    for(size_t position = 0; position <= encoded.size(); position++)
+    {
+        std::vector<uint8_t> spaced = encoded;
+        spaced.insert(spaced.begin() + position, '\n');
+        int64_t decoded_length = safe16_decode(spaced.data(), spaced.size(), decoded.data(), decoded.size());
+        ASSERT_EQ(length, decoded_length);
+        ASSERT_EQ(data, decoded);
+    }
+}
+
+void assert_strict_decode_whitespace_at_each_position(int length)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    std::vector<uint8_t> decoded(length);
+    const safe16_stream_state stream_state = (safe16_stream_state)(SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_SRC_HAS_NO_WHITESPACE);
+
+    const uint8_t* src = encoded.data();
+    uint8_t* dst = decoded.data();
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_decode_feed(&src, encoded.size(), &dst, decoded.size(), stream_state));
+    ASSERT_EQ(encoded.data() + encoded.size(), src);
+    ASSERT_EQ(data, decoded);
+
+    for(size_t position = 0; position <= encoded.size(); position++)
+    {
+        std::vector<uint8_t> spaced = encoded;
+        spaced.insert(spaced.begin() + position, '\n');
+        src = spaced.data();
+        dst = decoded.data();
+        safe16_status status = safe16_decode_feed(&src, spaced.size(), &dst, decoded.size(), stream_state);
+        ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, status);
+        ASSERT_EQ(spaced.data() + position, src);
+    }
+}
+
+void assert_decode_and_compact_wrapped(int length, int line_length)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    std::vector<uint8_t> wrapped;
+    for(size_t i = 0; i < encoded.size(); i++)
+    {
+        if(i > 0 && i % line_length == 0)
+        {
+            wrapped.push_back('\r');
+            wrapped.push_back('\n');
+            wrapped.push_back(' ');
+        }
+        wrapped.push_back(encoded[i]);
+    }
+
+    std::vector<uint8_t> decoded(length);
+    ASSERT_EQ(length, safe16_decode(wrapped.data(), wrapped.size(), decoded.data(), decoded.size()));
+    ASSERT_EQ(data, decoded);
+
+    for(size_t position = 0; position < wrapped.size(); position += 37)
+    {
+        if(wrapped[position] <= ' ')
+        {
+            continue;
+        }
+        std::vector<uint8_t> corrupted = wrapped;
+        corrupted[position] = '"';
+        const uint8_t* src = corrupted.data();
+        uint8_t* dst = decoded.data();
+        safe16_status status = safe16_decode_feed(&src,
+                                                  corrupted.size(),
+                                                  &dst,
+                                                  decoded.size(),
+                                                  SAFE16_SRC_IS_AT_END_OF_STREAM);
+        ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, status);
+        ASSERT_EQ(corrupted.data() + position, src);
+    }
+
+    std::vector<uint8_t> compacted(encoded.size());
+    ASSERT_EQ((int64_t)encoded.size(), safe16_compact(wrapped.data(), wrapped.size(), compacted.data(), compacted.size()));
+    ASSERT_EQ(encoded, compacted);
+
+    // In place
+    ASSERT_EQ((int64_t)encoded.size(), safe16_compact(wrapped.data(), wrapped.size(), wrapped.data(), wrapped.size()));
+    wrapped.resize(encoded.size());
+    ASSERT_EQ(encoded, wrapped);
+}
+
+void assert_slack_matches(int length)
+{
+    const int64_t slack = safe16_required_slack();
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+
+    // The slack is filled with junk that must not make it into the results.
+    std::vector<uint8_t> padded_data = data;
+    padded_data.resize(data.size() + slack, 0xa5);
+    std::vector<uint8_t> padded_encoded(encoded.size() + slack, 0xa5);
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode_with_slack(padded_data.data(), data.size(), padded_encoded.data(), encoded.size()));
+    ASSERT_EQ(encoded, std::vector<uint8_t>(padded_encoded.begin(), padded_encoded.begin() + encoded.size()));
+
+    padded_encoded.resize(encoded.size());
+    padded_encoded.resize(encoded.size() + slack, '!');
+    std::vector<uint8_t> padded_decoded(data.size() + slack, 0xa5);
+    ASSERT_EQ(length, safe16_decode_with_slack(padded_encoded.data(), encoded.size(), padded_decoded.data(), data.size()));
+    ASSERT_EQ(data, std::vector<uint8_t>(padded_decoded.begin(), padded_decoded.begin() + data.size()));
+}
+
+bool append_to_vector(void* context, const uint8_t* data, int64_t length)
+{
+    std::vector<uint8_t>* output = (std::vector<uint8_t>*)context;
+    output->insert(output->end(), data, data + length);
+    return true;
+}
+
+bool refuse_data(void* context, const uint8_t* data, int64_t length)
+{
+    (void)context;
+    (void)data;
+    (void)length;
+    return false;
+}
+
+// Streams the data through an encoder and a decoder piece_length bytes at a
+// time, with a line break after each piece of encoded data.
+void assert_stream_matches(int length, int piece_length, bool include_length_field)
+{
+    static const uint8_t nothing = 0;
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, include_length_field));
+    const int64_t encoded_length = include_length_field ?
+        safe16l_encode(data.data(), data.size(), encoded.data(), encoded.size()) :
+        safe16_encode(data.data(), data.size(), encoded.data(), encoded.size());
+    ASSERT_EQ((int64_t)encoded.size(), encoded_length);
+
+    std::vector<uint8_t> stream_encoded;
+    safe16_encoder encoder;
+    if(include_length_field)
+    {
+        safe16l_encoder_init(&encoder, length, append_to_vector, &stream_encoded);
+    }
+    else
+    {
+        safe16_encoder_init(&encoder, append_to_vector, &stream_encoded);
+    }
+    for(int offset = 0; offset < length; offset += piece_length)
+    {
+        const int count = std::min(piece_length, length - offset);
+        ASSERT_EQ(SAFE16_STATUS_OK, safe16_encoder_feed(&encoder, data.data() + offset, count, false));
+    }
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_encoder_feed(&encoder, &nothing, 0, true));
+    ASSERT_EQ(encoded, stream_encoded);
+
+    std::vector<uint8_t> stream_decoded;
+    safe16_decoder decoder;
+    if(include_length_field)
+    {
+        safe16l_decoder_init(&decoder, append_to_vector, &stream_decoded);
+    }
+    else
+    {
+        safe16_decoder_init(&decoder, append_to_vector, &stream_decoded);
+    }
+    for(int offset = 0; offset < encoded_length; offset += piece_length)
+    {
+        const int count = std::min(piece_length, (int)encoded_length - offset);
+        std::vector<uint8_t> piece(encoded.begin() + offset, encoded.begin() + offset + count);
+        piece.push_back('\n');
+        ASSERT_EQ(SAFE16_STATUS_OK, safe16_decoder_feed(&decoder, piece.data(), piece.size(), false));
+    }
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_decoder_feed(&decoder, &nothing, 0, true));
+    ASSERT_EQ(data, stream_decoded);
+}
+
+// Lays encoded data out the way the safe16 executable does with -n and -i.
+std::string lay_out_lines(const std::vector<uint8_t>& encoded, int line_length, int indent_count, const std::string& line_break)
+{
+    const std::string indentation(indent_count, ' ');
+    std::string result = indentation;
+    for(size_t i = 0; i < encoded.size(); i++)
+    {
+        result.push_back(encoded[i]);
+        if(line_length > 0 && (i + 1) % line_length == 0)
+        {
+            result += line_break + indentation;
+        }
+    }
+    return result;
+}
+
+// Splits a buffer into a vector of pieces, whose lengths cycle through
+// piece_lengths.
+std::vector<safe16_iovec> split_into_vector(uint8_t* data, int64_t length, const std::vector<int>& piece_lengths)
+{
+    std::vector<safe16_iovec> vector;
+    int64_t offset = 0;
+    for(size_t i = 0; offset < length; i++)
+    {
+        const int64_t piece_length = std::min((int64_t)piece_lengths[i % piece_lengths.size()], length - offset);
+        vector.push_back({data + offset, piece_length});
+        offset += piece_length;
+    }
+    return vector;
+}
+
+void assert_feedv_matches(int length, const std::vector<int>& src_piece_lengths, const std::vector<int>& dst_piece_lengths)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+
+    std::vector<uint8_t> vector_encoded(encoded.size());
+    std::vector<safe16_iovec> src_vector = split_into_vector(data.data(), data.size(), src_piece_lengths);
+    std::vector<safe16_iovec> dst_vector = split_into_vector(vector_encoded.data(), vector_encoded.size(), dst_piece_lengths);
+    int64_t src_used = -1;
+    int64_t dst_used = -1;
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_encode_feedv(src_vector.data(), src_vector.size(),
+                                                    dst_vector.data(), dst_vector.size(),
+                                                    &src_used, &dst_used, true));
+    ASSERT_EQ(length, src_used);
+    ASSERT_EQ((int64_t)encoded.size(), dst_used);
+    ASSERT_EQ(encoded, vector_encoded);
+
+    std::string laid_out = lay_out_lines(encoded, 7, 1, "\r\n");
+    std::vector<uint8_t> decoded(length);
+    src_vector = split_into_vector((uint8_t*)&laid_out[0], laid_out.size(), src_piece_lengths);
+    dst_vector = split_into_vector(decoded.data(), decoded.size(), dst_piece_lengths);
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_decode_feedv(src_vector.data(), src_vector.size(),
+                                                    dst_vector.data(), dst_vector.size(),
+                                                    &src_used, &dst_used,
+                                                    (safe16_stream_state)(SAFE16_SRC_IS_AT_END_OF_STREAM |
+                                                                          SAFE16_DST_IS_AT_END_OF_STREAM)));
+    ASSERT_EQ((int64_t)laid_out.size(), src_used);
+    ASSERT_EQ(length, dst_used);
+    ASSERT_EQ(data, decoded);
+}
+
+void assert_parallel_matches(int length, int thread_count)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> expected(safe16_get_encoded_length(length, true));
+    std::vector<uint8_t> actual(expected.size());
+
+    int64_t expected_length = safe16_encode(data.data(), data.size(), expected.data(), expected.size());
+    ASSERT_EQ(expected_length, safe16_encode_parallel(data.data(), data.size(), actual.data(), actual.size(), thread_count));
+    ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + expected_length, actual.begin()));
+
+    expected_length = safe16l_encode(data.data(), data.size(), expected.data(), expected.size());
+    ASSERT_EQ(expected_length, safe16l_encode_parallel(data.data(), data.size(), actual.data(), actual.size(), thread_count));
+    ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + expected_length, actual.begin()));
+}
+
+// Checks that a parallel decode gives the same result as a serial one,
+// including where any error is.
+void assert_parallel_decode_matches(const std::string& encoded, int64_t dst_length, int thread_count)
+{
+    const uint8_t* const src_buffer = (const uint8_t*)encoded.data();
+    std::vector<uint8_t> expected(dst_length);
+    std::vector<uint8_t> actual(dst_length);
+    const int64_t expected_result = safe16_decode(src_buffer, encoded.size(), expected.data(), expected.size());
+    int64_t error_offset = -1;
+    ASSERT_EQ(expected_result, safe16_decode_parallel(src_buffer, encoded.size(), actual.data(), actual.size(), thread_count, &error_offset));
+    if(expected_result >= 0)
+    {
+        ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + expected_result, actual.begin()));
+    }
+    if(expected_result == SAFE16_ERROR_INVALID_SOURCE_DATA)
+    {
+        const uint8_t* src = src_buffer;
+        uint8_t* dst = expected.data();
+        safe16_decode_feed(&src, encoded.size(), &dst, expected.size(),
+                           (safe16_stream_state)(SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM));
+        ASSERT_EQ(src - src_buffer, error_offset);
+    }
+}
+
+std::string encode_to_string(int length)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    safe16_encode(data.data(), data.size(), encoded.data(), encoded.size());
+    return std::string(encoded.begin(), encoded.end());
+}
+
+// Checks that a vectored decode stops on the same invalid char as a
+// contiguous one.
+void assert_feedv_error_matches(const std::string& encoded, const std::vector<int>& src_piece_lengths)
+{
+    std::vector<uint8_t> src_bytes(encoded.begin(), encoded.end());
+    std::vector<uint8_t> decoded(src_bytes.size());
+    const safe16_stream_state at_end = (safe16_stream_state)(SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM);
+    const uint8_t* src = src_bytes.data();
+    uint8_t* dst = decoded.data();
+    ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, safe16_decode_feed(&src, src_bytes.size(), &dst, decoded.size(), at_end));
+
+    std::vector<safe16_iovec> src_vector = split_into_vector(src_bytes.data(), src_bytes.size(), src_piece_lengths);
+    std::vector<safe16_iovec> dst_vector = split_into_vector(decoded.data(), decoded.size(), {7});
+    int64_t src_used = 0;
+    int64_t dst_used = 0;
+    ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, safe16_decode_feedv(src_vector.data(), src_vector.size(),
+                                                                    dst_vector.data(), dst_vector.size(),
+                                                                    &src_used, &dst_used, at_end));
+    ASSERT_EQ(src - src_bytes.data(), src_used);
+}
+
+// Checks a range decode against the data that was encoded.
+void assert_range_matches(const std::string& encoded,
+                          const std::vector<uint8_t>& data,
+                          const safe16_checkpoints* checkpoints,
+                          int64_t byte_offset,
+                          int64_t byte_count)
+{
+    int64_t expected_length = (int64_t)data.size() - byte_offset;
+    expected_length = expected_length < 0 ? 0 : expected_length < byte_count ? expected_length : byte_count;
+    std::vector<uint8_t> actual(byte_count);
+    ASSERT_EQ(expected_length, safe16_decode_range((const uint8_t*)encoded.data(), encoded.size(),
+                                                   byte_offset, byte_count, actual.data(), checkpoints))
+        << "offset " << byte_offset << ", count " << byte_count;
+    ASSERT_TRUE(std::equal(data.begin() + byte_offset, data.begin() + byte_offset + expected_length, actual.begin()));
+}
+
+void assert_every_range_matches(int length, int group_interval)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded_bytes(safe16_get_encoded_length(length, false));
+    safe16_encode(data.data(), data.size(), encoded_bytes.data(), encoded_bytes.size());
+    const std::string encoded(encoded_bytes.begin(), encoded_bytes.end());
+    const std::string laid_out = "\n " + lay_out_lines(encoded_bytes, 5, 1, "\r\n") + "\n";
+
+    std::vector<int64_t> offsets(safe16_get_checkpoint_count(laid_out.size(), group_interval));
+    safe16_checkpoints checkpoints;
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_build_checkpoints((const uint8_t*)laid_out.data(), laid_out.size(), group_interval,
+                                                         offsets.data(), offsets.size(), &checkpoints));
+    ASSERT_EQ(length, checkpoints.decoded_length);
+
+    for(int offset = 0; offset <= length + 1; offset++)
+    {
+        for(int count = 0; offset + count <= length + 2; count++)
+        {
+            assert_range_matches(encoded, data, NULL, offset, count);
+            assert_range_matches(laid_out, data, &checkpoints, offset, count);
+        }
+    }
+}
+
+void assert_decode_with_layout(int length, int line_length, int indent_count, safe16_line_break line_break)
+{
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(length, false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    const std::string laid_out = lay_out_lines(encoded,
+                                               line_length,
+                                               indent_count,
+                                               line_break == SAFE16_LINE_BREAK_CRLF ? "\r\n" : "\n");
+
+    std::vector<uint8_t> decoded(length);
+    int64_t decoded_length = safe16_decode_wrapped((const uint8_t*)laid_out.data(),
+                                                 laid_out.size(),
+                                                 decoded.data(),
+                                                 decoded.size(),
+                                                 line_length,
+                                                 indent_count,
+                                                 line_break);
+    ASSERT_EQ(length, decoded_length);
+    ASSERT_EQ(data, decoded);
+}
+
+void assert_decode_with_layout_status(std::string encoded,
+                                      int line_length,
+                                      int indent_count,
+                                      safe16_line_break line_break,
+                                      int64_t expected_status)
+{
+    std::vector<uint8_t> decoded(encoded.size());
+    int64_t status = safe16_decode_wrapped((const uint8_t*)encoded.data(),
+                                         encoded.size(),
+                                         decoded.data(),
+                                         decoded.size(),
+                                         line_length,
+                                         indent_count,
+                                         line_break);
+    ASSERT_EQ(expected_status, status);
+}
+
+
 
 // --------------------
 // Common Test Patterns
@@ -384,6 +845,484 @@ TEST(Packetized, decode_dst_packeted)
     assert_chunked_decode_dst_packeted(250);
 }
 
+TEST(Kernel, active_kernel)
+{
+    const std::string kernel = safe16_get_active_kernel();
+    ASSERT_TRUE(kernel == "avx2" || kernel == "sse4.1" || kernel == "bmi2" || kernel == "generic" || kernel == "scalar");
+
+    // Every CPU supports the scalar kernel.
+    const char* const requested = getenv("SAFE16_KERNEL");
+    if(requested != NULL && std::string(requested) == "scalar")
+    {
+        ASSERT_EQ("scalar", kernel);
+    }
+}
+
+TEST(Bulk, matches_per_group)
+{
+    assert_bulk_matches_per_group(1);
+    assert_bulk_matches_per_group(31);
+    assert_bulk_matches_per_group(32);
+    assert_bulk_matches_per_group(33);
+    assert_bulk_matches_per_group(300);
+    assert_bulk_matches_per_group(4099);
+}
+
+TEST(Bulk, invalid_at_each_position)
+{
+    assert_decode_invalid_at_each_position(100);
+}
+
+TEST(Bulk, whitespace_at_each_position)
+{
+    assert_decode_whitespace_at_each_position(100);
+}
+
+TEST(Bulk, strict_whitespace_at_each_position)
+{
+    assert_strict_decode_whitespace_at_each_position(100);
+}
+
+TEST(Bulk, wrapped_lines)
+{
+    assert_decode_and_compact_wrapped(100, 1);
+    assert_decode_and_compact_wrapped(100, 5);
+    assert_decode_and_compact_wrapped(4099, 19);
+    assert_decode_and_compact_wrapped(4099, 76);
+}
+
+TEST(Layout, decode)
+{
+    assert_decode_with_layout(0, 76, 0, SAFE16_LINE_BREAK_LF);
+    assert_decode_with_layout(1, 76, 4, SAFE16_LINE_BREAK_LF);
+    assert_decode_with_layout(100, 0, 2, SAFE16_LINE_BREAK_LF);
+    assert_decode_with_layout(100, 1, 0, SAFE16_LINE_BREAK_CRLF);
+    assert_decode_with_layout(300, 19, 3, SAFE16_LINE_BREAK_CRLF);
+    assert_decode_with_layout(10000, 64, 0, SAFE16_LINE_BREAK_LF);
+    assert_decode_with_layout(10000, 76, 8, SAFE16_LINE_BREAK_CRLF);
+}
+
+TEST(Layout, errors)
+{
+    std::vector<uint8_t> data = make_bytes(100, 100);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(data.size(), false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    const std::string laid_out = lay_out_lines(encoded, 10, 2, "\n");
+    const int64_t ok = data.size();
+
+    assert_decode_with_layout_status(laid_out, 10, 2, SAFE16_LINE_BREAK_LF, ok);
+    assert_decode_with_layout_status(laid_out + "\n", 10, 2, SAFE16_LINE_BREAK_LF, SAFE16_ERROR_INVALID_SOURCE_DATA);
+    assert_decode_with_layout_status(laid_out, 10, 1, SAFE16_LINE_BREAK_LF, SAFE16_ERROR_INVALID_SOURCE_DATA);
+    assert_decode_with_layout_status(laid_out, 10, 3, SAFE16_LINE_BREAK_LF, SAFE16_ERROR_INVALID_SOURCE_DATA);
+    assert_decode_with_layout_status(laid_out, 11, 2, SAFE16_LINE_BREAK_LF, SAFE16_ERROR_INVALID_SOURCE_DATA);
+    assert_decode_with_layout_status(laid_out, 10, 2, SAFE16_LINE_BREAK_CRLF, SAFE16_ERROR_INVALID_SOURCE_DATA);
+    assert_decode_with_layout_status(laid_out, -1, 2, SAFE16_LINE_BREAK_LF, SAFE16_ERROR_INVALID_LENGTH);
+    assert_decode_with_layout_status(laid_out, 10, -1, SAFE16_LINE_BREAK_LF, SAFE16_ERROR_INVALID_LENGTH);
+
+    std::string corrupted = laid_out;
+    corrupted[corrupted.size() / 2] = '\t';
+    assert_decode_with_layout_status(corrupted, 10, 2, SAFE16_LINE_BREAK_LF, SAFE16_ERROR_INVALID_SOURCE_DATA);
+
+    std::vector<uint8_t> decoded(data.size() - 1);
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_decode_wrapped((const uint8_t*)laid_out.data(),
+                                                             laid_out.size(),
+                                                             decoded.data(),
+                                                             decoded.size(),
+                                                             10,
+                                                             2,
+                                                             SAFE16_LINE_BREAK_LF));
+}
+
+TEST(Slack, matches_unpadded)
+{
+    ASSERT_GE(safe16_required_slack(), 0);
+    for(int length = 0; length < 200; length++)
+    {
+        assert_slack_matches(length);
+    }
+    assert_slack_matches(4099);
+}
+
+TEST(Slack, errors)
+{
+    const int64_t slack = safe16_required_slack();
+    std::vector<uint8_t> data = make_bytes(100, 100);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(data.size(), false) + slack);
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_encode_with_slack(data.data(), -1, encoded.data(), 10));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_encode_with_slack(data.data(), data.size(), encoded.data(), 10));
+    const int64_t encoded_length = safe16_encode_with_slack(data.data(), data.size(), encoded.data(), encoded.size() - slack);
+    ASSERT_GT(encoded_length, 0);
+
+    std::vector<uint8_t> decoded(data.size() + slack);
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_decode_with_slack(encoded.data(), encoded_length, decoded.data(), -1));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_decode_with_slack(encoded.data(), encoded_length, decoded.data(), 10));
+    encoded[encoded_length / 2] = '"';
+    ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, safe16_decode_with_slack(encoded.data(), encoded_length, decoded.data(), data.size()));
+}
+
+TEST(Stream, matches_one_shot)
+{
+    const int piece_lengths[] = {1, 2, 3, 7, 19, 64, 1000};
+    for(int length = 0; length < 100; length++)
+    {
+        for(int piece_length: piece_lengths)
+        {
+            assert_stream_matches(length, piece_length, false);
+            assert_stream_matches(length, piece_length, true);
+        }
+    }
+    assert_stream_matches(10000, 4099, false);
+    assert_stream_matches(10000, 4099, true);
+    assert_stream_matches(10000, 10000, true);
+}
+
+TEST(Stream, errors)
+{
+    std::vector<uint8_t> data = make_bytes(10000, 10000);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(data.size(), true));
+    ASSERT_EQ((int64_t)encoded.size(), safe16l_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    std::vector<uint8_t> output;
+
+    safe16_encoder encoder;
+    safe16_encoder_init(&encoder, append_to_vector, &output);
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_encoder_feed(&encoder, data.data(), -1, true));
+    safe16_encoder_init(&encoder, refuse_data, NULL);
+    ASSERT_EQ(SAFE16_ERROR_SINK_FAILED, safe16_encoder_feed(&encoder, data.data(), data.size(), true));
+
+    safe16_decoder decoder;
+    safe16l_decoder_init(&decoder, append_to_vector, &output);
+    ASSERT_EQ(SAFE16_ERROR_UNTERMINATED_LENGTH_FIELD, safe16_decoder_feed(&decoder, encoded.data(), 1, true));
+    safe16l_decoder_init(&decoder, append_to_vector, &output);
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_decoder_feed(&decoder, encoded.data(), encoded.size() / 2, false));
+    ASSERT_EQ(SAFE16_ERROR_TRUNCATED_DATA, safe16_decoder_feed(&decoder, encoded.data(), 0, true));
+    safe16l_decoder_init(&decoder, refuse_data, NULL);
+    ASSERT_EQ(SAFE16_ERROR_SINK_FAILED, safe16_decoder_feed(&decoder, encoded.data(), encoded.size(), true));
+
+    encoded[encoded.size() / 2] = '"';
+    safe16l_decoder_init(&decoder, append_to_vector, &output);
+    ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, safe16_decoder_feed(&decoder, encoded.data(), encoded.size(), true));
+    safe16_decoder_init(&decoder, append_to_vector, &output);
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_decoder_feed(&decoder, encoded.data(), -1, true));
+}
+
+TEST(Vector, matches_contiguous)
+{
+    const std::vector<int> small_pieces = {1, 2, 3, 5, 0, 7, 13};
+    const std::vector<int> other_small_pieces = {3, 0, 1, 11, 4};
+    const std::vector<int> large_pieces = {4096, 100};
+    for(int length = 0; length < 100; length++)
+    {
+        assert_feedv_matches(length, small_pieces, other_small_pieces);
+        assert_feedv_matches(length, other_small_pieces, small_pieces);
+        assert_feedv_matches(length, large_pieces, small_pieces);
+    }
+    assert_feedv_matches(5000, small_pieces, large_pieces);
+    assert_feedv_matches(5000, large_pieces, other_small_pieces);
+}
+
+TEST(Vector, partial_feeds)
+{
+    // Without the end of data, a trailing partial group is left for the next
+    // feed, as in the contiguous functions.
+    std::vector<uint8_t> data = make_bytes(1000, 1000);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(data.size(), false));
+    std::vector<safe16_iovec> src_vector = split_into_vector(data.data(), data.size() - 1, {1, 2, 3});
+    std::vector<safe16_iovec> dst_vector = split_into_vector(encoded.data(), encoded.size(), {5, 7});
+    int64_t src_used = 0;
+    int64_t dst_used = 0;
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_encode_feedv(src_vector.data(), src_vector.size(),
+                                                    dst_vector.data(), dst_vector.size(),
+                                                    &src_used, &dst_used, false));
+    const uint8_t* src = data.data();
+    std::vector<uint8_t> expected(encoded.size());
+    uint8_t* expected_dst = expected.data();
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_encode_feed(&src, data.size() - 1, &expected_dst, expected.size(), false));
+    ASSERT_EQ(src - data.data(), src_used);
+    ASSERT_EQ(expected_dst - expected.data(), dst_used);
+    ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + dst_used, encoded.begin()));
+
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    std::vector<uint8_t> decoded(data.size());
+    src_vector = split_into_vector(encoded.data(), encoded.size() - 1, {1, 2, 3});
+    dst_vector = split_into_vector(decoded.data(), decoded.size(), {5, 7});
+    ASSERT_EQ(SAFE16_STATUS_PARTIALLY_COMPLETE, safe16_decode_feedv(src_vector.data(), src_vector.size(),
+                                                                    dst_vector.data(), dst_vector.size(),
+                                                                    &src_used, &dst_used,
+                                                                    SAFE16_STREAM_STATE_NONE));
+    ASSERT_EQ(dst_used / g_bytes_per_group * g_chunks_per_group, src_used);
+    ASSERT_GT(dst_used, (int64_t)data.size() - 2 * g_bytes_per_group);
+    ASSERT_TRUE(std::equal(decoded.begin(), decoded.begin() + dst_used, data.begin()));
+}
+
+TEST(Vector, errors)
+{
+    std::vector<uint8_t> data = make_bytes(100, 100);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(data.size(), false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    int64_t src_used = 0;
+    int64_t dst_used = 0;
+    const safe16_stream_state at_end = (safe16_stream_state)(SAFE16_SRC_IS_AT_END_OF_STREAM | SAFE16_DST_IS_AT_END_OF_STREAM);
+
+    std::vector<safe16_iovec> src_vector = split_into_vector(data.data(), data.size(), {3});
+    std::vector<safe16_iovec> dst_vector = split_into_vector(encoded.data(), encoded.size(), {7});
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_encode_feedv(src_vector.data(), -1,
+                                                               dst_vector.data(), dst_vector.size(),
+                                                               &src_used, &dst_used, true));
+    src_vector[1].length = -1;
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_encode_feedv(src_vector.data(), src_vector.size(),
+                                                               dst_vector.data(), dst_vector.size(),
+                                                               &src_used, &dst_used, true));
+    src_vector[1].length = 3;
+    ASSERT_EQ(SAFE16_STATUS_PARTIALLY_COMPLETE, safe16_encode_feedv(src_vector.data(), src_vector.size(),
+                                                                    dst_vector.data(), dst_vector.size() - 2,
+                                                                    &src_used, &dst_used, true));
+
+    std::vector<uint8_t> decoded(data.size());
+    src_vector = split_into_vector(encoded.data(), encoded.size(), {7});
+    dst_vector = split_into_vector(decoded.data(), decoded.size(), {3});
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_decode_feedv(src_vector.data(), src_vector.size(),
+                                                                dst_vector.data(), dst_vector.size() - 2,
+                                                                &src_used, &dst_used, at_end));
+    encoded[50] = '"';
+    src_vector = split_into_vector(encoded.data(), encoded.size(), {100});
+    dst_vector = split_into_vector(decoded.data(), decoded.size(), {100});
+    ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, safe16_decode_feedv(src_vector.data(), src_vector.size(),
+                                                                    dst_vector.data(), dst_vector.size(),
+                                                                    &src_used, &dst_used, at_end));
+    ASSERT_EQ(50, src_used);
+}
+
+TEST(Vector, straddling_errors)
+{
+    const std::string encoded = encode_to_string(100);
+    for(int offset = 48; offset < 48 + 2 * g_chunks_per_group; offset++)
+    {
+        std::string corrupted = encoded;
+        corrupted[offset] = '\x01';
+        assert_feedv_error_matches(corrupted, {1});
+        assert_feedv_error_matches(corrupted, {3, 2});
+        // The group runs on through buffers that are all whitespace.
+        const std::string spaced = encoded.substr(0, offset) + std::string(3000, ' ') + corrupted.substr(offset);
+        assert_feedv_error_matches(spaced, {300});
+        assert_feedv_error_matches(spaced, {1});
+    }
+}
+
+TEST(Parallel, matches_serial)
+{
+    for(int length = 0; length < 100; length++)
+    {
+        assert_parallel_matches(length, 4);
+    }
+    // Big enough to be split into several shards.
+    const int lengths[] = {300000, 1000000, 1048583};
+    const int thread_counts[] = {0, 1, 2, 3, 8, 1000};
+    for(int length: lengths)
+    {
+        for(int thread_count: thread_counts)
+        {
+            assert_parallel_matches(length, thread_count);
+        }
+    }
+}
+
+TEST(Parallel, concurrent_calls)
+{
+    std::vector<uint8_t> data = make_bytes(1000000, 1);
+    std::vector<uint8_t> expected(safe16_get_encoded_length(data.size(), false));
+    ASSERT_EQ((int64_t)expected.size(), safe16_encode(data.data(), data.size(), expected.data(), expected.size()));
+
+    std::vector<std::vector<uint8_t>> results(4, std::vector<uint8_t>(expected.size()));
+    std::vector<int64_t> lengths(results.size());
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        threads.emplace_back([&, i]
+        {
+            lengths[i] = safe16_encode_parallel(data.data(), data.size(), results[i].data(), results[i].size(), 4);
+        });
+    }
+    for(auto& thread: threads)
+    {
+        thread.join();
+    }
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        ASSERT_EQ((int64_t)expected.size(), lengths[i]);
+        ASSERT_EQ(expected, results[i]);
+    }
+}
+
+TEST(Parallel, errors)
+{
+    std::vector<uint8_t> data = make_bytes(300000, 300000);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(data.size(), true));
+    const int64_t encoded_length = safe16_get_encoded_length(data.size(), false);
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_encode_parallel(data.data(), -1, encoded.data(), encoded.size(), 4));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_encode_parallel(data.data(), data.size(), encoded.data(), -1, 4));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_encode_parallel(data.data(), data.size(), encoded.data(), encoded_length - 1, 4));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16l_encode_parallel(data.data(), -1, encoded.data(), encoded.size(), 4));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16l_encode_parallel(data.data(), data.size(), encoded.data(), 1, 4));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16l_encode_parallel(data.data(), data.size(), encoded.data(), encoded_length, 4));
+}
+
+TEST(ParallelDecode, matches_serial)
+{
+    for(int length = 0; length < 100; length++)
+    {
+        assert_parallel_decode_matches(encode_to_string(length), length, 4);
+    }
+
+    const int thread_counts[] = {0, 1, 2, 3, 8};
+    for(int length: {300000, 300001, 300002})
+    {
+        const std::string encoded = encode_to_string(length);
+        std::vector<uint8_t> encoded_bytes(encoded.begin(), encoded.end());
+        // Whitespace runs longer than a block, starting part way through a
+        // group.
+        const std::string gappy = encoded.substr(0, 100001) + std::string(200000, ' ') +
+                                  encoded.substr(100001) + std::string(200000, '\n');
+        const std::string layouts[] =
+        {
+            encoded,
+            lay_out_lines(encoded_bytes, 76, 0, "\n"),
+            lay_out_lines(encoded_bytes, 10, 3, "\r\n"),
+            gappy,
+        };
+        for(const std::string& layout: layouts)
+        {
+            for(int thread_count: thread_counts)
+            {
+                assert_parallel_decode_matches(layout, length, thread_count);
+                assert_parallel_decode_matches(layout, length + 10, thread_count);
+            }
+        }
+    }
+}
+
+TEST(ParallelDecode, errors)
+{
+    const int length = 300000;
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded_bytes(safe16_get_encoded_length(length, false));
+    safe16_encode(data.data(), data.size(), encoded_bytes.data(), encoded_bytes.size());
+    const std::string encoded = lay_out_lines(encoded_bytes, 76, 0, "\n");
+
+    // Around the edges of the blocks, which are 64 KiB here.
+    for(int64_t offset: {(int64_t)0, (int64_t)65535, (int64_t)65536, (int64_t)65537, (int64_t)131071,
+                         (int64_t)encoded.size() / 2, (int64_t)encoded.size() - 1})
+    {
+        std::string corrupted = encoded;
+        corrupted[offset] = '"';
+        assert_parallel_decode_matches(corrupted, length, 3);
+        assert_parallel_decode_matches(corrupted, length + 10, 3);
+        // Only the first error counts.
+        corrupted[encoded.size() - 100] = '"';
+        assert_parallel_decode_matches(corrupted, length, 3);
+    }
+
+    assert_parallel_decode_matches(encoded, length - 1, 3);
+    assert_parallel_decode_matches(encoded + "\"", length, 3);
+    assert_parallel_decode_matches(encoded + "\"", length + 10, 3);
+
+    std::vector<uint8_t> decoded(length);
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_decode_parallel((const uint8_t*)encoded.data(), -1, decoded.data(), decoded.size(), 3, NULL));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_decode_parallel((const uint8_t*)encoded.data(), encoded.size(), decoded.data(), -1, 3, NULL));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_decode_parallel((const uint8_t*)encoded.data(), encoded.size(), decoded.data(), length - 1, 3, NULL));
+}
+
+TEST(Range, matches_data)
+{
+    for(int length = 0; length < 40; length++)
+    {
+        for(int group_interval: {1, 2, 3, 1000})
+        {
+            assert_every_range_matches(length, group_interval);
+        }
+    }
+
+    const int length = 300000;
+    std::vector<uint8_t> data = make_bytes(length, length);
+    std::vector<uint8_t> encoded_bytes(safe16_get_encoded_length(length, false));
+    safe16_encode(data.data(), data.size(), encoded_bytes.data(), encoded_bytes.size());
+    const std::string encoded(encoded_bytes.begin(), encoded_bytes.end());
+    const std::string laid_out = lay_out_lines(encoded_bytes, 76, 0, "\n");
+    std::vector<int64_t> offsets(safe16_get_checkpoint_count(laid_out.size(), 64));
+    safe16_checkpoints checkpoints;
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_build_checkpoints((const uint8_t*)laid_out.data(), laid_out.size(), 64,
+                                                         offsets.data(), offsets.size(), &checkpoints));
+    for(int64_t offset: {0, 1, 2, 191, 192, 193, 150001, length - 1000, length - 1})
+    {
+        for(int64_t count: {1, 2, 3, 100, 1000, 100000})
+        {
+            assert_range_matches(encoded, data, NULL, offset, count);
+            assert_range_matches(laid_out, data, &checkpoints, offset, count);
+        }
+    }
+}
+
+TEST(Range, errors)
+{
+    const std::string encoded = encode_to_string(100);
+    const uint8_t* const src = (const uint8_t*)encoded.data();
+    uint8_t dst[100];
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_decode_range(src, -1, 0, 10, dst, NULL));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_decode_range(src, encoded.size(), -1, 10, dst, NULL));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_decode_range(src, encoded.size(), 0, -1, dst, NULL));
+
+    // Only the chars in the range are checked.
+    std::string corrupted = encoded;
+    corrupted[encoded.size() / 2] = '"';
+    ASSERT_EQ(10, safe16_decode_range((const uint8_t*)corrupted.data(), corrupted.size(), 0, 10, dst, NULL));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, safe16_decode_range((const uint8_t*)corrupted.data(), corrupted.size(), 40, 20, dst, NULL));
+    corrupted[encoded.size() / 2] = ' ';
+    ASSERT_EQ(SAFE16_ERROR_INVALID_SOURCE_DATA, safe16_decode_range((const uint8_t*)corrupted.data(), corrupted.size(), 40, 20, dst, NULL));
+
+    std::vector<int64_t> offsets(safe16_get_checkpoint_count(encoded.size(), 2));
+    safe16_checkpoints checkpoints;
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_get_checkpoint_count(-1, 2));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_get_checkpoint_count(encoded.size(), 0));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_build_checkpoints(src, -1, 2, offsets.data(), offsets.size(), &checkpoints));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_build_checkpoints(src, encoded.size(), 0, offsets.data(), offsets.size(), &checkpoints));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_build_checkpoints(src, encoded.size(), 2, offsets.data(), offsets.size() - 1, &checkpoints));
+    ASSERT_EQ(SAFE16_STATUS_OK, safe16_build_checkpoints(src, encoded.size(), 2, offsets.data(), offsets.size(), &checkpoints));
+    ASSERT_EQ(SAFE16_ERROR_TRUNCATED_DATA, safe16_decode_range(src, encoded.size() - 10, 90, 10, dst, &checkpoints));
+    ASSERT_EQ(SAFE16_ERROR_TRUNCATED_DATA, safe16_decode_range(src, encoded.size() * 6 / 10, 90, 10, dst, &checkpoints));
+    ASSERT_EQ(SAFE16_ERROR_TRUNCATED_DATA, safe16_decode_range(src, 0, 90, 10, dst, &checkpoints));
+    checkpoints.offset_count = 1;
+    ASSERT_EQ(SAFE16_ERROR_TRUNCATED_DATA, safe16_decode_range(src, encoded.size(), 90, 10, dst, &checkpoints));
+}
+
+TEST(Compact, errors)
+{
+    const uint8_t src[] = "  ab\ncd  ";
+    uint8_t dst[4];
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_compact(src, -1, dst, sizeof(dst)));
+    ASSERT_EQ(SAFE16_ERROR_INVALID_LENGTH, safe16_compact(src, sizeof(src) - 1, dst, -1));
+    ASSERT_EQ(SAFE16_ERROR_NOT_ENOUGH_ROOM, safe16_compact(src, sizeof(src) - 1, dst, 3));
+    ASSERT_EQ(4, safe16_compact(src, sizeof(src) - 1, dst, sizeof(dst)));
+}
+
+TEST(Bulk, substitutions)
+{
+    std::vector<uint8_t> data = make_bytes(256, 0);
+    std::vector<uint8_t> encoded(safe16_get_encoded_length(data.size(), false));
+    ASSERT_EQ((int64_t)encoded.size(), safe16_encode(data.data(), data.size(), encoded.data(), encoded.size()));
+    const std::string ones = "iIlL";
+    const std::string zeroes = "oO";
+    for(size_t i = 0; i < encoded.size(); i++)
+    {
+        uint8_t ch = encoded[i];
+        if(ch >= 'a' && ch <= 'f') ch -= 'a' - 'A';
+        if(ch == '1') ch = ones[i % ones.size()];
+        if(ch == '0') ch = zeroes[i % zeroes.size()];
+        encoded[i] = ch;
+    }
+    std::vector<uint8_t> decoded(data.size());
+    ASSERT_EQ((int64_t)data.size(), safe16_decode(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+    ASSERT_EQ(data, decoded);
+}
+
 TEST_ENCODE_LENGTH(_0, 0, "0")
 TEST_ENCODE_LENGTH(_1, 1, "1")
 TEST_ENCODE_LENGTH(_5, 5, "5")
@@ -426,6 +1365,7 @@ TEST_DECODE(substitution_2, "ABCDEFOI", {0xab, 0xcd, 0xef, 0x01})
 TEST_DECODE(substitution_3, "ABCDEFOL", {0xab, 0xcd, 0xef, 0x01})
 TEST_DECODE(substitution_4, "abcdefoi", {0xab, 0xcd, 0xef, 0x01})
 TEST_DECODE(substitution_5, "abcdefol", {0xab, 0xcd, 0xef, 0x01})
+TEST_DECODE(substitution_bulk, "ABCDEFOIabcdefolABCDEFOL", {0xab, 0xcd, 0xef, 0x01, 0xab, 0xcd, 0xef, 0x01, 0xab, 0xcd, 0xef, 0x01})
 
 TEST(Length, invalid)
 {
@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <safe32/safe32.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Measures how safe32_encode_parallel() and safe32_decode_parallel() scale
+// from 1 thread up to one per CPU over a large buffer.
+//
+// Usage: run_benchmark [megabytes] [max threads]
+
+#define DEFAULT_MEGABYTES 128
+#define RUN_COUNT 3
+#define WRAPPED_LINE_LENGTH 76
+
+typedef int64_t (*run_function)(const uint8_t* src,
+                                int64_t src_length,
+                                uint8_t* dst,
+                                int64_t dst_length,
+                                int thread_count);
+
+static void* allocate(const int64_t length)
+{
+    void* const buffer = malloc((size_t)length);
+    if(buffer == NULL)
+    {
+        fprintf(stderr, "Could not allocate %lld bytes\n", (long long)length);
+        exit(1);
+    }
+    return buffer;
+}
+
+static double get_seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static int64_t encode(const uint8_t* const src,
+                      const int64_t src_length,
+                      uint8_t* const dst,
+                      const int64_t dst_length,
+                      const int thread_count)
+{
+    return safe32_encode_parallel(src, src_length, dst, dst_length, thread_count);
+}
+
+static int64_t decode(const uint8_t* const src,
+                      const int64_t src_length,
+                      uint8_t* const dst,
+                      const int64_t dst_length,
+                      const int thread_count)
+{
+    return safe32_decode_parallel(src, src_length, dst, dst_length, thread_count, NULL);
+}
+
+// Returns the best throughput of RUN_COUNT runs in MB/s of decoded data.
+static double measure(const run_function run,
+                      const uint8_t* const src,
+                      const int64_t src_length,
+                      uint8_t* const dst,
+                      const int64_t dst_length,
+                      const int64_t expected_length,
+                      const int64_t decoded_length,
+                      const int thread_count)
+{
+    double best_seconds = 0;
+    for(int i = 0; i < RUN_COUNT; i++)
+    {
+        const double start = get_seconds();
+        const int64_t result = run(src, src_length, dst, dst_length, thread_count);
+        const double seconds = get_seconds() - start;
+        if(result != expected_length)
+        {
+            fprintf(stderr, "Expected %lld bytes on %d threads but got %lld\n",
+                    (long long)expected_length, thread_count, (long long)result);
+            exit(1);
+        }
+        if(i == 0 || seconds < best_seconds)
+        {
+            best_seconds = seconds;
+        }
+    }
+    return (double)decoded_length / best_seconds / 1e6;
+}
+
+static void print_rate(const double rate, const double base_rate)
+{
+    printf(" %12.1f %7.2fx", rate, rate / base_rate);
+}
+
+int main(const int argc, const char* const argv[])
+{
+    const int64_t megabytes = argc > 1 ? atoll(argv[1]) : DEFAULT_MEGABYTES;
+    const int max_thread_count = argc > 2 ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if(megabytes < 1 || max_thread_count < 1)
+    {
+        fprintf(stderr, "Usage: %s [megabytes] [max threads]\n", argv[0]);
+        return 1;
+    }
+
+    const int64_t decoded_length = megabytes * 1024 * 1024;
+    uint8_t* const decoded = allocate(decoded_length);
+    uint8_t* const decode_buffer = allocate(decoded_length);
+    uint64_t random_state = 0x9e3779b97f4a7c15ULL;
+    for(int64_t i = 0; i < decoded_length; i++)
+    {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        decoded[i] = (uint8_t)random_state;
+    }
+
+    const int64_t encoded_length = safe32_get_encoded_length(decoded_length, false);
+    uint8_t* const encoded = allocate(encoded_length);
+    if(safe32_encode(decoded, decoded_length, encoded, encoded_length) != encoded_length)
+    {
+        fprintf(stderr, "Could not encode the test data\n");
+        return 1;
+    }
+
+    // The same data broken into lines, so that the decoder's whitespace
+    // handling gets measured too.
+    const int64_t wrapped_length = encoded_length + encoded_length / WRAPPED_LINE_LENGTH;
+    uint8_t* const wrapped = allocate(wrapped_length);
+    for(int64_t src_pos = 0, dst_pos = 0; src_pos < encoded_length; src_pos += WRAPPED_LINE_LENGTH)
+    {
+        const int64_t line_length = encoded_length - src_pos < WRAPPED_LINE_LENGTH ?
+                                    encoded_length - src_pos : WRAPPED_LINE_LENGTH;
+        memcpy(wrapped + dst_pos, encoded + src_pos, (size_t)line_length);
+        dst_pos += line_length;
+        if(line_length == WRAPPED_LINE_LENGTH)
+        {
+            wrapped[dst_pos++] = '\n';
+        }
+    }
+
+    printf("safe32 (%s kernel): %lld MiB, best of %d runs, MB/s of decoded data\n\n",
+           safe32_get_active_kernel(), (long long)megabytes, RUN_COUNT);
+    printf("threads       encode  speedup       decode  speedup      wrapped  speedup\n");
+
+    double encode_base = 0;
+    double decode_base = 0;
+    double wrapped_base = 0;
+    for(int thread_count = 1; thread_count <= max_thread_count; thread_count++)
+    {
+        const double encode_rate = measure(encode, decoded, decoded_length, encoded, encoded_length,
+                                           encoded_length, decoded_length, thread_count);
+        const double decode_rate = measure(decode, encoded, encoded_length, decode_buffer, decoded_length,
+                                           decoded_length, decoded_length, thread_count);
+        if(memcmp(decode_buffer, decoded, (size_t)decoded_length) != 0)
+        {
+            fprintf(stderr, "Decoded data doesn't match on %d threads\n", thread_count);
+            return 1;
+        }
+        memset(decode_buffer, 0, (size_t)decoded_length);
+        const double wrapped_rate = measure(decode, wrapped, wrapped_length, decode_buffer, decoded_length,
+                                            decoded_length, decoded_length, thread_count);
+        if(memcmp(decode_buffer, decoded, (size_t)decoded_length) != 0)
+        {
+            fprintf(stderr, "Decoded wrapped data doesn't match on %d threads\n", thread_count);
+            return 1;
+        }
+
+        if(thread_count == 1)
+        {
+            encode_base = encode_rate;
+            decode_base = decode_rate;
+            wrapped_base = wrapped_rate;
+        }
+        printf("%7d", thread_count);
+        print_rate(encode_rate, encode_base);
+        print_rate(decode_rate, decode_base);
+        print_rate(wrapped_rate, wrapped_base);
+        printf("\n");
+        fflush(stdout);
+    }
+
+    free(wrapped);
+    free(encoded);
+    free(decode_buffer);
+    free(decoded);
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "kernels.h"
+
+#if SAFE32_HAS_X86_KERNELS
+
+#include <immintrin.h>
+#include <string.h>
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+// Encoding: Each 128-bit lane receives 10 source bytes, which are shuffled so
+// that every 64-bit lane holds one 40-bit group. The group is split in half
+// three times (20, 10 and finally 5 bits) until each chunk has its own byte,
+// and the chunks are then mapped onto the alphabet with two 16-entry
+// shuffle tables.
+
+TARGET_AVX2 static inline __m256i encode_20_bytes(const uint8_t* const src)
+{
+    const __m256i chars_0_to_f = _mm256_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i chars_g_to_z = _mm256_setr_epi8(
+        'g', 'h', 'j', 'k', 'm', 'n', 'p', 'q', 'r', 's', 't', 'v', 'w', 'x', 'y', 'z',
+        'g', 'h', 'j', 'k', 'm', 'n', 'p', 'q', 'r', 's', 't', 'v', 'w', 'x', 'y', 'z');
+
+    // Reads 26 bytes
+    const __m256i input = _mm256_loadu2_m128i((const __m128i*)(src + 10), (const __m128i*)src);
+    const __m256i groups = _mm256_shuffle_epi8(input, _mm256_setr_epi8(
+        4, 3, 2, 1, 0, -1, -1, -1, 9, 8, 7, 6, 5, -1, -1, -1,
+        4, 3, 2, 1, 0, -1, -1, -1, 9, 8, 7, 6, 5, -1, -1, -1));
+
+    // At each step, the high half of a field moves into the low (first
+    // written) half of its lane, and the low half moves up.
+    const __m256i halves_20 = _mm256_or_si256(_mm256_srli_epi64(groups, 20),
+                                              _mm256_slli_epi64(_mm256_and_si256(groups, _mm256_set1_epi64x(0xfffff)), 32));
+    const __m256i halves_10 = _mm256_or_si256(_mm256_srli_epi32(halves_20, 10),
+                                              _mm256_slli_epi32(_mm256_and_si256(halves_20, _mm256_set1_epi32(0x3ff)), 16));
+    const __m256i chunks = _mm256_or_si256(_mm256_srli_epi16(halves_10, 5),
+                                           _mm256_slli_epi16(_mm256_and_si256(halves_10, _mm256_set1_epi16(0x1f)), 8));
+
+    return _mm256_blendv_epi8(_mm256_shuffle_epi8(chars_0_to_f, chunks),
+                              _mm256_shuffle_epi8(chars_g_to_z, chunks),
+                              _mm256_cmpgt_epi8(chunks, _mm256_set1_epi8(15)));
+}
+
+TARGET_AVX2 int64_t safe32_avx2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 5 bytes and 8 chars per group. Each step reads 26 bytes, so keep an
+    // extra 2 groups of input in reserve.
+    const int64_t groups_per_step = 4;
+    const int64_t groups_overread = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step + groups_overread <= group_count; offset += groups_per_step)
+    {
+        _mm256_storeu_si256((__m256i*)(dst + offset * 8), encode_20_bytes(src + offset * 5));
+    }
+    return offset;
+}
+
+// Decoding: Digits map directly. Letters are case folded and then looked up
+// by their position in the alphabet (which also takes care of the
+// substitutions i, l -> 1, o -> 0 and u -> v). Anything else (including
+// whitespace) aborts the block so that the scalar code can deal with it.
+
+TARGET_AVX2 static inline __m256i is_in_range(const __m256i values, const char lo, const char hi)
+{
+    const __m256i offset_values = _mm256_sub_epi8(values, _mm256_set1_epi8(lo));
+    const __m256i limit = _mm256_set1_epi8((char)(hi - lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(offset_values, limit), offset_values);
+}
+
+TARGET_AVX2 static inline bool decode_32_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    // Chunk values of the letters a-p and q-z
+    const __m256i letters_a_to_p = _mm256_setr_epi8(
+        10, 11, 12, 13, 14, 15, 16, 17, 1, 18, 19, 1, 20, 21, 0, 22,
+        10, 11, 12, 13, 14, 15, 16, 17, 1, 18, 19, 1, 20, 21, 0, 22);
+    const __m256i letters_q_to_z = _mm256_setr_epi8(
+        23, 24, 25, 26, 27, 27, 28, 29, 30, 31, 0, 0, 0, 0, 0, 0,
+        23, 24, 25, 26, 27, 27, 28, 29, 30, 31, 0, 0, 0, 0, 0, 0);
+
+    const __m256i chars = _mm256_loadu_si256((const __m256i*)src);
+    const __m256i folded = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+
+    const __m256i is_digit = is_in_range(chars, '0', '9');
+    const __m256i is_letter = is_in_range(folded, 'a', 'z');
+    if((uint32_t)_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != 0xffffffff)
+    {
+        return false;
+    }
+
+    const __m256i letter_index = _mm256_sub_epi8(folded, _mm256_set1_epi8('a'));
+    const __m256i is_q_to_z = _mm256_cmpgt_epi8(letter_index, _mm256_set1_epi8(15));
+    const __m256i letter_chunks = _mm256_blendv_epi8(_mm256_shuffle_epi8(letters_a_to_p, letter_index),
+                                                     _mm256_shuffle_epi8(letters_q_to_z, letter_index),
+                                                     is_q_to_z);
+    const __m256i chunks = _mm256_blendv_epi8(letter_chunks,
+                                              _mm256_sub_epi8(chars, _mm256_set1_epi8('0')),
+                                              is_digit);
+
+    // Merge 8 x 5-bit chunks into a 40-bit value in each 64-bit lane:
+    // pairs of chunks into 10 bits, pairs of those into 20 bits, and then
+    // the two 20-bit halves of each lane into 40 bits.
+    const __m256i pairs = _mm256_maddubs_epi16(chunks, _mm256_set1_epi16(0x0120));
+    const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00010400));
+    const __m256i groups = _mm256_or_si256(_mm256_mul_epu32(quads, _mm256_set1_epi64x(1 << 20)),
+                                           _mm256_srli_epi64(quads, 32));
+
+    // Put each group's 5 bytes in big endian order at the front of its
+    // 128-bit lane, then stitch the two lanes together.
+    const __m256i lane_bytes = _mm256_shuffle_epi8(groups, _mm256_setr_epi8(
+        4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1,
+        4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1));
+    const __m128i lo = _mm256_castsi256_si128(lane_bytes);
+    const __m128i hi = _mm256_extracti128_si256(lane_bytes, 1);
+    _mm_storeu_si128((__m128i*)dst, _mm_or_si128(lo, _mm_slli_si128(hi, 10)));
+    const uint32_t last_bytes = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(hi, 6));
+    memcpy(dst + 16, &last_bytes, sizeof(last_bytes));
+    return true;
+}
+
+TARGET_AVX2 int64_t safe32_avx2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 8 chars and 5 bytes per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_32_chars(src + offset * 8, dst + offset * 5))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE32_HAS_X86_KERNELS
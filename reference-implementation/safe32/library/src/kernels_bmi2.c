@@ -0,0 +1,126 @@
+#include "kernels.h"
+
+#if SAFE32_HAS_BMI2_KERNELS
+
+#include <immintrin.h>
+#include <string.h>
+
+#define TARGET_BMI2 __attribute__((target("bmi2")))
+
+// These kernels work in general purpose registers, one group (40 bits) at a
+// time. pdep spreads the bits out so that every 5-bit chunk gets a byte of its
+// own, and pext packs them back together again. The remaining per-byte work
+// is done on all 8 bytes of the register at once.
+
+static const uint64_t g_chunk_mask = 0x1f1f1f1f1f1f1f1full;
+static const uint64_t g_byte_ones  = 0x0101010101010101ull;
+static const uint64_t g_byte_highs = 0x8080808080808080ull;
+
+static inline uint64_t load_uint64_big_endian(const uint8_t* const src)
+{
+    uint64_t value;
+    memcpy(&value, src, sizeof(value));
+    return __builtin_bswap64(value);
+}
+
+// Adds amount to every byte of chars whose chunk is greater than threshold.
+// Chunks are below 0x20, so adding (0x7f - threshold) sets the high bit of
+// exactly those bytes without carrying into the next one.
+static inline uint64_t add_if_greater(const uint64_t chars, const uint64_t chunks, const int threshold, const int amount)
+{
+    const uint64_t is_greater = ((chunks + g_byte_ones * (0x7f - threshold)) >> 7) & g_byte_ones;
+    return chars + is_greater * amount;
+}
+
+TARGET_BMI2 static inline void encode_5_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    // Reads 8 bytes. The first chunk ends up in the lowest byte.
+    const uint64_t group = load_uint64_big_endian(src) >> 24;
+    const uint64_t chunks = __builtin_bswap64(_pdep_u64(group, g_chunk_mask));
+
+    // '0' = 0 + 48, 'a' = 10 + 87, 'j' = 18 + 88, 'm' = 20 + 89, 'p' = 22 + 90,
+    // 'v' = 27 + 91
+    uint64_t chars = chunks + g_byte_ones * 48;
+    chars = add_if_greater(chars, chunks, 9, 39);
+    chars = add_if_greater(chars, chunks, 17, 1);
+    chars = add_if_greater(chars, chunks, 19, 1);
+    chars = add_if_greater(chars, chunks, 21, 1);
+    chars = add_if_greater(chars, chunks, 26, 1);
+    memcpy(dst, &chars, sizeof(chars));
+}
+
+TARGET_BMI2 int64_t safe32_bmi2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 5 bytes and 8 chars per group. Each step reads 8 bytes, so keep an
+    // extra group of input in reserve.
+    const int64_t groups_overread = 1;
+    int64_t offset = 0;
+    for(; offset + groups_overread < group_count; offset++)
+    {
+        encode_5_bytes(src + offset * 5, dst + offset * 8);
+    }
+    return offset;
+}
+
+#define ERRR 0xff
+#define WHSP 0xfe
+// g_encode_char_to_chunk from library.c, for the characters 0x00 - 0x7f.
+static const uint8_t g_char_to_chunk[128] =
+{
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, WHSP, WHSP, ERRR, ERRR, WHSP, ERRR, ERRR,
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+    WHSP, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, WHSP, ERRR, ERRR,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+    ERRR, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x01, 0x12, 0x13, 0x01, 0x14, 0x15, 0x00,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, ERRR, ERRR, ERRR, ERRR, ERRR,
+    ERRR, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x01, 0x12, 0x13, 0x01, 0x14, 0x15, 0x00,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, ERRR, ERRR, ERRR, ERRR, ERRR,
+};
+#undef WHSP
+#undef ERRR
+
+TARGET_BMI2 static inline bool decode_8_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    uint64_t chars;
+    memcpy(&chars, src, sizeof(chars));
+    if((chars & g_byte_highs) != 0)
+    {
+        return false;
+    }
+
+    // The first chunk ends up in the highest byte. Whitespace and invalid
+    // characters both have their high bit set.
+    uint64_t chunks = 0;
+    for(int i = 0; i < 8; i++)
+    {
+        chunks = (chunks << 8) | g_char_to_chunk[src[i]];
+    }
+    if((chunks & g_byte_highs) != 0)
+    {
+        return false;
+    }
+
+    const uint64_t bytes = __builtin_bswap64(_pext_u64(chunks, g_chunk_mask) << 24);
+    memcpy(dst, &bytes, 5);
+    return true;
+}
+
+TARGET_BMI2 int64_t safe32_bmi2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 8 chars and 5 bytes per group
+    int64_t offset = 0;
+    for(; offset < group_count; offset++)
+    {
+        if(!decode_8_chars(src + offset * 8, dst + offset * 5))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE32_HAS_BMI2_KERNELS
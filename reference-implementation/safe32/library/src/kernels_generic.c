@@ -0,0 +1,150 @@
+#include "kernels.h"
+
+#if SAFE32_HAS_GENERIC_KERNELS
+
+#include <string.h>
+
+// These are the same algorithms as in kernels_sse41.c, written with the
+// compiler's vector extensions rather than intrinsics so that they build for
+// any target. The compiler lowers them to whatever the build's -march allows.
+// 16-byte vectors are native wherever there is SIMD at all (SSE2, NEON, ...),
+// and unlike wider ones they don't change the calling convention.
+
+typedef uint8_t  u8x16  __attribute__((vector_size(16)));
+typedef uint16_t u16x8  __attribute__((vector_size(16)));
+typedef uint32_t u32x4  __attribute__((vector_size(16)));
+typedef uint64_t u64x2  __attribute__((vector_size(16)));
+
+static inline u8x16 load_u8x16(const uint8_t* const src)
+{
+    u8x16 value;
+    memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+static inline uint64_t load_uint64_big_endian(const uint8_t* const src)
+{
+    uint64_t value;
+    memcpy(&value, src, sizeof(value));
+    return __builtin_bswap64(value);
+}
+
+static inline void store_group(uint8_t* const dst, const uint64_t group)
+{
+    const uint64_t value = __builtin_bswap64(group << 24);
+    memcpy(dst, &value, 5);
+}
+
+// Comparisons give 0 or -1 in each element.
+static inline bool is_all_set(const u8x16 mask)
+{
+    const u64x2 words = (u64x2)mask;
+    return (words[0] & words[1]) == ~(uint64_t)0;
+}
+
+static inline u8x16 is_in_range(const u8x16 values, const uint8_t lo, const uint8_t hi)
+{
+    return (u8x16)((u8x16)(values - lo) <= (uint8_t)(hi - lo));
+}
+
+// Gives amount in every element that is greater than threshold, and 0 in the
+// others.
+static inline u8x16 amount_if_greater(const u8x16 values, const uint8_t threshold, const uint8_t amount)
+{
+    return (u8x16)(values > threshold) & amount;
+}
+
+static inline void encode_10_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    // Reads 13 bytes. Byte shuffles are expensive on some targets, so the
+    // groups are loaded into their lanes one by one.
+    const u64x2 groups = {load_uint64_big_endian(src) >> 24, load_uint64_big_endian(src + 5) >> 24};
+
+    // At each step, the high half of a field moves into the low (first
+    // written) half of its lane, and the low half moves up.
+    const u32x4 halves_20 = (u32x4)((groups >> 20) | ((groups & 0xfffff) << 32));
+    const u16x8 halves_10 = (u16x8)((halves_20 >> 10) | ((halves_20 & 0x3ff) << 16));
+    const u8x16 chunks = (u8x16)((halves_10 >> 5) | ((halves_10 & 0x1f) << 8));
+
+    // '0' = 0 + 48, 'a' = 10 + 87, 'j' = 18 + 88, 'm' = 20 + 89, 'p' = 22 + 90,
+    // 'v' = 27 + 91
+    const u8x16 chars = chunks + 48 +
+                        amount_if_greater(chunks, 9, 39) +
+                        amount_if_greater(chunks, 17, 1) +
+                        amount_if_greater(chunks, 19, 1) +
+                        amount_if_greater(chunks, 21, 1) +
+                        amount_if_greater(chunks, 26, 1);
+    memcpy(dst, &chars, sizeof(chars));
+}
+
+int64_t safe32_generic_encode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 5 bytes and 8 chars per group. Each step reads 13 bytes, so keep an
+    // extra group of input in reserve.
+    const int64_t groups_per_step = 2;
+    const int64_t groups_overread = 1;
+    int64_t offset = 0;
+    for(; offset + groups_per_step + groups_overread <= group_count; offset += groups_per_step)
+    {
+        encode_10_bytes(src + offset * 5, dst + offset * 8);
+    }
+    return offset;
+}
+
+static inline bool decode_16_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const u8x16 chars = load_u8x16(src);
+    const u8x16 folded = chars | 0x20;
+
+    const u8x16 is_digit = is_in_range(chars, '0', '9');
+    const u8x16 is_letter = is_in_range(folded, 'a', 'z');
+    if(!is_all_set(is_digit | is_letter))
+    {
+        return false;
+    }
+
+    // '0' = 0 + 48, 'a' = 10 + 87, 'j' = 18 + 88, 'm' = 20 + 89, 'p' = 22 + 90,
+    // 'v' = 27 + 91 ('u' is a substitute for 'v', which this gets for free)
+    const u8x16 offsets = (is_digit & 48) +
+                          (is_letter & 87) +
+                          amount_if_greater(folded, 'h', 1) +
+                          amount_if_greater(folded, 'k', 1) +
+                          amount_if_greater(folded, 'n', 1) +
+                          amount_if_greater(folded, 'u', 1);
+
+    // 'i' and 'l' are substitutes for '1', and 'o' for '0'.
+    const u8x16 is_one = (u8x16)(folded == 'i') | (u8x16)(folded == 'l');
+    const u8x16 is_zero = (u8x16)(folded == 'o');
+    const u8x16 chunks = ((folded - offsets) & ~(is_one | is_zero)) | (is_one & 1);
+
+    // Chunks are combined in pairs until each 64-bit lane holds a group.
+    const u16x8 pairs = (u16x8)chunks;
+    const u32x4 quads = (u32x4)(((pairs & 0x1f) << 5) | (pairs >> 8));
+    const u64x2 halves = (u64x2)(((quads & 0x3ff) << 10) | (quads >> 16));
+    const u64x2 groups = ((halves & 0xfffff) << 20) | (halves >> 32);
+
+    store_group(dst, groups[0]);
+    store_group(dst + 5, groups[1]);
+    return true;
+}
+
+int64_t safe32_generic_decode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 8 chars and 5 bytes per group
+    const int64_t groups_per_step = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_16_chars(src + offset * 8, dst + offset * 5))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE32_HAS_GENERIC_KERNELS
@@ -0,0 +1,224 @@
+#include "kernels.h"
+
+#if SAFE32_HAS_X86_KERNELS
+
+#include <smmintrin.h>
+#include <string.h>
+
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+
+// These are the same algorithms as in kernels_avx2.c, on 128-bit registers.
+
+TARGET_SSE41 static inline __m128i encode_10_bytes(const uint8_t* const src)
+{
+    const __m128i chars_0_to_f = _mm_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i chars_g_to_z = _mm_setr_epi8(
+        'g', 'h', 'j', 'k', 'm', 'n', 'p', 'q', 'r', 's', 't', 'v', 'w', 'x', 'y', 'z');
+
+    // Reads 16 bytes
+    const __m128i groups = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), _mm_setr_epi8(
+        4, 3, 2, 1, 0, -1, -1, -1, 9, 8, 7, 6, 5, -1, -1, -1));
+
+    const __m128i halves_20 = _mm_or_si128(_mm_srli_epi64(groups, 20),
+                                           _mm_slli_epi64(_mm_and_si128(groups, _mm_set1_epi64x(0xfffff)), 32));
+    const __m128i halves_10 = _mm_or_si128(_mm_srli_epi32(halves_20, 10),
+                                           _mm_slli_epi32(_mm_and_si128(halves_20, _mm_set1_epi32(0x3ff)), 16));
+    const __m128i chunks = _mm_or_si128(_mm_srli_epi16(halves_10, 5),
+                                        _mm_slli_epi16(_mm_and_si128(halves_10, _mm_set1_epi16(0x1f)), 8));
+
+    return _mm_blendv_epi8(_mm_shuffle_epi8(chars_0_to_f, chunks),
+                           _mm_shuffle_epi8(chars_g_to_z, chunks),
+                           _mm_cmpgt_epi8(chunks, _mm_set1_epi8(15)));
+}
+
+TARGET_SSE41 int64_t safe32_sse41_encode_groups(const uint8_t* const src,
+                                                uint8_t* const dst,
+                                                const int64_t group_count)
+{
+    // 5 bytes and 8 chars per group. Each step reads 16 bytes, so keep an
+    // extra 2 groups of input in reserve.
+    const int64_t groups_per_step = 2;
+    const int64_t groups_overread = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step + groups_overread <= group_count; offset += groups_per_step)
+    {
+        _mm_storeu_si128((__m128i*)(dst + offset * 8), encode_10_bytes(src + offset * 5));
+    }
+    return offset;
+}
+
+TARGET_SSE41 static inline __m128i is_in_range(const __m128i values, const char lo, const char hi)
+{
+    const __m128i offset_values = _mm_sub_epi8(values, _mm_set1_epi8(lo));
+    const __m128i limit = _mm_set1_epi8((char)(hi - lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset_values, limit), offset_values);
+}
+
+TARGET_SSE41 static inline bool decode_16_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const __m128i letters_a_to_p = _mm_setr_epi8(
+        10, 11, 12, 13, 14, 15, 16, 17, 1, 18, 19, 1, 20, 21, 0, 22);
+    const __m128i letters_q_to_z = _mm_setr_epi8(
+        23, 24, 25, 26, 27, 27, 28, 29, 30, 31, 0, 0, 0, 0, 0, 0);
+
+    const __m128i chars = _mm_loadu_si128((const __m128i*)src);
+    const __m128i folded = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+    const __m128i is_digit = is_in_range(chars, '0', '9');
+    const __m128i is_letter = is_in_range(folded, 'a', 'z');
+    if(_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff)
+    {
+        return false;
+    }
+
+    const __m128i letter_index = _mm_sub_epi8(folded, _mm_set1_epi8('a'));
+    const __m128i is_q_to_z = _mm_cmpgt_epi8(letter_index, _mm_set1_epi8(15));
+    const __m128i letter_chunks = _mm_blendv_epi8(_mm_shuffle_epi8(letters_a_to_p, letter_index),
+                                                  _mm_shuffle_epi8(letters_q_to_z, letter_index),
+                                                  is_q_to_z);
+    const __m128i chunks = _mm_blendv_epi8(letter_chunks,
+                                           _mm_sub_epi8(chars, _mm_set1_epi8('0')),
+                                           is_digit);
+
+    const __m128i pairs = _mm_maddubs_epi16(chunks, _mm_set1_epi16(0x0120));
+    const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010400));
+    const __m128i groups = _mm_or_si128(_mm_mul_epu32(quads, _mm_set1_epi64x(1 << 20)),
+                                        _mm_srli_epi64(quads, 32));
+
+    const __m128i bytes = _mm_shuffle_epi8(groups, _mm_setr_epi8(
+        4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1));
+    _mm_storel_epi64((__m128i*)dst, bytes);
+    const uint16_t last_bytes = (uint16_t)_mm_extract_epi16(bytes, 4);
+    memcpy(dst + 8, &last_bytes, sizeof(last_bytes));
+    return true;
+}
+
+TARGET_SSE41 int64_t safe32_sse41_decode_groups(const uint8_t* const src,
+                                                uint8_t* const dst,
+                                                const int64_t group_count)
+{
+    // 8 chars and 5 bytes per group
+    const int64_t groups_per_step = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_16_chars(src + offset * 8, dst + offset * 5))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+// Entry n holds the indices of the set bits in n, lowest first, as a pshufb
+// mask. Generated by print_left_pack_shuffle_table() in dev-tools.
+static const uint64_t g_left_pack_shuffles[256] =
+{
+    0x8080808080808080, 0x8080808080808000, 0x8080808080808001, 0x8080808080800100,
+    0x8080808080808002, 0x8080808080800200, 0x8080808080800201, 0x8080808080020100,
+    0x8080808080808003, 0x8080808080800300, 0x8080808080800301, 0x8080808080030100,
+    0x8080808080800302, 0x8080808080030200, 0x8080808080030201, 0x8080808003020100,
+    0x8080808080808004, 0x8080808080800400, 0x8080808080800401, 0x8080808080040100,
+    0x8080808080800402, 0x8080808080040200, 0x8080808080040201, 0x8080808004020100,
+    0x8080808080800403, 0x8080808080040300, 0x8080808080040301, 0x8080808004030100,
+    0x8080808080040302, 0x8080808004030200, 0x8080808004030201, 0x8080800403020100,
+    0x8080808080808005, 0x8080808080800500, 0x8080808080800501, 0x8080808080050100,
+    0x8080808080800502, 0x8080808080050200, 0x8080808080050201, 0x8080808005020100,
+    0x8080808080800503, 0x8080808080050300, 0x8080808080050301, 0x8080808005030100,
+    0x8080808080050302, 0x8080808005030200, 0x8080808005030201, 0x8080800503020100,
+    0x8080808080800504, 0x8080808080050400, 0x8080808080050401, 0x8080808005040100,
+    0x8080808080050402, 0x8080808005040200, 0x8080808005040201, 0x8080800504020100,
+    0x8080808080050403, 0x8080808005040300, 0x8080808005040301, 0x8080800504030100,
+    0x8080808005040302, 0x8080800504030200, 0x8080800504030201, 0x8080050403020100,
+    0x8080808080808006, 0x8080808080800600, 0x8080808080800601, 0x8080808080060100,
+    0x8080808080800602, 0x8080808080060200, 0x8080808080060201, 0x8080808006020100,
+    0x8080808080800603, 0x8080808080060300, 0x8080808080060301, 0x8080808006030100,
+    0x8080808080060302, 0x8080808006030200, 0x8080808006030201, 0x8080800603020100,
+    0x8080808080800604, 0x8080808080060400, 0x8080808080060401, 0x8080808006040100,
+    0x8080808080060402, 0x8080808006040200, 0x8080808006040201, 0x8080800604020100,
+    0x8080808080060403, 0x8080808006040300, 0x8080808006040301, 0x8080800604030100,
+    0x8080808006040302, 0x8080800604030200, 0x8080800604030201, 0x8080060403020100,
+    0x8080808080800605, 0x8080808080060500, 0x8080808080060501, 0x8080808006050100,
+    0x8080808080060502, 0x8080808006050200, 0x8080808006050201, 0x8080800605020100,
+    0x8080808080060503, 0x8080808006050300, 0x8080808006050301, 0x8080800605030100,
+    0x8080808006050302, 0x8080800605030200, 0x8080800605030201, 0x8080060503020100,
+    0x8080808080060504, 0x8080808006050400, 0x8080808006050401, 0x8080800605040100,
+    0x8080808006050402, 0x8080800605040200, 0x8080800605040201, 0x8080060504020100,
+    0x8080808006050403, 0x8080800605040300, 0x8080800605040301, 0x8080060504030100,
+    0x8080800605040302, 0x8080060504030200, 0x8080060504030201, 0x8006050403020100,
+    0x8080808080808007, 0x8080808080800700, 0x8080808080800701, 0x8080808080070100,
+    0x8080808080800702, 0x8080808080070200, 0x8080808080070201, 0x8080808007020100,
+    0x8080808080800703, 0x8080808080070300, 0x8080808080070301, 0x8080808007030100,
+    0x8080808080070302, 0x8080808007030200, 0x8080808007030201, 0x8080800703020100,
+    0x8080808080800704, 0x8080808080070400, 0x8080808080070401, 0x8080808007040100,
+    0x8080808080070402, 0x8080808007040200, 0x8080808007040201, 0x8080800704020100,
+    0x8080808080070403, 0x8080808007040300, 0x8080808007040301, 0x8080800704030100,
+    0x8080808007040302, 0x8080800704030200, 0x8080800704030201, 0x8080070403020100,
+    0x8080808080800705, 0x8080808080070500, 0x8080808080070501, 0x8080808007050100,
+    0x8080808080070502, 0x8080808007050200, 0x8080808007050201, 0x8080800705020100,
+    0x8080808080070503, 0x8080808007050300, 0x8080808007050301, 0x8080800705030100,
+    0x8080808007050302, 0x8080800705030200, 0x8080800705030201, 0x8080070503020100,
+    0x8080808080070504, 0x8080808007050400, 0x8080808007050401, 0x8080800705040100,
+    0x8080808007050402, 0x8080800705040200, 0x8080800705040201, 0x8080070504020100,
+    0x8080808007050403, 0x8080800705040300, 0x8080800705040301, 0x8080070504030100,
+    0x8080800705040302, 0x8080070504030200, 0x8080070504030201, 0x8007050403020100,
+    0x8080808080800706, 0x8080808080070600, 0x8080808080070601, 0x8080808007060100,
+    0x8080808080070602, 0x8080808007060200, 0x8080808007060201, 0x8080800706020100,
+    0x8080808080070603, 0x8080808007060300, 0x8080808007060301, 0x8080800706030100,
+    0x8080808007060302, 0x8080800706030200, 0x8080800706030201, 0x8080070603020100,
+    0x8080808080070604, 0x8080808007060400, 0x8080808007060401, 0x8080800706040100,
+    0x8080808007060402, 0x8080800706040200, 0x8080800706040201, 0x8080070604020100,
+    0x8080808007060403, 0x8080800706040300, 0x8080800706040301, 0x8080070604030100,
+    0x8080800706040302, 0x8080070604030200, 0x8080070604030201, 0x8007060403020100,
+    0x8080808080070605, 0x8080808007060500, 0x8080808007060501, 0x8080800706050100,
+    0x8080808007060502, 0x8080800706050200, 0x8080800706050201, 0x8080070605020100,
+    0x8080808007060503, 0x8080800706050300, 0x8080800706050301, 0x8080070605030100,
+    0x8080800706050302, 0x8080070605030200, 0x8080070605030201, 0x8007060503020100,
+    0x8080808007060504, 0x8080800706050400, 0x8080800706050401, 0x8080070605040100,
+    0x8080800706050402, 0x8080070605040200, 0x8080070605040201, 0x8007060504020100,
+    0x8080800706050403, 0x8080070605040300, 0x8080070605040301, 0x8007060504030100,
+    0x8080070605040302, 0x8007060504030200, 0x8007060504030201, 0x0706050403020100,
+};
+
+// Whitespace is everything that the decoder skips: tab, LF, CR, space and '-'.
+TARGET_SSE41 static inline __m128i is_whitespace(const __m128i chars)
+{
+    const __m128i is_space_or_tab = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+                                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')));
+    const __m128i is_line_break = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')),
+                                               _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+    const __m128i is_dash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('-'));
+    return _mm_or_si128(_mm_or_si128(is_space_or_tab, is_line_break), is_dash);
+}
+
+// AVX2 has no cross-lane byte shuffle, so this is shared with the avx2 kernel.
+TARGET_SSE41 int64_t safe32_sse41_compact_blocks(const uint8_t* const src,
+                                                 uint8_t* const dst,
+                                                 const int64_t block_count)
+{
+    // 16 chars per block. Each block is read before anything is written over
+    // it, so src and dst may be the same.
+    const __m128i high_half_offsets = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8);
+    uint8_t* next = dst;
+    for(int64_t offset = 0; offset < block_count * 16; offset += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(src + offset));
+        const int keep = ~_mm_movemask_epi8(is_whitespace(chars)) & 0xffff;
+        if(keep == 0xffff)
+        {
+            _mm_storeu_si128((__m128i*)next, chars);
+            next += 16;
+            continue;
+        }
+        const __m128i shuffle = _mm_set_epi64x((long long)g_left_pack_shuffles[keep >> 8],
+                                               (long long)g_left_pack_shuffles[keep & 0xff]);
+        const __m128i packed = _mm_shuffle_epi8(chars, _mm_add_epi8(shuffle, high_half_offsets));
+        _mm_storel_epi64((__m128i*)next, packed);
+        _mm_storel_epi64((__m128i*)(next + __builtin_popcount(keep & 0xff)), _mm_unpackhi_epi64(packed, packed));
+        next += __builtin_popcount(keep);
+    }
+    return next - dst;
+}
+
+#endif // SAFE32_HAS_X86_KERNELS
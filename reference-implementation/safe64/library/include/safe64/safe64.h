@@ -66,6 +66,11 @@ typedef enum
      * There wasn't enough room in the bufer to complete the operation.
      */
     SAFE64_ERROR_NOT_ENOUGH_ROOM = -6,
+
+    /**
+     * A sink refused the data that it was given. See safe64_sink.
+     */
+    SAFE64_ERROR_SINK_FAILED = -7,
 } safe64_status;
 
 /**
@@ -95,8 +100,104 @@ typedef enum
      * The destination buffer endpoint marks the end of the destination stream.
      */
     SAFE64_DST_IS_AT_END_OF_STREAM = 4,
+
+    /**
+     * The source data contains no whitespace, so whitespace is treated as
+     * invalid source data rather than skipped. This lets the decoder assume
+     * that groups are packed together, and reports the first whitespace
+     * character as SAFE64_ERROR_INVALID_SOURCE_DATA.
+     */
+    SAFE64_SRC_HAS_NO_WHITESPACE = 8,
 } safe64_stream_state;
 
+/**
+ * The line break that goes between lines of encoded data.
+ */
+typedef enum
+{
+    SAFE64_LINE_BREAK_LF = 0,
+    SAFE64_LINE_BREAK_CRLF = 1,
+} safe64_line_break;
+
+/**
+ * One buffer in a vector of buffers, laid out like a struct iovec.
+ */
+typedef struct
+{
+    void* base;
+    int64_t length;
+} safe64_iovec;
+
+/**
+ * Receives the output of a safe64_encoder or safe64_decoder.
+ *
+ * @param context The sink context that the encoder or decoder was set up with.
+ * @param data The data, which is only valid until the sink returns.
+ * @param length The length of the data.
+ * @return true if the sink took the data, false to stop with SAFE64_ERROR_SINK_FAILED.
+ */
+typedef bool (*safe64_sink)(void* context, const uint8_t* data, int64_t length);
+
+/**
+ * Encoder state that lasts from one safe64_encoder_feed() to the next.
+ * Set it up with safe64_encoder_init() or safe64l_encoder_init().
+ * The fields are private.
+ */
+typedef struct
+{
+    safe64_sink sink;
+    void* sink_context;
+    bool has_length_field;
+    int64_t length_field;
+    int partial_group_length;
+    uint8_t partial_group[3];
+} safe64_encoder;
+
+/**
+ * Decoder state that lasts from one safe64_decoder_feed() to the next.
+ * Set it up with safe64_decoder_init() or safe64l_decoder_init().
+ * The fields are private.
+ */
+typedef struct
+{
+    safe64_sink sink;
+    void* sink_context;
+    bool is_reading_length_field;
+    int64_t length_field;
+    int64_t bytes_left;
+    int partial_group_length;
+    uint8_t partial_group[4];
+} safe64_decoder;
+
+/**
+ * A sparse index of where the groups of a safe64 sequence start, which lets
+ * safe64_decode_range() find its way around data that contains whitespace.
+ * Set it up with safe64_build_checkpoints().
+ */
+typedef struct
+{
+    /**
+     * The number of groups from one checkpoint to the next.
+     */
+    int64_t group_interval;
+
+    /**
+     * The offsets in the sequence of the first characters of groups 0,
+     * group_interval, 2 * group_interval, and so on.
+     */
+    const int64_t* offsets;
+
+    /**
+     * The number of offsets.
+     */
+    int64_t offset_count;
+
+    /**
+     * The length of the decoded data.
+     */
+    int64_t decoded_length;
+} safe64_checkpoints;
+
 
 
 // --------------
@@ -110,6 +211,24 @@ typedef enum
  */
 SAFE64_PUBLIC const char* safe64_version(void);
 
+/**
+ * Get the name of the bulk kernel that this library uses on the current CPU.
+ * In the order that they're preferred, the kernels are:
+ *
+ *   - "avx2" and "sse4.1": x86, built with GCC or Clang.
+ *   - "bmi2": x86_64, built with GCC or Clang.
+ *   - "generic": any little endian CPU, built with GCC or Clang.
+ *   - "scalar": any CPU.
+ *
+ * The fastest kernel that the CPU supports is chosen the first time one is
+ * needed. To force a particular kernel (for example in tests), set the
+ * environment variable SAFE64_KERNEL to its name before calling into the
+ * library. Unknown or unsupported kernel names are ignored.
+ *
+ * @return The kernel name.
+ */
+SAFE64_PUBLIC const char* safe64_get_active_kernel(void);
+
 /**
  * Estimate the number of bytes that would be occupied when decoding a safe64
  * sequence of the specified length. Since whitespace would throw this number
@@ -166,6 +285,67 @@ SAFE64_PUBLIC int64_t safe64l_decode(const uint8_t* src_buffer,
                                      uint8_t* dst_buffer,
                                      int64_t dst_length);
 
+/**
+ * Completely decodes a safe64 sequence that is laid out in lines of a known
+ * width, such as the output of the safe64 executable's -n and -i options:
+ *
+ *   - Every line starts with indent_count spaces.
+ *   - Every line but the last holds line_length encoded characters, and is
+ *     followed by a line break.
+ *   - The last line holds the rest (at least 1 character). If it's a full
+ *     line, the line break and indentation that follow it are optional.
+ *
+ * The encoded characters are found from the layout instead of by looking for
+ * whitespace, so this is faster than safe64_decode(). Input that doesn't follow
+ * the layout exactly is rejected as invalid.
+ *
+ * A line_length of 0 means that there are no line breaks.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length or the layout was negative.
+ *  * SAFE64_ERROR_INVALID_SOURCE_DATA: The data was invalid, or not laid out as described.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: The destination buffer was not big enough.
+ *
+ * @param src_buffer The buffer containing the complete safe64 sequence.
+ * @param src_length The length in bytes of the sequence.
+ * @param dst_buffer A buffer to store the decoded data.
+ * @param dst_length The length of the destination buffer.
+ * @param line_length The number of encoded characters on each full line.
+ * @param indent_count The number of spaces at the start of each line.
+ * @param line_break The line break between lines.
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_decode_wrapped(const uint8_t* src_buffer,
+                                            int64_t src_length,
+                                            uint8_t* dst_buffer,
+                                            int64_t dst_length,
+                                            int line_length,
+                                            int indent_count,
+                                            safe64_line_break line_break);
+
+/**
+ * Copies a safe64 or safe64L sequence, leaving out any whitespace. Decoding the
+ * result gives the same data, but faster, so this is useful for normalizing
+ * data that will be decoded more than once.
+ *
+ * The source and destination buffers may be the same. Characters that aren't
+ * whitespace are copied as-is, whether they're valid or not.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: The destination buffer was not big enough.
+ *
+ * @param src_buffer The buffer containing the safe64 sequence.
+ * @param src_length The length in bytes of the sequence.
+ * @param dst_buffer A buffer to store the compacted sequence.
+ * @param dst_length The length of the destination buffer.
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_compact(const uint8_t* src_buffer,
+                                     int64_t src_length,
+                                     uint8_t* dst_buffer,
+                                     int64_t dst_length);
+
 /**
  * Estimate the number of bytes required to encode some binary data.
  *
@@ -218,6 +398,216 @@ SAFE64_PUBLIC int64_t safe64l_encode(const uint8_t* src_buffer,
                                      int64_t dst_buffer_length);
 
 
+/**
+ * Get the number of bytes of slack that safe64_encode_with_slack() and
+ * safe64_decode_with_slack() need past the end of each of their buffers.
+ *
+ * @return The number of bytes of slack.
+ */
+SAFE64_PUBLIC int64_t safe64_required_slack(void);
+
+/**
+ * Completely encodes some binary data, like safe64_encode(), but faster for
+ * short data.
+ *
+ * The caller guarantees that safe64_required_slack() bytes past the end of each
+ * buffer can be read, and that those past the end of dst_buffer can also be
+ * written. Anything in dst_buffer past the returned length may be junk.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: The destination buffer was not big enough.
+ *
+ * @param src_buffer The buffer containing the complete binary data.
+ * @param src_length The length in bytes of the data (not counting slack).
+ * @param dst_buffer A buffer to store the encoded data.
+ * @param dst_length The length of the destination buffer (not counting slack).
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_encode_with_slack(const uint8_t* src_buffer,
+                                               int64_t src_length,
+                                               uint8_t* dst_buffer,
+                                               int64_t dst_length);
+
+/**
+ * Completely decodes a safe64 sequence, like safe64_decode(), but faster for
+ * short data.
+ *
+ * The caller guarantees that safe64_required_slack() bytes past the end of each
+ * buffer can be read, and that those past the end of dst_buffer can also be
+ * written. Anything in dst_buffer past the returned length may be junk.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_INVALID_SOURCE_DATA: The data was invalid.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: The destination buffer was not big enough.
+ *
+ * @param src_buffer The buffer containing the complete safe64 sequence.
+ * @param src_length The length in bytes of the sequence (not counting slack).
+ * @param dst_buffer A buffer to store the decoded data.
+ * @param dst_length The length of the destination buffer (not counting slack).
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_decode_with_slack(const uint8_t* src_buffer,
+                                               int64_t src_length,
+                                               uint8_t* dst_buffer,
+                                               int64_t dst_length);
+
+/**
+ * Completely encodes some binary data, like safe64_encode(), but spreads the
+ * work over several threads.
+ *
+ * The threads come from a pool that's started on the first call and kept for
+ * later ones. Only one parallel encode uses the pool at a time; if another
+ * thread's is already running, this one runs on the calling thread alone.
+ * Data too short to be worth splitting up is also encoded on the calling
+ * thread.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: The destination buffer was not big enough.
+ *
+ * @param src_buffer The buffer containing the complete binary data.
+ * @param src_length The length in bytes of the data.
+ * @param dst_buffer A buffer to store the encoded data.
+ * @param dst_length The length of the destination buffer.
+ * @param thread_count The most threads to use, counting the calling one, or 0
+ *                     to use one per CPU.
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_encode_parallel(const uint8_t* src_buffer,
+                                             int64_t src_length,
+                                             uint8_t* dst_buffer,
+                                             int64_t dst_length,
+                                             int thread_count);
+
+/**
+ * Completely encodes a length field & some binary data, like safe64l_encode(),
+ * but spreads the work over several threads as in safe64_encode_parallel().
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: The destination buffer was not big enough.
+ *
+ * @param src_buffer The buffer containing the complete binary data.
+ * @param src_length The length in bytes of the data.
+ * @param dst_buffer A buffer to store the encoded data.
+ * @param dst_length The length of the destination buffer.
+ * @param thread_count The most threads to use, counting the calling one, or 0
+ *                     to use one per CPU.
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64l_encode_parallel(const uint8_t* src_buffer,
+                                              int64_t src_length,
+                                              uint8_t* dst_buffer,
+                                              int64_t dst_length,
+                                              int thread_count);
+
+/**
+ * Completely decodes a safe64 sequence, like safe64_decode(), but spreads the
+ * work over several threads, using the same pool as safe64_encode_parallel().
+ *
+ * The result is always the same as safe64_decode()'s would be. If the data is
+ * invalid, error_offset shows exactly where the first offending character is.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_INVALID_SOURCE_DATA: The data was invalid.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: The destination buffer was not big enough.
+ *
+ * @param src_buffer The buffer containing the complete safe64 sequence.
+ * @param src_length The length in bytes of the sequence.
+ * @param dst_buffer A buffer to store the decoded data.
+ * @param dst_length The length of the destination buffer.
+ * @param thread_count The most threads to use, counting the calling one, or 0
+ *                     to use one per CPU.
+ * @param error_offset If not NULL, where to store the offset in src_buffer of
+ *                     the first invalid character (output).
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_decode_parallel(const uint8_t* src_buffer,
+                                             int64_t src_length,
+                                             uint8_t* dst_buffer,
+                                             int64_t dst_length,
+                                             int thread_count,
+                                             int64_t* error_offset);
+
+/**
+ * Decodes byte_count bytes from byte_offset onwards in the decoded data,
+ * without decoding anything before them. Only the groups that cover the range
+ * get looked at, so this takes time in proportion to byte_count rather than
+ * to the length of the sequence.
+ *
+ * If checkpoints is NULL, the sequence must not contain any whitespace, since
+ * the groups are found by position alone. Whitespace inside the range is
+ * reported as invalid data, but whitespace before it goes unnoticed and throws
+ * the result off. For sequences with whitespace, pass the checkpoints that
+ * safe64_build_checkpoints() built from the same sequence.
+ *
+ * If the range runs past the end of the decoded data, only the bytes up to
+ * the end are decoded.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length or offset was negative.
+ *  * SAFE64_ERROR_INVALID_SOURCE_DATA: The data was invalid.
+ *  * SAFE64_ERROR_TRUNCATED_DATA: The sequence is shorter than the checkpoints say.
+ *
+ * @param src_buffer The buffer containing the complete safe64 sequence.
+ * @param src_length The length in bytes of the sequence.
+ * @param byte_offset The offset in the decoded data of the first byte to decode.
+ * @param byte_count The number of bytes to decode.
+ * @param dst_buffer A buffer with room for byte_count bytes.
+ * @param checkpoints The sequence's checkpoints, or NULL if it has no whitespace.
+ * @return the number of bytes written, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_decode_range(const uint8_t* src_buffer,
+                                          int64_t src_length,
+                                          int64_t byte_offset,
+                                          int64_t byte_count,
+                                          uint8_t* dst_buffer,
+                                          const safe64_checkpoints* checkpoints);
+
+/**
+ * Gives the most checkpoints that safe64_build_checkpoints() could need for a
+ * safe64 sequence of the specified length.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: The length was negative or the interval less than 1.
+ *
+ * @param src_length The length in bytes of the sequence.
+ * @param group_interval The number of groups from one checkpoint to the next.
+ * @return The number of checkpoints, or a status code.
+ */
+SAFE64_PUBLIC int64_t safe64_get_checkpoint_count(int64_t src_length, int64_t group_interval);
+
+/**
+ * Builds a checkpoint index for safe64_decode_range() by going through a
+ * safe64 sequence once. The index only depends on where the whitespace is,
+ * so it can be kept alongside the sequence and used for as long as that
+ * stays the same. A bigger group_interval makes for a smaller index, but
+ * safe64_decode_range() has to count off up to that many groups to find the
+ * start of a range.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative or the interval less than 1.
+ *  * SAFE64_ERROR_NOT_ENOUGH_ROOM: There wasn't room for all of the offsets.
+ *
+ * @param src_buffer The buffer containing the complete safe64 sequence.
+ * @param src_length The length in bytes of the sequence.
+ * @param group_interval The number of groups from one checkpoint to the next.
+ * @param offsets A buffer to store the checkpoints in, which must last as long as the index does.
+ * @param offset_capacity The number of checkpoints the buffer can hold (see safe64_get_checkpoint_count()).
+ * @param checkpoints The index to set up (output).
+ * @return The status.
+ */
+SAFE64_PUBLIC safe64_status safe64_build_checkpoints(const uint8_t* src_buffer,
+                                                     int64_t src_length,
+                                                     int64_t group_interval,
+                                                     int64_t* offsets,
+                                                     int64_t offset_capacity,
+                                                     safe64_checkpoints* checkpoints);
+
+
 
 // -------------
 // Low Level API
@@ -278,6 +668,41 @@ SAFE64_PUBLIC safe64_status safe64_decode_feed(const uint8_t** src_buffer_ptr,
                                                int64_t dst_length,
                                                safe64_stream_state stream_state);
 
+/**
+ * Decode part of a safe64 sequence that's spread over a vector of buffers,
+ * into another vector of buffers.
+ *
+ * This works like safe64_decode_feed(), as if each vector were one buffer
+ * holding its buffers end to end. Groups that straddle buffers are gathered
+ * and scattered internally, so the buffers don't need to be joined first.
+ *
+ * Upon return:
+ *
+ *   src_used will hold the number of characters used. If it's less than the
+ *   total length of the source buffers, the remaining characters need to be
+ *   fed again, along with more input data.
+ *
+ *   dst_used will hold the number of bytes written.
+ *
+ * Can return the same status codes as safe64_decode_feed().
+ *
+ * @param src_vector The source buffers.
+ * @param src_vector_count The number of source buffers.
+ * @param dst_vector The destination buffers.
+ * @param dst_vector_count The number of destination buffers.
+ * @param src_used Where to store the number of characters used (output).
+ * @param dst_used Where to store the number of bytes written (output).
+ * @param stream_state The state of the streams, as in safe64_decode_feed().
+ * @return Status code indicating the result of the operation.
+ */
+SAFE64_PUBLIC safe64_status safe64_decode_feedv(const safe64_iovec* src_vector,
+                                                int src_vector_count,
+                                                const safe64_iovec* dst_vector,
+                                                int dst_vector_count,
+                                                int64_t* src_used,
+                                                int64_t* dst_used,
+                                                safe64_stream_state stream_state);
+
 /**
  * Write a length field to a buffer.
  *
@@ -330,6 +755,146 @@ SAFE64_PUBLIC safe64_status safe64_encode_feed(const uint8_t** src_buffer_ptr,
                                                int64_t dst_length,
                                                bool is_end_of_data);
 
+/**
+ * Encode part of a sequence of binary data that's spread over a vector of
+ * buffers, into another vector of buffers.
+ *
+ * This works like safe64_encode_feed(), as if each vector were one buffer
+ * holding its buffers end to end. Groups that straddle buffers are gathered
+ * and scattered internally, so the buffers don't need to be joined first.
+ *
+ * Upon return:
+ *
+ *   src_used will hold the number of bytes used. If it's less than the total
+ *   length of the source buffers, the remaining bytes need to be fed again,
+ *   along with more input data.
+ *
+ *   dst_used will hold the number of characters written.
+ *
+ * Can return the same status codes as safe64_encode_feed().
+ *
+ * @param src_vector The source buffers.
+ * @param src_vector_count The number of source buffers.
+ * @param dst_vector The destination buffers.
+ * @param dst_vector_count The number of destination buffers.
+ * @param src_used Where to store the number of bytes used (output).
+ * @param dst_used Where to store the number of characters written (output).
+ * @param is_end_of_data If true, this is the last packet of data to encode.
+ * @return Status code indicating the result of the operation.
+ */
+SAFE64_PUBLIC safe64_status safe64_encode_feedv(const safe64_iovec* src_vector,
+                                                int src_vector_count,
+                                                const safe64_iovec* dst_vector,
+                                                int dst_vector_count,
+                                                int64_t* src_used,
+                                                int64_t* dst_used,
+                                                bool is_end_of_data);
+
+
+
+// ----------
+// Stream API
+// ----------
+
+/**
+ * Set up an encoder that hands its output to a sink.
+ *
+ * @param encoder The encoder to set up.
+ * @param sink Where the encoded data goes.
+ * @param sink_context A value to pass to the sink.
+ */
+SAFE64_PUBLIC void safe64_encoder_init(safe64_encoder* encoder,
+                                       safe64_sink sink,
+                                       void* sink_context);
+
+/**
+ * Set up an encoder that hands its output to a sink, starting with a length
+ * field. The caller must then feed exactly length bytes.
+ *
+ * @param encoder The encoder to set up.
+ * @param length The length of the data that will be fed.
+ * @param sink Where the encoded data goes.
+ * @param sink_context A value to pass to the sink.
+ */
+SAFE64_PUBLIC void safe64l_encoder_init(safe64_encoder* encoder,
+                                        int64_t length,
+                                        safe64_sink sink,
+                                        void* sink_context);
+
+/**
+ * Encode the next part of a sequence of binary data.
+ *
+ * Unlike safe64_encode_feed(), all of src_buffer gets used. Any trailing
+ * partial group is kept in the encoder until the next feed, so src_buffer
+ * can be reused as soon as this returns.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_STATUS_OK: The data was encoded.
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_SINK_FAILED: The sink refused some data.
+ *
+ * @param encoder The encoder.
+ * @param src_buffer The next part of the data.
+ * @param src_length Length of the source buffer.
+ * @param is_end_of_data If true, this is the last part of the data.
+ * @return Status code indicating the result of the operation.
+ */
+SAFE64_PUBLIC safe64_status safe64_encoder_feed(safe64_encoder* encoder,
+                                                const uint8_t* src_buffer,
+                                                int64_t src_length,
+                                                bool is_end_of_data);
+
+/**
+ * Set up a decoder that hands its output to a sink.
+ *
+ * @param decoder The decoder to set up.
+ * @param sink Where the decoded data goes.
+ * @param sink_context A value to pass to the sink.
+ */
+SAFE64_PUBLIC void safe64_decoder_init(safe64_decoder* decoder,
+                                       safe64_sink sink,
+                                       void* sink_context);
+
+/**
+ * Set up a decoder that hands its output to a sink, for a sequence that
+ * starts with a length field. Anything after the length's worth of data gets
+ * ignored, as in safe64l_decode().
+ *
+ * @param decoder The decoder to set up.
+ * @param sink Where the decoded data goes.
+ * @param sink_context A value to pass to the sink.
+ */
+SAFE64_PUBLIC void safe64l_decoder_init(safe64_decoder* decoder,
+                                        safe64_sink sink,
+                                        void* sink_context);
+
+/**
+ * Decode the next part of a safe64 sequence.
+ *
+ * Unlike safe64_decode_feed(), all of src_buffer gets used. Any trailing
+ * partial group (and any part of the length field) is kept in the decoder
+ * until the next feed, so src_buffer can be reused as soon as this returns.
+ * After an error, the decoder must be set up again before it can be reused.
+ *
+ * Can return the following status codes:
+ *  * SAFE64_STATUS_OK: The data was decoded.
+ *  * SAFE64_ERROR_INVALID_LENGTH: A length was negative.
+ *  * SAFE64_ERROR_INVALID_SOURCE_DATA: The data was invalid.
+ *  * SAFE64_ERROR_UNTERMINATED_LENGTH_FIELD: The data ended in the length field.
+ *  * SAFE64_ERROR_TRUNCATED_DATA: The data was shorter than its length field.
+ *  * SAFE64_ERROR_SINK_FAILED: The sink refused some data.
+ *
+ * @param decoder The decoder.
+ * @param src_buffer The next part of the safe64 sequence.
+ * @param src_length Length of the source buffer.
+ * @param is_end_of_data If true, this is the last part of the sequence.
+ * @return Status code indicating the result of the operation.
+ */
+SAFE64_PUBLIC safe64_status safe64_decoder_feed(safe64_decoder* decoder,
+                                                const uint8_t* src_buffer,
+                                                int64_t src_length,
+                                                bool is_end_of_data);
+
 
 #ifdef __cplusplus 
 }
@@ -0,0 +1,133 @@
+#include "kernels.h"
+
+#if SAFE64_HAS_X86_KERNELS
+
+#include <immintrin.h>
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+// Encoding: Each 128-bit lane receives 12 source bytes, which are shuffled so
+// that every 32-bit lane holds one 3-byte group. The four 6-bit fields are
+// then moved into separate bytes with multiplies, and mapped onto the safe64
+// alphabet by adding an offset that depends on which range the chunk is in.
+
+TARGET_AVX2 static inline __m256i encode_24_bytes(const uint8_t* const src)
+{
+    // Reads 28 bytes
+    const __m256i input = _mm256_loadu2_m128i((const __m128i*)(src + 12), (const __m128i*)src);
+    const __m256i groups = _mm256_shuffle_epi8(input, _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+    const __m256i chunks_0_2 = _mm256_mulhi_epu16(_mm256_and_si256(groups, _mm256_set1_epi32(0x0fc0fc00)),
+                                                  _mm256_set1_epi32(0x04000040));
+    const __m256i chunks_1_3 = _mm256_mullo_epi16(_mm256_and_si256(groups, _mm256_set1_epi32(0x003f03f0)),
+                                                  _mm256_set1_epi32(0x01000010));
+    const __m256i chunks = _mm256_or_si256(chunks_0_2, chunks_1_3);
+
+    // '-' = 0 + 45, '0' = 1 + 47, 'A' = 11 + 54, '_' = 37 + 58, 'a' = 38 + 59
+    __m256i offsets = _mm256_set1_epi8(45);
+    offsets = _mm256_add_epi8(offsets, _mm256_and_si256(_mm256_cmpgt_epi8(chunks, _mm256_set1_epi8(0)),
+                                                        _mm256_set1_epi8(2)));
+    offsets = _mm256_add_epi8(offsets, _mm256_and_si256(_mm256_cmpgt_epi8(chunks, _mm256_set1_epi8(10)),
+                                                        _mm256_set1_epi8(7)));
+    offsets = _mm256_add_epi8(offsets, _mm256_and_si256(_mm256_cmpgt_epi8(chunks, _mm256_set1_epi8(36)),
+                                                        _mm256_set1_epi8(4)));
+    offsets = _mm256_add_epi8(offsets, _mm256_and_si256(_mm256_cmpgt_epi8(chunks, _mm256_set1_epi8(37)),
+                                                        _mm256_set1_epi8(1)));
+    return _mm256_add_epi8(chunks, offsets);
+}
+
+TARGET_AVX2 int64_t safe64_avx2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 3 bytes and 4 chars per group. Each step reads 28 bytes, so keep an
+    // extra 2 groups of input in reserve.
+    const int64_t groups_per_step = 8;
+    const int64_t groups_overread = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step + groups_overread <= group_count; offset += groups_per_step)
+    {
+        _mm256_storeu_si256((__m256i*)(dst + offset * 4), encode_24_bytes(src + offset * 3));
+    }
+    return offset;
+}
+
+// Decoding: The safe64 alphabet is made of five contiguous ranges
+// ('-', '0'-'9', 'A'-'Z', '_', 'a'-'z'), so each character is classified by
+// range and translated with that range's offset. Anything else (including
+// whitespace) aborts the block so that the scalar code can deal with it.
+
+TARGET_AVX2 static inline __m256i is_in_range(const __m256i values, const char lo, const char hi)
+{
+    const __m256i offset_values = _mm256_sub_epi8(values, _mm256_set1_epi8(lo));
+    const __m256i limit = _mm256_set1_epi8((char)(hi - lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(offset_values, limit), offset_values);
+}
+
+TARGET_AVX2 static inline __m256i translate_range(const __m256i chars,
+                                                   const __m256i is_in_range,
+                                                   const char first_char,
+                                                   const char first_chunk)
+{
+    return _mm256_and_si256(is_in_range, _mm256_sub_epi8(chars, _mm256_set1_epi8((char)(first_char - first_chunk))));
+}
+
+TARGET_AVX2 static inline bool decode_32_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const __m256i chars = _mm256_loadu_si256((const __m256i*)src);
+
+    const __m256i is_dash       = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('-'));
+    const __m256i is_digit      = is_in_range(chars, '0', '9');
+    const __m256i is_upper      = is_in_range(chars, 'A', 'Z');
+    const __m256i is_underscore = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_'));
+    const __m256i is_lower      = is_in_range(chars, 'a', 'z');
+
+    const __m256i is_valid = _mm256_or_si256(_mm256_or_si256(is_dash, is_digit),
+                                             _mm256_or_si256(_mm256_or_si256(is_upper, is_underscore), is_lower));
+    if((uint32_t)_mm256_movemask_epi8(is_valid) != 0xffffffff)
+    {
+        return false;
+    }
+
+    // is_dash contributes nothing, which leaves its chunks at 0.
+    __m256i chunks = translate_range(chars, is_digit, '0', 1);
+    chunks = _mm256_or_si256(chunks, translate_range(chars, is_upper, 'A', 11));
+    chunks = _mm256_or_si256(chunks, translate_range(chars, is_underscore, '_', 37));
+    chunks = _mm256_or_si256(chunks, translate_range(chars, is_lower, 'a', 38));
+
+    // Merge 4 x 6-bit chunks into a 24-bit value in each 32-bit lane:
+    // (c0 << 6 | c1) and (c2 << 6 | c3), then (hi << 12 | lo).
+    const __m256i pairs = _mm256_maddubs_epi16(chunks, _mm256_set1_epi32(0x01400140));
+    const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+
+    // Put each group's 3 bytes in big endian order at the front of its
+    // 128-bit lane, then close the gap between the lanes.
+    const __m256i lane_bytes = _mm256_shuffle_epi8(groups, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    const __m256i bytes = _mm256_permutevar8x32_epi32(lane_bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(bytes));
+    _mm_storel_epi64((__m128i*)(dst + 16), _mm256_extracti128_si256(bytes, 1));
+    return true;
+}
+
+TARGET_AVX2 int64_t safe64_avx2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 4 chars and 3 bytes per group
+    const int64_t groups_per_step = 8;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_32_chars(src + offset * 4, dst + offset * 3))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE64_HAS_X86_KERNELS
@@ -0,0 +1,126 @@
+#include "kernels.h"
+
+#if SAFE64_HAS_BMI2_KERNELS
+
+#include <immintrin.h>
+#include <string.h>
+
+#define TARGET_BMI2 __attribute__((target("bmi2")))
+
+// These kernels work in general purpose registers, two groups (48 bits) at a
+// time. pdep spreads the bits out so that every 6-bit chunk gets a byte of its
+// own, and pext packs them back together again. The remaining per-byte work
+// is done on all 8 bytes of the register at once.
+
+static const uint64_t g_chunk_mask = 0x3f3f3f3f3f3f3f3full;
+static const uint64_t g_byte_ones  = 0x0101010101010101ull;
+static const uint64_t g_byte_highs = 0x8080808080808080ull;
+
+static inline uint64_t load_uint64_big_endian(const uint8_t* const src)
+{
+    uint64_t value;
+    memcpy(&value, src, sizeof(value));
+    return __builtin_bswap64(value);
+}
+
+// Adds amount to every byte of chars whose chunk is greater than threshold.
+// Chunks are below 0x40, so adding (0x7f - threshold) sets the high bit of
+// exactly those bytes without carrying into the next one.
+static inline uint64_t add_if_greater(const uint64_t chars, const uint64_t chunks, const int threshold, const int amount)
+{
+    const uint64_t is_greater = ((chunks + g_byte_ones * (0x7f - threshold)) >> 7) & g_byte_ones;
+    return chars + is_greater * amount;
+}
+
+TARGET_BMI2 static inline void encode_6_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    // Reads 8 bytes. The first chunk ends up in the lowest byte.
+    const uint64_t groups = load_uint64_big_endian(src) >> 16;
+    const uint64_t chunks = __builtin_bswap64(_pdep_u64(groups, g_chunk_mask));
+
+    // '-' = 0 + 45, '0' = 1 + 47, 'A' = 11 + 54, '_' = 37 + 58, 'a' = 38 + 59
+    uint64_t chars = chunks + g_byte_ones * 45;
+    chars = add_if_greater(chars, chunks, 0, 2);
+    chars = add_if_greater(chars, chunks, 10, 7);
+    chars = add_if_greater(chars, chunks, 36, 4);
+    chars = add_if_greater(chars, chunks, 37, 1);
+    memcpy(dst, &chars, sizeof(chars));
+}
+
+TARGET_BMI2 int64_t safe64_bmi2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 3 bytes and 4 chars per group. Each step reads 8 bytes, so keep an
+    // extra group of input in reserve.
+    const int64_t groups_per_step = 2;
+    const int64_t groups_overread = 1;
+    int64_t offset = 0;
+    for(; offset + groups_per_step + groups_overread <= group_count; offset += groups_per_step)
+    {
+        encode_6_bytes(src + offset * 3, dst + offset * 4);
+    }
+    return offset;
+}
+
+#define ERRR 0xff
+#define WHSP 0xfe
+// g_encode_char_to_chunk from library.c, for the characters 0x00 - 0x7f.
+static const uint8_t g_char_to_chunk[128] =
+{
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, WHSP, WHSP, ERRR, ERRR, WHSP, ERRR, ERRR,
+    ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+    WHSP, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR, 0x00, ERRR, ERRR,
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, ERRR, ERRR, ERRR, ERRR, ERRR, ERRR,
+    ERRR, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+    0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, ERRR, ERRR, ERRR, ERRR, 0x25,
+    ERRR, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, ERRR, ERRR, ERRR, ERRR, ERRR,
+};
+#undef WHSP
+#undef ERRR
+
+TARGET_BMI2 static inline bool decode_8_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    uint64_t chars;
+    memcpy(&chars, src, sizeof(chars));
+    if((chars & g_byte_highs) != 0)
+    {
+        return false;
+    }
+
+    // The first chunk ends up in the highest byte. Whitespace and invalid
+    // characters both have their high bit set.
+    uint64_t chunks = 0;
+    for(int i = 0; i < 8; i++)
+    {
+        chunks = (chunks << 8) | g_char_to_chunk[src[i]];
+    }
+    if((chunks & g_byte_highs) != 0)
+    {
+        return false;
+    }
+
+    const uint64_t bytes = __builtin_bswap64(_pext_u64(chunks, g_chunk_mask) << 16);
+    memcpy(dst, &bytes, 6);
+    return true;
+}
+
+TARGET_BMI2 int64_t safe64_bmi2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 4 chars and 3 bytes per group
+    const int64_t groups_per_step = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_8_chars(src + offset * 4, dst + offset * 3))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE64_HAS_BMI2_KERNELS
@@ -0,0 +1,148 @@
+#include "kernels.h"
+
+#if SAFE64_HAS_GENERIC_KERNELS
+
+#include <string.h>
+
+// These are the same algorithms as in kernels_sse41.c, written with the
+// compiler's vector extensions rather than intrinsics so that they build for
+// any target. The compiler lowers them to whatever the build's -march allows.
+// 16-byte vectors are native wherever there is SIMD at all (SSE2, NEON, ...),
+// and unlike wider ones they don't change the calling convention.
+
+typedef uint8_t  u8x16  __attribute__((vector_size(16)));
+typedef uint16_t u16x8  __attribute__((vector_size(16)));
+typedef uint32_t u32x4  __attribute__((vector_size(16)));
+typedef uint64_t u64x2  __attribute__((vector_size(16)));
+
+static inline u8x16 load_u8x16(const uint8_t* const src)
+{
+    u8x16 value;
+    memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+static inline uint32_t load_uint32_big_endian(const uint8_t* const src)
+{
+    uint32_t value;
+    memcpy(&value, src, sizeof(value));
+    return __builtin_bswap32(value);
+}
+
+// Writes the low 48 bits (two groups).
+static inline void store_two_groups(uint8_t* const dst, const uint64_t groups)
+{
+    const uint64_t value = __builtin_bswap64(groups << 16);
+    memcpy(dst, &value, 6);
+}
+
+// Comparisons give 0 or -1 in each element.
+static inline bool is_all_set(const u8x16 mask)
+{
+    const u64x2 words = (u64x2)mask;
+    return (words[0] & words[1]) == ~(uint64_t)0;
+}
+
+static inline u8x16 is_in_range(const u8x16 values, const uint8_t lo, const uint8_t hi)
+{
+    return (u8x16)((u8x16)(values - lo) <= (uint8_t)(hi - lo));
+}
+
+// Gives amount in every element that is greater than threshold, and 0 in the
+// others.
+static inline u8x16 amount_if_greater(const u8x16 values, const uint8_t threshold, const uint8_t amount)
+{
+    return (u8x16)(values > threshold) & amount;
+}
+
+static inline void encode_12_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    // Reads 13 bytes. Byte shuffles are expensive on some targets, so the
+    // groups are loaded into their lanes one by one.
+    const u32x4 groups = {load_uint32_big_endian(src) >> 8,
+                          load_uint32_big_endian(src + 3) >> 8,
+                          load_uint32_big_endian(src + 6) >> 8,
+                          load_uint32_big_endian(src + 9) >> 8};
+
+    // The first chunk goes in the low byte so that it gets stored first.
+    const u8x16 chunks = (u8x16)((groups >> 18) |
+                                 ((groups >> 4) & 0x3f00) |
+                                 ((groups << 10) & 0x3f0000) |
+                                 ((groups << 24) & 0x3f000000));
+
+    // '-' = 0 + 45, '0' = 1 + 47, 'A' = 11 + 54, '_' = 37 + 58, 'a' = 38 + 59
+    const u8x16 chars = chunks + 45 +
+                        amount_if_greater(chunks, 0, 2) +
+                        amount_if_greater(chunks, 10, 7) +
+                        amount_if_greater(chunks, 36, 4) +
+                        amount_if_greater(chunks, 37, 1);
+    memcpy(dst, &chars, sizeof(chars));
+}
+
+int64_t safe64_generic_encode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 3 bytes and 4 chars per group. Each step reads 13 bytes, so keep an
+    // extra group of input in reserve.
+    const int64_t groups_per_step = 4;
+    const int64_t groups_overread = 1;
+    int64_t offset = 0;
+    for(; offset + groups_per_step + groups_overread <= group_count; offset += groups_per_step)
+    {
+        encode_12_bytes(src + offset * 3, dst + offset * 4);
+    }
+    return offset;
+}
+
+static inline bool decode_16_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const u8x16 chars = load_u8x16(src);
+
+    const u8x16 is_dash       = (u8x16)(chars == '-');
+    const u8x16 is_digit      = is_in_range(chars, '0', '9');
+    const u8x16 is_upper      = is_in_range(chars, 'A', 'Z');
+    const u8x16 is_underscore = (u8x16)(chars == '_');
+    const u8x16 is_lower      = is_in_range(chars, 'a', 'z');
+    if(!is_all_set(is_dash | is_digit | is_upper | is_underscore | is_lower))
+    {
+        return false;
+    }
+
+    // '-' = 0 + 45, '0' = 1 + 47, 'A' = 11 + 54, '_' = 37 + 58, 'a' = 38 + 59
+    const u8x16 offsets = (is_dash & 45) |
+                          (is_digit & 47) |
+                          (is_upper & 54) |
+                          (is_underscore & 58) |
+                          (is_lower & 59);
+    const u8x16 chunks = chars - offsets;
+
+    // Chunks are combined in pairs until each 64-bit lane holds two groups.
+    const u16x8 pairs = (u16x8)chunks;
+    const u32x4 quads = (u32x4)(((pairs & 0x3f) << 6) | (pairs >> 8));
+    const u64x2 groups = (u64x2)(((quads & 0xfff) << 12) | (quads >> 16));
+    const u64x2 group_pairs = ((groups & 0xffffff) << 24) | (groups >> 32);
+
+    store_two_groups(dst, group_pairs[0]);
+    store_two_groups(dst + 6, group_pairs[1]);
+    return true;
+}
+
+int64_t safe64_generic_decode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 4 chars and 3 bytes per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_16_chars(src + offset * 4, dst + offset * 3))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE64_HAS_GENERIC_KERNELS
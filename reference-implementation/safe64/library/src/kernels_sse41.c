@@ -0,0 +1,228 @@
+#include "kernels.h"
+
+#if SAFE64_HAS_X86_KERNELS
+
+#include <smmintrin.h>
+#include <string.h>
+
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+
+// These are the same algorithms as in kernels_avx2.c, on 128-bit registers.
+
+TARGET_SSE41 static inline __m128i encode_12_bytes(const uint8_t* const src)
+{
+    // Reads 16 bytes
+    const __m128i groups = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), _mm_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+    const __m128i chunks_0_2 = _mm_mulhi_epu16(_mm_and_si128(groups, _mm_set1_epi32(0x0fc0fc00)),
+                                               _mm_set1_epi32(0x04000040));
+    const __m128i chunks_1_3 = _mm_mullo_epi16(_mm_and_si128(groups, _mm_set1_epi32(0x003f03f0)),
+                                               _mm_set1_epi32(0x01000010));
+    const __m128i chunks = _mm_or_si128(chunks_0_2, chunks_1_3);
+
+    // '-' = 0 + 45, '0' = 1 + 47, 'A' = 11 + 54, '_' = 37 + 58, 'a' = 38 + 59
+    __m128i offsets = _mm_set1_epi8(45);
+    offsets = _mm_add_epi8(offsets, _mm_and_si128(_mm_cmpgt_epi8(chunks, _mm_set1_epi8(0)),
+                                                  _mm_set1_epi8(2)));
+    offsets = _mm_add_epi8(offsets, _mm_and_si128(_mm_cmpgt_epi8(chunks, _mm_set1_epi8(10)),
+                                                  _mm_set1_epi8(7)));
+    offsets = _mm_add_epi8(offsets, _mm_and_si128(_mm_cmpgt_epi8(chunks, _mm_set1_epi8(36)),
+                                                  _mm_set1_epi8(4)));
+    offsets = _mm_add_epi8(offsets, _mm_and_si128(_mm_cmpgt_epi8(chunks, _mm_set1_epi8(37)),
+                                                  _mm_set1_epi8(1)));
+    return _mm_add_epi8(chunks, offsets);
+}
+
+TARGET_SSE41 int64_t safe64_sse41_encode_groups(const uint8_t* const src,
+                                                uint8_t* const dst,
+                                                const int64_t group_count)
+{
+    // 3 bytes and 4 chars per group. Each step reads 16 bytes, so keep an
+    // extra 2 groups of input in reserve.
+    const int64_t groups_per_step = 4;
+    const int64_t groups_overread = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step + groups_overread <= group_count; offset += groups_per_step)
+    {
+        _mm_storeu_si128((__m128i*)(dst + offset * 4), encode_12_bytes(src + offset * 3));
+    }
+    return offset;
+}
+
+TARGET_SSE41 static inline __m128i is_in_range(const __m128i values, const char lo, const char hi)
+{
+    const __m128i offset_values = _mm_sub_epi8(values, _mm_set1_epi8(lo));
+    const __m128i limit = _mm_set1_epi8((char)(hi - lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset_values, limit), offset_values);
+}
+
+TARGET_SSE41 static inline __m128i translate_range(const __m128i chars,
+                                                    const __m128i is_in_range,
+                                                    const char first_char,
+                                                    const char first_chunk)
+{
+    return _mm_and_si128(is_in_range, _mm_sub_epi8(chars, _mm_set1_epi8((char)(first_char - first_chunk))));
+}
+
+TARGET_SSE41 static inline bool decode_16_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const __m128i chars = _mm_loadu_si128((const __m128i*)src);
+
+    const __m128i is_dash       = _mm_cmpeq_epi8(chars, _mm_set1_epi8('-'));
+    const __m128i is_digit      = is_in_range(chars, '0', '9');
+    const __m128i is_upper      = is_in_range(chars, 'A', 'Z');
+    const __m128i is_underscore = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+    const __m128i is_lower      = is_in_range(chars, 'a', 'z');
+
+    const __m128i is_valid = _mm_or_si128(_mm_or_si128(is_dash, is_digit),
+                                          _mm_or_si128(_mm_or_si128(is_upper, is_underscore), is_lower));
+    if(_mm_movemask_epi8(is_valid) != 0xffff)
+    {
+        return false;
+    }
+
+    // is_dash contributes nothing, which leaves its chunks at 0.
+    __m128i chunks = translate_range(chars, is_digit, '0', 1);
+    chunks = _mm_or_si128(chunks, translate_range(chars, is_upper, 'A', 11));
+    chunks = _mm_or_si128(chunks, translate_range(chars, is_underscore, '_', 37));
+    chunks = _mm_or_si128(chunks, translate_range(chars, is_lower, 'a', 38));
+
+    const __m128i pairs = _mm_maddubs_epi16(chunks, _mm_set1_epi32(0x01400140));
+    const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+    const __m128i bytes = _mm_shuffle_epi8(groups, _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storel_epi64((__m128i*)dst, bytes);
+    const uint32_t last_bytes = (uint32_t)_mm_extract_epi32(bytes, 2);
+    memcpy(dst + 8, &last_bytes, sizeof(last_bytes));
+    return true;
+}
+
+TARGET_SSE41 int64_t safe64_sse41_decode_groups(const uint8_t* const src,
+                                                uint8_t* const dst,
+                                                const int64_t group_count)
+{
+    // 4 chars and 3 bytes per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_16_chars(src + offset * 4, dst + offset * 3))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+// Entry n holds the indices of the set bits in n, lowest first, as a pshufb
+// mask. Generated by print_left_pack_shuffle_table() in dev-tools.
+static const uint64_t g_left_pack_shuffles[256] =
+{
+    0x8080808080808080, 0x8080808080808000, 0x8080808080808001, 0x8080808080800100,
+    0x8080808080808002, 0x8080808080800200, 0x8080808080800201, 0x8080808080020100,
+    0x8080808080808003, 0x8080808080800300, 0x8080808080800301, 0x8080808080030100,
+    0x8080808080800302, 0x8080808080030200, 0x8080808080030201, 0x8080808003020100,
+    0x8080808080808004, 0x8080808080800400, 0x8080808080800401, 0x8080808080040100,
+    0x8080808080800402, 0x8080808080040200, 0x8080808080040201, 0x8080808004020100,
+    0x8080808080800403, 0x8080808080040300, 0x8080808080040301, 0x8080808004030100,
+    0x8080808080040302, 0x8080808004030200, 0x8080808004030201, 0x8080800403020100,
+    0x8080808080808005, 0x8080808080800500, 0x8080808080800501, 0x8080808080050100,
+    0x8080808080800502, 0x8080808080050200, 0x8080808080050201, 0x8080808005020100,
+    0x8080808080800503, 0x8080808080050300, 0x8080808080050301, 0x8080808005030100,
+    0x8080808080050302, 0x8080808005030200, 0x8080808005030201, 0x8080800503020100,
+    0x8080808080800504, 0x8080808080050400, 0x8080808080050401, 0x8080808005040100,
+    0x8080808080050402, 0x8080808005040200, 0x8080808005040201, 0x8080800504020100,
+    0x8080808080050403, 0x8080808005040300, 0x8080808005040301, 0x8080800504030100,
+    0x8080808005040302, 0x8080800504030200, 0x8080800504030201, 0x8080050403020100,
+    0x8080808080808006, 0x8080808080800600, 0x8080808080800601, 0x8080808080060100,
+    0x8080808080800602, 0x8080808080060200, 0x8080808080060201, 0x8080808006020100,
+    0x8080808080800603, 0x8080808080060300, 0x8080808080060301, 0x8080808006030100,
+    0x8080808080060302, 0x8080808006030200, 0x8080808006030201, 0x8080800603020100,
+    0x8080808080800604, 0x8080808080060400, 0x8080808080060401, 0x8080808006040100,
+    0x8080808080060402, 0x8080808006040200, 0x8080808006040201, 0x8080800604020100,
+    0x8080808080060403, 0x8080808006040300, 0x8080808006040301, 0x8080800604030100,
+    0x8080808006040302, 0x8080800604030200, 0x8080800604030201, 0x8080060403020100,
+    0x8080808080800605, 0x8080808080060500, 0x8080808080060501, 0x8080808006050100,
+    0x8080808080060502, 0x8080808006050200, 0x8080808006050201, 0x8080800605020100,
+    0x8080808080060503, 0x8080808006050300, 0x8080808006050301, 0x8080800605030100,
+    0x8080808006050302, 0x8080800605030200, 0x8080800605030201, 0x8080060503020100,
+    0x8080808080060504, 0x8080808006050400, 0x8080808006050401, 0x8080800605040100,
+    0x8080808006050402, 0x8080800605040200, 0x8080800605040201, 0x8080060504020100,
+    0x8080808006050403, 0x8080800605040300, 0x8080800605040301, 0x8080060504030100,
+    0x8080800605040302, 0x8080060504030200, 0x8080060504030201, 0x8006050403020100,
+    0x8080808080808007, 0x8080808080800700, 0x8080808080800701, 0x8080808080070100,
+    0x8080808080800702, 0x8080808080070200, 0x8080808080070201, 0x8080808007020100,
+    0x8080808080800703, 0x8080808080070300, 0x8080808080070301, 0x8080808007030100,
+    0x8080808080070302, 0x8080808007030200, 0x8080808007030201, 0x8080800703020100,
+    0x8080808080800704, 0x8080808080070400, 0x8080808080070401, 0x8080808007040100,
+    0x8080808080070402, 0x8080808007040200, 0x8080808007040201, 0x8080800704020100,
+    0x8080808080070403, 0x8080808007040300, 0x8080808007040301, 0x8080800704030100,
+    0x8080808007040302, 0x8080800704030200, 0x8080800704030201, 0x8080070403020100,
+    0x8080808080800705, 0x8080808080070500, 0x8080808080070501, 0x8080808007050100,
+    0x8080808080070502, 0x8080808007050200, 0x8080808007050201, 0x8080800705020100,
+    0x8080808080070503, 0x8080808007050300, 0x8080808007050301, 0x8080800705030100,
+    0x8080808007050302, 0x8080800705030200, 0x8080800705030201, 0x8080070503020100,
+    0x8080808080070504, 0x8080808007050400, 0x8080808007050401, 0x8080800705040100,
+    0x8080808007050402, 0x8080800705040200, 0x8080800705040201, 0x8080070504020100,
+    0x8080808007050403, 0x8080800705040300, 0x8080800705040301, 0x8080070504030100,
+    0x8080800705040302, 0x8080070504030200, 0x8080070504030201, 0x8007050403020100,
+    0x8080808080800706, 0x8080808080070600, 0x8080808080070601, 0x8080808007060100,
+    0x8080808080070602, 0x8080808007060200, 0x8080808007060201, 0x8080800706020100,
+    0x8080808080070603, 0x8080808007060300, 0x8080808007060301, 0x8080800706030100,
+    0x8080808007060302, 0x8080800706030200, 0x8080800706030201, 0x8080070603020100,
+    0x8080808080070604, 0x8080808007060400, 0x8080808007060401, 0x8080800706040100,
+    0x8080808007060402, 0x8080800706040200, 0x8080800706040201, 0x8080070604020100,
+    0x8080808007060403, 0x8080800706040300, 0x8080800706040301, 0x8080070604030100,
+    0x8080800706040302, 0x8080070604030200, 0x8080070604030201, 0x8007060403020100,
+    0x8080808080070605, 0x8080808007060500, 0x8080808007060501, 0x8080800706050100,
+    0x8080808007060502, 0x8080800706050200, 0x8080800706050201, 0x8080070605020100,
+    0x8080808007060503, 0x8080800706050300, 0x8080800706050301, 0x8080070605030100,
+    0x8080800706050302, 0x8080070605030200, 0x8080070605030201, 0x8007060503020100,
+    0x8080808007060504, 0x8080800706050400, 0x8080800706050401, 0x8080070605040100,
+    0x8080800706050402, 0x8080070605040200, 0x8080070605040201, 0x8007060504020100,
+    0x8080800706050403, 0x8080070605040300, 0x8080070605040301, 0x8007060504030100,
+    0x8080070605040302, 0x8007060504030200, 0x8007060504030201, 0x0706050403020100,
+};
+
+// Whitespace is everything that the decoder skips: tab, LF, CR and space.
+TARGET_SSE41 static inline __m128i is_whitespace(const __m128i chars)
+{
+    const __m128i is_space_or_tab = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+                                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')));
+    const __m128i is_line_break = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')),
+                                               _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+    return _mm_or_si128(is_space_or_tab, is_line_break);
+}
+
+// AVX2 has no cross-lane byte shuffle, so this is shared with the avx2 kernel.
+TARGET_SSE41 int64_t safe64_sse41_compact_blocks(const uint8_t* const src,
+                                                 uint8_t* const dst,
+                                                 const int64_t block_count)
+{
+    // 16 chars per block. Each block is read before anything is written over
+    // it, so src and dst may be the same.
+    const __m128i high_half_offsets = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8);
+    uint8_t* next = dst;
+    for(int64_t offset = 0; offset < block_count * 16; offset += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(src + offset));
+        const int keep = ~_mm_movemask_epi8(is_whitespace(chars)) & 0xffff;
+        if(keep == 0xffff)
+        {
+            _mm_storeu_si128((__m128i*)next, chars);
+            next += 16;
+            continue;
+        }
+        const __m128i shuffle = _mm_set_epi64x((long long)g_left_pack_shuffles[keep >> 8],
+                                               (long long)g_left_pack_shuffles[keep & 0xff]);
+        const __m128i packed = _mm_shuffle_epi8(chars, _mm_add_epi8(shuffle, high_half_offsets));
+        _mm_storel_epi64((__m128i*)next, packed);
+        _mm_storel_epi64((__m128i*)(next + __builtin_popcount(keep & 0xff)), _mm_unpackhi_epi64(packed, packed));
+        next += __builtin_popcount(keep);
+    }
+    return next - dst;
+}
+
+#endif // SAFE64_HAS_X86_KERNELS
@@ -1,8 +1,15 @@
 #include <safe64/safe64.h>
 
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
 // #define KSLogger_LocalLevel DEBUG
 #include "kslogger.h"
 
+#include "kernels.h"
+#include "thread_pool.h"
+
 #define QUOTE(str) #str
 #define EXPAND_AND_QUOTE(str) QUOTE(str)
 
@@ -67,6 +74,1178 @@ static const uint8_t g_chunk_to_encode_char[] =
     's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
 };
 
+static const char g_chunk_pair_to_encode_chars[] =
+    "---0-1-2-3-4-5-6-7-8-9-A-B-C-D-E-F-G-H-I-J-K-L-M-N-O-P-Q-R-S-T-U"
+    "-V-W-X-Y-Z-_-a-b-c-d-e-f-g-h-i-j-k-l-m-n-o-p-q-r-s-t-u-v-w-x-y-z"
+    "0-000102030405060708090A0B0C0D0E0F0G0H0I0J0K0L0M0N0O0P0Q0R0S0T0U"
+    "0V0W0X0Y0Z0_0a0b0c0d0e0f0g0h0i0j0k0l0m0n0o0p0q0r0s0t0u0v0w0x0y0z"
+    "1-101112131415161718191A1B1C1D1E1F1G1H1I1J1K1L1M1N1O1P1Q1R1S1T1U"
+    "1V1W1X1Y1Z1_1a1b1c1d1e1f1g1h1i1j1k1l1m1n1o1p1q1r1s1t1u1v1w1x1y1z"
+    "2-202122232425262728292A2B2C2D2E2F2G2H2I2J2K2L2M2N2O2P2Q2R2S2T2U"
+    "2V2W2X2Y2Z2_2a2b2c2d2e2f2g2h2i2j2k2l2m2n2o2p2q2r2s2t2u2v2w2x2y2z"
+    "3-303132333435363738393A3B3C3D3E3F3G3H3I3J3K3L3M3N3O3P3Q3R3S3T3U"
+    "3V3W3X3Y3Z3_3a3b3c3d3e3f3g3h3i3j3k3l3m3n3o3p3q3r3s3t3u3v3w3x3y3z"
+    "4-404142434445464748494A4B4C4D4E4F4G4H4I4J4K4L4M4N4O4P4Q4R4S4T4U"
+    "4V4W4X4Y4Z4_4a4b4c4d4e4f4g4h4i4j4k4l4m4n4o4p4q4r4s4t4u4v4w4x4y4z"
+    "5-505152535455565758595A5B5C5D5E5F5G5H5I5J5K5L5M5N5O5P5Q5R5S5T5U"
+    "5V5W5X5Y5Z5_5a5b5c5d5e5f5g5h5i5j5k5l5m5n5o5p5q5r5s5t5u5v5w5x5y5z"
+    "6-606162636465666768696A6B6C6D6E6F6G6H6I6J6K6L6M6N6O6P6Q6R6S6T6U"
+    "6V6W6X6Y6Z6_6a6b6c6d6e6f6g6h6i6j6k6l6m6n6o6p6q6r6s6t6u6v6w6x6y6z"
+    "7-707172737475767778797A7B7C7D7E7F7G7H7I7J7K7L7M7N7O7P7Q7R7S7T7U"
+    "7V7W7X7Y7Z7_7a7b7c7d7e7f7g7h7i7j7k7l7m7n7o7p7q7r7s7t7u7v7w7x7y7z"
+    "8-808182838485868788898A8B8C8D8E8F8G8H8I8J8K8L8M8N8O8P8Q8R8S8T8U"
+    "8V8W8X8Y8Z8_8a8b8c8d8e8f8g8h8i8j8k8l8m8n8o8p8q8r8s8t8u8v8w8x8y8z"
+    "9-909192939495969798999A9B9C9D9E9F9G9H9I9J9K9L9M9N9O9P9Q9R9S9T9U"
+    "9V9W9X9Y9Z9_9a9b9c9d9e9f9g9h9i9j9k9l9m9n9o9p9q9r9s9t9u9v9w9x9y9z"
+    "A-A0A1A2A3A4A5A6A7A8A9AAABACADAEAFAGAHAIAJAKALAMANAOAPAQARASATAU"
+    "AVAWAXAYAZA_AaAbAcAdAeAfAgAhAiAjAkAlAmAnAoApAqArAsAtAuAvAwAxAyAz"
+    "B-B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBFBGBHBIBJBKBLBMBNBOBPBQBRBSBTBU"
+    "BVBWBXBYBZB_BaBbBcBdBeBfBgBhBiBjBkBlBmBnBoBpBqBrBsBtBuBvBwBxByBz"
+    "C-C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFCGCHCICJCKCLCMCNCOCPCQCRCSCTCU"
+    "CVCWCXCYCZC_CaCbCcCdCeCfCgChCiCjCkClCmCnCoCpCqCrCsCtCuCvCwCxCyCz"
+    "D-D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDFDGDHDIDJDKDLDMDNDODPDQDRDSDTDU"
+    "DVDWDXDYDZD_DaDbDcDdDeDfDgDhDiDjDkDlDmDnDoDpDqDrDsDtDuDvDwDxDyDz"
+    "E-E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFEGEHEIEJEKELEMENEOEPEQERESETEU"
+    "EVEWEXEYEZE_EaEbEcEdEeEfEgEhEiEjEkElEmEnEoEpEqErEsEtEuEvEwExEyEz"
+    "F-F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFFFGFHFIFJFKFLFMFNFOFPFQFRFSFTFU"
+    "FVFWFXFYFZF_FaFbFcFdFeFfFgFhFiFjFkFlFmFnFoFpFqFrFsFtFuFvFwFxFyFz"
+    "G-G0G1G2G3G4G5G6G7G8G9GAGBGCGDGEGFGGGHGIGJGKGLGMGNGOGPGQGRGSGTGU"
+    "GVGWGXGYGZG_GaGbGcGdGeGfGgGhGiGjGkGlGmGnGoGpGqGrGsGtGuGvGwGxGyGz"
+    "H-H0H1H2H3H4H5H6H7H8H9HAHBHCHDHEHFHGHHHIHJHKHLHMHNHOHPHQHRHSHTHU"
+    "HVHWHXHYHZH_HaHbHcHdHeHfHgHhHiHjHkHlHmHnHoHpHqHrHsHtHuHvHwHxHyHz"
+    "I-I0I1I2I3I4I5I6I7I8I9IAIBICIDIEIFIGIHIIIJIKILIMINIOIPIQIRISITIU"
+    "IVIWIXIYIZI_IaIbIcIdIeIfIgIhIiIjIkIlImInIoIpIqIrIsItIuIvIwIxIyIz"
+    "J-J0J1J2J3J4J5J6J7J8J9JAJBJCJDJEJFJGJHJIJJJKJLJMJNJOJPJQJRJSJTJU"
+    "JVJWJXJYJZJ_JaJbJcJdJeJfJgJhJiJjJkJlJmJnJoJpJqJrJsJtJuJvJwJxJyJz"
+    "K-K0K1K2K3K4K5K6K7K8K9KAKBKCKDKEKFKGKHKIKJKKKLKMKNKOKPKQKRKSKTKU"
+    "KVKWKXKYKZK_KaKbKcKdKeKfKgKhKiKjKkKlKmKnKoKpKqKrKsKtKuKvKwKxKyKz"
+    "L-L0L1L2L3L4L5L6L7L8L9LALBLCLDLELFLGLHLILJLKLLLMLNLOLPLQLRLSLTLU"
+    "LVLWLXLYLZL_LaLbLcLdLeLfLgLhLiLjLkLlLmLnLoLpLqLrLsLtLuLvLwLxLyLz"
+    "M-M0M1M2M3M4M5M6M7M8M9MAMBMCMDMEMFMGMHMIMJMKMLMMMNMOMPMQMRMSMTMU"
+    "MVMWMXMYMZM_MaMbMcMdMeMfMgMhMiMjMkMlMmMnMoMpMqMrMsMtMuMvMwMxMyMz"
+    "N-N0N1N2N3N4N5N6N7N8N9NANBNCNDNENFNGNHNINJNKNLNMNNNONPNQNRNSNTNU"
+    "NVNWNXNYNZN_NaNbNcNdNeNfNgNhNiNjNkNlNmNnNoNpNqNrNsNtNuNvNwNxNyNz"
+    "O-O0O1O2O3O4O5O6O7O8O9OAOBOCODOEOFOGOHOIOJOKOLOMONOOOPOQOROSOTOU"
+    "OVOWOXOYOZO_OaObOcOdOeOfOgOhOiOjOkOlOmOnOoOpOqOrOsOtOuOvOwOxOyOz"
+    "P-P0P1P2P3P4P5P6P7P8P9PAPBPCPDPEPFPGPHPIPJPKPLPMPNPOPPPQPRPSPTPU"
+    "PVPWPXPYPZP_PaPbPcPdPePfPgPhPiPjPkPlPmPnPoPpPqPrPsPtPuPvPwPxPyPz"
+    "Q-Q0Q1Q2Q3Q4Q5Q6Q7Q8Q9QAQBQCQDQEQFQGQHQIQJQKQLQMQNQOQPQQQRQSQTQU"
+    "QVQWQXQYQZQ_QaQbQcQdQeQfQgQhQiQjQkQlQmQnQoQpQqQrQsQtQuQvQwQxQyQz"
+    "R-R0R1R2R3R4R5R6R7R8R9RARBRCRDRERFRGRHRIRJRKRLRMRNRORPRQRRRSRTRU"
+    "RVRWRXRYRZR_RaRbRcRdReRfRgRhRiRjRkRlRmRnRoRpRqRrRsRtRuRvRwRxRyRz"
+    "S-S0S1S2S3S4S5S6S7S8S9SASBSCSDSESFSGSHSISJSKSLSMSNSOSPSQSRSSSTSU"
+    "SVSWSXSYSZS_SaSbScSdSeSfSgShSiSjSkSlSmSnSoSpSqSrSsStSuSvSwSxSySz"
+    "T-T0T1T2T3T4T5T6T7T8T9TATBTCTDTETFTGTHTITJTKTLTMTNTOTPTQTRTSTTTU"
+    "TVTWTXTYTZT_TaTbTcTdTeTfTgThTiTjTkTlTmTnToTpTqTrTsTtTuTvTwTxTyTz"
+    "U-U0U1U2U3U4U5U6U7U8U9UAUBUCUDUEUFUGUHUIUJUKULUMUNUOUPUQURUSUTUU"
+    "UVUWUXUYUZU_UaUbUcUdUeUfUgUhUiUjUkUlUmUnUoUpUqUrUsUtUuUvUwUxUyUz"
+    "V-V0V1V2V3V4V5V6V7V8V9VAVBVCVDVEVFVGVHVIVJVKVLVMVNVOVPVQVRVSVTVU"
+    "VVVWVXVYVZV_VaVbVcVdVeVfVgVhViVjVkVlVmVnVoVpVqVrVsVtVuVvVwVxVyVz"
+    "W-W0W1W2W3W4W5W6W7W8W9WAWBWCWDWEWFWGWHWIWJWKWLWMWNWOWPWQWRWSWTWU"
+    "WVWWWXWYWZW_WaWbWcWdWeWfWgWhWiWjWkWlWmWnWoWpWqWrWsWtWuWvWwWxWyWz"
+    "X-X0X1X2X3X4X5X6X7X8X9XAXBXCXDXEXFXGXHXIXJXKXLXMXNXOXPXQXRXSXTXU"
+    "XVXWXXXYXZX_XaXbXcXdXeXfXgXhXiXjXkXlXmXnXoXpXqXrXsXtXuXvXwXxXyXz"
+    "Y-Y0Y1Y2Y3Y4Y5Y6Y7Y8Y9YAYBYCYDYEYFYGYHYIYJYKYLYMYNYOYPYQYRYSYTYU"
+    "YVYWYXYYYZY_YaYbYcYdYeYfYgYhYiYjYkYlYmYnYoYpYqYrYsYtYuYvYwYxYyYz"
+    "Z-Z0Z1Z2Z3Z4Z5Z6Z7Z8Z9ZAZBZCZDZEZFZGZHZIZJZKZLZMZNZOZPZQZRZSZTZU"
+    "ZVZWZXZYZZZ_ZaZbZcZdZeZfZgZhZiZjZkZlZmZnZoZpZqZrZsZtZuZvZwZxZyZz"
+    "_-_0_1_2_3_4_5_6_7_8_9_A_B_C_D_E_F_G_H_I_J_K_L_M_N_O_P_Q_R_S_T_U"
+    "_V_W_X_Y_Z___a_b_c_d_e_f_g_h_i_j_k_l_m_n_o_p_q_r_s_t_u_v_w_x_y_z"
+    "a-a0a1a2a3a4a5a6a7a8a9aAaBaCaDaEaFaGaHaIaJaKaLaMaNaOaPaQaRaSaTaU"
+    "aVaWaXaYaZa_aaabacadaeafagahaiajakalamanaoapaqarasatauavawaxayaz"
+    "b-b0b1b2b3b4b5b6b7b8b9bAbBbCbDbEbFbGbHbIbJbKbLbMbNbObPbQbRbSbTbU"
+    "bVbWbXbYbZb_babbbcbdbebfbgbhbibjbkblbmbnbobpbqbrbsbtbubvbwbxbybz"
+    "c-c0c1c2c3c4c5c6c7c8c9cAcBcCcDcEcFcGcHcIcJcKcLcMcNcOcPcQcRcScTcU"
+    "cVcWcXcYcZc_cacbcccdcecfcgchcicjckclcmcncocpcqcrcsctcucvcwcxcycz"
+    "d-d0d1d2d3d4d5d6d7d8d9dAdBdCdDdEdFdGdHdIdJdKdLdMdNdOdPdQdRdSdTdU"
+    "dVdWdXdYdZd_dadbdcdddedfdgdhdidjdkdldmdndodpdqdrdsdtdudvdwdxdydz"
+    "e-e0e1e2e3e4e5e6e7e8e9eAeBeCeDeEeFeGeHeIeJeKeLeMeNeOePeQeReSeTeU"
+    "eVeWeXeYeZe_eaebecedeeefegeheiejekelemeneoepeqereseteuevewexeyez"
+    "f-f0f1f2f3f4f5f6f7f8f9fAfBfCfDfEfFfGfHfIfJfKfLfMfNfOfPfQfRfSfTfU"
+    "fVfWfXfYfZf_fafbfcfdfefffgfhfifjfkflfmfnfofpfqfrfsftfufvfwfxfyfz"
+    "g-g0g1g2g3g4g5g6g7g8g9gAgBgCgDgEgFgGgHgIgJgKgLgMgNgOgPgQgRgSgTgU"
+    "gVgWgXgYgZg_gagbgcgdgegfggghgigjgkglgmgngogpgqgrgsgtgugvgwgxgygz"
+    "h-h0h1h2h3h4h5h6h7h8h9hAhBhChDhEhFhGhHhIhJhKhLhMhNhOhPhQhRhShThU"
+    "hVhWhXhYhZh_hahbhchdhehfhghhhihjhkhlhmhnhohphqhrhshthuhvhwhxhyhz"
+    "i-i0i1i2i3i4i5i6i7i8i9iAiBiCiDiEiFiGiHiIiJiKiLiMiNiOiPiQiRiSiTiU"
+    "iViWiXiYiZi_iaibicidieifigihiiijikiliminioipiqirisitiuiviwixiyiz"
+    "j-j0j1j2j3j4j5j6j7j8j9jAjBjCjDjEjFjGjHjIjJjKjLjMjNjOjPjQjRjSjTjU"
+    "jVjWjXjYjZj_jajbjcjdjejfjgjhjijjjkjljmjnjojpjqjrjsjtjujvjwjxjyjz"
+    "k-k0k1k2k3k4k5k6k7k8k9kAkBkCkDkEkFkGkHkIkJkKkLkMkNkOkPkQkRkSkTkU"
+    "kVkWkXkYkZk_kakbkckdkekfkgkhkikjkkklkmknkokpkqkrksktkukvkwkxkykz"
+    "l-l0l1l2l3l4l5l6l7l8l9lAlBlClDlElFlGlHlIlJlKlLlMlNlOlPlQlRlSlTlU"
+    "lVlWlXlYlZl_lalblcldlelflglhliljlklllmlnlolplqlrlsltlulvlwlxlylz"
+    "m-m0m1m2m3m4m5m6m7m8m9mAmBmCmDmEmFmGmHmImJmKmLmMmNmOmPmQmRmSmTmU"
+    "mVmWmXmYmZm_mambmcmdmemfmgmhmimjmkmlmmmnmompmqmrmsmtmumvmwmxmymz"
+    "n-n0n1n2n3n4n5n6n7n8n9nAnBnCnDnEnFnGnHnInJnKnLnMnNnOnPnQnRnSnTnU"
+    "nVnWnXnYnZn_nanbncndnenfngnhninjnknlnmnnnonpnqnrnsntnunvnwnxnynz"
+    "o-o0o1o2o3o4o5o6o7o8o9oAoBoCoDoEoFoGoHoIoJoKoLoMoNoOoPoQoRoSoToU"
+    "oVoWoXoYoZo_oaobocodoeofogohoiojokolomonooopoqorosotouovowoxoyoz"
+    "p-p0p1p2p3p4p5p6p7p8p9pApBpCpDpEpFpGpHpIpJpKpLpMpNpOpPpQpRpSpTpU"
+    "pVpWpXpYpZp_papbpcpdpepfpgphpipjpkplpmpnpopppqprpsptpupvpwpxpypz"
+    "q-q0q1q2q3q4q5q6q7q8q9qAqBqCqDqEqFqGqHqIqJqKqLqMqNqOqPqQqRqSqTqU"
+    "qVqWqXqYqZq_qaqbqcqdqeqfqgqhqiqjqkqlqmqnqoqpqqqrqsqtquqvqwqxqyqz"
+    "r-r0r1r2r3r4r5r6r7r8r9rArBrCrDrErFrGrHrIrJrKrLrMrNrOrPrQrRrSrTrU"
+    "rVrWrXrYrZr_rarbrcrdrerfrgrhrirjrkrlrmrnrorprqrrrsrtrurvrwrxryrz"
+    "s-s0s1s2s3s4s5s6s7s8s9sAsBsCsDsEsFsGsHsIsJsKsLsMsNsOsPsQsRsSsTsU"
+    "sVsWsXsYsZs_sasbscsdsesfsgshsisjskslsmsnsospsqsrssstsusvswsxsysz"
+    "t-t0t1t2t3t4t5t6t7t8t9tAtBtCtDtEtFtGtHtItJtKtLtMtNtOtPtQtRtStTtU"
+    "tVtWtXtYtZt_tatbtctdtetftgthtitjtktltmtntotptqtrtstttutvtwtxtytz"
+    "u-u0u1u2u3u4u5u6u7u8u9uAuBuCuDuEuFuGuHuIuJuKuLuMuNuOuPuQuRuSuTuU"
+    "uVuWuXuYuZu_uaubucudueufuguhuiujukulumunuoupuqurusutuuuvuwuxuyuz"
+    "v-v0v1v2v3v4v5v6v7v8v9vAvBvCvDvEvFvGvHvIvJvKvLvMvNvOvPvQvRvSvTvU"
+    "vVvWvXvYvZv_vavbvcvdvevfvgvhvivjvkvlvmvnvovpvqvrvsvtvuvvvwvxvyvz"
+    "w-w0w1w2w3w4w5w6w7w8w9wAwBwCwDwEwFwGwHwIwJwKwLwMwNwOwPwQwRwSwTwU"
+    "wVwWwXwYwZw_wawbwcwdwewfwgwhwiwjwkwlwmwnwowpwqwrwswtwuwvwwwxwywz"
+    "x-x0x1x2x3x4x5x6x7x8x9xAxBxCxDxExFxGxHxIxJxKxLxMxNxOxPxQxRxSxTxU"
+    "xVxWxXxYxZx_xaxbxcxdxexfxgxhxixjxkxlxmxnxoxpxqxrxsxtxuxvxwxxxyxz"
+    "y-y0y1y2y3y4y5y6y7y8y9yAyByCyDyEyFyGyHyIyJyKyLyMyNyOyPyQyRySyTyU"
+    "yVyWyXyYyZy_yaybycydyeyfygyhyiyjykylymynyoypyqyrysytyuyvywyxyyyz"
+    "z-z0z1z2z3z4z5z6z7z8z9zAzBzCzDzEzFzGzHzIzJzKzLzMzNzOzPzQzRzSzTzU"
+    "zVzWzXzYzZz_zazbzczdzezfzgzhzizjzkzlzmznzozpzqzrzsztzuzvzwzxzyzz";
+
+// The scalar decoder looks up two chars at a time in g_chars_to_chunk_pair,
+// which takes up 128 KiB. Builds that can't spare that much can define
+// SAFE64_NO_PAIR_TABLE to get a SWAR decoder instead.
+#ifdef SAFE64_NO_PAIR_TABLE
+    #define SAFE64_HAS_PAIR_TABLE 0
+#else
+    #define SAFE64_HAS_PAIR_TABLE 1
+#endif
+
+#if SAFE64_HAS_PAIR_TABLE
+// Set in the entries of g_chars_to_chunk_pair that hold a chunk pair.
+#define CHUNK_PAIR_FLAG_VALID 0x8000
+
+static const uint16_t g_chars_to_chunk_pair[256 * 256] =
+{
+    [0x2d2d] = 0x8000, [0x2d30] = 0x8040, [0x2d31] = 0x8080, [0x2d32] = 0x80c0,
+    [0x2d33] = 0x8100, [0x2d34] = 0x8140, [0x2d35] = 0x8180, [0x2d36] = 0x81c0,
+    [0x2d37] = 0x8200, [0x2d38] = 0x8240, [0x2d39] = 0x8280, [0x2d41] = 0x82c0,
+    [0x2d42] = 0x8300, [0x2d43] = 0x8340, [0x2d44] = 0x8380, [0x2d45] = 0x83c0,
+    [0x2d46] = 0x8400, [0x2d47] = 0x8440, [0x2d48] = 0x8480, [0x2d49] = 0x84c0,
+    [0x2d4a] = 0x8500, [0x2d4b] = 0x8540, [0x2d4c] = 0x8580, [0x2d4d] = 0x85c0,
+    [0x2d4e] = 0x8600, [0x2d4f] = 0x8640, [0x2d50] = 0x8680, [0x2d51] = 0x86c0,
+    [0x2d52] = 0x8700, [0x2d53] = 0x8740, [0x2d54] = 0x8780, [0x2d55] = 0x87c0,
+    [0x2d56] = 0x8800, [0x2d57] = 0x8840, [0x2d58] = 0x8880, [0x2d59] = 0x88c0,
+    [0x2d5a] = 0x8900, [0x2d5f] = 0x8940, [0x2d61] = 0x8980, [0x2d62] = 0x89c0,
+    [0x2d63] = 0x8a00, [0x2d64] = 0x8a40, [0x2d65] = 0x8a80, [0x2d66] = 0x8ac0,
+    [0x2d67] = 0x8b00, [0x2d68] = 0x8b40, [0x2d69] = 0x8b80, [0x2d6a] = 0x8bc0,
+    [0x2d6b] = 0x8c00, [0x2d6c] = 0x8c40, [0x2d6d] = 0x8c80, [0x2d6e] = 0x8cc0,
+    [0x2d6f] = 0x8d00, [0x2d70] = 0x8d40, [0x2d71] = 0x8d80, [0x2d72] = 0x8dc0,
+    [0x2d73] = 0x8e00, [0x2d74] = 0x8e40, [0x2d75] = 0x8e80, [0x2d76] = 0x8ec0,
+    [0x2d77] = 0x8f00, [0x2d78] = 0x8f40, [0x2d79] = 0x8f80, [0x2d7a] = 0x8fc0,
+    [0x302d] = 0x8001, [0x3030] = 0x8041, [0x3031] = 0x8081, [0x3032] = 0x80c1,
+    [0x3033] = 0x8101, [0x3034] = 0x8141, [0x3035] = 0x8181, [0x3036] = 0x81c1,
+    [0x3037] = 0x8201, [0x3038] = 0x8241, [0x3039] = 0x8281, [0x3041] = 0x82c1,
+    [0x3042] = 0x8301, [0x3043] = 0x8341, [0x3044] = 0x8381, [0x3045] = 0x83c1,
+    [0x3046] = 0x8401, [0x3047] = 0x8441, [0x3048] = 0x8481, [0x3049] = 0x84c1,
+    [0x304a] = 0x8501, [0x304b] = 0x8541, [0x304c] = 0x8581, [0x304d] = 0x85c1,
+    [0x304e] = 0x8601, [0x304f] = 0x8641, [0x3050] = 0x8681, [0x3051] = 0x86c1,
+    [0x3052] = 0x8701, [0x3053] = 0x8741, [0x3054] = 0x8781, [0x3055] = 0x87c1,
+    [0x3056] = 0x8801, [0x3057] = 0x8841, [0x3058] = 0x8881, [0x3059] = 0x88c1,
+    [0x305a] = 0x8901, [0x305f] = 0x8941, [0x3061] = 0x8981, [0x3062] = 0x89c1,
+    [0x3063] = 0x8a01, [0x3064] = 0x8a41, [0x3065] = 0x8a81, [0x3066] = 0x8ac1,
+    [0x3067] = 0x8b01, [0x3068] = 0x8b41, [0x3069] = 0x8b81, [0x306a] = 0x8bc1,
+    [0x306b] = 0x8c01, [0x306c] = 0x8c41, [0x306d] = 0x8c81, [0x306e] = 0x8cc1,
+    [0x306f] = 0x8d01, [0x3070] = 0x8d41, [0x3071] = 0x8d81, [0x3072] = 0x8dc1,
+    [0x3073] = 0x8e01, [0x3074] = 0x8e41, [0x3075] = 0x8e81, [0x3076] = 0x8ec1,
+    [0x3077] = 0x8f01, [0x3078] = 0x8f41, [0x3079] = 0x8f81, [0x307a] = 0x8fc1,
+    [0x312d] = 0x8002, [0x3130] = 0x8042, [0x3131] = 0x8082, [0x3132] = 0x80c2,
+    [0x3133] = 0x8102, [0x3134] = 0x8142, [0x3135] = 0x8182, [0x3136] = 0x81c2,
+    [0x3137] = 0x8202, [0x3138] = 0x8242, [0x3139] = 0x8282, [0x3141] = 0x82c2,
+    [0x3142] = 0x8302, [0x3143] = 0x8342, [0x3144] = 0x8382, [0x3145] = 0x83c2,
+    [0x3146] = 0x8402, [0x3147] = 0x8442, [0x3148] = 0x8482, [0x3149] = 0x84c2,
+    [0x314a] = 0x8502, [0x314b] = 0x8542, [0x314c] = 0x8582, [0x314d] = 0x85c2,
+    [0x314e] = 0x8602, [0x314f] = 0x8642, [0x3150] = 0x8682, [0x3151] = 0x86c2,
+    [0x3152] = 0x8702, [0x3153] = 0x8742, [0x3154] = 0x8782, [0x3155] = 0x87c2,
+    [0x3156] = 0x8802, [0x3157] = 0x8842, [0x3158] = 0x8882, [0x3159] = 0x88c2,
+    [0x315a] = 0x8902, [0x315f] = 0x8942, [0x3161] = 0x8982, [0x3162] = 0x89c2,
+    [0x3163] = 0x8a02, [0x3164] = 0x8a42, [0x3165] = 0x8a82, [0x3166] = 0x8ac2,
+    [0x3167] = 0x8b02, [0x3168] = 0x8b42, [0x3169] = 0x8b82, [0x316a] = 0x8bc2,
+    [0x316b] = 0x8c02, [0x316c] = 0x8c42, [0x316d] = 0x8c82, [0x316e] = 0x8cc2,
+    [0x316f] = 0x8d02, [0x3170] = 0x8d42, [0x3171] = 0x8d82, [0x3172] = 0x8dc2,
+    [0x3173] = 0x8e02, [0x3174] = 0x8e42, [0x3175] = 0x8e82, [0x3176] = 0x8ec2,
+    [0x3177] = 0x8f02, [0x3178] = 0x8f42, [0x3179] = 0x8f82, [0x317a] = 0x8fc2,
+    [0x322d] = 0x8003, [0x3230] = 0x8043, [0x3231] = 0x8083, [0x3232] = 0x80c3,
+    [0x3233] = 0x8103, [0x3234] = 0x8143, [0x3235] = 0x8183, [0x3236] = 0x81c3,
+    [0x3237] = 0x8203, [0x3238] = 0x8243, [0x3239] = 0x8283, [0x3241] = 0x82c3,
+    [0x3242] = 0x8303, [0x3243] = 0x8343, [0x3244] = 0x8383, [0x3245] = 0x83c3,
+    [0x3246] = 0x8403, [0x3247] = 0x8443, [0x3248] = 0x8483, [0x3249] = 0x84c3,
+    [0x324a] = 0x8503, [0x324b] = 0x8543, [0x324c] = 0x8583, [0x324d] = 0x85c3,
+    [0x324e] = 0x8603, [0x324f] = 0x8643, [0x3250] = 0x8683, [0x3251] = 0x86c3,
+    [0x3252] = 0x8703, [0x3253] = 0x8743, [0x3254] = 0x8783, [0x3255] = 0x87c3,
+    [0x3256] = 0x8803, [0x3257] = 0x8843, [0x3258] = 0x8883, [0x3259] = 0x88c3,
+    [0x325a] = 0x8903, [0x325f] = 0x8943, [0x3261] = 0x8983, [0x3262] = 0x89c3,
+    [0x3263] = 0x8a03, [0x3264] = 0x8a43, [0x3265] = 0x8a83, [0x3266] = 0x8ac3,
+    [0x3267] = 0x8b03, [0x3268] = 0x8b43, [0x3269] = 0x8b83, [0x326a] = 0x8bc3,
+    [0x326b] = 0x8c03, [0x326c] = 0x8c43, [0x326d] = 0x8c83, [0x326e] = 0x8cc3,
+    [0x326f] = 0x8d03, [0x3270] = 0x8d43, [0x3271] = 0x8d83, [0x3272] = 0x8dc3,
+    [0x3273] = 0x8e03, [0x3274] = 0x8e43, [0x3275] = 0x8e83, [0x3276] = 0x8ec3,
+    [0x3277] = 0x8f03, [0x3278] = 0x8f43, [0x3279] = 0x8f83, [0x327a] = 0x8fc3,
+    [0x332d] = 0x8004, [0x3330] = 0x8044, [0x3331] = 0x8084, [0x3332] = 0x80c4,
+    [0x3333] = 0x8104, [0x3334] = 0x8144, [0x3335] = 0x8184, [0x3336] = 0x81c4,
+    [0x3337] = 0x8204, [0x3338] = 0x8244, [0x3339] = 0x8284, [0x3341] = 0x82c4,
+    [0x3342] = 0x8304, [0x3343] = 0x8344, [0x3344] = 0x8384, [0x3345] = 0x83c4,
+    [0x3346] = 0x8404, [0x3347] = 0x8444, [0x3348] = 0x8484, [0x3349] = 0x84c4,
+    [0x334a] = 0x8504, [0x334b] = 0x8544, [0x334c] = 0x8584, [0x334d] = 0x85c4,
+    [0x334e] = 0x8604, [0x334f] = 0x8644, [0x3350] = 0x8684, [0x3351] = 0x86c4,
+    [0x3352] = 0x8704, [0x3353] = 0x8744, [0x3354] = 0x8784, [0x3355] = 0x87c4,
+    [0x3356] = 0x8804, [0x3357] = 0x8844, [0x3358] = 0x8884, [0x3359] = 0x88c4,
+    [0x335a] = 0x8904, [0x335f] = 0x8944, [0x3361] = 0x8984, [0x3362] = 0x89c4,
+    [0x3363] = 0x8a04, [0x3364] = 0x8a44, [0x3365] = 0x8a84, [0x3366] = 0x8ac4,
+    [0x3367] = 0x8b04, [0x3368] = 0x8b44, [0x3369] = 0x8b84, [0x336a] = 0x8bc4,
+    [0x336b] = 0x8c04, [0x336c] = 0x8c44, [0x336d] = 0x8c84, [0x336e] = 0x8cc4,
+    [0x336f] = 0x8d04, [0x3370] = 0x8d44, [0x3371] = 0x8d84, [0x3372] = 0x8dc4,
+    [0x3373] = 0x8e04, [0x3374] = 0x8e44, [0x3375] = 0x8e84, [0x3376] = 0x8ec4,
+    [0x3377] = 0x8f04, [0x3378] = 0x8f44, [0x3379] = 0x8f84, [0x337a] = 0x8fc4,
+    [0x342d] = 0x8005, [0x3430] = 0x8045, [0x3431] = 0x8085, [0x3432] = 0x80c5,
+    [0x3433] = 0x8105, [0x3434] = 0x8145, [0x3435] = 0x8185, [0x3436] = 0x81c5,
+    [0x3437] = 0x8205, [0x3438] = 0x8245, [0x3439] = 0x8285, [0x3441] = 0x82c5,
+    [0x3442] = 0x8305, [0x3443] = 0x8345, [0x3444] = 0x8385, [0x3445] = 0x83c5,
+    [0x3446] = 0x8405, [0x3447] = 0x8445, [0x3448] = 0x8485, [0x3449] = 0x84c5,
+    [0x344a] = 0x8505, [0x344b] = 0x8545, [0x344c] = 0x8585, [0x344d] = 0x85c5,
+    [0x344e] = 0x8605, [0x344f] = 0x8645, [0x3450] = 0x8685, [0x3451] = 0x86c5,
+    [0x3452] = 0x8705, [0x3453] = 0x8745, [0x3454] = 0x8785, [0x3455] = 0x87c5,
+    [0x3456] = 0x8805, [0x3457] = 0x8845, [0x3458] = 0x8885, [0x3459] = 0x88c5,
+    [0x345a] = 0x8905, [0x345f] = 0x8945, [0x3461] = 0x8985, [0x3462] = 0x89c5,
+    [0x3463] = 0x8a05, [0x3464] = 0x8a45, [0x3465] = 0x8a85, [0x3466] = 0x8ac5,
+    [0x3467] = 0x8b05, [0x3468] = 0x8b45, [0x3469] = 0x8b85, [0x346a] = 0x8bc5,
+    [0x346b] = 0x8c05, [0x346c] = 0x8c45, [0x346d] = 0x8c85, [0x346e] = 0x8cc5,
+    [0x346f] = 0x8d05, [0x3470] = 0x8d45, [0x3471] = 0x8d85, [0x3472] = 0x8dc5,
+    [0x3473] = 0x8e05, [0x3474] = 0x8e45, [0x3475] = 0x8e85, [0x3476] = 0x8ec5,
+    [0x3477] = 0x8f05, [0x3478] = 0x8f45, [0x3479] = 0x8f85, [0x347a] = 0x8fc5,
+    [0x352d] = 0x8006, [0x3530] = 0x8046, [0x3531] = 0x8086, [0x3532] = 0x80c6,
+    [0x3533] = 0x8106, [0x3534] = 0x8146, [0x3535] = 0x8186, [0x3536] = 0x81c6,
+    [0x3537] = 0x8206, [0x3538] = 0x8246, [0x3539] = 0x8286, [0x3541] = 0x82c6,
+    [0x3542] = 0x8306, [0x3543] = 0x8346, [0x3544] = 0x8386, [0x3545] = 0x83c6,
+    [0x3546] = 0x8406, [0x3547] = 0x8446, [0x3548] = 0x8486, [0x3549] = 0x84c6,
+    [0x354a] = 0x8506, [0x354b] = 0x8546, [0x354c] = 0x8586, [0x354d] = 0x85c6,
+    [0x354e] = 0x8606, [0x354f] = 0x8646, [0x3550] = 0x8686, [0x3551] = 0x86c6,
+    [0x3552] = 0x8706, [0x3553] = 0x8746, [0x3554] = 0x8786, [0x3555] = 0x87c6,
+    [0x3556] = 0x8806, [0x3557] = 0x8846, [0x3558] = 0x8886, [0x3559] = 0x88c6,
+    [0x355a] = 0x8906, [0x355f] = 0x8946, [0x3561] = 0x8986, [0x3562] = 0x89c6,
+    [0x3563] = 0x8a06, [0x3564] = 0x8a46, [0x3565] = 0x8a86, [0x3566] = 0x8ac6,
+    [0x3567] = 0x8b06, [0x3568] = 0x8b46, [0x3569] = 0x8b86, [0x356a] = 0x8bc6,
+    [0x356b] = 0x8c06, [0x356c] = 0x8c46, [0x356d] = 0x8c86, [0x356e] = 0x8cc6,
+    [0x356f] = 0x8d06, [0x3570] = 0x8d46, [0x3571] = 0x8d86, [0x3572] = 0x8dc6,
+    [0x3573] = 0x8e06, [0x3574] = 0x8e46, [0x3575] = 0x8e86, [0x3576] = 0x8ec6,
+    [0x3577] = 0x8f06, [0x3578] = 0x8f46, [0x3579] = 0x8f86, [0x357a] = 0x8fc6,
+    [0x362d] = 0x8007, [0x3630] = 0x8047, [0x3631] = 0x8087, [0x3632] = 0x80c7,
+    [0x3633] = 0x8107, [0x3634] = 0x8147, [0x3635] = 0x8187, [0x3636] = 0x81c7,
+    [0x3637] = 0x8207, [0x3638] = 0x8247, [0x3639] = 0x8287, [0x3641] = 0x82c7,
+    [0x3642] = 0x8307, [0x3643] = 0x8347, [0x3644] = 0x8387, [0x3645] = 0x83c7,
+    [0x3646] = 0x8407, [0x3647] = 0x8447, [0x3648] = 0x8487, [0x3649] = 0x84c7,
+    [0x364a] = 0x8507, [0x364b] = 0x8547, [0x364c] = 0x8587, [0x364d] = 0x85c7,
+    [0x364e] = 0x8607, [0x364f] = 0x8647, [0x3650] = 0x8687, [0x3651] = 0x86c7,
+    [0x3652] = 0x8707, [0x3653] = 0x8747, [0x3654] = 0x8787, [0x3655] = 0x87c7,
+    [0x3656] = 0x8807, [0x3657] = 0x8847, [0x3658] = 0x8887, [0x3659] = 0x88c7,
+    [0x365a] = 0x8907, [0x365f] = 0x8947, [0x3661] = 0x8987, [0x3662] = 0x89c7,
+    [0x3663] = 0x8a07, [0x3664] = 0x8a47, [0x3665] = 0x8a87, [0x3666] = 0x8ac7,
+    [0x3667] = 0x8b07, [0x3668] = 0x8b47, [0x3669] = 0x8b87, [0x366a] = 0x8bc7,
+    [0x366b] = 0x8c07, [0x366c] = 0x8c47, [0x366d] = 0x8c87, [0x366e] = 0x8cc7,
+    [0x366f] = 0x8d07, [0x3670] = 0x8d47, [0x3671] = 0x8d87, [0x3672] = 0x8dc7,
+    [0x3673] = 0x8e07, [0x3674] = 0x8e47, [0x3675] = 0x8e87, [0x3676] = 0x8ec7,
+    [0x3677] = 0x8f07, [0x3678] = 0x8f47, [0x3679] = 0x8f87, [0x367a] = 0x8fc7,
+    [0x372d] = 0x8008, [0x3730] = 0x8048, [0x3731] = 0x8088, [0x3732] = 0x80c8,
+    [0x3733] = 0x8108, [0x3734] = 0x8148, [0x3735] = 0x8188, [0x3736] = 0x81c8,
+    [0x3737] = 0x8208, [0x3738] = 0x8248, [0x3739] = 0x8288, [0x3741] = 0x82c8,
+    [0x3742] = 0x8308, [0x3743] = 0x8348, [0x3744] = 0x8388, [0x3745] = 0x83c8,
+    [0x3746] = 0x8408, [0x3747] = 0x8448, [0x3748] = 0x8488, [0x3749] = 0x84c8,
+    [0x374a] = 0x8508, [0x374b] = 0x8548, [0x374c] = 0x8588, [0x374d] = 0x85c8,
+    [0x374e] = 0x8608, [0x374f] = 0x8648, [0x3750] = 0x8688, [0x3751] = 0x86c8,
+    [0x3752] = 0x8708, [0x3753] = 0x8748, [0x3754] = 0x8788, [0x3755] = 0x87c8,
+    [0x3756] = 0x8808, [0x3757] = 0x8848, [0x3758] = 0x8888, [0x3759] = 0x88c8,
+    [0x375a] = 0x8908, [0x375f] = 0x8948, [0x3761] = 0x8988, [0x3762] = 0x89c8,
+    [0x3763] = 0x8a08, [0x3764] = 0x8a48, [0x3765] = 0x8a88, [0x3766] = 0x8ac8,
+    [0x3767] = 0x8b08, [0x3768] = 0x8b48, [0x3769] = 0x8b88, [0x376a] = 0x8bc8,
+    [0x376b] = 0x8c08, [0x376c] = 0x8c48, [0x376d] = 0x8c88, [0x376e] = 0x8cc8,
+    [0x376f] = 0x8d08, [0x3770] = 0x8d48, [0x3771] = 0x8d88, [0x3772] = 0x8dc8,
+    [0x3773] = 0x8e08, [0x3774] = 0x8e48, [0x3775] = 0x8e88, [0x3776] = 0x8ec8,
+    [0x3777] = 0x8f08, [0x3778] = 0x8f48, [0x3779] = 0x8f88, [0x377a] = 0x8fc8,
+    [0x382d] = 0x8009, [0x3830] = 0x8049, [0x3831] = 0x8089, [0x3832] = 0x80c9,
+    [0x3833] = 0x8109, [0x3834] = 0x8149, [0x3835] = 0x8189, [0x3836] = 0x81c9,
+    [0x3837] = 0x8209, [0x3838] = 0x8249, [0x3839] = 0x8289, [0x3841] = 0x82c9,
+    [0x3842] = 0x8309, [0x3843] = 0x8349, [0x3844] = 0x8389, [0x3845] = 0x83c9,
+    [0x3846] = 0x8409, [0x3847] = 0x8449, [0x3848] = 0x8489, [0x3849] = 0x84c9,
+    [0x384a] = 0x8509, [0x384b] = 0x8549, [0x384c] = 0x8589, [0x384d] = 0x85c9,
+    [0x384e] = 0x8609, [0x384f] = 0x8649, [0x3850] = 0x8689, [0x3851] = 0x86c9,
+    [0x3852] = 0x8709, [0x3853] = 0x8749, [0x3854] = 0x8789, [0x3855] = 0x87c9,
+    [0x3856] = 0x8809, [0x3857] = 0x8849, [0x3858] = 0x8889, [0x3859] = 0x88c9,
+    [0x385a] = 0x8909, [0x385f] = 0x8949, [0x3861] = 0x8989, [0x3862] = 0x89c9,
+    [0x3863] = 0x8a09, [0x3864] = 0x8a49, [0x3865] = 0x8a89, [0x3866] = 0x8ac9,
+    [0x3867] = 0x8b09, [0x3868] = 0x8b49, [0x3869] = 0x8b89, [0x386a] = 0x8bc9,
+    [0x386b] = 0x8c09, [0x386c] = 0x8c49, [0x386d] = 0x8c89, [0x386e] = 0x8cc9,
+    [0x386f] = 0x8d09, [0x3870] = 0x8d49, [0x3871] = 0x8d89, [0x3872] = 0x8dc9,
+    [0x3873] = 0x8e09, [0x3874] = 0x8e49, [0x3875] = 0x8e89, [0x3876] = 0x8ec9,
+    [0x3877] = 0x8f09, [0x3878] = 0x8f49, [0x3879] = 0x8f89, [0x387a] = 0x8fc9,
+    [0x392d] = 0x800a, [0x3930] = 0x804a, [0x3931] = 0x808a, [0x3932] = 0x80ca,
+    [0x3933] = 0x810a, [0x3934] = 0x814a, [0x3935] = 0x818a, [0x3936] = 0x81ca,
+    [0x3937] = 0x820a, [0x3938] = 0x824a, [0x3939] = 0x828a, [0x3941] = 0x82ca,
+    [0x3942] = 0x830a, [0x3943] = 0x834a, [0x3944] = 0x838a, [0x3945] = 0x83ca,
+    [0x3946] = 0x840a, [0x3947] = 0x844a, [0x3948] = 0x848a, [0x3949] = 0x84ca,
+    [0x394a] = 0x850a, [0x394b] = 0x854a, [0x394c] = 0x858a, [0x394d] = 0x85ca,
+    [0x394e] = 0x860a, [0x394f] = 0x864a, [0x3950] = 0x868a, [0x3951] = 0x86ca,
+    [0x3952] = 0x870a, [0x3953] = 0x874a, [0x3954] = 0x878a, [0x3955] = 0x87ca,
+    [0x3956] = 0x880a, [0x3957] = 0x884a, [0x3958] = 0x888a, [0x3959] = 0x88ca,
+    [0x395a] = 0x890a, [0x395f] = 0x894a, [0x3961] = 0x898a, [0x3962] = 0x89ca,
+    [0x3963] = 0x8a0a, [0x3964] = 0x8a4a, [0x3965] = 0x8a8a, [0x3966] = 0x8aca,
+    [0x3967] = 0x8b0a, [0x3968] = 0x8b4a, [0x3969] = 0x8b8a, [0x396a] = 0x8bca,
+    [0x396b] = 0x8c0a, [0x396c] = 0x8c4a, [0x396d] = 0x8c8a, [0x396e] = 0x8cca,
+    [0x396f] = 0x8d0a, [0x3970] = 0x8d4a, [0x3971] = 0x8d8a, [0x3972] = 0x8dca,
+    [0x3973] = 0x8e0a, [0x3974] = 0x8e4a, [0x3975] = 0x8e8a, [0x3976] = 0x8eca,
+    [0x3977] = 0x8f0a, [0x3978] = 0x8f4a, [0x3979] = 0x8f8a, [0x397a] = 0x8fca,
+    [0x412d] = 0x800b, [0x4130] = 0x804b, [0x4131] = 0x808b, [0x4132] = 0x80cb,
+    [0x4133] = 0x810b, [0x4134] = 0x814b, [0x4135] = 0x818b, [0x4136] = 0x81cb,
+    [0x4137] = 0x820b, [0x4138] = 0x824b, [0x4139] = 0x828b, [0x4141] = 0x82cb,
+    [0x4142] = 0x830b, [0x4143] = 0x834b, [0x4144] = 0x838b, [0x4145] = 0x83cb,
+    [0x4146] = 0x840b, [0x4147] = 0x844b, [0x4148] = 0x848b, [0x4149] = 0x84cb,
+    [0x414a] = 0x850b, [0x414b] = 0x854b, [0x414c] = 0x858b, [0x414d] = 0x85cb,
+    [0x414e] = 0x860b, [0x414f] = 0x864b, [0x4150] = 0x868b, [0x4151] = 0x86cb,
+    [0x4152] = 0x870b, [0x4153] = 0x874b, [0x4154] = 0x878b, [0x4155] = 0x87cb,
+    [0x4156] = 0x880b, [0x4157] = 0x884b, [0x4158] = 0x888b, [0x4159] = 0x88cb,
+    [0x415a] = 0x890b, [0x415f] = 0x894b, [0x4161] = 0x898b, [0x4162] = 0x89cb,
+    [0x4163] = 0x8a0b, [0x4164] = 0x8a4b, [0x4165] = 0x8a8b, [0x4166] = 0x8acb,
+    [0x4167] = 0x8b0b, [0x4168] = 0x8b4b, [0x4169] = 0x8b8b, [0x416a] = 0x8bcb,
+    [0x416b] = 0x8c0b, [0x416c] = 0x8c4b, [0x416d] = 0x8c8b, [0x416e] = 0x8ccb,
+    [0x416f] = 0x8d0b, [0x4170] = 0x8d4b, [0x4171] = 0x8d8b, [0x4172] = 0x8dcb,
+    [0x4173] = 0x8e0b, [0x4174] = 0x8e4b, [0x4175] = 0x8e8b, [0x4176] = 0x8ecb,
+    [0x4177] = 0x8f0b, [0x4178] = 0x8f4b, [0x4179] = 0x8f8b, [0x417a] = 0x8fcb,
+    [0x422d] = 0x800c, [0x4230] = 0x804c, [0x4231] = 0x808c, [0x4232] = 0x80cc,
+    [0x4233] = 0x810c, [0x4234] = 0x814c, [0x4235] = 0x818c, [0x4236] = 0x81cc,
+    [0x4237] = 0x820c, [0x4238] = 0x824c, [0x4239] = 0x828c, [0x4241] = 0x82cc,
+    [0x4242] = 0x830c, [0x4243] = 0x834c, [0x4244] = 0x838c, [0x4245] = 0x83cc,
+    [0x4246] = 0x840c, [0x4247] = 0x844c, [0x4248] = 0x848c, [0x4249] = 0x84cc,
+    [0x424a] = 0x850c, [0x424b] = 0x854c, [0x424c] = 0x858c, [0x424d] = 0x85cc,
+    [0x424e] = 0x860c, [0x424f] = 0x864c, [0x4250] = 0x868c, [0x4251] = 0x86cc,
+    [0x4252] = 0x870c, [0x4253] = 0x874c, [0x4254] = 0x878c, [0x4255] = 0x87cc,
+    [0x4256] = 0x880c, [0x4257] = 0x884c, [0x4258] = 0x888c, [0x4259] = 0x88cc,
+    [0x425a] = 0x890c, [0x425f] = 0x894c, [0x4261] = 0x898c, [0x4262] = 0x89cc,
+    [0x4263] = 0x8a0c, [0x4264] = 0x8a4c, [0x4265] = 0x8a8c, [0x4266] = 0x8acc,
+    [0x4267] = 0x8b0c, [0x4268] = 0x8b4c, [0x4269] = 0x8b8c, [0x426a] = 0x8bcc,
+    [0x426b] = 0x8c0c, [0x426c] = 0x8c4c, [0x426d] = 0x8c8c, [0x426e] = 0x8ccc,
+    [0x426f] = 0x8d0c, [0x4270] = 0x8d4c, [0x4271] = 0x8d8c, [0x4272] = 0x8dcc,
+    [0x4273] = 0x8e0c, [0x4274] = 0x8e4c, [0x4275] = 0x8e8c, [0x4276] = 0x8ecc,
+    [0x4277] = 0x8f0c, [0x4278] = 0x8f4c, [0x4279] = 0x8f8c, [0x427a] = 0x8fcc,
+    [0x432d] = 0x800d, [0x4330] = 0x804d, [0x4331] = 0x808d, [0x4332] = 0x80cd,
+    [0x4333] = 0x810d, [0x4334] = 0x814d, [0x4335] = 0x818d, [0x4336] = 0x81cd,
+    [0x4337] = 0x820d, [0x4338] = 0x824d, [0x4339] = 0x828d, [0x4341] = 0x82cd,
+    [0x4342] = 0x830d, [0x4343] = 0x834d, [0x4344] = 0x838d, [0x4345] = 0x83cd,
+    [0x4346] = 0x840d, [0x4347] = 0x844d, [0x4348] = 0x848d, [0x4349] = 0x84cd,
+    [0x434a] = 0x850d, [0x434b] = 0x854d, [0x434c] = 0x858d, [0x434d] = 0x85cd,
+    [0x434e] = 0x860d, [0x434f] = 0x864d, [0x4350] = 0x868d, [0x4351] = 0x86cd,
+    [0x4352] = 0x870d, [0x4353] = 0x874d, [0x4354] = 0x878d, [0x4355] = 0x87cd,
+    [0x4356] = 0x880d, [0x4357] = 0x884d, [0x4358] = 0x888d, [0x4359] = 0x88cd,
+    [0x435a] = 0x890d, [0x435f] = 0x894d, [0x4361] = 0x898d, [0x4362] = 0x89cd,
+    [0x4363] = 0x8a0d, [0x4364] = 0x8a4d, [0x4365] = 0x8a8d, [0x4366] = 0x8acd,
+    [0x4367] = 0x8b0d, [0x4368] = 0x8b4d, [0x4369] = 0x8b8d, [0x436a] = 0x8bcd,
+    [0x436b] = 0x8c0d, [0x436c] = 0x8c4d, [0x436d] = 0x8c8d, [0x436e] = 0x8ccd,
+    [0x436f] = 0x8d0d, [0x4370] = 0x8d4d, [0x4371] = 0x8d8d, [0x4372] = 0x8dcd,
+    [0x4373] = 0x8e0d, [0x4374] = 0x8e4d, [0x4375] = 0x8e8d, [0x4376] = 0x8ecd,
+    [0x4377] = 0x8f0d, [0x4378] = 0x8f4d, [0x4379] = 0x8f8d, [0x437a] = 0x8fcd,
+    [0x442d] = 0x800e, [0x4430] = 0x804e, [0x4431] = 0x808e, [0x4432] = 0x80ce,
+    [0x4433] = 0x810e, [0x4434] = 0x814e, [0x4435] = 0x818e, [0x4436] = 0x81ce,
+    [0x4437] = 0x820e, [0x4438] = 0x824e, [0x4439] = 0x828e, [0x4441] = 0x82ce,
+    [0x4442] = 0x830e, [0x4443] = 0x834e, [0x4444] = 0x838e, [0x4445] = 0x83ce,
+    [0x4446] = 0x840e, [0x4447] = 0x844e, [0x4448] = 0x848e, [0x4449] = 0x84ce,
+    [0x444a] = 0x850e, [0x444b] = 0x854e, [0x444c] = 0x858e, [0x444d] = 0x85ce,
+    [0x444e] = 0x860e, [0x444f] = 0x864e, [0x4450] = 0x868e, [0x4451] = 0x86ce,
+    [0x4452] = 0x870e, [0x4453] = 0x874e, [0x4454] = 0x878e, [0x4455] = 0x87ce,
+    [0x4456] = 0x880e, [0x4457] = 0x884e, [0x4458] = 0x888e, [0x4459] = 0x88ce,
+    [0x445a] = 0x890e, [0x445f] = 0x894e, [0x4461] = 0x898e, [0x4462] = 0x89ce,
+    [0x4463] = 0x8a0e, [0x4464] = 0x8a4e, [0x4465] = 0x8a8e, [0x4466] = 0x8ace,
+    [0x4467] = 0x8b0e, [0x4468] = 0x8b4e, [0x4469] = 0x8b8e, [0x446a] = 0x8bce,
+    [0x446b] = 0x8c0e, [0x446c] = 0x8c4e, [0x446d] = 0x8c8e, [0x446e] = 0x8cce,
+    [0x446f] = 0x8d0e, [0x4470] = 0x8d4e, [0x4471] = 0x8d8e, [0x4472] = 0x8dce,
+    [0x4473] = 0x8e0e, [0x4474] = 0x8e4e, [0x4475] = 0x8e8e, [0x4476] = 0x8ece,
+    [0x4477] = 0x8f0e, [0x4478] = 0x8f4e, [0x4479] = 0x8f8e, [0x447a] = 0x8fce,
+    [0x452d] = 0x800f, [0x4530] = 0x804f, [0x4531] = 0x808f, [0x4532] = 0x80cf,
+    [0x4533] = 0x810f, [0x4534] = 0x814f, [0x4535] = 0x818f, [0x4536] = 0x81cf,
+    [0x4537] = 0x820f, [0x4538] = 0x824f, [0x4539] = 0x828f, [0x4541] = 0x82cf,
+    [0x4542] = 0x830f, [0x4543] = 0x834f, [0x4544] = 0x838f, [0x4545] = 0x83cf,
+    [0x4546] = 0x840f, [0x4547] = 0x844f, [0x4548] = 0x848f, [0x4549] = 0x84cf,
+    [0x454a] = 0x850f, [0x454b] = 0x854f, [0x454c] = 0x858f, [0x454d] = 0x85cf,
+    [0x454e] = 0x860f, [0x454f] = 0x864f, [0x4550] = 0x868f, [0x4551] = 0x86cf,
+    [0x4552] = 0x870f, [0x4553] = 0x874f, [0x4554] = 0x878f, [0x4555] = 0x87cf,
+    [0x4556] = 0x880f, [0x4557] = 0x884f, [0x4558] = 0x888f, [0x4559] = 0x88cf,
+    [0x455a] = 0x890f, [0x455f] = 0x894f, [0x4561] = 0x898f, [0x4562] = 0x89cf,
+    [0x4563] = 0x8a0f, [0x4564] = 0x8a4f, [0x4565] = 0x8a8f, [0x4566] = 0x8acf,
+    [0x4567] = 0x8b0f, [0x4568] = 0x8b4f, [0x4569] = 0x8b8f, [0x456a] = 0x8bcf,
+    [0x456b] = 0x8c0f, [0x456c] = 0x8c4f, [0x456d] = 0x8c8f, [0x456e] = 0x8ccf,
+    [0x456f] = 0x8d0f, [0x4570] = 0x8d4f, [0x4571] = 0x8d8f, [0x4572] = 0x8dcf,
+    [0x4573] = 0x8e0f, [0x4574] = 0x8e4f, [0x4575] = 0x8e8f, [0x4576] = 0x8ecf,
+    [0x4577] = 0x8f0f, [0x4578] = 0x8f4f, [0x4579] = 0x8f8f, [0x457a] = 0x8fcf,
+    [0x462d] = 0x8010, [0x4630] = 0x8050, [0x4631] = 0x8090, [0x4632] = 0x80d0,
+    [0x4633] = 0x8110, [0x4634] = 0x8150, [0x4635] = 0x8190, [0x4636] = 0x81d0,
+    [0x4637] = 0x8210, [0x4638] = 0x8250, [0x4639] = 0x8290, [0x4641] = 0x82d0,
+    [0x4642] = 0x8310, [0x4643] = 0x8350, [0x4644] = 0x8390, [0x4645] = 0x83d0,
+    [0x4646] = 0x8410, [0x4647] = 0x8450, [0x4648] = 0x8490, [0x4649] = 0x84d0,
+    [0x464a] = 0x8510, [0x464b] = 0x8550, [0x464c] = 0x8590, [0x464d] = 0x85d0,
+    [0x464e] = 0x8610, [0x464f] = 0x8650, [0x4650] = 0x8690, [0x4651] = 0x86d0,
+    [0x4652] = 0x8710, [0x4653] = 0x8750, [0x4654] = 0x8790, [0x4655] = 0x87d0,
+    [0x4656] = 0x8810, [0x4657] = 0x8850, [0x4658] = 0x8890, [0x4659] = 0x88d0,
+    [0x465a] = 0x8910, [0x465f] = 0x8950, [0x4661] = 0x8990, [0x4662] = 0x89d0,
+    [0x4663] = 0x8a10, [0x4664] = 0x8a50, [0x4665] = 0x8a90, [0x4666] = 0x8ad0,
+    [0x4667] = 0x8b10, [0x4668] = 0x8b50, [0x4669] = 0x8b90, [0x466a] = 0x8bd0,
+    [0x466b] = 0x8c10, [0x466c] = 0x8c50, [0x466d] = 0x8c90, [0x466e] = 0x8cd0,
+    [0x466f] = 0x8d10, [0x4670] = 0x8d50, [0x4671] = 0x8d90, [0x4672] = 0x8dd0,
+    [0x4673] = 0x8e10, [0x4674] = 0x8e50, [0x4675] = 0x8e90, [0x4676] = 0x8ed0,
+    [0x4677] = 0x8f10, [0x4678] = 0x8f50, [0x4679] = 0x8f90, [0x467a] = 0x8fd0,
+    [0x472d] = 0x8011, [0x4730] = 0x8051, [0x4731] = 0x8091, [0x4732] = 0x80d1,
+    [0x4733] = 0x8111, [0x4734] = 0x8151, [0x4735] = 0x8191, [0x4736] = 0x81d1,
+    [0x4737] = 0x8211, [0x4738] = 0x8251, [0x4739] = 0x8291, [0x4741] = 0x82d1,
+    [0x4742] = 0x8311, [0x4743] = 0x8351, [0x4744] = 0x8391, [0x4745] = 0x83d1,
+    [0x4746] = 0x8411, [0x4747] = 0x8451, [0x4748] = 0x8491, [0x4749] = 0x84d1,
+    [0x474a] = 0x8511, [0x474b] = 0x8551, [0x474c] = 0x8591, [0x474d] = 0x85d1,
+    [0x474e] = 0x8611, [0x474f] = 0x8651, [0x4750] = 0x8691, [0x4751] = 0x86d1,
+    [0x4752] = 0x8711, [0x4753] = 0x8751, [0x4754] = 0x8791, [0x4755] = 0x87d1,
+    [0x4756] = 0x8811, [0x4757] = 0x8851, [0x4758] = 0x8891, [0x4759] = 0x88d1,
+    [0x475a] = 0x8911, [0x475f] = 0x8951, [0x4761] = 0x8991, [0x4762] = 0x89d1,
+    [0x4763] = 0x8a11, [0x4764] = 0x8a51, [0x4765] = 0x8a91, [0x4766] = 0x8ad1,
+    [0x4767] = 0x8b11, [0x4768] = 0x8b51, [0x4769] = 0x8b91, [0x476a] = 0x8bd1,
+    [0x476b] = 0x8c11, [0x476c] = 0x8c51, [0x476d] = 0x8c91, [0x476e] = 0x8cd1,
+    [0x476f] = 0x8d11, [0x4770] = 0x8d51, [0x4771] = 0x8d91, [0x4772] = 0x8dd1,
+    [0x4773] = 0x8e11, [0x4774] = 0x8e51, [0x4775] = 0x8e91, [0x4776] = 0x8ed1,
+    [0x4777] = 0x8f11, [0x4778] = 0x8f51, [0x4779] = 0x8f91, [0x477a] = 0x8fd1,
+    [0x482d] = 0x8012, [0x4830] = 0x8052, [0x4831] = 0x8092, [0x4832] = 0x80d2,
+    [0x4833] = 0x8112, [0x4834] = 0x8152, [0x4835] = 0x8192, [0x4836] = 0x81d2,
+    [0x4837] = 0x8212, [0x4838] = 0x8252, [0x4839] = 0x8292, [0x4841] = 0x82d2,
+    [0x4842] = 0x8312, [0x4843] = 0x8352, [0x4844] = 0x8392, [0x4845] = 0x83d2,
+    [0x4846] = 0x8412, [0x4847] = 0x8452, [0x4848] = 0x8492, [0x4849] = 0x84d2,
+    [0x484a] = 0x8512, [0x484b] = 0x8552, [0x484c] = 0x8592, [0x484d] = 0x85d2,
+    [0x484e] = 0x8612, [0x484f] = 0x8652, [0x4850] = 0x8692, [0x4851] = 0x86d2,
+    [0x4852] = 0x8712, [0x4853] = 0x8752, [0x4854] = 0x8792, [0x4855] = 0x87d2,
+    [0x4856] = 0x8812, [0x4857] = 0x8852, [0x4858] = 0x8892, [0x4859] = 0x88d2,
+    [0x485a] = 0x8912, [0x485f] = 0x8952, [0x4861] = 0x8992, [0x4862] = 0x89d2,
+    [0x4863] = 0x8a12, [0x4864] = 0x8a52, [0x4865] = 0x8a92, [0x4866] = 0x8ad2,
+    [0x4867] = 0x8b12, [0x4868] = 0x8b52, [0x4869] = 0x8b92, [0x486a] = 0x8bd2,
+    [0x486b] = 0x8c12, [0x486c] = 0x8c52, [0x486d] = 0x8c92, [0x486e] = 0x8cd2,
+    [0x486f] = 0x8d12, [0x4870] = 0x8d52, [0x4871] = 0x8d92, [0x4872] = 0x8dd2,
+    [0x4873] = 0x8e12, [0x4874] = 0x8e52, [0x4875] = 0x8e92, [0x4876] = 0x8ed2,
+    [0x4877] = 0x8f12, [0x4878] = 0x8f52, [0x4879] = 0x8f92, [0x487a] = 0x8fd2,
+    [0x492d] = 0x8013, [0x4930] = 0x8053, [0x4931] = 0x8093, [0x4932] = 0x80d3,
+    [0x4933] = 0x8113, [0x4934] = 0x8153, [0x4935] = 0x8193, [0x4936] = 0x81d3,
+    [0x4937] = 0x8213, [0x4938] = 0x8253, [0x4939] = 0x8293, [0x4941] = 0x82d3,
+    [0x4942] = 0x8313, [0x4943] = 0x8353, [0x4944] = 0x8393, [0x4945] = 0x83d3,
+    [0x4946] = 0x8413, [0x4947] = 0x8453, [0x4948] = 0x8493, [0x4949] = 0x84d3,
+    [0x494a] = 0x8513, [0x494b] = 0x8553, [0x494c] = 0x8593, [0x494d] = 0x85d3,
+    [0x494e] = 0x8613, [0x494f] = 0x8653, [0x4950] = 0x8693, [0x4951] = 0x86d3,
+    [0x4952] = 0x8713, [0x4953] = 0x8753, [0x4954] = 0x8793, [0x4955] = 0x87d3,
+    [0x4956] = 0x8813, [0x4957] = 0x8853, [0x4958] = 0x8893, [0x4959] = 0x88d3,
+    [0x495a] = 0x8913, [0x495f] = 0x8953, [0x4961] = 0x8993, [0x4962] = 0x89d3,
+    [0x4963] = 0x8a13, [0x4964] = 0x8a53, [0x4965] = 0x8a93, [0x4966] = 0x8ad3,
+    [0x4967] = 0x8b13, [0x4968] = 0x8b53, [0x4969] = 0x8b93, [0x496a] = 0x8bd3,
+    [0x496b] = 0x8c13, [0x496c] = 0x8c53, [0x496d] = 0x8c93, [0x496e] = 0x8cd3,
+    [0x496f] = 0x8d13, [0x4970] = 0x8d53, [0x4971] = 0x8d93, [0x4972] = 0x8dd3,
+    [0x4973] = 0x8e13, [0x4974] = 0x8e53, [0x4975] = 0x8e93, [0x4976] = 0x8ed3,
+    [0x4977] = 0x8f13, [0x4978] = 0x8f53, [0x4979] = 0x8f93, [0x497a] = 0x8fd3,
+    [0x4a2d] = 0x8014, [0x4a30] = 0x8054, [0x4a31] = 0x8094, [0x4a32] = 0x80d4,
+    [0x4a33] = 0x8114, [0x4a34] = 0x8154, [0x4a35] = 0x8194, [0x4a36] = 0x81d4,
+    [0x4a37] = 0x8214, [0x4a38] = 0x8254, [0x4a39] = 0x8294, [0x4a41] = 0x82d4,
+    [0x4a42] = 0x8314, [0x4a43] = 0x8354, [0x4a44] = 0x8394, [0x4a45] = 0x83d4,
+    [0x4a46] = 0x8414, [0x4a47] = 0x8454, [0x4a48] = 0x8494, [0x4a49] = 0x84d4,
+    [0x4a4a] = 0x8514, [0x4a4b] = 0x8554, [0x4a4c] = 0x8594, [0x4a4d] = 0x85d4,
+    [0x4a4e] = 0x8614, [0x4a4f] = 0x8654, [0x4a50] = 0x8694, [0x4a51] = 0x86d4,
+    [0x4a52] = 0x8714, [0x4a53] = 0x8754, [0x4a54] = 0x8794, [0x4a55] = 0x87d4,
+    [0x4a56] = 0x8814, [0x4a57] = 0x8854, [0x4a58] = 0x8894, [0x4a59] = 0x88d4,
+    [0x4a5a] = 0x8914, [0x4a5f] = 0x8954, [0x4a61] = 0x8994, [0x4a62] = 0x89d4,
+    [0x4a63] = 0x8a14, [0x4a64] = 0x8a54, [0x4a65] = 0x8a94, [0x4a66] = 0x8ad4,
+    [0x4a67] = 0x8b14, [0x4a68] = 0x8b54, [0x4a69] = 0x8b94, [0x4a6a] = 0x8bd4,
+    [0x4a6b] = 0x8c14, [0x4a6c] = 0x8c54, [0x4a6d] = 0x8c94, [0x4a6e] = 0x8cd4,
+    [0x4a6f] = 0x8d14, [0x4a70] = 0x8d54, [0x4a71] = 0x8d94, [0x4a72] = 0x8dd4,
+    [0x4a73] = 0x8e14, [0x4a74] = 0x8e54, [0x4a75] = 0x8e94, [0x4a76] = 0x8ed4,
+    [0x4a77] = 0x8f14, [0x4a78] = 0x8f54, [0x4a79] = 0x8f94, [0x4a7a] = 0x8fd4,
+    [0x4b2d] = 0x8015, [0x4b30] = 0x8055, [0x4b31] = 0x8095, [0x4b32] = 0x80d5,
+    [0x4b33] = 0x8115, [0x4b34] = 0x8155, [0x4b35] = 0x8195, [0x4b36] = 0x81d5,
+    [0x4b37] = 0x8215, [0x4b38] = 0x8255, [0x4b39] = 0x8295, [0x4b41] = 0x82d5,
+    [0x4b42] = 0x8315, [0x4b43] = 0x8355, [0x4b44] = 0x8395, [0x4b45] = 0x83d5,
+    [0x4b46] = 0x8415, [0x4b47] = 0x8455, [0x4b48] = 0x8495, [0x4b49] = 0x84d5,
+    [0x4b4a] = 0x8515, [0x4b4b] = 0x8555, [0x4b4c] = 0x8595, [0x4b4d] = 0x85d5,
+    [0x4b4e] = 0x8615, [0x4b4f] = 0x8655, [0x4b50] = 0x8695, [0x4b51] = 0x86d5,
+    [0x4b52] = 0x8715, [0x4b53] = 0x8755, [0x4b54] = 0x8795, [0x4b55] = 0x87d5,
+    [0x4b56] = 0x8815, [0x4b57] = 0x8855, [0x4b58] = 0x8895, [0x4b59] = 0x88d5,
+    [0x4b5a] = 0x8915, [0x4b5f] = 0x8955, [0x4b61] = 0x8995, [0x4b62] = 0x89d5,
+    [0x4b63] = 0x8a15, [0x4b64] = 0x8a55, [0x4b65] = 0x8a95, [0x4b66] = 0x8ad5,
+    [0x4b67] = 0x8b15, [0x4b68] = 0x8b55, [0x4b69] = 0x8b95, [0x4b6a] = 0x8bd5,
+    [0x4b6b] = 0x8c15, [0x4b6c] = 0x8c55, [0x4b6d] = 0x8c95, [0x4b6e] = 0x8cd5,
+    [0x4b6f] = 0x8d15, [0x4b70] = 0x8d55, [0x4b71] = 0x8d95, [0x4b72] = 0x8dd5,
+    [0x4b73] = 0x8e15, [0x4b74] = 0x8e55, [0x4b75] = 0x8e95, [0x4b76] = 0x8ed5,
+    [0x4b77] = 0x8f15, [0x4b78] = 0x8f55, [0x4b79] = 0x8f95, [0x4b7a] = 0x8fd5,
+    [0x4c2d] = 0x8016, [0x4c30] = 0x8056, [0x4c31] = 0x8096, [0x4c32] = 0x80d6,
+    [0x4c33] = 0x8116, [0x4c34] = 0x8156, [0x4c35] = 0x8196, [0x4c36] = 0x81d6,
+    [0x4c37] = 0x8216, [0x4c38] = 0x8256, [0x4c39] = 0x8296, [0x4c41] = 0x82d6,
+    [0x4c42] = 0x8316, [0x4c43] = 0x8356, [0x4c44] = 0x8396, [0x4c45] = 0x83d6,
+    [0x4c46] = 0x8416, [0x4c47] = 0x8456, [0x4c48] = 0x8496, [0x4c49] = 0x84d6,
+    [0x4c4a] = 0x8516, [0x4c4b] = 0x8556, [0x4c4c] = 0x8596, [0x4c4d] = 0x85d6,
+    [0x4c4e] = 0x8616, [0x4c4f] = 0x8656, [0x4c50] = 0x8696, [0x4c51] = 0x86d6,
+    [0x4c52] = 0x8716, [0x4c53] = 0x8756, [0x4c54] = 0x8796, [0x4c55] = 0x87d6,
+    [0x4c56] = 0x8816, [0x4c57] = 0x8856, [0x4c58] = 0x8896, [0x4c59] = 0x88d6,
+    [0x4c5a] = 0x8916, [0x4c5f] = 0x8956, [0x4c61] = 0x8996, [0x4c62] = 0x89d6,
+    [0x4c63] = 0x8a16, [0x4c64] = 0x8a56, [0x4c65] = 0x8a96, [0x4c66] = 0x8ad6,
+    [0x4c67] = 0x8b16, [0x4c68] = 0x8b56, [0x4c69] = 0x8b96, [0x4c6a] = 0x8bd6,
+    [0x4c6b] = 0x8c16, [0x4c6c] = 0x8c56, [0x4c6d] = 0x8c96, [0x4c6e] = 0x8cd6,
+    [0x4c6f] = 0x8d16, [0x4c70] = 0x8d56, [0x4c71] = 0x8d96, [0x4c72] = 0x8dd6,
+    [0x4c73] = 0x8e16, [0x4c74] = 0x8e56, [0x4c75] = 0x8e96, [0x4c76] = 0x8ed6,
+    [0x4c77] = 0x8f16, [0x4c78] = 0x8f56, [0x4c79] = 0x8f96, [0x4c7a] = 0x8fd6,
+    [0x4d2d] = 0x8017, [0x4d30] = 0x8057, [0x4d31] = 0x8097, [0x4d32] = 0x80d7,
+    [0x4d33] = 0x8117, [0x4d34] = 0x8157, [0x4d35] = 0x8197, [0x4d36] = 0x81d7,
+    [0x4d37] = 0x8217, [0x4d38] = 0x8257, [0x4d39] = 0x8297, [0x4d41] = 0x82d7,
+    [0x4d42] = 0x8317, [0x4d43] = 0x8357, [0x4d44] = 0x8397, [0x4d45] = 0x83d7,
+    [0x4d46] = 0x8417, [0x4d47] = 0x8457, [0x4d48] = 0x8497, [0x4d49] = 0x84d7,
+    [0x4d4a] = 0x8517, [0x4d4b] = 0x8557, [0x4d4c] = 0x8597, [0x4d4d] = 0x85d7,
+    [0x4d4e] = 0x8617, [0x4d4f] = 0x8657, [0x4d50] = 0x8697, [0x4d51] = 0x86d7,
+    [0x4d52] = 0x8717, [0x4d53] = 0x8757, [0x4d54] = 0x8797, [0x4d55] = 0x87d7,
+    [0x4d56] = 0x8817, [0x4d57] = 0x8857, [0x4d58] = 0x8897, [0x4d59] = 0x88d7,
+    [0x4d5a] = 0x8917, [0x4d5f] = 0x8957, [0x4d61] = 0x8997, [0x4d62] = 0x89d7,
+    [0x4d63] = 0x8a17, [0x4d64] = 0x8a57, [0x4d65] = 0x8a97, [0x4d66] = 0x8ad7,
+    [0x4d67] = 0x8b17, [0x4d68] = 0x8b57, [0x4d69] = 0x8b97, [0x4d6a] = 0x8bd7,
+    [0x4d6b] = 0x8c17, [0x4d6c] = 0x8c57, [0x4d6d] = 0x8c97, [0x4d6e] = 0x8cd7,
+    [0x4d6f] = 0x8d17, [0x4d70] = 0x8d57, [0x4d71] = 0x8d97, [0x4d72] = 0x8dd7,
+    [0x4d73] = 0x8e17, [0x4d74] = 0x8e57, [0x4d75] = 0x8e97, [0x4d76] = 0x8ed7,
+    [0x4d77] = 0x8f17, [0x4d78] = 0x8f57, [0x4d79] = 0x8f97, [0x4d7a] = 0x8fd7,
+    [0x4e2d] = 0x8018, [0x4e30] = 0x8058, [0x4e31] = 0x8098, [0x4e32] = 0x80d8,
+    [0x4e33] = 0x8118, [0x4e34] = 0x8158, [0x4e35] = 0x8198, [0x4e36] = 0x81d8,
+    [0x4e37] = 0x8218, [0x4e38] = 0x8258, [0x4e39] = 0x8298, [0x4e41] = 0x82d8,
+    [0x4e42] = 0x8318, [0x4e43] = 0x8358, [0x4e44] = 0x8398, [0x4e45] = 0x83d8,
+    [0x4e46] = 0x8418, [0x4e47] = 0x8458, [0x4e48] = 0x8498, [0x4e49] = 0x84d8,
+    [0x4e4a] = 0x8518, [0x4e4b] = 0x8558, [0x4e4c] = 0x8598, [0x4e4d] = 0x85d8,
+    [0x4e4e] = 0x8618, [0x4e4f] = 0x8658, [0x4e50] = 0x8698, [0x4e51] = 0x86d8,
+    [0x4e52] = 0x8718, [0x4e53] = 0x8758, [0x4e54] = 0x8798, [0x4e55] = 0x87d8,
+    [0x4e56] = 0x8818, [0x4e57] = 0x8858, [0x4e58] = 0x8898, [0x4e59] = 0x88d8,
+    [0x4e5a] = 0x8918, [0x4e5f] = 0x8958, [0x4e61] = 0x8998, [0x4e62] = 0x89d8,
+    [0x4e63] = 0x8a18, [0x4e64] = 0x8a58, [0x4e65] = 0x8a98, [0x4e66] = 0x8ad8,
+    [0x4e67] = 0x8b18, [0x4e68] = 0x8b58, [0x4e69] = 0x8b98, [0x4e6a] = 0x8bd8,
+    [0x4e6b] = 0x8c18, [0x4e6c] = 0x8c58, [0x4e6d] = 0x8c98, [0x4e6e] = 0x8cd8,
+    [0x4e6f] = 0x8d18, [0x4e70] = 0x8d58, [0x4e71] = 0x8d98, [0x4e72] = 0x8dd8,
+    [0x4e73] = 0x8e18, [0x4e74] = 0x8e58, [0x4e75] = 0x8e98, [0x4e76] = 0x8ed8,
+    [0x4e77] = 0x8f18, [0x4e78] = 0x8f58, [0x4e79] = 0x8f98, [0x4e7a] = 0x8fd8,
+    [0x4f2d] = 0x8019, [0x4f30] = 0x8059, [0x4f31] = 0x8099, [0x4f32] = 0x80d9,
+    [0x4f33] = 0x8119, [0x4f34] = 0x8159, [0x4f35] = 0x8199, [0x4f36] = 0x81d9,
+    [0x4f37] = 0x8219, [0x4f38] = 0x8259, [0x4f39] = 0x8299, [0x4f41] = 0x82d9,
+    [0x4f42] = 0x8319, [0x4f43] = 0x8359, [0x4f44] = 0x8399, [0x4f45] = 0x83d9,
+    [0x4f46] = 0x8419, [0x4f47] = 0x8459, [0x4f48] = 0x8499, [0x4f49] = 0x84d9,
+    [0x4f4a] = 0x8519, [0x4f4b] = 0x8559, [0x4f4c] = 0x8599, [0x4f4d] = 0x85d9,
+    [0x4f4e] = 0x8619, [0x4f4f] = 0x8659, [0x4f50] = 0x8699, [0x4f51] = 0x86d9,
+    [0x4f52] = 0x8719, [0x4f53] = 0x8759, [0x4f54] = 0x8799, [0x4f55] = 0x87d9,
+    [0x4f56] = 0x8819, [0x4f57] = 0x8859, [0x4f58] = 0x8899, [0x4f59] = 0x88d9,
+    [0x4f5a] = 0x8919, [0x4f5f] = 0x8959, [0x4f61] = 0x8999, [0x4f62] = 0x89d9,
+    [0x4f63] = 0x8a19, [0x4f64] = 0x8a59, [0x4f65] = 0x8a99, [0x4f66] = 0x8ad9,
+    [0x4f67] = 0x8b19, [0x4f68] = 0x8b59, [0x4f69] = 0x8b99, [0x4f6a] = 0x8bd9,
+    [0x4f6b] = 0x8c19, [0x4f6c] = 0x8c59, [0x4f6d] = 0x8c99, [0x4f6e] = 0x8cd9,
+    [0x4f6f] = 0x8d19, [0x4f70] = 0x8d59, [0x4f71] = 0x8d99, [0x4f72] = 0x8dd9,
+    [0x4f73] = 0x8e19, [0x4f74] = 0x8e59, [0x4f75] = 0x8e99, [0x4f76] = 0x8ed9,
+    [0x4f77] = 0x8f19, [0x4f78] = 0x8f59, [0x4f79] = 0x8f99, [0x4f7a] = 0x8fd9,
+    [0x502d] = 0x801a, [0x5030] = 0x805a, [0x5031] = 0x809a, [0x5032] = 0x80da,
+    [0x5033] = 0x811a, [0x5034] = 0x815a, [0x5035] = 0x819a, [0x5036] = 0x81da,
+    [0x5037] = 0x821a, [0x5038] = 0x825a, [0x5039] = 0x829a, [0x5041] = 0x82da,
+    [0x5042] = 0x831a, [0x5043] = 0x835a, [0x5044] = 0x839a, [0x5045] = 0x83da,
+    [0x5046] = 0x841a, [0x5047] = 0x845a, [0x5048] = 0x849a, [0x5049] = 0x84da,
+    [0x504a] = 0x851a, [0x504b] = 0x855a, [0x504c] = 0x859a, [0x504d] = 0x85da,
+    [0x504e] = 0x861a, [0x504f] = 0x865a, [0x5050] = 0x869a, [0x5051] = 0x86da,
+    [0x5052] = 0x871a, [0x5053] = 0x875a, [0x5054] = 0x879a, [0x5055] = 0x87da,
+    [0x5056] = 0x881a, [0x5057] = 0x885a, [0x5058] = 0x889a, [0x5059] = 0x88da,
+    [0x505a] = 0x891a, [0x505f] = 0x895a, [0x5061] = 0x899a, [0x5062] = 0x89da,
+    [0x5063] = 0x8a1a, [0x5064] = 0x8a5a, [0x5065] = 0x8a9a, [0x5066] = 0x8ada,
+    [0x5067] = 0x8b1a, [0x5068] = 0x8b5a, [0x5069] = 0x8b9a, [0x506a] = 0x8bda,
+    [0x506b] = 0x8c1a, [0x506c] = 0x8c5a, [0x506d] = 0x8c9a, [0x506e] = 0x8cda,
+    [0x506f] = 0x8d1a, [0x5070] = 0x8d5a, [0x5071] = 0x8d9a, [0x5072] = 0x8dda,
+    [0x5073] = 0x8e1a, [0x5074] = 0x8e5a, [0x5075] = 0x8e9a, [0x5076] = 0x8eda,
+    [0x5077] = 0x8f1a, [0x5078] = 0x8f5a, [0x5079] = 0x8f9a, [0x507a] = 0x8fda,
+    [0x512d] = 0x801b, [0x5130] = 0x805b, [0x5131] = 0x809b, [0x5132] = 0x80db,
+    [0x5133] = 0x811b, [0x5134] = 0x815b, [0x5135] = 0x819b, [0x5136] = 0x81db,
+    [0x5137] = 0x821b, [0x5138] = 0x825b, [0x5139] = 0x829b, [0x5141] = 0x82db,
+    [0x5142] = 0x831b, [0x5143] = 0x835b, [0x5144] = 0x839b, [0x5145] = 0x83db,
+    [0x5146] = 0x841b, [0x5147] = 0x845b, [0x5148] = 0x849b, [0x5149] = 0x84db,
+    [0x514a] = 0x851b, [0x514b] = 0x855b, [0x514c] = 0x859b, [0x514d] = 0x85db,
+    [0x514e] = 0x861b, [0x514f] = 0x865b, [0x5150] = 0x869b, [0x5151] = 0x86db,
+    [0x5152] = 0x871b, [0x5153] = 0x875b, [0x5154] = 0x879b, [0x5155] = 0x87db,
+    [0x5156] = 0x881b, [0x5157] = 0x885b, [0x5158] = 0x889b, [0x5159] = 0x88db,
+    [0x515a] = 0x891b, [0x515f] = 0x895b, [0x5161] = 0x899b, [0x5162] = 0x89db,
+    [0x5163] = 0x8a1b, [0x5164] = 0x8a5b, [0x5165] = 0x8a9b, [0x5166] = 0x8adb,
+    [0x5167] = 0x8b1b, [0x5168] = 0x8b5b, [0x5169] = 0x8b9b, [0x516a] = 0x8bdb,
+    [0x516b] = 0x8c1b, [0x516c] = 0x8c5b, [0x516d] = 0x8c9b, [0x516e] = 0x8cdb,
+    [0x516f] = 0x8d1b, [0x5170] = 0x8d5b, [0x5171] = 0x8d9b, [0x5172] = 0x8ddb,
+    [0x5173] = 0x8e1b, [0x5174] = 0x8e5b, [0x5175] = 0x8e9b, [0x5176] = 0x8edb,
+    [0x5177] = 0x8f1b, [0x5178] = 0x8f5b, [0x5179] = 0x8f9b, [0x517a] = 0x8fdb,
+    [0x522d] = 0x801c, [0x5230] = 0x805c, [0x5231] = 0x809c, [0x5232] = 0x80dc,
+    [0x5233] = 0x811c, [0x5234] = 0x815c, [0x5235] = 0x819c, [0x5236] = 0x81dc,
+    [0x5237] = 0x821c, [0x5238] = 0x825c, [0x5239] = 0x829c, [0x5241] = 0x82dc,
+    [0x5242] = 0x831c, [0x5243] = 0x835c, [0x5244] = 0x839c, [0x5245] = 0x83dc,
+    [0x5246] = 0x841c, [0x5247] = 0x845c, [0x5248] = 0x849c, [0x5249] = 0x84dc,
+    [0x524a] = 0x851c, [0x524b] = 0x855c, [0x524c] = 0x859c, [0x524d] = 0x85dc,
+    [0x524e] = 0x861c, [0x524f] = 0x865c, [0x5250] = 0x869c, [0x5251] = 0x86dc,
+    [0x5252] = 0x871c, [0x5253] = 0x875c, [0x5254] = 0x879c, [0x5255] = 0x87dc,
+    [0x5256] = 0x881c, [0x5257] = 0x885c, [0x5258] = 0x889c, [0x5259] = 0x88dc,
+    [0x525a] = 0x891c, [0x525f] = 0x895c, [0x5261] = 0x899c, [0x5262] = 0x89dc,
+    [0x5263] = 0x8a1c, [0x5264] = 0x8a5c, [0x5265] = 0x8a9c, [0x5266] = 0x8adc,
+    [0x5267] = 0x8b1c, [0x5268] = 0x8b5c, [0x5269] = 0x8b9c, [0x526a] = 0x8bdc,
+    [0x526b] = 0x8c1c, [0x526c] = 0x8c5c, [0x526d] = 0x8c9c, [0x526e] = 0x8cdc,
+    [0x526f] = 0x8d1c, [0x5270] = 0x8d5c, [0x5271] = 0x8d9c, [0x5272] = 0x8ddc,
+    [0x5273] = 0x8e1c, [0x5274] = 0x8e5c, [0x5275] = 0x8e9c, [0x5276] = 0x8edc,
+    [0x5277] = 0x8f1c, [0x5278] = 0x8f5c, [0x5279] = 0x8f9c, [0x527a] = 0x8fdc,
+    [0x532d] = 0x801d, [0x5330] = 0x805d, [0x5331] = 0x809d, [0x5332] = 0x80dd,
+    [0x5333] = 0x811d, [0x5334] = 0x815d, [0x5335] = 0x819d, [0x5336] = 0x81dd,
+    [0x5337] = 0x821d, [0x5338] = 0x825d, [0x5339] = 0x829d, [0x5341] = 0x82dd,
+    [0x5342] = 0x831d, [0x5343] = 0x835d, [0x5344] = 0x839d, [0x5345] = 0x83dd,
+    [0x5346] = 0x841d, [0x5347] = 0x845d, [0x5348] = 0x849d, [0x5349] = 0x84dd,
+    [0x534a] = 0x851d, [0x534b] = 0x855d, [0x534c] = 0x859d, [0x534d] = 0x85dd,
+    [0x534e] = 0x861d, [0x534f] = 0x865d, [0x5350] = 0x869d, [0x5351] = 0x86dd,
+    [0x5352] = 0x871d, [0x5353] = 0x875d, [0x5354] = 0x879d, [0x5355] = 0x87dd,
+    [0x5356] = 0x881d, [0x5357] = 0x885d, [0x5358] = 0x889d, [0x5359] = 0x88dd,
+    [0x535a] = 0x891d, [0x535f] = 0x895d, [0x5361] = 0x899d, [0x5362] = 0x89dd,
+    [0x5363] = 0x8a1d, [0x5364] = 0x8a5d, [0x5365] = 0x8a9d, [0x5366] = 0x8add,
+    [0x5367] = 0x8b1d, [0x5368] = 0x8b5d, [0x5369] = 0x8b9d, [0x536a] = 0x8bdd,
+    [0x536b] = 0x8c1d, [0x536c] = 0x8c5d, [0x536d] = 0x8c9d, [0x536e] = 0x8cdd,
+    [0x536f] = 0x8d1d, [0x5370] = 0x8d5d, [0x5371] = 0x8d9d, [0x5372] = 0x8ddd,
+    [0x5373] = 0x8e1d, [0x5374] = 0x8e5d, [0x5375] = 0x8e9d, [0x5376] = 0x8edd,
+    [0x5377] = 0x8f1d, [0x5378] = 0x8f5d, [0x5379] = 0x8f9d, [0x537a] = 0x8fdd,
+    [0x542d] = 0x801e, [0x5430] = 0x805e, [0x5431] = 0x809e, [0x5432] = 0x80de,
+    [0x5433] = 0x811e, [0x5434] = 0x815e, [0x5435] = 0x819e, [0x5436] = 0x81de,
+    [0x5437] = 0x821e, [0x5438] = 0x825e, [0x5439] = 0x829e, [0x5441] = 0x82de,
+    [0x5442] = 0x831e, [0x5443] = 0x835e, [0x5444] = 0x839e, [0x5445] = 0x83de,
+    [0x5446] = 0x841e, [0x5447] = 0x845e, [0x5448] = 0x849e, [0x5449] = 0x84de,
+    [0x544a] = 0x851e, [0x544b] = 0x855e, [0x544c] = 0x859e, [0x544d] = 0x85de,
+    [0x544e] = 0x861e, [0x544f] = 0x865e, [0x5450] = 0x869e, [0x5451] = 0x86de,
+    [0x5452] = 0x871e, [0x5453] = 0x875e, [0x5454] = 0x879e, [0x5455] = 0x87de,
+    [0x5456] = 0x881e, [0x5457] = 0x885e, [0x5458] = 0x889e, [0x5459] = 0x88de,
+    [0x545a] = 0x891e, [0x545f] = 0x895e, [0x5461] = 0x899e, [0x5462] = 0x89de,
+    [0x5463] = 0x8a1e, [0x5464] = 0x8a5e, [0x5465] = 0x8a9e, [0x5466] = 0x8ade,
+    [0x5467] = 0x8b1e, [0x5468] = 0x8b5e, [0x5469] = 0x8b9e, [0x546a] = 0x8bde,
+    [0x546b] = 0x8c1e, [0x546c] = 0x8c5e, [0x546d] = 0x8c9e, [0x546e] = 0x8cde,
+    [0x546f] = 0x8d1e, [0x5470] = 0x8d5e, [0x5471] = 0x8d9e, [0x5472] = 0x8dde,
+    [0x5473] = 0x8e1e, [0x5474] = 0x8e5e, [0x5475] = 0x8e9e, [0x5476] = 0x8ede,
+    [0x5477] = 0x8f1e, [0x5478] = 0x8f5e, [0x5479] = 0x8f9e, [0x547a] = 0x8fde,
+    [0x552d] = 0x801f, [0x5530] = 0x805f, [0x5531] = 0x809f, [0x5532] = 0x80df,
+    [0x5533] = 0x811f, [0x5534] = 0x815f, [0x5535] = 0x819f, [0x5536] = 0x81df,
+    [0x5537] = 0x821f, [0x5538] = 0x825f, [0x5539] = 0x829f, [0x5541] = 0x82df,
+    [0x5542] = 0x831f, [0x5543] = 0x835f, [0x5544] = 0x839f, [0x5545] = 0x83df,
+    [0x5546] = 0x841f, [0x5547] = 0x845f, [0x5548] = 0x849f, [0x5549] = 0x84df,
+    [0x554a] = 0x851f, [0x554b] = 0x855f, [0x554c] = 0x859f, [0x554d] = 0x85df,
+    [0x554e] = 0x861f, [0x554f] = 0x865f, [0x5550] = 0x869f, [0x5551] = 0x86df,
+    [0x5552] = 0x871f, [0x5553] = 0x875f, [0x5554] = 0x879f, [0x5555] = 0x87df,
+    [0x5556] = 0x881f, [0x5557] = 0x885f, [0x5558] = 0x889f, [0x5559] = 0x88df,
+    [0x555a] = 0x891f, [0x555f] = 0x895f, [0x5561] = 0x899f, [0x5562] = 0x89df,
+    [0x5563] = 0x8a1f, [0x5564] = 0x8a5f, [0x5565] = 0x8a9f, [0x5566] = 0x8adf,
+    [0x5567] = 0x8b1f, [0x5568] = 0x8b5f, [0x5569] = 0x8b9f, [0x556a] = 0x8bdf,
+    [0x556b] = 0x8c1f, [0x556c] = 0x8c5f, [0x556d] = 0x8c9f, [0x556e] = 0x8cdf,
+    [0x556f] = 0x8d1f, [0x5570] = 0x8d5f, [0x5571] = 0x8d9f, [0x5572] = 0x8ddf,
+    [0x5573] = 0x8e1f, [0x5574] = 0x8e5f, [0x5575] = 0x8e9f, [0x5576] = 0x8edf,
+    [0x5577] = 0x8f1f, [0x5578] = 0x8f5f, [0x5579] = 0x8f9f, [0x557a] = 0x8fdf,
+    [0x562d] = 0x8020, [0x5630] = 0x8060, [0x5631] = 0x80a0, [0x5632] = 0x80e0,
+    [0x5633] = 0x8120, [0x5634] = 0x8160, [0x5635] = 0x81a0, [0x5636] = 0x81e0,
+    [0x5637] = 0x8220, [0x5638] = 0x8260, [0x5639] = 0x82a0, [0x5641] = 0x82e0,
+    [0x5642] = 0x8320, [0x5643] = 0x8360, [0x5644] = 0x83a0, [0x5645] = 0x83e0,
+    [0x5646] = 0x8420, [0x5647] = 0x8460, [0x5648] = 0x84a0, [0x5649] = 0x84e0,
+    [0x564a] = 0x8520, [0x564b] = 0x8560, [0x564c] = 0x85a0, [0x564d] = 0x85e0,
+    [0x564e] = 0x8620, [0x564f] = 0x8660, [0x5650] = 0x86a0, [0x5651] = 0x86e0,
+    [0x5652] = 0x8720, [0x5653] = 0x8760, [0x5654] = 0x87a0, [0x5655] = 0x87e0,
+    [0x5656] = 0x8820, [0x5657] = 0x8860, [0x5658] = 0x88a0, [0x5659] = 0x88e0,
+    [0x565a] = 0x8920, [0x565f] = 0x8960, [0x5661] = 0x89a0, [0x5662] = 0x89e0,
+    [0x5663] = 0x8a20, [0x5664] = 0x8a60, [0x5665] = 0x8aa0, [0x5666] = 0x8ae0,
+    [0x5667] = 0x8b20, [0x5668] = 0x8b60, [0x5669] = 0x8ba0, [0x566a] = 0x8be0,
+    [0x566b] = 0x8c20, [0x566c] = 0x8c60, [0x566d] = 0x8ca0, [0x566e] = 0x8ce0,
+    [0x566f] = 0x8d20, [0x5670] = 0x8d60, [0x5671] = 0x8da0, [0x5672] = 0x8de0,
+    [0x5673] = 0x8e20, [0x5674] = 0x8e60, [0x5675] = 0x8ea0, [0x5676] = 0x8ee0,
+    [0x5677] = 0x8f20, [0x5678] = 0x8f60, [0x5679] = 0x8fa0, [0x567a] = 0x8fe0,
+    [0x572d] = 0x8021, [0x5730] = 0x8061, [0x5731] = 0x80a1, [0x5732] = 0x80e1,
+    [0x5733] = 0x8121, [0x5734] = 0x8161, [0x5735] = 0x81a1, [0x5736] = 0x81e1,
+    [0x5737] = 0x8221, [0x5738] = 0x8261, [0x5739] = 0x82a1, [0x5741] = 0x82e1,
+    [0x5742] = 0x8321, [0x5743] = 0x8361, [0x5744] = 0x83a1, [0x5745] = 0x83e1,
+    [0x5746] = 0x8421, [0x5747] = 0x8461, [0x5748] = 0x84a1, [0x5749] = 0x84e1,
+    [0x574a] = 0x8521, [0x574b] = 0x8561, [0x574c] = 0x85a1, [0x574d] = 0x85e1,
+    [0x574e] = 0x8621, [0x574f] = 0x8661, [0x5750] = 0x86a1, [0x5751] = 0x86e1,
+    [0x5752] = 0x8721, [0x5753] = 0x8761, [0x5754] = 0x87a1, [0x5755] = 0x87e1,
+    [0x5756] = 0x8821, [0x5757] = 0x8861, [0x5758] = 0x88a1, [0x5759] = 0x88e1,
+    [0x575a] = 0x8921, [0x575f] = 0x8961, [0x5761] = 0x89a1, [0x5762] = 0x89e1,
+    [0x5763] = 0x8a21, [0x5764] = 0x8a61, [0x5765] = 0x8aa1, [0x5766] = 0x8ae1,
+    [0x5767] = 0x8b21, [0x5768] = 0x8b61, [0x5769] = 0x8ba1, [0x576a] = 0x8be1,
+    [0x576b] = 0x8c21, [0x576c] = 0x8c61, [0x576d] = 0x8ca1, [0x576e] = 0x8ce1,
+    [0x576f] = 0x8d21, [0x5770] = 0x8d61, [0x5771] = 0x8da1, [0x5772] = 0x8de1,
+    [0x5773] = 0x8e21, [0x5774] = 0x8e61, [0x5775] = 0x8ea1, [0x5776] = 0x8ee1,
+    [0x5777] = 0x8f21, [0x5778] = 0x8f61, [0x5779] = 0x8fa1, [0x577a] = 0x8fe1,
+    [0x582d] = 0x8022, [0x5830] = 0x8062, [0x5831] = 0x80a2, [0x5832] = 0x80e2,
+    [0x5833] = 0x8122, [0x5834] = 0x8162, [0x5835] = 0x81a2, [0x5836] = 0x81e2,
+    [0x5837] = 0x8222, [0x5838] = 0x8262, [0x5839] = 0x82a2, [0x5841] = 0x82e2,
+    [0x5842] = 0x8322, [0x5843] = 0x8362, [0x5844] = 0x83a2, [0x5845] = 0x83e2,
+    [0x5846] = 0x8422, [0x5847] = 0x8462, [0x5848] = 0x84a2, [0x5849] = 0x84e2,
+    [0x584a] = 0x8522, [0x584b] = 0x8562, [0x584c] = 0x85a2, [0x584d] = 0x85e2,
+    [0x584e] = 0x8622, [0x584f] = 0x8662, [0x5850] = 0x86a2, [0x5851] = 0x86e2,
+    [0x5852] = 0x8722, [0x5853] = 0x8762, [0x5854] = 0x87a2, [0x5855] = 0x87e2,
+    [0x5856] = 0x8822, [0x5857] = 0x8862, [0x5858] = 0x88a2, [0x5859] = 0x88e2,
+    [0x585a] = 0x8922, [0x585f] = 0x8962, [0x5861] = 0x89a2, [0x5862] = 0x89e2,
+    [0x5863] = 0x8a22, [0x5864] = 0x8a62, [0x5865] = 0x8aa2, [0x5866] = 0x8ae2,
+    [0x5867] = 0x8b22, [0x5868] = 0x8b62, [0x5869] = 0x8ba2, [0x586a] = 0x8be2,
+    [0x586b] = 0x8c22, [0x586c] = 0x8c62, [0x586d] = 0x8ca2, [0x586e] = 0x8ce2,
+    [0x586f] = 0x8d22, [0x5870] = 0x8d62, [0x5871] = 0x8da2, [0x5872] = 0x8de2,
+    [0x5873] = 0x8e22, [0x5874] = 0x8e62, [0x5875] = 0x8ea2, [0x5876] = 0x8ee2,
+    [0x5877] = 0x8f22, [0x5878] = 0x8f62, [0x5879] = 0x8fa2, [0x587a] = 0x8fe2,
+    [0x592d] = 0x8023, [0x5930] = 0x8063, [0x5931] = 0x80a3, [0x5932] = 0x80e3,
+    [0x5933] = 0x8123, [0x5934] = 0x8163, [0x5935] = 0x81a3, [0x5936] = 0x81e3,
+    [0x5937] = 0x8223, [0x5938] = 0x8263, [0x5939] = 0x82a3, [0x5941] = 0x82e3,
+    [0x5942] = 0x8323, [0x5943] = 0x8363, [0x5944] = 0x83a3, [0x5945] = 0x83e3,
+    [0x5946] = 0x8423, [0x5947] = 0x8463, [0x5948] = 0x84a3, [0x5949] = 0x84e3,
+    [0x594a] = 0x8523, [0x594b] = 0x8563, [0x594c] = 0x85a3, [0x594d] = 0x85e3,
+    [0x594e] = 0x8623, [0x594f] = 0x8663, [0x5950] = 0x86a3, [0x5951] = 0x86e3,
+    [0x5952] = 0x8723, [0x5953] = 0x8763, [0x5954] = 0x87a3, [0x5955] = 0x87e3,
+    [0x5956] = 0x8823, [0x5957] = 0x8863, [0x5958] = 0x88a3, [0x5959] = 0x88e3,
+    [0x595a] = 0x8923, [0x595f] = 0x8963, [0x5961] = 0x89a3, [0x5962] = 0x89e3,
+    [0x5963] = 0x8a23, [0x5964] = 0x8a63, [0x5965] = 0x8aa3, [0x5966] = 0x8ae3,
+    [0x5967] = 0x8b23, [0x5968] = 0x8b63, [0x5969] = 0x8ba3, [0x596a] = 0x8be3,
+    [0x596b] = 0x8c23, [0x596c] = 0x8c63, [0x596d] = 0x8ca3, [0x596e] = 0x8ce3,
+    [0x596f] = 0x8d23, [0x5970] = 0x8d63, [0x5971] = 0x8da3, [0x5972] = 0x8de3,
+    [0x5973] = 0x8e23, [0x5974] = 0x8e63, [0x5975] = 0x8ea3, [0x5976] = 0x8ee3,
+    [0x5977] = 0x8f23, [0x5978] = 0x8f63, [0x5979] = 0x8fa3, [0x597a] = 0x8fe3,
+    [0x5a2d] = 0x8024, [0x5a30] = 0x8064, [0x5a31] = 0x80a4, [0x5a32] = 0x80e4,
+    [0x5a33] = 0x8124, [0x5a34] = 0x8164, [0x5a35] = 0x81a4, [0x5a36] = 0x81e4,
+    [0x5a37] = 0x8224, [0x5a38] = 0x8264, [0x5a39] = 0x82a4, [0x5a41] = 0x82e4,
+    [0x5a42] = 0x8324, [0x5a43] = 0x8364, [0x5a44] = 0x83a4, [0x5a45] = 0x83e4,
+    [0x5a46] = 0x8424, [0x5a47] = 0x8464, [0x5a48] = 0x84a4, [0x5a49] = 0x84e4,
+    [0x5a4a] = 0x8524, [0x5a4b] = 0x8564, [0x5a4c] = 0x85a4, [0x5a4d] = 0x85e4,
+    [0x5a4e] = 0x8624, [0x5a4f] = 0x8664, [0x5a50] = 0x86a4, [0x5a51] = 0x86e4,
+    [0x5a52] = 0x8724, [0x5a53] = 0x8764, [0x5a54] = 0x87a4, [0x5a55] = 0x87e4,
+    [0x5a56] = 0x8824, [0x5a57] = 0x8864, [0x5a58] = 0x88a4, [0x5a59] = 0x88e4,
+    [0x5a5a] = 0x8924, [0x5a5f] = 0x8964, [0x5a61] = 0x89a4, [0x5a62] = 0x89e4,
+    [0x5a63] = 0x8a24, [0x5a64] = 0x8a64, [0x5a65] = 0x8aa4, [0x5a66] = 0x8ae4,
+    [0x5a67] = 0x8b24, [0x5a68] = 0x8b64, [0x5a69] = 0x8ba4, [0x5a6a] = 0x8be4,
+    [0x5a6b] = 0x8c24, [0x5a6c] = 0x8c64, [0x5a6d] = 0x8ca4, [0x5a6e] = 0x8ce4,
+    [0x5a6f] = 0x8d24, [0x5a70] = 0x8d64, [0x5a71] = 0x8da4, [0x5a72] = 0x8de4,
+    [0x5a73] = 0x8e24, [0x5a74] = 0x8e64, [0x5a75] = 0x8ea4, [0x5a76] = 0x8ee4,
+    [0x5a77] = 0x8f24, [0x5a78] = 0x8f64, [0x5a79] = 0x8fa4, [0x5a7a] = 0x8fe4,
+    [0x5f2d] = 0x8025, [0x5f30] = 0x8065, [0x5f31] = 0x80a5, [0x5f32] = 0x80e5,
+    [0x5f33] = 0x8125, [0x5f34] = 0x8165, [0x5f35] = 0x81a5, [0x5f36] = 0x81e5,
+    [0x5f37] = 0x8225, [0x5f38] = 0x8265, [0x5f39] = 0x82a5, [0x5f41] = 0x82e5,
+    [0x5f42] = 0x8325, [0x5f43] = 0x8365, [0x5f44] = 0x83a5, [0x5f45] = 0x83e5,
+    [0x5f46] = 0x8425, [0x5f47] = 0x8465, [0x5f48] = 0x84a5, [0x5f49] = 0x84e5,
+    [0x5f4a] = 0x8525, [0x5f4b] = 0x8565, [0x5f4c] = 0x85a5, [0x5f4d] = 0x85e5,
+    [0x5f4e] = 0x8625, [0x5f4f] = 0x8665, [0x5f50] = 0x86a5, [0x5f51] = 0x86e5,
+    [0x5f52] = 0x8725, [0x5f53] = 0x8765, [0x5f54] = 0x87a5, [0x5f55] = 0x87e5,
+    [0x5f56] = 0x8825, [0x5f57] = 0x8865, [0x5f58] = 0x88a5, [0x5f59] = 0x88e5,
+    [0x5f5a] = 0x8925, [0x5f5f] = 0x8965, [0x5f61] = 0x89a5, [0x5f62] = 0x89e5,
+    [0x5f63] = 0x8a25, [0x5f64] = 0x8a65, [0x5f65] = 0x8aa5, [0x5f66] = 0x8ae5,
+    [0x5f67] = 0x8b25, [0x5f68] = 0x8b65, [0x5f69] = 0x8ba5, [0x5f6a] = 0x8be5,
+    [0x5f6b] = 0x8c25, [0x5f6c] = 0x8c65, [0x5f6d] = 0x8ca5, [0x5f6e] = 0x8ce5,
+    [0x5f6f] = 0x8d25, [0x5f70] = 0x8d65, [0x5f71] = 0x8da5, [0x5f72] = 0x8de5,
+    [0x5f73] = 0x8e25, [0x5f74] = 0x8e65, [0x5f75] = 0x8ea5, [0x5f76] = 0x8ee5,
+    [0x5f77] = 0x8f25, [0x5f78] = 0x8f65, [0x5f79] = 0x8fa5, [0x5f7a] = 0x8fe5,
+    [0x612d] = 0x8026, [0x6130] = 0x8066, [0x6131] = 0x80a6, [0x6132] = 0x80e6,
+    [0x6133] = 0x8126, [0x6134] = 0x8166, [0x6135] = 0x81a6, [0x6136] = 0x81e6,
+    [0x6137] = 0x8226, [0x6138] = 0x8266, [0x6139] = 0x82a6, [0x6141] = 0x82e6,
+    [0x6142] = 0x8326, [0x6143] = 0x8366, [0x6144] = 0x83a6, [0x6145] = 0x83e6,
+    [0x6146] = 0x8426, [0x6147] = 0x8466, [0x6148] = 0x84a6, [0x6149] = 0x84e6,
+    [0x614a] = 0x8526, [0x614b] = 0x8566, [0x614c] = 0x85a6, [0x614d] = 0x85e6,
+    [0x614e] = 0x8626, [0x614f] = 0x8666, [0x6150] = 0x86a6, [0x6151] = 0x86e6,
+    [0x6152] = 0x8726, [0x6153] = 0x8766, [0x6154] = 0x87a6, [0x6155] = 0x87e6,
+    [0x6156] = 0x8826, [0x6157] = 0x8866, [0x6158] = 0x88a6, [0x6159] = 0x88e6,
+    [0x615a] = 0x8926, [0x615f] = 0x8966, [0x6161] = 0x89a6, [0x6162] = 0x89e6,
+    [0x6163] = 0x8a26, [0x6164] = 0x8a66, [0x6165] = 0x8aa6, [0x6166] = 0x8ae6,
+    [0x6167] = 0x8b26, [0x6168] = 0x8b66, [0x6169] = 0x8ba6, [0x616a] = 0x8be6,
+    [0x616b] = 0x8c26, [0x616c] = 0x8c66, [0x616d] = 0x8ca6, [0x616e] = 0x8ce6,
+    [0x616f] = 0x8d26, [0x6170] = 0x8d66, [0x6171] = 0x8da6, [0x6172] = 0x8de6,
+    [0x6173] = 0x8e26, [0x6174] = 0x8e66, [0x6175] = 0x8ea6, [0x6176] = 0x8ee6,
+    [0x6177] = 0x8f26, [0x6178] = 0x8f66, [0x6179] = 0x8fa6, [0x617a] = 0x8fe6,
+    [0x622d] = 0x8027, [0x6230] = 0x8067, [0x6231] = 0x80a7, [0x6232] = 0x80e7,
+    [0x6233] = 0x8127, [0x6234] = 0x8167, [0x6235] = 0x81a7, [0x6236] = 0x81e7,
+    [0x6237] = 0x8227, [0x6238] = 0x8267, [0x6239] = 0x82a7, [0x6241] = 0x82e7,
+    [0x6242] = 0x8327, [0x6243] = 0x8367, [0x6244] = 0x83a7, [0x6245] = 0x83e7,
+    [0x6246] = 0x8427, [0x6247] = 0x8467, [0x6248] = 0x84a7, [0x6249] = 0x84e7,
+    [0x624a] = 0x8527, [0x624b] = 0x8567, [0x624c] = 0x85a7, [0x624d] = 0x85e7,
+    [0x624e] = 0x8627, [0x624f] = 0x8667, [0x6250] = 0x86a7, [0x6251] = 0x86e7,
+    [0x6252] = 0x8727, [0x6253] = 0x8767, [0x6254] = 0x87a7, [0x6255] = 0x87e7,
+    [0x6256] = 0x8827, [0x6257] = 0x8867, [0x6258] = 0x88a7, [0x6259] = 0x88e7,
+    [0x625a] = 0x8927, [0x625f] = 0x8967, [0x6261] = 0x89a7, [0x6262] = 0x89e7,
+    [0x6263] = 0x8a27, [0x6264] = 0x8a67, [0x6265] = 0x8aa7, [0x6266] = 0x8ae7,
+    [0x6267] = 0x8b27, [0x6268] = 0x8b67, [0x6269] = 0x8ba7, [0x626a] = 0x8be7,
+    [0x626b] = 0x8c27, [0x626c] = 0x8c67, [0x626d] = 0x8ca7, [0x626e] = 0x8ce7,
+    [0x626f] = 0x8d27, [0x6270] = 0x8d67, [0x6271] = 0x8da7, [0x6272] = 0x8de7,
+    [0x6273] = 0x8e27, [0x6274] = 0x8e67, [0x6275] = 0x8ea7, [0x6276] = 0x8ee7,
+    [0x6277] = 0x8f27, [0x6278] = 0x8f67, [0x6279] = 0x8fa7, [0x627a] = 0x8fe7,
+    [0x632d] = 0x8028, [0x6330] = 0x8068, [0x6331] = 0x80a8, [0x6332] = 0x80e8,
+    [0x6333] = 0x8128, [0x6334] = 0x8168, [0x6335] = 0x81a8, [0x6336] = 0x81e8,
+    [0x6337] = 0x8228, [0x6338] = 0x8268, [0x6339] = 0x82a8, [0x6341] = 0x82e8,
+    [0x6342] = 0x8328, [0x6343] = 0x8368, [0x6344] = 0x83a8, [0x6345] = 0x83e8,
+    [0x6346] = 0x8428, [0x6347] = 0x8468, [0x6348] = 0x84a8, [0x6349] = 0x84e8,
+    [0x634a] = 0x8528, [0x634b] = 0x8568, [0x634c] = 0x85a8, [0x634d] = 0x85e8,
+    [0x634e] = 0x8628, [0x634f] = 0x8668, [0x6350] = 0x86a8, [0x6351] = 0x86e8,
+    [0x6352] = 0x8728, [0x6353] = 0x8768, [0x6354] = 0x87a8, [0x6355] = 0x87e8,
+    [0x6356] = 0x8828, [0x6357] = 0x8868, [0x6358] = 0x88a8, [0x6359] = 0x88e8,
+    [0x635a] = 0x8928, [0x635f] = 0x8968, [0x6361] = 0x89a8, [0x6362] = 0x89e8,
+    [0x6363] = 0x8a28, [0x6364] = 0x8a68, [0x6365] = 0x8aa8, [0x6366] = 0x8ae8,
+    [0x6367] = 0x8b28, [0x6368] = 0x8b68, [0x6369] = 0x8ba8, [0x636a] = 0x8be8,
+    [0x636b] = 0x8c28, [0x636c] = 0x8c68, [0x636d] = 0x8ca8, [0x636e] = 0x8ce8,
+    [0x636f] = 0x8d28, [0x6370] = 0x8d68, [0x6371] = 0x8da8, [0x6372] = 0x8de8,
+    [0x6373] = 0x8e28, [0x6374] = 0x8e68, [0x6375] = 0x8ea8, [0x6376] = 0x8ee8,
+    [0x6377] = 0x8f28, [0x6378] = 0x8f68, [0x6379] = 0x8fa8, [0x637a] = 0x8fe8,
+    [0x642d] = 0x8029, [0x6430] = 0x8069, [0x6431] = 0x80a9, [0x6432] = 0x80e9,
+    [0x6433] = 0x8129, [0x6434] = 0x8169, [0x6435] = 0x81a9, [0x6436] = 0x81e9,
+    [0x6437] = 0x8229, [0x6438] = 0x8269, [0x6439] = 0x82a9, [0x6441] = 0x82e9,
+    [0x6442] = 0x8329, [0x6443] = 0x8369, [0x6444] = 0x83a9, [0x6445] = 0x83e9,
+    [0x6446] = 0x8429, [0x6447] = 0x8469, [0x6448] = 0x84a9, [0x6449] = 0x84e9,
+    [0x644a] = 0x8529, [0x644b] = 0x8569, [0x644c] = 0x85a9, [0x644d] = 0x85e9,
+    [0x644e] = 0x8629, [0x644f] = 0x8669, [0x6450] = 0x86a9, [0x6451] = 0x86e9,
+    [0x6452] = 0x8729, [0x6453] = 0x8769, [0x6454] = 0x87a9, [0x6455] = 0x87e9,
+    [0x6456] = 0x8829, [0x6457] = 0x8869, [0x6458] = 0x88a9, [0x6459] = 0x88e9,
+    [0x645a] = 0x8929, [0x645f] = 0x8969, [0x6461] = 0x89a9, [0x6462] = 0x89e9,
+    [0x6463] = 0x8a29, [0x6464] = 0x8a69, [0x6465] = 0x8aa9, [0x6466] = 0x8ae9,
+    [0x6467] = 0x8b29, [0x6468] = 0x8b69, [0x6469] = 0x8ba9, [0x646a] = 0x8be9,
+    [0x646b] = 0x8c29, [0x646c] = 0x8c69, [0x646d] = 0x8ca9, [0x646e] = 0x8ce9,
+    [0x646f] = 0x8d29, [0x6470] = 0x8d69, [0x6471] = 0x8da9, [0x6472] = 0x8de9,
+    [0x6473] = 0x8e29, [0x6474] = 0x8e69, [0x6475] = 0x8ea9, [0x6476] = 0x8ee9,
+    [0x6477] = 0x8f29, [0x6478] = 0x8f69, [0x6479] = 0x8fa9, [0x647a] = 0x8fe9,
+    [0x652d] = 0x802a, [0x6530] = 0x806a, [0x6531] = 0x80aa, [0x6532] = 0x80ea,
+    [0x6533] = 0x812a, [0x6534] = 0x816a, [0x6535] = 0x81aa, [0x6536] = 0x81ea,
+    [0x6537] = 0x822a, [0x6538] = 0x826a, [0x6539] = 0x82aa, [0x6541] = 0x82ea,
+    [0x6542] = 0x832a, [0x6543] = 0x836a, [0x6544] = 0x83aa, [0x6545] = 0x83ea,
+    [0x6546] = 0x842a, [0x6547] = 0x846a, [0x6548] = 0x84aa, [0x6549] = 0x84ea,
+    [0x654a] = 0x852a, [0x654b] = 0x856a, [0x654c] = 0x85aa, [0x654d] = 0x85ea,
+    [0x654e] = 0x862a, [0x654f] = 0x866a, [0x6550] = 0x86aa, [0x6551] = 0x86ea,
+    [0x6552] = 0x872a, [0x6553] = 0x876a, [0x6554] = 0x87aa, [0x6555] = 0x87ea,
+    [0x6556] = 0x882a, [0x6557] = 0x886a, [0x6558] = 0x88aa, [0x6559] = 0x88ea,
+    [0x655a] = 0x892a, [0x655f] = 0x896a, [0x6561] = 0x89aa, [0x6562] = 0x89ea,
+    [0x6563] = 0x8a2a, [0x6564] = 0x8a6a, [0x6565] = 0x8aaa, [0x6566] = 0x8aea,
+    [0x6567] = 0x8b2a, [0x6568] = 0x8b6a, [0x6569] = 0x8baa, [0x656a] = 0x8bea,
+    [0x656b] = 0x8c2a, [0x656c] = 0x8c6a, [0x656d] = 0x8caa, [0x656e] = 0x8cea,
+    [0x656f] = 0x8d2a, [0x6570] = 0x8d6a, [0x6571] = 0x8daa, [0x6572] = 0x8dea,
+    [0x6573] = 0x8e2a, [0x6574] = 0x8e6a, [0x6575] = 0x8eaa, [0x6576] = 0x8eea,
+    [0x6577] = 0x8f2a, [0x6578] = 0x8f6a, [0x6579] = 0x8faa, [0x657a] = 0x8fea,
+    [0x662d] = 0x802b, [0x6630] = 0x806b, [0x6631] = 0x80ab, [0x6632] = 0x80eb,
+    [0x6633] = 0x812b, [0x6634] = 0x816b, [0x6635] = 0x81ab, [0x6636] = 0x81eb,
+    [0x6637] = 0x822b, [0x6638] = 0x826b, [0x6639] = 0x82ab, [0x6641] = 0x82eb,
+    [0x6642] = 0x832b, [0x6643] = 0x836b, [0x6644] = 0x83ab, [0x6645] = 0x83eb,
+    [0x6646] = 0x842b, [0x6647] = 0x846b, [0x6648] = 0x84ab, [0x6649] = 0x84eb,
+    [0x664a] = 0x852b, [0x664b] = 0x856b, [0x664c] = 0x85ab, [0x664d] = 0x85eb,
+    [0x664e] = 0x862b, [0x664f] = 0x866b, [0x6650] = 0x86ab, [0x6651] = 0x86eb,
+    [0x6652] = 0x872b, [0x6653] = 0x876b, [0x6654] = 0x87ab, [0x6655] = 0x87eb,
+    [0x6656] = 0x882b, [0x6657] = 0x886b, [0x6658] = 0x88ab, [0x6659] = 0x88eb,
+    [0x665a] = 0x892b, [0x665f] = 0x896b, [0x6661] = 0x89ab, [0x6662] = 0x89eb,
+    [0x6663] = 0x8a2b, [0x6664] = 0x8a6b, [0x6665] = 0x8aab, [0x6666] = 0x8aeb,
+    [0x6667] = 0x8b2b, [0x6668] = 0x8b6b, [0x6669] = 0x8bab, [0x666a] = 0x8beb,
+    [0x666b] = 0x8c2b, [0x666c] = 0x8c6b, [0x666d] = 0x8cab, [0x666e] = 0x8ceb,
+    [0x666f] = 0x8d2b, [0x6670] = 0x8d6b, [0x6671] = 0x8dab, [0x6672] = 0x8deb,
+    [0x6673] = 0x8e2b, [0x6674] = 0x8e6b, [0x6675] = 0x8eab, [0x6676] = 0x8eeb,
+    [0x6677] = 0x8f2b, [0x6678] = 0x8f6b, [0x6679] = 0x8fab, [0x667a] = 0x8feb,
+    [0x672d] = 0x802c, [0x6730] = 0x806c, [0x6731] = 0x80ac, [0x6732] = 0x80ec,
+    [0x6733] = 0x812c, [0x6734] = 0x816c, [0x6735] = 0x81ac, [0x6736] = 0x81ec,
+    [0x6737] = 0x822c, [0x6738] = 0x826c, [0x6739] = 0x82ac, [0x6741] = 0x82ec,
+    [0x6742] = 0x832c, [0x6743] = 0x836c, [0x6744] = 0x83ac, [0x6745] = 0x83ec,
+    [0x6746] = 0x842c, [0x6747] = 0x846c, [0x6748] = 0x84ac, [0x6749] = 0x84ec,
+    [0x674a] = 0x852c, [0x674b] = 0x856c, [0x674c] = 0x85ac, [0x674d] = 0x85ec,
+    [0x674e] = 0x862c, [0x674f] = 0x866c, [0x6750] = 0x86ac, [0x6751] = 0x86ec,
+    [0x6752] = 0x872c, [0x6753] = 0x876c, [0x6754] = 0x87ac, [0x6755] = 0x87ec,
+    [0x6756] = 0x882c, [0x6757] = 0x886c, [0x6758] = 0x88ac, [0x6759] = 0x88ec,
+    [0x675a] = 0x892c, [0x675f] = 0x896c, [0x6761] = 0x89ac, [0x6762] = 0x89ec,
+    [0x6763] = 0x8a2c, [0x6764] = 0x8a6c, [0x6765] = 0x8aac, [0x6766] = 0x8aec,
+    [0x6767] = 0x8b2c, [0x6768] = 0x8b6c, [0x6769] = 0x8bac, [0x676a] = 0x8bec,
+    [0x676b] = 0x8c2c, [0x676c] = 0x8c6c, [0x676d] = 0x8cac, [0x676e] = 0x8cec,
+    [0x676f] = 0x8d2c, [0x6770] = 0x8d6c, [0x6771] = 0x8dac, [0x6772] = 0x8dec,
+    [0x6773] = 0x8e2c, [0x6774] = 0x8e6c, [0x6775] = 0x8eac, [0x6776] = 0x8eec,
+    [0x6777] = 0x8f2c, [0x6778] = 0x8f6c, [0x6779] = 0x8fac, [0x677a] = 0x8fec,
+    [0x682d] = 0x802d, [0x6830] = 0x806d, [0x6831] = 0x80ad, [0x6832] = 0x80ed,
+    [0x6833] = 0x812d, [0x6834] = 0x816d, [0x6835] = 0x81ad, [0x6836] = 0x81ed,
+    [0x6837] = 0x822d, [0x6838] = 0x826d, [0x6839] = 0x82ad, [0x6841] = 0x82ed,
+    [0x6842] = 0x832d, [0x6843] = 0x836d, [0x6844] = 0x83ad, [0x6845] = 0x83ed,
+    [0x6846] = 0x842d, [0x6847] = 0x846d, [0x6848] = 0x84ad, [0x6849] = 0x84ed,
+    [0x684a] = 0x852d, [0x684b] = 0x856d, [0x684c] = 0x85ad, [0x684d] = 0x85ed,
+    [0x684e] = 0x862d, [0x684f] = 0x866d, [0x6850] = 0x86ad, [0x6851] = 0x86ed,
+    [0x6852] = 0x872d, [0x6853] = 0x876d, [0x6854] = 0x87ad, [0x6855] = 0x87ed,
+    [0x6856] = 0x882d, [0x6857] = 0x886d, [0x6858] = 0x88ad, [0x6859] = 0x88ed,
+    [0x685a] = 0x892d, [0x685f] = 0x896d, [0x6861] = 0x89ad, [0x6862] = 0x89ed,
+    [0x6863] = 0x8a2d, [0x6864] = 0x8a6d, [0x6865] = 0x8aad, [0x6866] = 0x8aed,
+    [0x6867] = 0x8b2d, [0x6868] = 0x8b6d, [0x6869] = 0x8bad, [0x686a] = 0x8bed,
+    [0x686b] = 0x8c2d, [0x686c] = 0x8c6d, [0x686d] = 0x8cad, [0x686e] = 0x8ced,
+    [0x686f] = 0x8d2d, [0x6870] = 0x8d6d, [0x6871] = 0x8dad, [0x6872] = 0x8ded,
+    [0x6873] = 0x8e2d, [0x6874] = 0x8e6d, [0x6875] = 0x8ead, [0x6876] = 0x8eed,
+    [0x6877] = 0x8f2d, [0x6878] = 0x8f6d, [0x6879] = 0x8fad, [0x687a] = 0x8fed,
+    [0x692d] = 0x802e, [0x6930] = 0x806e, [0x6931] = 0x80ae, [0x6932] = 0x80ee,
+    [0x6933] = 0x812e, [0x6934] = 0x816e, [0x6935] = 0x81ae, [0x6936] = 0x81ee,
+    [0x6937] = 0x822e, [0x6938] = 0x826e, [0x6939] = 0x82ae, [0x6941] = 0x82ee,
+    [0x6942] = 0x832e, [0x6943] = 0x836e, [0x6944] = 0x83ae, [0x6945] = 0x83ee,
+    [0x6946] = 0x842e, [0x6947] = 0x846e, [0x6948] = 0x84ae, [0x6949] = 0x84ee,
+    [0x694a] = 0x852e, [0x694b] = 0x856e, [0x694c] = 0x85ae, [0x694d] = 0x85ee,
+    [0x694e] = 0x862e, [0x694f] = 0x866e, [0x6950] = 0x86ae, [0x6951] = 0x86ee,
+    [0x6952] = 0x872e, [0x6953] = 0x876e, [0x6954] = 0x87ae, [0x6955] = 0x87ee,
+    [0x6956] = 0x882e, [0x6957] = 0x886e, [0x6958] = 0x88ae, [0x6959] = 0x88ee,
+    [0x695a] = 0x892e, [0x695f] = 0x896e, [0x6961] = 0x89ae, [0x6962] = 0x89ee,
+    [0x6963] = 0x8a2e, [0x6964] = 0x8a6e, [0x6965] = 0x8aae, [0x6966] = 0x8aee,
+    [0x6967] = 0x8b2e, [0x6968] = 0x8b6e, [0x6969] = 0x8bae, [0x696a] = 0x8bee,
+    [0x696b] = 0x8c2e, [0x696c] = 0x8c6e, [0x696d] = 0x8cae, [0x696e] = 0x8cee,
+    [0x696f] = 0x8d2e, [0x6970] = 0x8d6e, [0x6971] = 0x8dae, [0x6972] = 0x8dee,
+    [0x6973] = 0x8e2e, [0x6974] = 0x8e6e, [0x6975] = 0x8eae, [0x6976] = 0x8eee,
+    [0x6977] = 0x8f2e, [0x6978] = 0x8f6e, [0x6979] = 0x8fae, [0x697a] = 0x8fee,
+    [0x6a2d] = 0x802f, [0x6a30] = 0x806f, [0x6a31] = 0x80af, [0x6a32] = 0x80ef,
+    [0x6a33] = 0x812f, [0x6a34] = 0x816f, [0x6a35] = 0x81af, [0x6a36] = 0x81ef,
+    [0x6a37] = 0x822f, [0x6a38] = 0x826f, [0x6a39] = 0x82af, [0x6a41] = 0x82ef,
+    [0x6a42] = 0x832f, [0x6a43] = 0x836f, [0x6a44] = 0x83af, [0x6a45] = 0x83ef,
+    [0x6a46] = 0x842f, [0x6a47] = 0x846f, [0x6a48] = 0x84af, [0x6a49] = 0x84ef,
+    [0x6a4a] = 0x852f, [0x6a4b] = 0x856f, [0x6a4c] = 0x85af, [0x6a4d] = 0x85ef,
+    [0x6a4e] = 0x862f, [0x6a4f] = 0x866f, [0x6a50] = 0x86af, [0x6a51] = 0x86ef,
+    [0x6a52] = 0x872f, [0x6a53] = 0x876f, [0x6a54] = 0x87af, [0x6a55] = 0x87ef,
+    [0x6a56] = 0x882f, [0x6a57] = 0x886f, [0x6a58] = 0x88af, [0x6a59] = 0x88ef,
+    [0x6a5a] = 0x892f, [0x6a5f] = 0x896f, [0x6a61] = 0x89af, [0x6a62] = 0x89ef,
+    [0x6a63] = 0x8a2f, [0x6a64] = 0x8a6f, [0x6a65] = 0x8aaf, [0x6a66] = 0x8aef,
+    [0x6a67] = 0x8b2f, [0x6a68] = 0x8b6f, [0x6a69] = 0x8baf, [0x6a6a] = 0x8bef,
+    [0x6a6b] = 0x8c2f, [0x6a6c] = 0x8c6f, [0x6a6d] = 0x8caf, [0x6a6e] = 0x8cef,
+    [0x6a6f] = 0x8d2f, [0x6a70] = 0x8d6f, [0x6a71] = 0x8daf, [0x6a72] = 0x8def,
+    [0x6a73] = 0x8e2f, [0x6a74] = 0x8e6f, [0x6a75] = 0x8eaf, [0x6a76] = 0x8eef,
+    [0x6a77] = 0x8f2f, [0x6a78] = 0x8f6f, [0x6a79] = 0x8faf, [0x6a7a] = 0x8fef,
+    [0x6b2d] = 0x8030, [0x6b30] = 0x8070, [0x6b31] = 0x80b0, [0x6b32] = 0x80f0,
+    [0x6b33] = 0x8130, [0x6b34] = 0x8170, [0x6b35] = 0x81b0, [0x6b36] = 0x81f0,
+    [0x6b37] = 0x8230, [0x6b38] = 0x8270, [0x6b39] = 0x82b0, [0x6b41] = 0x82f0,
+    [0x6b42] = 0x8330, [0x6b43] = 0x8370, [0x6b44] = 0x83b0, [0x6b45] = 0x83f0,
+    [0x6b46] = 0x8430, [0x6b47] = 0x8470, [0x6b48] = 0x84b0, [0x6b49] = 0x84f0,
+    [0x6b4a] = 0x8530, [0x6b4b] = 0x8570, [0x6b4c] = 0x85b0, [0x6b4d] = 0x85f0,
+    [0x6b4e] = 0x8630, [0x6b4f] = 0x8670, [0x6b50] = 0x86b0, [0x6b51] = 0x86f0,
+    [0x6b52] = 0x8730, [0x6b53] = 0x8770, [0x6b54] = 0x87b0, [0x6b55] = 0x87f0,
+    [0x6b56] = 0x8830, [0x6b57] = 0x8870, [0x6b58] = 0x88b0, [0x6b59] = 0x88f0,
+    [0x6b5a] = 0x8930, [0x6b5f] = 0x8970, [0x6b61] = 0x89b0, [0x6b62] = 0x89f0,
+    [0x6b63] = 0x8a30, [0x6b64] = 0x8a70, [0x6b65] = 0x8ab0, [0x6b66] = 0x8af0,
+    [0x6b67] = 0x8b30, [0x6b68] = 0x8b70, [0x6b69] = 0x8bb0, [0x6b6a] = 0x8bf0,
+    [0x6b6b] = 0x8c30, [0x6b6c] = 0x8c70, [0x6b6d] = 0x8cb0, [0x6b6e] = 0x8cf0,
+    [0x6b6f] = 0x8d30, [0x6b70] = 0x8d70, [0x6b71] = 0x8db0, [0x6b72] = 0x8df0,
+    [0x6b73] = 0x8e30, [0x6b74] = 0x8e70, [0x6b75] = 0x8eb0, [0x6b76] = 0x8ef0,
+    [0x6b77] = 0x8f30, [0x6b78] = 0x8f70, [0x6b79] = 0x8fb0, [0x6b7a] = 0x8ff0,
+    [0x6c2d] = 0x8031, [0x6c30] = 0x8071, [0x6c31] = 0x80b1, [0x6c32] = 0x80f1,
+    [0x6c33] = 0x8131, [0x6c34] = 0x8171, [0x6c35] = 0x81b1, [0x6c36] = 0x81f1,
+    [0x6c37] = 0x8231, [0x6c38] = 0x8271, [0x6c39] = 0x82b1, [0x6c41] = 0x82f1,
+    [0x6c42] = 0x8331, [0x6c43] = 0x8371, [0x6c44] = 0x83b1, [0x6c45] = 0x83f1,
+    [0x6c46] = 0x8431, [0x6c47] = 0x8471, [0x6c48] = 0x84b1, [0x6c49] = 0x84f1,
+    [0x6c4a] = 0x8531, [0x6c4b] = 0x8571, [0x6c4c] = 0x85b1, [0x6c4d] = 0x85f1,
+    [0x6c4e] = 0x8631, [0x6c4f] = 0x8671, [0x6c50] = 0x86b1, [0x6c51] = 0x86f1,
+    [0x6c52] = 0x8731, [0x6c53] = 0x8771, [0x6c54] = 0x87b1, [0x6c55] = 0x87f1,
+    [0x6c56] = 0x8831, [0x6c57] = 0x8871, [0x6c58] = 0x88b1, [0x6c59] = 0x88f1,
+    [0x6c5a] = 0x8931, [0x6c5f] = 0x8971, [0x6c61] = 0x89b1, [0x6c62] = 0x89f1,
+    [0x6c63] = 0x8a31, [0x6c64] = 0x8a71, [0x6c65] = 0x8ab1, [0x6c66] = 0x8af1,
+    [0x6c67] = 0x8b31, [0x6c68] = 0x8b71, [0x6c69] = 0x8bb1, [0x6c6a] = 0x8bf1,
+    [0x6c6b] = 0x8c31, [0x6c6c] = 0x8c71, [0x6c6d] = 0x8cb1, [0x6c6e] = 0x8cf1,
+    [0x6c6f] = 0x8d31, [0x6c70] = 0x8d71, [0x6c71] = 0x8db1, [0x6c72] = 0x8df1,
+    [0x6c73] = 0x8e31, [0x6c74] = 0x8e71, [0x6c75] = 0x8eb1, [0x6c76] = 0x8ef1,
+    [0x6c77] = 0x8f31, [0x6c78] = 0x8f71, [0x6c79] = 0x8fb1, [0x6c7a] = 0x8ff1,
+    [0x6d2d] = 0x8032, [0x6d30] = 0x8072, [0x6d31] = 0x80b2, [0x6d32] = 0x80f2,
+    [0x6d33] = 0x8132, [0x6d34] = 0x8172, [0x6d35] = 0x81b2, [0x6d36] = 0x81f2,
+    [0x6d37] = 0x8232, [0x6d38] = 0x8272, [0x6d39] = 0x82b2, [0x6d41] = 0x82f2,
+    [0x6d42] = 0x8332, [0x6d43] = 0x8372, [0x6d44] = 0x83b2, [0x6d45] = 0x83f2,
+    [0x6d46] = 0x8432, [0x6d47] = 0x8472, [0x6d48] = 0x84b2, [0x6d49] = 0x84f2,
+    [0x6d4a] = 0x8532, [0x6d4b] = 0x8572, [0x6d4c] = 0x85b2, [0x6d4d] = 0x85f2,
+    [0x6d4e] = 0x8632, [0x6d4f] = 0x8672, [0x6d50] = 0x86b2, [0x6d51] = 0x86f2,
+    [0x6d52] = 0x8732, [0x6d53] = 0x8772, [0x6d54] = 0x87b2, [0x6d55] = 0x87f2,
+    [0x6d56] = 0x8832, [0x6d57] = 0x8872, [0x6d58] = 0x88b2, [0x6d59] = 0x88f2,
+    [0x6d5a] = 0x8932, [0x6d5f] = 0x8972, [0x6d61] = 0x89b2, [0x6d62] = 0x89f2,
+    [0x6d63] = 0x8a32, [0x6d64] = 0x8a72, [0x6d65] = 0x8ab2, [0x6d66] = 0x8af2,
+    [0x6d67] = 0x8b32, [0x6d68] = 0x8b72, [0x6d69] = 0x8bb2, [0x6d6a] = 0x8bf2,
+    [0x6d6b] = 0x8c32, [0x6d6c] = 0x8c72, [0x6d6d] = 0x8cb2, [0x6d6e] = 0x8cf2,
+    [0x6d6f] = 0x8d32, [0x6d70] = 0x8d72, [0x6d71] = 0x8db2, [0x6d72] = 0x8df2,
+    [0x6d73] = 0x8e32, [0x6d74] = 0x8e72, [0x6d75] = 0x8eb2, [0x6d76] = 0x8ef2,
+    [0x6d77] = 0x8f32, [0x6d78] = 0x8f72, [0x6d79] = 0x8fb2, [0x6d7a] = 0x8ff2,
+    [0x6e2d] = 0x8033, [0x6e30] = 0x8073, [0x6e31] = 0x80b3, [0x6e32] = 0x80f3,
+    [0x6e33] = 0x8133, [0x6e34] = 0x8173, [0x6e35] = 0x81b3, [0x6e36] = 0x81f3,
+    [0x6e37] = 0x8233, [0x6e38] = 0x8273, [0x6e39] = 0x82b3, [0x6e41] = 0x82f3,
+    [0x6e42] = 0x8333, [0x6e43] = 0x8373, [0x6e44] = 0x83b3, [0x6e45] = 0x83f3,
+    [0x6e46] = 0x8433, [0x6e47] = 0x8473, [0x6e48] = 0x84b3, [0x6e49] = 0x84f3,
+    [0x6e4a] = 0x8533, [0x6e4b] = 0x8573, [0x6e4c] = 0x85b3, [0x6e4d] = 0x85f3,
+    [0x6e4e] = 0x8633, [0x6e4f] = 0x8673, [0x6e50] = 0x86b3, [0x6e51] = 0x86f3,
+    [0x6e52] = 0x8733, [0x6e53] = 0x8773, [0x6e54] = 0x87b3, [0x6e55] = 0x87f3,
+    [0x6e56] = 0x8833, [0x6e57] = 0x8873, [0x6e58] = 0x88b3, [0x6e59] = 0x88f3,
+    [0x6e5a] = 0x8933, [0x6e5f] = 0x8973, [0x6e61] = 0x89b3, [0x6e62] = 0x89f3,
+    [0x6e63] = 0x8a33, [0x6e64] = 0x8a73, [0x6e65] = 0x8ab3, [0x6e66] = 0x8af3,
+    [0x6e67] = 0x8b33, [0x6e68] = 0x8b73, [0x6e69] = 0x8bb3, [0x6e6a] = 0x8bf3,
+    [0x6e6b] = 0x8c33, [0x6e6c] = 0x8c73, [0x6e6d] = 0x8cb3, [0x6e6e] = 0x8cf3,
+    [0x6e6f] = 0x8d33, [0x6e70] = 0x8d73, [0x6e71] = 0x8db3, [0x6e72] = 0x8df3,
+    [0x6e73] = 0x8e33, [0x6e74] = 0x8e73, [0x6e75] = 0x8eb3, [0x6e76] = 0x8ef3,
+    [0x6e77] = 0x8f33, [0x6e78] = 0x8f73, [0x6e79] = 0x8fb3, [0x6e7a] = 0x8ff3,
+    [0x6f2d] = 0x8034, [0x6f30] = 0x8074, [0x6f31] = 0x80b4, [0x6f32] = 0x80f4,
+    [0x6f33] = 0x8134, [0x6f34] = 0x8174, [0x6f35] = 0x81b4, [0x6f36] = 0x81f4,
+    [0x6f37] = 0x8234, [0x6f38] = 0x8274, [0x6f39] = 0x82b4, [0x6f41] = 0x82f4,
+    [0x6f42] = 0x8334, [0x6f43] = 0x8374, [0x6f44] = 0x83b4, [0x6f45] = 0x83f4,
+    [0x6f46] = 0x8434, [0x6f47] = 0x8474, [0x6f48] = 0x84b4, [0x6f49] = 0x84f4,
+    [0x6f4a] = 0x8534, [0x6f4b] = 0x8574, [0x6f4c] = 0x85b4, [0x6f4d] = 0x85f4,
+    [0x6f4e] = 0x8634, [0x6f4f] = 0x8674, [0x6f50] = 0x86b4, [0x6f51] = 0x86f4,
+    [0x6f52] = 0x8734, [0x6f53] = 0x8774, [0x6f54] = 0x87b4, [0x6f55] = 0x87f4,
+    [0x6f56] = 0x8834, [0x6f57] = 0x8874, [0x6f58] = 0x88b4, [0x6f59] = 0x88f4,
+    [0x6f5a] = 0x8934, [0x6f5f] = 0x8974, [0x6f61] = 0x89b4, [0x6f62] = 0x89f4,
+    [0x6f63] = 0x8a34, [0x6f64] = 0x8a74, [0x6f65] = 0x8ab4, [0x6f66] = 0x8af4,
+    [0x6f67] = 0x8b34, [0x6f68] = 0x8b74, [0x6f69] = 0x8bb4, [0x6f6a] = 0x8bf4,
+    [0x6f6b] = 0x8c34, [0x6f6c] = 0x8c74, [0x6f6d] = 0x8cb4, [0x6f6e] = 0x8cf4,
+    [0x6f6f] = 0x8d34, [0x6f70] = 0x8d74, [0x6f71] = 0x8db4, [0x6f72] = 0x8df4,
+    [0x6f73] = 0x8e34, [0x6f74] = 0x8e74, [0x6f75] = 0x8eb4, [0x6f76] = 0x8ef4,
+    [0x6f77] = 0x8f34, [0x6f78] = 0x8f74, [0x6f79] = 0x8fb4, [0x6f7a] = 0x8ff4,
+    [0x702d] = 0x8035, [0x7030] = 0x8075, [0x7031] = 0x80b5, [0x7032] = 0x80f5,
+    [0x7033] = 0x8135, [0x7034] = 0x8175, [0x7035] = 0x81b5, [0x7036] = 0x81f5,
+    [0x7037] = 0x8235, [0x7038] = 0x8275, [0x7039] = 0x82b5, [0x7041] = 0x82f5,
+    [0x7042] = 0x8335, [0x7043] = 0x8375, [0x7044] = 0x83b5, [0x7045] = 0x83f5,
+    [0x7046] = 0x8435, [0x7047] = 0x8475, [0x7048] = 0x84b5, [0x7049] = 0x84f5,
+    [0x704a] = 0x8535, [0x704b] = 0x8575, [0x704c] = 0x85b5, [0x704d] = 0x85f5,
+    [0x704e] = 0x8635, [0x704f] = 0x8675, [0x7050] = 0x86b5, [0x7051] = 0x86f5,
+    [0x7052] = 0x8735, [0x7053] = 0x8775, [0x7054] = 0x87b5, [0x7055] = 0x87f5,
+    [0x7056] = 0x8835, [0x7057] = 0x8875, [0x7058] = 0x88b5, [0x7059] = 0x88f5,
+    [0x705a] = 0x8935, [0x705f] = 0x8975, [0x7061] = 0x89b5, [0x7062] = 0x89f5,
+    [0x7063] = 0x8a35, [0x7064] = 0x8a75, [0x7065] = 0x8ab5, [0x7066] = 0x8af5,
+    [0x7067] = 0x8b35, [0x7068] = 0x8b75, [0x7069] = 0x8bb5, [0x706a] = 0x8bf5,
+    [0x706b] = 0x8c35, [0x706c] = 0x8c75, [0x706d] = 0x8cb5, [0x706e] = 0x8cf5,
+    [0x706f] = 0x8d35, [0x7070] = 0x8d75, [0x7071] = 0x8db5, [0x7072] = 0x8df5,
+    [0x7073] = 0x8e35, [0x7074] = 0x8e75, [0x7075] = 0x8eb5, [0x7076] = 0x8ef5,
+    [0x7077] = 0x8f35, [0x7078] = 0x8f75, [0x7079] = 0x8fb5, [0x707a] = 0x8ff5,
+    [0x712d] = 0x8036, [0x7130] = 0x8076, [0x7131] = 0x80b6, [0x7132] = 0x80f6,
+    [0x7133] = 0x8136, [0x7134] = 0x8176, [0x7135] = 0x81b6, [0x7136] = 0x81f6,
+    [0x7137] = 0x8236, [0x7138] = 0x8276, [0x7139] = 0x82b6, [0x7141] = 0x82f6,
+    [0x7142] = 0x8336, [0x7143] = 0x8376, [0x7144] = 0x83b6, [0x7145] = 0x83f6,
+    [0x7146] = 0x8436, [0x7147] = 0x8476, [0x7148] = 0x84b6, [0x7149] = 0x84f6,
+    [0x714a] = 0x8536, [0x714b] = 0x8576, [0x714c] = 0x85b6, [0x714d] = 0x85f6,
+    [0x714e] = 0x8636, [0x714f] = 0x8676, [0x7150] = 0x86b6, [0x7151] = 0x86f6,
+    [0x7152] = 0x8736, [0x7153] = 0x8776, [0x7154] = 0x87b6, [0x7155] = 0x87f6,
+    [0x7156] = 0x8836, [0x7157] = 0x8876, [0x7158] = 0x88b6, [0x7159] = 0x88f6,
+    [0x715a] = 0x8936, [0x715f] = 0x8976, [0x7161] = 0x89b6, [0x7162] = 0x89f6,
+    [0x7163] = 0x8a36, [0x7164] = 0x8a76, [0x7165] = 0x8ab6, [0x7166] = 0x8af6,
+    [0x7167] = 0x8b36, [0x7168] = 0x8b76, [0x7169] = 0x8bb6, [0x716a] = 0x8bf6,
+    [0x716b] = 0x8c36, [0x716c] = 0x8c76, [0x716d] = 0x8cb6, [0x716e] = 0x8cf6,
+    [0x716f] = 0x8d36, [0x7170] = 0x8d76, [0x7171] = 0x8db6, [0x7172] = 0x8df6,
+    [0x7173] = 0x8e36, [0x7174] = 0x8e76, [0x7175] = 0x8eb6, [0x7176] = 0x8ef6,
+    [0x7177] = 0x8f36, [0x7178] = 0x8f76, [0x7179] = 0x8fb6, [0x717a] = 0x8ff6,
+    [0x722d] = 0x8037, [0x7230] = 0x8077, [0x7231] = 0x80b7, [0x7232] = 0x80f7,
+    [0x7233] = 0x8137, [0x7234] = 0x8177, [0x7235] = 0x81b7, [0x7236] = 0x81f7,
+    [0x7237] = 0x8237, [0x7238] = 0x8277, [0x7239] = 0x82b7, [0x7241] = 0x82f7,
+    [0x7242] = 0x8337, [0x7243] = 0x8377, [0x7244] = 0x83b7, [0x7245] = 0x83f7,
+    [0x7246] = 0x8437, [0x7247] = 0x8477, [0x7248] = 0x84b7, [0x7249] = 0x84f7,
+    [0x724a] = 0x8537, [0x724b] = 0x8577, [0x724c] = 0x85b7, [0x724d] = 0x85f7,
+    [0x724e] = 0x8637, [0x724f] = 0x8677, [0x7250] = 0x86b7, [0x7251] = 0x86f7,
+    [0x7252] = 0x8737, [0x7253] = 0x8777, [0x7254] = 0x87b7, [0x7255] = 0x87f7,
+    [0x7256] = 0x8837, [0x7257] = 0x8877, [0x7258] = 0x88b7, [0x7259] = 0x88f7,
+    [0x725a] = 0x8937, [0x725f] = 0x8977, [0x7261] = 0x89b7, [0x7262] = 0x89f7,
+    [0x7263] = 0x8a37, [0x7264] = 0x8a77, [0x7265] = 0x8ab7, [0x7266] = 0x8af7,
+    [0x7267] = 0x8b37, [0x7268] = 0x8b77, [0x7269] = 0x8bb7, [0x726a] = 0x8bf7,
+    [0x726b] = 0x8c37, [0x726c] = 0x8c77, [0x726d] = 0x8cb7, [0x726e] = 0x8cf7,
+    [0x726f] = 0x8d37, [0x7270] = 0x8d77, [0x7271] = 0x8db7, [0x7272] = 0x8df7,
+    [0x7273] = 0x8e37, [0x7274] = 0x8e77, [0x7275] = 0x8eb7, [0x7276] = 0x8ef7,
+    [0x7277] = 0x8f37, [0x7278] = 0x8f77, [0x7279] = 0x8fb7, [0x727a] = 0x8ff7,
+    [0x732d] = 0x8038, [0x7330] = 0x8078, [0x7331] = 0x80b8, [0x7332] = 0x80f8,
+    [0x7333] = 0x8138, [0x7334] = 0x8178, [0x7335] = 0x81b8, [0x7336] = 0x81f8,
+    [0x7337] = 0x8238, [0x7338] = 0x8278, [0x7339] = 0x82b8, [0x7341] = 0x82f8,
+    [0x7342] = 0x8338, [0x7343] = 0x8378, [0x7344] = 0x83b8, [0x7345] = 0x83f8,
+    [0x7346] = 0x8438, [0x7347] = 0x8478, [0x7348] = 0x84b8, [0x7349] = 0x84f8,
+    [0x734a] = 0x8538, [0x734b] = 0x8578, [0x734c] = 0x85b8, [0x734d] = 0x85f8,
+    [0x734e] = 0x8638, [0x734f] = 0x8678, [0x7350] = 0x86b8, [0x7351] = 0x86f8,
+    [0x7352] = 0x8738, [0x7353] = 0x8778, [0x7354] = 0x87b8, [0x7355] = 0x87f8,
+    [0x7356] = 0x8838, [0x7357] = 0x8878, [0x7358] = 0x88b8, [0x7359] = 0x88f8,
+    [0x735a] = 0x8938, [0x735f] = 0x8978, [0x7361] = 0x89b8, [0x7362] = 0x89f8,
+    [0x7363] = 0x8a38, [0x7364] = 0x8a78, [0x7365] = 0x8ab8, [0x7366] = 0x8af8,
+    [0x7367] = 0x8b38, [0x7368] = 0x8b78, [0x7369] = 0x8bb8, [0x736a] = 0x8bf8,
+    [0x736b] = 0x8c38, [0x736c] = 0x8c78, [0x736d] = 0x8cb8, [0x736e] = 0x8cf8,
+    [0x736f] = 0x8d38, [0x7370] = 0x8d78, [0x7371] = 0x8db8, [0x7372] = 0x8df8,
+    [0x7373] = 0x8e38, [0x7374] = 0x8e78, [0x7375] = 0x8eb8, [0x7376] = 0x8ef8,
+    [0x7377] = 0x8f38, [0x7378] = 0x8f78, [0x7379] = 0x8fb8, [0x737a] = 0x8ff8,
+    [0x742d] = 0x8039, [0x7430] = 0x8079, [0x7431] = 0x80b9, [0x7432] = 0x80f9,
+    [0x7433] = 0x8139, [0x7434] = 0x8179, [0x7435] = 0x81b9, [0x7436] = 0x81f9,
+    [0x7437] = 0x8239, [0x7438] = 0x8279, [0x7439] = 0x82b9, [0x7441] = 0x82f9,
+    [0x7442] = 0x8339, [0x7443] = 0x8379, [0x7444] = 0x83b9, [0x7445] = 0x83f9,
+    [0x7446] = 0x8439, [0x7447] = 0x8479, [0x7448] = 0x84b9, [0x7449] = 0x84f9,
+    [0x744a] = 0x8539, [0x744b] = 0x8579, [0x744c] = 0x85b9, [0x744d] = 0x85f9,
+    [0x744e] = 0x8639, [0x744f] = 0x8679, [0x7450] = 0x86b9, [0x7451] = 0x86f9,
+    [0x7452] = 0x8739, [0x7453] = 0x8779, [0x7454] = 0x87b9, [0x7455] = 0x87f9,
+    [0x7456] = 0x8839, [0x7457] = 0x8879, [0x7458] = 0x88b9, [0x7459] = 0x88f9,
+    [0x745a] = 0x8939, [0x745f] = 0x8979, [0x7461] = 0x89b9, [0x7462] = 0x89f9,
+    [0x7463] = 0x8a39, [0x7464] = 0x8a79, [0x7465] = 0x8ab9, [0x7466] = 0x8af9,
+    [0x7467] = 0x8b39, [0x7468] = 0x8b79, [0x7469] = 0x8bb9, [0x746a] = 0x8bf9,
+    [0x746b] = 0x8c39, [0x746c] = 0x8c79, [0x746d] = 0x8cb9, [0x746e] = 0x8cf9,
+    [0x746f] = 0x8d39, [0x7470] = 0x8d79, [0x7471] = 0x8db9, [0x7472] = 0x8df9,
+    [0x7473] = 0x8e39, [0x7474] = 0x8e79, [0x7475] = 0x8eb9, [0x7476] = 0x8ef9,
+    [0x7477] = 0x8f39, [0x7478] = 0x8f79, [0x7479] = 0x8fb9, [0x747a] = 0x8ff9,
+    [0x752d] = 0x803a, [0x7530] = 0x807a, [0x7531] = 0x80ba, [0x7532] = 0x80fa,
+    [0x7533] = 0x813a, [0x7534] = 0x817a, [0x7535] = 0x81ba, [0x7536] = 0x81fa,
+    [0x7537] = 0x823a, [0x7538] = 0x827a, [0x7539] = 0x82ba, [0x7541] = 0x82fa,
+    [0x7542] = 0x833a, [0x7543] = 0x837a, [0x7544] = 0x83ba, [0x7545] = 0x83fa,
+    [0x7546] = 0x843a, [0x7547] = 0x847a, [0x7548] = 0x84ba, [0x7549] = 0x84fa,
+    [0x754a] = 0x853a, [0x754b] = 0x857a, [0x754c] = 0x85ba, [0x754d] = 0x85fa,
+    [0x754e] = 0x863a, [0x754f] = 0x867a, [0x7550] = 0x86ba, [0x7551] = 0x86fa,
+    [0x7552] = 0x873a, [0x7553] = 0x877a, [0x7554] = 0x87ba, [0x7555] = 0x87fa,
+    [0x7556] = 0x883a, [0x7557] = 0x887a, [0x7558] = 0x88ba, [0x7559] = 0x88fa,
+    [0x755a] = 0x893a, [0x755f] = 0x897a, [0x7561] = 0x89ba, [0x7562] = 0x89fa,
+    [0x7563] = 0x8a3a, [0x7564] = 0x8a7a, [0x7565] = 0x8aba, [0x7566] = 0x8afa,
+    [0x7567] = 0x8b3a, [0x7568] = 0x8b7a, [0x7569] = 0x8bba, [0x756a] = 0x8bfa,
+    [0x756b] = 0x8c3a, [0x756c] = 0x8c7a, [0x756d] = 0x8cba, [0x756e] = 0x8cfa,
+    [0x756f] = 0x8d3a, [0x7570] = 0x8d7a, [0x7571] = 0x8dba, [0x7572] = 0x8dfa,
+    [0x7573] = 0x8e3a, [0x7574] = 0x8e7a, [0x7575] = 0x8eba, [0x7576] = 0x8efa,
+    [0x7577] = 0x8f3a, [0x7578] = 0x8f7a, [0x7579] = 0x8fba, [0x757a] = 0x8ffa,
+    [0x762d] = 0x803b, [0x7630] = 0x807b, [0x7631] = 0x80bb, [0x7632] = 0x80fb,
+    [0x7633] = 0x813b, [0x7634] = 0x817b, [0x7635] = 0x81bb, [0x7636] = 0x81fb,
+    [0x7637] = 0x823b, [0x7638] = 0x827b, [0x7639] = 0x82bb, [0x7641] = 0x82fb,
+    [0x7642] = 0x833b, [0x7643] = 0x837b, [0x7644] = 0x83bb, [0x7645] = 0x83fb,
+    [0x7646] = 0x843b, [0x7647] = 0x847b, [0x7648] = 0x84bb, [0x7649] = 0x84fb,
+    [0x764a] = 0x853b, [0x764b] = 0x857b, [0x764c] = 0x85bb, [0x764d] = 0x85fb,
+    [0x764e] = 0x863b, [0x764f] = 0x867b, [0x7650] = 0x86bb, [0x7651] = 0x86fb,
+    [0x7652] = 0x873b, [0x7653] = 0x877b, [0x7654] = 0x87bb, [0x7655] = 0x87fb,
+    [0x7656] = 0x883b, [0x7657] = 0x887b, [0x7658] = 0x88bb, [0x7659] = 0x88fb,
+    [0x765a] = 0x893b, [0x765f] = 0x897b, [0x7661] = 0x89bb, [0x7662] = 0x89fb,
+    [0x7663] = 0x8a3b, [0x7664] = 0x8a7b, [0x7665] = 0x8abb, [0x7666] = 0x8afb,
+    [0x7667] = 0x8b3b, [0x7668] = 0x8b7b, [0x7669] = 0x8bbb, [0x766a] = 0x8bfb,
+    [0x766b] = 0x8c3b, [0x766c] = 0x8c7b, [0x766d] = 0x8cbb, [0x766e] = 0x8cfb,
+    [0x766f] = 0x8d3b, [0x7670] = 0x8d7b, [0x7671] = 0x8dbb, [0x7672] = 0x8dfb,
+    [0x7673] = 0x8e3b, [0x7674] = 0x8e7b, [0x7675] = 0x8ebb, [0x7676] = 0x8efb,
+    [0x7677] = 0x8f3b, [0x7678] = 0x8f7b, [0x7679] = 0x8fbb, [0x767a] = 0x8ffb,
+    [0x772d] = 0x803c, [0x7730] = 0x807c, [0x7731] = 0x80bc, [0x7732] = 0x80fc,
+    [0x7733] = 0x813c, [0x7734] = 0x817c, [0x7735] = 0x81bc, [0x7736] = 0x81fc,
+    [0x7737] = 0x823c, [0x7738] = 0x827c, [0x7739] = 0x82bc, [0x7741] = 0x82fc,
+    [0x7742] = 0x833c, [0x7743] = 0x837c, [0x7744] = 0x83bc, [0x7745] = 0x83fc,
+    [0x7746] = 0x843c, [0x7747] = 0x847c, [0x7748] = 0x84bc, [0x7749] = 0x84fc,
+    [0x774a] = 0x853c, [0x774b] = 0x857c, [0x774c] = 0x85bc, [0x774d] = 0x85fc,
+    [0x774e] = 0x863c, [0x774f] = 0x867c, [0x7750] = 0x86bc, [0x7751] = 0x86fc,
+    [0x7752] = 0x873c, [0x7753] = 0x877c, [0x7754] = 0x87bc, [0x7755] = 0x87fc,
+    [0x7756] = 0x883c, [0x7757] = 0x887c, [0x7758] = 0x88bc, [0x7759] = 0x88fc,
+    [0x775a] = 0x893c, [0x775f] = 0x897c, [0x7761] = 0x89bc, [0x7762] = 0x89fc,
+    [0x7763] = 0x8a3c, [0x7764] = 0x8a7c, [0x7765] = 0x8abc, [0x7766] = 0x8afc,
+    [0x7767] = 0x8b3c, [0x7768] = 0x8b7c, [0x7769] = 0x8bbc, [0x776a] = 0x8bfc,
+    [0x776b] = 0x8c3c, [0x776c] = 0x8c7c, [0x776d] = 0x8cbc, [0x776e] = 0x8cfc,
+    [0x776f] = 0x8d3c, [0x7770] = 0x8d7c, [0x7771] = 0x8dbc, [0x7772] = 0x8dfc,
+    [0x7773] = 0x8e3c, [0x7774] = 0x8e7c, [0x7775] = 0x8ebc, [0x7776] = 0x8efc,
+    [0x7777] = 0x8f3c, [0x7778] = 0x8f7c, [0x7779] = 0x8fbc, [0x777a] = 0x8ffc,
+    [0x782d] = 0x803d, [0x7830] = 0x807d, [0x7831] = 0x80bd, [0x7832] = 0x80fd,
+    [0x7833] = 0x813d, [0x7834] = 0x817d, [0x7835] = 0x81bd, [0x7836] = 0x81fd,
+    [0x7837] = 0x823d, [0x7838] = 0x827d, [0x7839] = 0x82bd, [0x7841] = 0x82fd,
+    [0x7842] = 0x833d, [0x7843] = 0x837d, [0x7844] = 0x83bd, [0x7845] = 0x83fd,
+    [0x7846] = 0x843d, [0x7847] = 0x847d, [0x7848] = 0x84bd, [0x7849] = 0x84fd,
+    [0x784a] = 0x853d, [0x784b] = 0x857d, [0x784c] = 0x85bd, [0x784d] = 0x85fd,
+    [0x784e] = 0x863d, [0x784f] = 0x867d, [0x7850] = 0x86bd, [0x7851] = 0x86fd,
+    [0x7852] = 0x873d, [0x7853] = 0x877d, [0x7854] = 0x87bd, [0x7855] = 0x87fd,
+    [0x7856] = 0x883d, [0x7857] = 0x887d, [0x7858] = 0x88bd, [0x7859] = 0x88fd,
+    [0x785a] = 0x893d, [0x785f] = 0x897d, [0x7861] = 0x89bd, [0x7862] = 0x89fd,
+    [0x7863] = 0x8a3d, [0x7864] = 0x8a7d, [0x7865] = 0x8abd, [0x7866] = 0x8afd,
+    [0x7867] = 0x8b3d, [0x7868] = 0x8b7d, [0x7869] = 0x8bbd, [0x786a] = 0x8bfd,
+    [0x786b] = 0x8c3d, [0x786c] = 0x8c7d, [0x786d] = 0x8cbd, [0x786e] = 0x8cfd,
+    [0x786f] = 0x8d3d, [0x7870] = 0x8d7d, [0x7871] = 0x8dbd, [0x7872] = 0x8dfd,
+    [0x7873] = 0x8e3d, [0x7874] = 0x8e7d, [0x7875] = 0x8ebd, [0x7876] = 0x8efd,
+    [0x7877] = 0x8f3d, [0x7878] = 0x8f7d, [0x7879] = 0x8fbd, [0x787a] = 0x8ffd,
+    [0x792d] = 0x803e, [0x7930] = 0x807e, [0x7931] = 0x80be, [0x7932] = 0x80fe,
+    [0x7933] = 0x813e, [0x7934] = 0x817e, [0x7935] = 0x81be, [0x7936] = 0x81fe,
+    [0x7937] = 0x823e, [0x7938] = 0x827e, [0x7939] = 0x82be, [0x7941] = 0x82fe,
+    [0x7942] = 0x833e, [0x7943] = 0x837e, [0x7944] = 0x83be, [0x7945] = 0x83fe,
+    [0x7946] = 0x843e, [0x7947] = 0x847e, [0x7948] = 0x84be, [0x7949] = 0x84fe,
+    [0x794a] = 0x853e, [0x794b] = 0x857e, [0x794c] = 0x85be, [0x794d] = 0x85fe,
+    [0x794e] = 0x863e, [0x794f] = 0x867e, [0x7950] = 0x86be, [0x7951] = 0x86fe,
+    [0x7952] = 0x873e, [0x7953] = 0x877e, [0x7954] = 0x87be, [0x7955] = 0x87fe,
+    [0x7956] = 0x883e, [0x7957] = 0x887e, [0x7958] = 0x88be, [0x7959] = 0x88fe,
+    [0x795a] = 0x893e, [0x795f] = 0x897e, [0x7961] = 0x89be, [0x7962] = 0x89fe,
+    [0x7963] = 0x8a3e, [0x7964] = 0x8a7e, [0x7965] = 0x8abe, [0x7966] = 0x8afe,
+    [0x7967] = 0x8b3e, [0x7968] = 0x8b7e, [0x7969] = 0x8bbe, [0x796a] = 0x8bfe,
+    [0x796b] = 0x8c3e, [0x796c] = 0x8c7e, [0x796d] = 0x8cbe, [0x796e] = 0x8cfe,
+    [0x796f] = 0x8d3e, [0x7970] = 0x8d7e, [0x7971] = 0x8dbe, [0x7972] = 0x8dfe,
+    [0x7973] = 0x8e3e, [0x7974] = 0x8e7e, [0x7975] = 0x8ebe, [0x7976] = 0x8efe,
+    [0x7977] = 0x8f3e, [0x7978] = 0x8f7e, [0x7979] = 0x8fbe, [0x797a] = 0x8ffe,
+    [0x7a2d] = 0x803f, [0x7a30] = 0x807f, [0x7a31] = 0x80bf, [0x7a32] = 0x80ff,
+    [0x7a33] = 0x813f, [0x7a34] = 0x817f, [0x7a35] = 0x81bf, [0x7a36] = 0x81ff,
+    [0x7a37] = 0x823f, [0x7a38] = 0x827f, [0x7a39] = 0x82bf, [0x7a41] = 0x82ff,
+    [0x7a42] = 0x833f, [0x7a43] = 0x837f, [0x7a44] = 0x83bf, [0x7a45] = 0x83ff,
+    [0x7a46] = 0x843f, [0x7a47] = 0x847f, [0x7a48] = 0x84bf, [0x7a49] = 0x84ff,
+    [0x7a4a] = 0x853f, [0x7a4b] = 0x857f, [0x7a4c] = 0x85bf, [0x7a4d] = 0x85ff,
+    [0x7a4e] = 0x863f, [0x7a4f] = 0x867f, [0x7a50] = 0x86bf, [0x7a51] = 0x86ff,
+    [0x7a52] = 0x873f, [0x7a53] = 0x877f, [0x7a54] = 0x87bf, [0x7a55] = 0x87ff,
+    [0x7a56] = 0x883f, [0x7a57] = 0x887f, [0x7a58] = 0x88bf, [0x7a59] = 0x88ff,
+    [0x7a5a] = 0x893f, [0x7a5f] = 0x897f, [0x7a61] = 0x89bf, [0x7a62] = 0x89ff,
+    [0x7a63] = 0x8a3f, [0x7a64] = 0x8a7f, [0x7a65] = 0x8abf, [0x7a66] = 0x8aff,
+    [0x7a67] = 0x8b3f, [0x7a68] = 0x8b7f, [0x7a69] = 0x8bbf, [0x7a6a] = 0x8bff,
+    [0x7a6b] = 0x8c3f, [0x7a6c] = 0x8c7f, [0x7a6d] = 0x8cbf, [0x7a6e] = 0x8cff,
+    [0x7a6f] = 0x8d3f, [0x7a70] = 0x8d7f, [0x7a71] = 0x8dbf, [0x7a72] = 0x8dff,
+    [0x7a73] = 0x8e3f, [0x7a74] = 0x8e7f, [0x7a75] = 0x8ebf, [0x7a76] = 0x8eff,
+    [0x7a77] = 0x8f3f, [0x7a78] = 0x8f7f, [0x7a79] = 0x8fbf, [0x7a7a] = 0x8fff,
+};
+#endif
+
 static const int g_chunk_to_byte_count[]   = { 0, 0, 1, 2, 3 };
 
 static const int g_byte_to_chunk_count[]   = { 0, 2, 3, 4 };
@@ -94,6 +1273,20 @@ static inline int extract_byte_from_accumulator(const int64_t accumulator, const
     return extracted_byte;
 }
 
+// The most groups that any of the bulk encoders hold back because they load
+// past the groups that they encode.
+static const int g_slack_group_count = 2;
+
+// Writes the low byte_count bytes of the accumulator, high byte first, as one
+// 8-byte store. This writes 8 bytes no matter what byte_count is, so it needs
+// slack after dst.
+static inline void store_accumulator_bytes(uint8_t* const dst, const int64_t accumulator, const int byte_count)
+{
+    const uint64_t value = (uint64_t)accumulator << (64 - byte_count * g_bits_per_byte);
+    const uint64_t bytes = __builtin_bswap64(value);
+    memcpy(dst, &bytes, sizeof(bytes));
+}
+
 static inline int extract_chunk_from_accumulator(const int64_t accumulator, const int chunk_index_lo_first)
 {
     const int chunk_mask = (1 << g_bits_per_chunk) - 1;
@@ -104,6 +1297,176 @@ static inline int extract_chunk_from_accumulator(const int64_t accumulator, cons
     return extracted_chunk;
 }
 
+// The scalar bulk encoder works on two chunks (12 bits) at a time, looking
+// them up in g_chunk_pair_to_encode_chars.
+static inline int64_t encode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    const int pair_mask = (1 << (g_bits_per_chunk * 2)) - 1;
+    for(int64_t offset = 0; offset < group_count; offset++)
+    {
+        const uint8_t* const group_src = src + offset * g_bytes_per_group;
+        uint8_t* const group_dst = dst + offset * g_chunks_per_group;
+        const int group = (group_src[0] << 16) | (group_src[1] << 8) | group_src[2];
+        memcpy(group_dst, g_chunk_pair_to_encode_chars + (group >> (g_bits_per_chunk * 2)) * 2, 2);
+        memcpy(group_dst + 2, g_chunk_pair_to_encode_chars + (group & pair_mask) * 2, 2);
+    }
+    return group_count;
+}
+
+#if SAFE64_HAS_PAIR_TABLE
+
+// With the pair table, the scalar decoder works on two chunks (12 bits) at a
+// time. Groups that contain whitespace or an invalid character are left to
+// the per-character loop.
+
+static inline uint16_t decode_char_pair(const uint8_t* const src)
+{
+    return g_chars_to_chunk_pair[src[0] | (src[1] << g_bits_per_byte)];
+}
+
+static inline int64_t decode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    const int pair_mask = (1 << (g_bits_per_chunk * 2)) - 1;
+    // Errors are only checked once per step, so that the lookups don't have
+    // to wait for each other.
+    int64_t offset = 0;
+    for(; offset + 4 <= group_count; offset += 4)
+    {
+        const uint8_t* const step_src = src + offset * g_chunks_per_group;
+        uint8_t bytes[12];
+        uint16_t valid_pairs = CHUNK_PAIR_FLAG_VALID;
+        for(int i = 0; i < 4; i++)
+        {
+            const uint16_t hi = decode_char_pair(step_src + i * g_chunks_per_group);
+            const uint16_t lo = decode_char_pair(step_src + i * g_chunks_per_group + 2);
+            valid_pairs &= hi & lo;
+            const int group = (hi << (g_bits_per_chunk * 2)) | (lo & pair_mask);
+            bytes[i * 3]     = (uint8_t)(group >> 16);
+            bytes[i * 3 + 1] = (uint8_t)(group >> 8);
+            bytes[i * 3 + 2] = (uint8_t)group;
+        }
+        if(!(valid_pairs & CHUNK_PAIR_FLAG_VALID))
+        {
+            break;
+        }
+        memcpy(dst + offset * g_bytes_per_group, bytes, sizeof(bytes));
+    }
+    return offset;
+}
+
+#else
+
+// Without the pair table, the scalar decoder works on 8 characters at a time
+// in a 64-bit word (SWAR), using plain C so that it's available on every
+// platform. Words that contain whitespace or an invalid character are left to
+// the per-character loop.
+
+static const uint64_t g_swar_ones  = 0x0101010101010101ull;
+static const uint64_t g_swar_highs = 0x8080808080808080ull;
+
+// Written out in full so that compilers turn it into a single load.
+static inline uint64_t load_little_endian(const uint8_t* const src)
+{
+    return (uint64_t)src[0]       | (uint64_t)src[1] << 8  | (uint64_t)src[2] << 16 | (uint64_t)src[3] << 24 |
+           (uint64_t)src[4] << 32 | (uint64_t)src[5] << 40 | (uint64_t)src[6] << 48 | (uint64_t)src[7] << 56;
+}
+
+static inline void store_big_endian(uint8_t* const dst, const uint64_t value, const int byte_count)
+{
+    for(int i = 0; i < byte_count; i++)
+    {
+        dst[i] = (uint8_t)(value >> ((byte_count - 1 - i) * g_bits_per_byte));
+    }
+}
+
+// The comparisons only work on bytes with the high bit clear. They return a
+// word with the high bit set in every byte that matches.
+static inline uint64_t swar_greater_than(const uint64_t chars, const int value)
+{
+    return (chars + g_swar_ones * (0x7f - value)) & g_swar_highs;
+}
+
+static inline uint64_t swar_in_range(const uint64_t chars, const int lo, const int hi)
+{
+    return swar_greater_than(chars, lo - 1) & ~swar_greater_than(chars, hi);
+}
+
+// Puts value into every byte that matches, and 0 into the others.
+static inline uint64_t swar_select(const uint64_t matches, const int value)
+{
+    return (matches >> 7) * value;
+}
+
+// Subtracts a separate offset (below 0x80) from each byte. Setting the high
+// bits first stops the bytes from borrowing from each other.
+static inline uint64_t swar_subtract(const uint64_t chars, const uint64_t offsets)
+{
+    return ((chars | g_swar_highs) - offsets) & ~g_swar_highs;
+}
+
+// Packs 8 chunks (the first one in the lowest byte) into a single value,
+// most significant chunk first.
+static inline uint64_t swar_pack_chunks(const uint64_t chunks)
+{
+    const uint64_t pairs = ((chunks & 0x00ff00ff00ff00ffull) << g_bits_per_chunk) |
+                           ((chunks >> 8) & 0x00ff00ff00ff00ffull);
+    const uint64_t quads = ((pairs & 0x0000ffff0000ffffull) << (g_bits_per_chunk * 2)) |
+                           ((pairs >> 16) & 0x0000ffff0000ffffull);
+    return ((quads & 0xffffffffull) << (g_bits_per_chunk * 4)) | (quads >> 32);
+}
+
+// Returns false if any of the characters is whitespace or invalid.
+static inline bool swar_chars_to_chunks(const uint64_t chars, uint64_t* const chunks)
+{
+    const uint64_t is_dash       = swar_in_range(chars, '-', '-');
+    const uint64_t is_digit      = swar_in_range(chars, '0', '9');
+    const uint64_t is_upper      = swar_in_range(chars, 'A', 'Z');
+    const uint64_t is_underscore = swar_in_range(chars, '_', '_');
+    const uint64_t is_lower      = swar_in_range(chars, 'a', 'z');
+    if((is_dash | is_digit | is_upper | is_underscore | is_lower) != g_swar_highs)
+    {
+        return false;
+    }
+
+    // '-' = 0 + 45, '0' = 1 + 47, 'A' = 11 + 54, '_' = 37 + 58, 'a' = 38 + 59
+    const uint64_t offsets = swar_select(is_dash, 45) +
+                             swar_select(is_digit, 47) +
+                             swar_select(is_upper, 54) +
+                             swar_select(is_underscore, 58) +
+                             swar_select(is_lower, 59);
+    *chunks = swar_subtract(chars, offsets);
+    return true;
+}
+
+// Returns false if any of the characters is whitespace or invalid.
+static inline bool decode_8_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const uint64_t chars = load_little_endian(src);
+    uint64_t chunks;
+    if((chars & g_swar_highs) != 0 || !swar_chars_to_chunks(chars, &chunks))
+    {
+        return false;
+    }
+    store_big_endian(dst, swar_pack_chunks(chunks), 8 * g_bits_per_chunk / g_bits_per_byte);
+    return true;
+}
+
+static inline int64_t decode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    const int64_t groups_per_step = 8 / g_chunks_per_group;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_8_chars(src + offset * g_chunks_per_group, dst + offset * g_bytes_per_group))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif
+
 
 // ===========================================================================
 // Code below this point is the same in all safeXX codecs (with a different
@@ -112,6 +1475,212 @@ static inline int extract_chunk_from_accumulator(const int64_t accumulator, cons
 // other codecs.
 // ===========================================================================
 
+// After the bulk decoder stops early (usually because of whitespace), the
+// per-character loop consumes at least this many characters before the bulk
+// decoder is tried again.
+static const int g_bulk_decode_retry_char_count = 32;
+
+// -------
+// Kernels
+// -------
+
+typedef struct
+{
+    const char* name;
+    bool (*is_supported)(void);
+    int64_t (*encode_groups)(const uint8_t* src, uint8_t* dst, int64_t group_count);
+    int64_t (*decode_groups)(const uint8_t* src, uint8_t* dst, int64_t group_count);
+    int64_t (*compact_blocks)(const uint8_t* src, uint8_t* dst, int64_t block_count);
+} bulk_kernel;
+
+static bool is_always_supported(void)
+{
+    return true;
+}
+
+static int64_t no_bulk_kernel(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    (void)src;
+    (void)dst;
+    (void)group_count;
+    return 0;
+}
+
+// Compaction works on blocks of this many chars.
+static const int g_compact_block_size = 16;
+
+static int64_t compact_blocks_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t block_count)
+{
+    // Every char gets written, but only kept ones move the write position on.
+    // This saves a hard to predict branch.
+    uint8_t* next = dst;
+    for(int64_t i = 0; i < block_count * g_compact_block_size; i++)
+    {
+        const uint8_t next_char = src[i];
+        *next = next_char;
+        next += g_encode_char_to_chunk[next_char] != CHUNK_CODE_WHITESPACE;
+    }
+    return next - dst;
+}
+
+#if SAFE64_HAS_X86_KERNELS
+static bool is_avx2_supported(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+static bool is_sse41_supported(void)
+{
+    return __builtin_cpu_supports("sse4.1");
+}
+#endif
+
+#if SAFE64_HAS_BMI2_KERNELS
+// pdep and pext are microcoded on AMD CPUs before Zen 3, but those all support
+// AVX2 anyway, so they never get this far down the list.
+static bool is_bmi2_supported(void)
+{
+    return __builtin_cpu_supports("bmi2");
+}
+#endif
+
+// Fastest first. The scalar kernel leaves everything to encode_groups_scalar()
+// and decode_groups_scalar().
+static const bulk_kernel g_kernels[] =
+{
+#if SAFE64_HAS_X86_KERNELS
+    {"avx2",    is_avx2_supported,   safe64_avx2_encode_groups,     safe64_avx2_decode_groups,    safe64_sse41_compact_blocks},
+    {"sse4.1",  is_sse41_supported,  safe64_sse41_encode_groups,    safe64_sse41_decode_groups,   safe64_sse41_compact_blocks},
+#endif
+#if SAFE64_HAS_BMI2_KERNELS
+    {"bmi2",    is_bmi2_supported,   safe64_bmi2_encode_groups,     safe64_bmi2_decode_groups,    compact_blocks_scalar},
+#endif
+#if SAFE64_HAS_GENERIC_KERNELS
+    {"generic", is_always_supported, safe64_generic_encode_groups,  safe64_generic_decode_groups, compact_blocks_scalar},
+#endif
+    {"scalar",  is_always_supported, no_bulk_kernel,                no_bulk_kernel,               compact_blocks_scalar},
+};
+static const int g_kernel_count = sizeof(g_kernels) / sizeof(*g_kernels);
+
+// Forces a kernel by name (if the CPU supports it).
+static const char* const g_kernel_override_env_var = "SAFE64_KERNEL";
+
+static const bulk_kernel* select_kernel(void)
+{
+    const char* const requested = getenv(g_kernel_override_env_var);
+    if(requested != NULL)
+    {
+        for(int i = 0; i < g_kernel_count; i++)
+        {
+            if(strcmp(g_kernels[i].name, requested) == 0 && g_kernels[i].is_supported())
+            {
+                return &g_kernels[i];
+            }
+        }
+        KSLOG_DEBUG("Kernel %s is unknown or unsupported. Using the default.", requested);
+    }
+
+    for(int i = 0; i < g_kernel_count - 1; i++)
+    {
+        if(g_kernels[i].is_supported())
+        {
+            return &g_kernels[i];
+        }
+    }
+    return &g_kernels[g_kernel_count - 1];
+}
+
+// Selection always gives the same result, so threads that race to initialize
+// this just store the same pointer.
+static _Atomic(const bulk_kernel*) g_active_kernel = NULL;
+
+static inline const bulk_kernel* get_active_kernel(void)
+{
+    const bulk_kernel* kernel = atomic_load_explicit(&g_active_kernel, memory_order_acquire);
+    if(kernel == NULL)
+    {
+        kernel = select_kernel();
+        KSLOG_DEBUG("Selected kernel %s", kernel->name);
+        atomic_store_explicit(&g_active_kernel, kernel, memory_order_release);
+    }
+    return kernel;
+}
+
+// Buffers passed to the *_with_slack() functions can be read and written for
+// this many bytes past their ends, which is enough for g_slack_group_count
+// groups and a store_accumulator_bytes().
+static const int g_required_slack = 64;
+
+// Bulk encoders hold back the last few groups when they load more than they
+// use. extra_group_count tells them how many more groups' worth of src and dst
+// are safe to touch, so that they don't have to.
+static inline int64_t encode_groups(const uint8_t* const src,
+                                    uint8_t* const dst,
+                                    const int64_t group_count,
+                                    const int64_t extra_group_count)
+{
+    int64_t offset = get_active_kernel()->encode_groups(src, dst, group_count + extra_group_count);
+    if(offset > group_count)
+    {
+        offset = group_count;
+    }
+    return offset + encode_groups_scalar(src + offset * g_bytes_per_group,
+                                         dst + offset * g_chunks_per_group,
+                                         group_count - offset);
+}
+
+static inline int64_t decode_groups(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    const int64_t offset = get_active_kernel()->decode_groups(src, dst, group_count);
+    return offset + decode_groups_scalar(src + offset * g_chunks_per_group,
+                                         dst + offset * g_bytes_per_group,
+                                         group_count - offset);
+}
+
+static inline int64_t compact_blocks(const uint8_t* const src, uint8_t* const dst, const int64_t block_count)
+{
+    return get_active_kernel()->compact_blocks(src, dst, block_count);
+}
+
+// Decodes whole groups from source data that has whitespace in it, by
+// compacting as much of it as fits into a scratch buffer first. Moves
+// *src_ptr past the groups that were decoded, and returns how many there were.
+static int64_t decode_compacted_groups(const uint8_t** const src_ptr,
+                                       const uint8_t* const src_end,
+                                       uint8_t* const dst,
+                                       const int64_t max_group_count)
+{
+    uint8_t scratch[1024];
+    const uint8_t* const src = *src_ptr;
+    const int64_t src_length = src_end - src < (int64_t)sizeof(scratch) ? src_end - src : (int64_t)sizeof(scratch);
+    const int64_t block_count = src_length / g_compact_block_size;
+    const int64_t char_count = compact_blocks(src, scratch, block_count);
+    const int64_t src_group_count = char_count / g_chunks_per_group;
+    const int64_t group_count = src_group_count < max_group_count ? src_group_count : max_group_count;
+    const int64_t decoded_group_count = decode_groups(scratch, dst, group_count);
+    KSLOG_DEBUG("Compacted %d chars to %d, and decoded %d of %d groups",
+                block_count * g_compact_block_size, char_count, decoded_group_count, group_count);
+    if(decoded_group_count == 0)
+    {
+        return 0;
+    }
+
+    // Walk back over the chars that weren't decoded (and any whitespace in
+    // front of them) to find where the last decoded one came from.
+    const uint8_t* next = src + block_count * g_compact_block_size;
+    int64_t left_over = char_count - decoded_group_count * g_chunks_per_group;
+    while(left_over > 0 || g_encode_char_to_chunk[next[-1]] == CHUNK_CODE_WHITESPACE)
+    {
+        next--;
+        if(g_encode_char_to_chunk[*next] != CHUNK_CODE_WHITESPACE)
+        {
+            left_over--;
+        }
+    }
+    *src_ptr = next;
+    return decoded_group_count;
+}
+
 static inline int calculate_length_chunk_count(int64_t length)
 {
     int chunk_count = 0;
@@ -132,6 +1701,11 @@ const char* safe64_version(void)
     return EXPAND_AND_QUOTE(PROJECT_VERSION);
 }
 
+const char* safe64_get_active_kernel(void)
+{
+    return get_active_kernel()->name;
+}
+
 int64_t safe64_get_decoded_length(const int64_t encoded_length)
 {
     if(encoded_length < 0)
@@ -147,11 +1721,12 @@ int64_t safe64_get_decoded_length(const int64_t encoded_length)
     return result;
 }
 
-safe64_status safe64_decode_feed(const uint8_t** const src_buffer_ptr,
+static safe64_status decode_feed(const uint8_t** const src_buffer_ptr,
                                  const int64_t src_length,
                                  uint8_t** const dst_buffer_ptr,
                                  const int64_t dst_length,
-                                 const safe64_stream_state stream_state)
+                                 const safe64_stream_state stream_state,
+                                 const bool has_slack)
 {
     if(src_length < 0 || dst_length < 0)
     {
@@ -170,27 +1745,98 @@ safe64_status safe64_decode_feed(const uint8_t** const src_buffer_ptr,
     { \
         const int bytes_to_write = g_chunk_to_byte_count[CHUNK_COUNT]; \
         KSLOG_DEBUG("Writing %d chunks as %d decoded bytes", CHUNK_COUNT, bytes_to_write); \
-        for(int i = bytes_to_write - 1; i >= 0; i--) \
+        if(has_slack && bytes_to_write > 0) \
+        { \
+            store_accumulator_bytes(dst, accumulator, bytes_to_write); \
+            dst += bytes_to_write; \
+        } \
+        else \
         { \
-            *dst++ = extract_byte_from_accumulator(accumulator, i); \
-            KSLOG_DEBUG("Wrote byte %02x to index %d", dst[-1], i); \
+            for(int i = bytes_to_write - 1; i >= 0; i--) \
+            { \
+                *dst++ = extract_byte_from_accumulator(accumulator, i); \
+                KSLOG_DEBUG("Wrote byte %02x to index %d", dst[-1], i); \
+            } \
         } \
     }
 
+    const bool whitespace_is_invalid = stream_state & SAFE64_SRC_HAS_NO_WHITESPACE;
     const uint8_t* last_src = src;
+    const uint8_t* next_bulk_src = src;
     int current_group_chunk_count = 0;
     int64_t accumulator = 0;
 
     while(src < src_end)
     {
+        if(current_group_chunk_count == 0 && src >= next_bulk_src)
+        {
+            // The per-character loop never fills the last byte of dst by
+            // itself (that's left to the end-of-stream handling), so the bulk
+            // decoder must leave it free as well.
+            const int64_t src_group_count = (src_end - src) / g_chunks_per_group;
+            const int64_t dst_group_count = dst < dst_end ? (dst_end - dst - 1) / g_bytes_per_group : 0;
+            const int64_t group_count = src_group_count < dst_group_count ? src_group_count : dst_group_count;
+            const int64_t decoded_group_count = decode_groups(src, dst, group_count);
+            KSLOG_DEBUG("Bulk decoded %d of %d groups", decoded_group_count, group_count);
+            src += decoded_group_count * g_chunks_per_group;
+            dst += decoded_group_count * g_bytes_per_group;
+            if(decoded_group_count > 0)
+            {
+                last_src = src;
+            }
+            // Without whitespace, a group that the bulk decoder stopped on
+            // holds an error, so there's no point in trying again.
+            next_bulk_src = whitespace_is_invalid ? src_end : src + g_bulk_decode_retry_char_count;
+            if(decoded_group_count < group_count && !whitespace_is_invalid)
+            {
+                // Most likely the bulk decoder stopped on whitespace, so give
+                // it another go without.
+                const int64_t compacted_group_count = decode_compacted_groups(&src,
+                                                                              src_end,
+                                                                              dst,
+                                                                              dst_group_count - decoded_group_count);
+                if(compacted_group_count > 0)
+                {
+                    dst += compacted_group_count * g_bytes_per_group;
+                    last_src = src;
+                    next_bulk_src = src;
+                }
+            }
+            continue;
+        }
+        if(current_group_chunk_count == 0 && src_end - src >= g_chunks_per_group && dst_end - dst > g_bytes_per_group)
+        {
+            // There's room for a whole group, so its chunks can skip the
+            // per-character checks below until whitespace or an error turns
+            // up. That character is left to the checks.
+            while(current_group_chunk_count < g_chunks_per_group)
+            {
+                const uint8_t chunk = g_encode_char_to_chunk[*src];
+                if(chunk >= CHUNK_CODE_WHITESPACE)
+                {
+                    break;
+                }
+                accumulator = accumulate_chunk(accumulator, chunk);
+                current_group_chunk_count++;
+                src++;
+            }
+            if(current_group_chunk_count == g_chunks_per_group)
+            {
+                WRITE_BYTES(current_group_chunk_count);
+                current_group_chunk_count = 0;
+                accumulator = 0;
+                last_src = src;
+                continue;
+            }
+        }
         const uint8_t next_char = *src++;
         const uint8_t next_chunk = g_encode_char_to_chunk[next_char];
-        if(next_chunk == CHUNK_CODE_WHITESPACE)
+        if(next_chunk == CHUNK_CODE_WHITESPACE && !whitespace_is_invalid)
         {
             KSLOG_TRACE("Whitespace");
             continue;
         }
-        if(next_chunk == CHUNK_CODE_ERROR)
+        if(next_chunk >= CHUNK_CODE_WHITESPACE)
         {
             KSLOG_DEBUG("Error: Invalid source data: %02x: [%c]", next_char, next_char);
             *src_buffer_ptr = src - 1;
@@ -213,13 +1859,27 @@ safe64_status safe64_decode_feed(const uint8_t** const src_buffer_ptr,
         }
     }
 
-    // Skip over any trailing whitespace
-    for(; src < src_end; src++)
+    if(whitespace_is_invalid)
     {
-        if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+        if(src < src_end && g_encode_char_to_chunk[*src] == CHUNK_CODE_WHITESPACE)
         {
-            last_src = src;
-            break;
+            KSLOG_DEBUG("Error: Whitespace in strict source data");
+            *src_buffer_ptr = src;
+            *dst_buffer_ptr = dst;
+            return SAFE64_ERROR_INVALID_SOURCE_DATA;
+        }
+    }
+    else
+    {
+        // Skip over any trailing whitespace. The loop only stops early part
+        // way through a group, so last_src stays at the start of that group
+        // unless it gets written below.
+        for(; src < src_end; src++)
+        {
+            if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+            {
+                break;
+            }
         }
     }
 
@@ -276,87 +1936,350 @@ safe64_status safe64_decode_feed(const uint8_t** const src_buffer_ptr,
     #undef WRITE_BYTES
 }
 
-int64_t safe64_read_length_field(const uint8_t* const buffer,
-                                 const int64_t buffer_length,
-                                 int64_t* const length)
+safe64_status safe64_decode_feed(const uint8_t** const src_buffer_ptr,
+                                 const int64_t src_length,
+                                 uint8_t** const dst_buffer_ptr,
+                                 const int64_t dst_length,
+                                 const safe64_stream_state stream_state)
 {
-    if(buffer_length < 0)
+    return decode_feed(src_buffer_ptr, src_length, dst_buffer_ptr, dst_length, stream_state, false);
+}
+
+// A position in a vector of buffers, as if they were one buffer.
+typedef struct
+{
+    const safe64_iovec* vector;
+    int count;
+    int index;
+    int64_t offset;
+    int64_t used;
+} vector_cursor;
+
+static safe64_status init_vector_cursor(vector_cursor* const cursor,
+                                        const safe64_iovec* const vector,
+                                        const int count)
+{
+    if(count < 0)
     {
         return SAFE64_ERROR_INVALID_LENGTH;
     }
-    const int64_t max_pre_append_value = INT64_MAX >> g_bits_per_length_chunk;
-    const int continuation_bit = 1 << g_bits_per_length_chunk;
-    const int max_chunk_value = continuation_bit - 1;
-    const int chunk_mask = continuation_bit - 1;
-    KSLOG_DEBUG("bits %d, continue %02x, mask %02x",
-                g_bits_per_length_chunk, continuation_bit, chunk_mask);
-
-    const uint8_t* buffer_end = buffer + buffer_length;
-    int64_t value = 0;
-    int next_chunk = 0;
-
-    const uint8_t* src = buffer;
-    while(src < buffer_end)
+    for(int i = 0; i < count; i++)
     {
-        next_chunk = g_encode_char_to_chunk[(int)*src];
-        if(next_chunk == CHUNK_CODE_WHITESPACE)
-        {
-            src++;
-            continue;
-        }
-        const int chunk_value = next_chunk & ~continuation_bit;
-        if(chunk_value > max_chunk_value)
-        {
-            KSLOG_DEBUG("Error: Invalid length character: [%c]", *src);
-            return SAFE64_ERROR_INVALID_SOURCE_DATA;
-        }
-        if(value > max_pre_append_value)
-        {
-            KSLOG_DEBUG("Error: Length field too big");
-            return SAFE64_ERROR_INVALID_SOURCE_DATA;            
-        }
-        value = (value << g_bits_per_length_chunk) | (next_chunk & chunk_mask);
-        KSLOG_DEBUG("Chunk %d: '%c' (%d), continue %d, value portion = %d",
-                    src - buffer, *src, next_chunk, next_chunk & continuation_bit,
-                    (next_chunk & chunk_mask));
-        src++;
-        if(!(next_chunk & continuation_bit))
+        if(vector[i].length < 0)
         {
-            break;
+            return SAFE64_ERROR_INVALID_LENGTH;
         }
     }
-    if(next_chunk & continuation_bit)
+    cursor->vector = vector;
+    cursor->count = count;
+    cursor->index = 0;
+    cursor->offset = 0;
+    cursor->used = 0;
+    return SAFE64_STATUS_OK;
+}
+
+// Gives the length left in the current buffer, after moving past any buffers
+// that are used up.
+static int64_t get_contiguous_length(vector_cursor* const cursor)
+{
+    while(cursor->index < cursor->count && cursor->offset >= cursor->vector[cursor->index].length)
     {
-        KSLOG_DEBUG("Error: Unterminated length field");
-        return SAFE64_ERROR_UNTERMINATED_LENGTH_FIELD;
+        cursor->index++;
+        cursor->offset = 0;
     }
-    *length = value;
-    KSLOG_DEBUG("Length = %d, chunks = %d", value, src - buffer);
-    return src - buffer;
+    return cursor->index < cursor->count ? cursor->vector[cursor->index].length - cursor->offset : 0;
 }
 
-int64_t safe64_decode(const uint8_t* const src_buffer,
-                      const int64_t src_length,
-                      uint8_t* const dst_buffer,
-                      const int64_t dst_length)
+static inline uint8_t* get_cursor_pointer(const vector_cursor* const cursor)
 {
-    if(src_length < 0 || dst_length < 0)
+    return (uint8_t*)cursor->vector[cursor->index].base + cursor->offset;
+}
+
+// Gives the total length left in the vector, or limit if that's less.
+static int64_t get_remaining_length(vector_cursor* const cursor, const int64_t limit)
+{
+    int64_t length = get_contiguous_length(cursor);
+    for(int i = cursor->index + 1; i < cursor->count && length < limit; i++)
     {
-        return SAFE64_ERROR_INVALID_LENGTH;
+        length += cursor->vector[i].length;
     }
-    const uint8_t* src = src_buffer;
-    uint8_t* dst = dst_buffer;
-    const safe64_status status = safe64_decode_feed(
-                                    &src,
-                                    src_length,
-                                    &dst,
-                                    dst_length,
-                                    SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM);
-    if(status != SAFE64_STATUS_OK)
+    return length < limit ? length : limit;
+}
+
+// True if nothing comes after the current buffer.
+static bool is_in_last_buffer(vector_cursor* const cursor)
+{
+    get_contiguous_length(cursor);
+    for(int i = cursor->index + 1; i < cursor->count; i++)
     {
-        if(status == SAFE64_STATUS_PARTIALLY_COMPLETE)
+        if(cursor->vector[i].length > 0)
         {
-            return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void advance_cursor(vector_cursor* const cursor, int64_t length)
+{
+    cursor->used += length;
+    while(length > 0)
+    {
+        const int64_t contiguous_length = get_contiguous_length(cursor);
+        const int64_t step = length < contiguous_length ? length : contiguous_length;
+        cursor->offset += step;
+        length -= step;
+    }
+}
+
+// The caller makes sure that there's room for length bytes.
+static void scatter_to_cursor(vector_cursor* const cursor, const uint8_t* src, int64_t length)
+{
+    while(length > 0)
+    {
+        const int64_t contiguous_length = get_contiguous_length(cursor);
+        const int64_t step = length < contiguous_length ? length : contiguous_length;
+        memcpy(get_cursor_pointer(cursor), src, step);
+        src += step;
+        length -= step;
+        advance_cursor(cursor, step);
+    }
+}
+
+// Groups that straddle buffers go through a buffer on the stack. This is big
+// enough for a group in any of the codecs.
+#define STRADDLED_GROUP_SIZE 32
+
+safe64_status safe64_decode_feedv(const safe64_iovec* const src_vector,
+                                  const int src_vector_count,
+                                  const safe64_iovec* const dst_vector,
+                                  const int dst_vector_count,
+                                  int64_t* const src_used,
+                                  int64_t* const dst_used,
+                                  const safe64_stream_state stream_state)
+{
+    vector_cursor src;
+    vector_cursor dst;
+    if(init_vector_cursor(&src, src_vector, src_vector_count) != SAFE64_STATUS_OK ||
+       init_vector_cursor(&dst, dst_vector, dst_vector_count) != SAFE64_STATUS_OK)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const bool whitespace_is_invalid = stream_state & SAFE64_SRC_HAS_NO_WHITESPACE;
+    const int persistent_state = stream_state & (SAFE64_EXPECT_DST_STREAM_TO_END | SAFE64_SRC_HAS_NO_WHITESPACE);
+    safe64_status status = SAFE64_STATUS_PARTIALLY_COMPLETE;
+
+    for(;;)
+    {
+        const int64_t src_length = get_contiguous_length(&src);
+        const int64_t dst_length = get_contiguous_length(&dst);
+        if(src_length > 0 && dst_length > 0)
+        {
+            // The ends of the streams only come into it once both are in
+            // their last buffers. Before that, the group at the end of one
+            // buffer is left for the code below.
+            int current_state = persistent_state;
+            if(is_in_last_buffer(&src) && is_in_last_buffer(&dst))
+            {
+                current_state |= stream_state & (SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM);
+            }
+            const uint8_t* const src_start = get_cursor_pointer(&src);
+            uint8_t* const dst_start = get_cursor_pointer(&dst);
+            const uint8_t* src_ptr = src_start;
+            uint8_t* dst_ptr = dst_start;
+            status = decode_feed(&src_ptr, src_length, &dst_ptr, dst_length, (safe64_stream_state)current_state, false);
+            advance_cursor(&src, src_ptr - src_start);
+            advance_cursor(&dst, dst_ptr - dst_start);
+            if(status != SAFE64_STATUS_PARTIALLY_COMPLETE)
+            {
+                break;
+            }
+            if(src_ptr > src_start || dst_ptr > dst_start)
+            {
+                continue;
+            }
+        }
+
+        // The next group straddles buffers (or is the last one), so gather
+        // its chars, decode them, and scatter the bytes.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        // Where each char is in the source, counting any whitespace that was
+        // skipped, so that errors can be pinned on the right one.
+        int64_t group_offsets[STRADDLED_GROUP_SIZE];
+        int group_length = 0;
+        vector_cursor group_end = src;
+        while(group_length < g_chunks_per_group && get_contiguous_length(&group_end) > 0)
+        {
+            const uint8_t next_char = *get_cursor_pointer(&group_end);
+            const int64_t next_char_offset = group_end.used;
+            advance_cursor(&group_end, 1);
+            if(g_encode_char_to_chunk[next_char] == CHUNK_CODE_WHITESPACE && !whitespace_is_invalid)
+            {
+                continue;
+            }
+            group_offsets[group_length] = next_char_offset;
+            group[group_length++] = next_char;
+        }
+        // Whitespace after the group goes with it, so that the source is seen
+        // to end with the group if that's all there is.
+        while(!whitespace_is_invalid &&
+              get_contiguous_length(&group_end) > 0 &&
+              g_encode_char_to_chunk[*get_cursor_pointer(&group_end)] == CHUNK_CODE_WHITESPACE)
+        {
+            advance_cursor(&group_end, 1);
+        }
+
+        int current_state = persistent_state;
+        if(get_contiguous_length(&group_end) == 0)
+        {
+            current_state |= stream_state & SAFE64_SRC_IS_AT_END_OF_STREAM;
+        }
+        uint8_t bytes[STRADDLED_GROUP_SIZE];
+        int64_t bytes_length = sizeof(bytes);
+        const int64_t dst_remaining_length = get_remaining_length(&dst, bytes_length + 1);
+        if(dst_remaining_length <= bytes_length)
+        {
+            bytes_length = dst_remaining_length;
+            current_state |= stream_state & SAFE64_DST_IS_AT_END_OF_STREAM;
+        }
+        const uint8_t* group_ptr = group;
+        uint8_t* bytes_ptr = bytes;
+        status = decode_feed(&group_ptr, group_length, &bytes_ptr, bytes_length, (safe64_stream_state)current_state, false);
+        if(status == SAFE64_ERROR_INVALID_SOURCE_DATA)
+        {
+            advance_cursor(&src, group_offsets[group_ptr - group] - src.used);
+            break;
+        }
+        if(status != SAFE64_STATUS_OK && status != SAFE64_STATUS_PARTIALLY_COMPLETE)
+        {
+            break;
+        }
+        if(bytes_ptr == bytes && status == SAFE64_STATUS_PARTIALLY_COMPLETE)
+        {
+            // Not enough data or room for the group yet.
+            break;
+        }
+        KSLOG_DEBUG("Decoded a straddling group of %d chars", group_length);
+        scatter_to_cursor(&dst, bytes, bytes_ptr - bytes);
+        advance_cursor(&src, group_end.used - src.used);
+        if(status == SAFE64_STATUS_OK)
+        {
+            break;
+        }
+    }
+
+    *src_used = src.used;
+    *dst_used = dst.used;
+    return status;
+}
+
+// Reads length field chars on top of *value, which holds the value of any
+// chars read before. *is_complete gets set once the last char has been read.
+// Returns the number of chars used, or a status code.
+static int64_t continue_length_field(const uint8_t* const buffer,
+                                     const int64_t buffer_length,
+                                     int64_t* const value,
+                                     bool* const is_complete)
+{
+    const int64_t max_pre_append_value = INT64_MAX >> g_bits_per_length_chunk;
+    const int continuation_bit = 1 << g_bits_per_length_chunk;
+    const int max_chunk_value = continuation_bit - 1;
+    const int chunk_mask = continuation_bit - 1;
+    KSLOG_DEBUG("bits %d, continue %02x, mask %02x",
+                g_bits_per_length_chunk, continuation_bit, chunk_mask);
+
+    const uint8_t* buffer_end = buffer + buffer_length;
+    *is_complete = false;
+
+    const uint8_t* src = buffer;
+    while(src < buffer_end)
+    {
+        const int next_chunk = g_encode_char_to_chunk[(int)*src];
+        if(next_chunk == CHUNK_CODE_WHITESPACE)
+        {
+            src++;
+            continue;
+        }
+        const int chunk_value = next_chunk & ~continuation_bit;
+        if(chunk_value > max_chunk_value)
+        {
+            KSLOG_DEBUG("Error: Invalid length character: [%c]", *src);
+            return SAFE64_ERROR_INVALID_SOURCE_DATA;
+        }
+        if(*value > max_pre_append_value)
+        {
+            KSLOG_DEBUG("Error: Length field too big");
+            return SAFE64_ERROR_INVALID_SOURCE_DATA;            
+        }
+        *value = (*value << g_bits_per_length_chunk) | (next_chunk & chunk_mask);
+        KSLOG_DEBUG("Chunk %d: '%c' (%d), continue %d, value portion = %d",
+                    src - buffer, *src, next_chunk, next_chunk & continuation_bit,
+                    (next_chunk & chunk_mask));
+        src++;
+        if(!(next_chunk & continuation_bit))
+        {
+            *is_complete = true;
+            break;
+        }
+    }
+    return src - buffer;
+}
+
+int64_t safe64_read_length_field(const uint8_t* const buffer,
+                                 const int64_t buffer_length,
+                                 int64_t* const length)
+{
+    if(buffer_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    int64_t value = 0;
+    bool is_complete = false;
+    const int64_t used_length = continue_length_field(buffer, buffer_length, &value, &is_complete);
+    if(used_length < 0)
+    {
+        return used_length;
+    }
+    // An empty buffer reads as a length of 0.
+    if(!is_complete && buffer_length > 0)
+    {
+        KSLOG_DEBUG("Error: Unterminated length field");
+        return SAFE64_ERROR_UNTERMINATED_LENGTH_FIELD;
+    }
+    *length = value;
+    KSLOG_DEBUG("Length = %d, chunks = %d", value, used_length);
+    return used_length;
+}
+
+// Stores the offset of the offending character in *error_offset (if it isn't
+// NULL) when the data is invalid.
+static int64_t decode_completely(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length,
+                                 int64_t* const error_offset)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe64_status status = decode_feed(&src,
+                                             src_length,
+                                             &dst,
+                                             dst_length,
+                                             SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM,
+                                             false);
+    if(status != SAFE64_STATUS_OK)
+    {
+        if(status == SAFE64_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+        }
+        if(status == SAFE64_ERROR_INVALID_SOURCE_DATA && error_offset != NULL)
+        {
+            *error_offset = src - src_buffer;
         }
         return status;
     }
@@ -365,6 +2288,14 @@ int64_t safe64_decode(const uint8_t* const src_buffer,
     return decoded_byte_count;
 }
 
+int64_t safe64_decode(const uint8_t* const src_buffer,
+                      const int64_t src_length,
+                      uint8_t* const dst_buffer,
+                      const int64_t dst_length)
+{
+    return decode_completely(src_buffer, src_length, dst_buffer, dst_length, NULL);
+}
+
 int64_t safe64l_decode(const uint8_t* const src_buffer,
                        const int64_t src_length,
                        uint8_t* const dst_buffer,
@@ -413,6 +2344,168 @@ int64_t safe64l_decode(const uint8_t* const src_buffer,
     return decoded_byte_count;
 }
 
+static inline bool is_indentation(const uint8_t* const src, const uint8_t* const src_end, const int indent_count)
+{
+    if(src_end - src < indent_count)
+    {
+        return false;
+    }
+    for(int i = 0; i < indent_count; i++)
+    {
+        if(src[i] != ' ')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Decodes the payload chars gathered in scratch, and moves any trailing
+// partial group to the front. Returns the number of chars left in scratch, or
+// a status code.
+static int64_t decode_wrapped_payload(uint8_t* const scratch,
+                                      const int64_t scratch_length,
+                                      uint8_t** const dst_ptr,
+                                      const uint8_t* const dst_end,
+                                      const bool is_end_of_data)
+{
+    const uint8_t* src = scratch;
+    const safe64_stream_state stream_state = is_end_of_data ?
+        (safe64_stream_state)(SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM | SAFE64_SRC_HAS_NO_WHITESPACE) :
+        SAFE64_SRC_HAS_NO_WHITESPACE;
+    const safe64_status status = safe64_decode_feed(&src, scratch_length, dst_ptr, dst_end - *dst_ptr, stream_state);
+    if(status == SAFE64_STATUS_PARTIALLY_COMPLETE)
+    {
+        if(is_end_of_data || src == scratch)
+        {
+            return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+        }
+    }
+    else if(status != SAFE64_STATUS_OK)
+    {
+        return status;
+    }
+    const int64_t left_over = scratch + scratch_length - src;
+    memmove(scratch, src, left_over);
+    return left_over;
+}
+
+int64_t safe64_decode_wrapped(const uint8_t* const src_buffer,
+                              const int64_t src_length,
+                              uint8_t* const dst_buffer,
+                              const int64_t dst_length,
+                              const int line_length,
+                              const int indent_count,
+                              const safe64_line_break line_break)
+{
+    if(src_length < 0 || dst_length < 0 || line_length < 0 || indent_count < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    KSLOG_DEBUG("Decode %d chars in lines of %d, indented by %d", src_length, line_length, indent_count);
+    const char* const line_break_chars = line_break == SAFE64_LINE_BREAK_CRLF ? "\r\n" : "\n";
+    const int line_break_length = strlen(line_break_chars);
+
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+    uint8_t* dst = dst_buffer;
+    const uint8_t* const dst_end = dst_buffer + dst_length;
+
+    // The payload is gathered into scratch one line at a time, so that it can
+    // be decoded without looking for whitespace.
+    uint8_t scratch[4096];
+    int64_t scratch_length = 0;
+
+    if(!is_indentation(src, src_end, indent_count))
+    {
+        KSLOG_DEBUG("Error: Expected %d spaces of indentation at offset %d", indent_count, src - src_buffer);
+        return SAFE64_ERROR_INVALID_SOURCE_DATA;
+    }
+    src += indent_count;
+    int64_t line_chars_left = line_length > 0 ? line_length : src_end - src;
+    while(src < src_end)
+    {
+        if(line_chars_left == 0)
+        {
+            if(src_end - src < line_break_length ||
+               memcmp(src, line_break_chars, line_break_length) != 0 ||
+               !is_indentation(src + line_break_length, src_end, indent_count))
+            {
+                KSLOG_DEBUG("Error: Expected a line break and indentation at offset %d", src - src_buffer);
+                return SAFE64_ERROR_INVALID_SOURCE_DATA;
+            }
+            src += line_break_length + indent_count;
+            line_chars_left = line_length;
+            if(src >= src_end)
+            {
+                break;
+            }
+        }
+
+        int64_t copy_count = line_chars_left;
+        if(copy_count > src_end - src)
+        {
+            copy_count = src_end - src;
+        }
+        if(copy_count > (int64_t)sizeof(scratch) - scratch_length)
+        {
+            copy_count = sizeof(scratch) - scratch_length;
+        }
+        memcpy(scratch + scratch_length, src, copy_count);
+        scratch_length += copy_count;
+        src += copy_count;
+        line_chars_left -= copy_count;
+
+        if(scratch_length == sizeof(scratch))
+        {
+            scratch_length = decode_wrapped_payload(scratch, scratch_length, &dst, dst_end, false);
+            if(scratch_length < 0)
+            {
+                return scratch_length;
+            }
+        }
+    }
+
+    const int64_t status = decode_wrapped_payload(scratch, scratch_length, &dst, dst_end, true);
+    if(status < 0)
+    {
+        return status;
+    }
+    int64_t decoded_byte_count = dst - dst_buffer;
+    KSLOG_DEBUG("Decoded %d bytes", decoded_byte_count);
+    return decoded_byte_count;
+}
+
+int64_t safe64_compact(const uint8_t* const src_buffer,
+                       const int64_t src_length,
+                       uint8_t* const dst_buffer,
+                       const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const int64_t block_count = (src_length < dst_length ? src_length : dst_length) / g_compact_block_size;
+    uint8_t* dst = dst_buffer + compact_blocks(src_buffer, dst_buffer, block_count);
+    const uint8_t* const src_end = src_buffer + src_length;
+    const uint8_t* const dst_end = dst_buffer + dst_length;
+    for(const uint8_t* src = src_buffer + block_count * g_compact_block_size; src < src_end; src++)
+    {
+        if(g_encode_char_to_chunk[*src] == CHUNK_CODE_WHITESPACE)
+        {
+            continue;
+        }
+        if(dst >= dst_end)
+        {
+            KSLOG_DEBUG("Error: Not enough room to compact %d chars", src_length);
+            return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+        }
+        *dst++ = *src;
+    }
+    KSLOG_DEBUG("Compacted %d chars to %d", src_length, dst - dst_buffer);
+    return dst - dst_buffer;
+}
+
 int64_t safe64_get_encoded_length(const int64_t decoded_length,
                                   const bool include_length_field)
 {
@@ -433,11 +2526,12 @@ int64_t safe64_get_encoded_length(const int64_t decoded_length,
     return group_count * g_chunks_per_group + chunk_count + length_chunk_count;
 }
 
-safe64_status safe64_encode_feed(const uint8_t** const src_buffer_ptr,
+static safe64_status encode_feed(const uint8_t** const src_buffer_ptr,
                                  const int64_t src_length,
                                  uint8_t** const dst_buffer_ptr,
                                  const int64_t dst_length,
-                                 const bool is_end_of_data)
+                                 const bool is_end_of_data,
+                                 const bool has_slack)
 {
     if(src_length < 0 || dst_length < 0)
     {
@@ -474,6 +2568,17 @@ safe64_status safe64_encode_feed(const uint8_t** const src_buffer_ptr,
     int current_group_byte_count = 0;
     int64_t accumulator = 0;
 
+    {
+        const int64_t src_group_count = (src_end - src) / g_bytes_per_group;
+        const int64_t dst_group_count = (dst_end - dst) / g_chunks_per_group;
+        const int64_t group_count = src_group_count < dst_group_count ? src_group_count : dst_group_count;
+        const int64_t encoded_group_count = encode_groups(src, dst, group_count, has_slack ? g_slack_group_count : 0);
+        KSLOG_DEBUG("Bulk encoded %d of %d groups", encoded_group_count, group_count);
+        src += encoded_group_count * g_bytes_per_group;
+        dst += encoded_group_count * g_chunks_per_group;
+        last_src = src;
+    }
+
     while(src < src_end)
     {
         const uint8_t next_byte = *src++;
@@ -511,6 +2616,87 @@ safe64_status safe64_encode_feed(const uint8_t** const src_buffer_ptr,
 #undef WRITE_CHUNKS
 }
 
+safe64_status safe64_encode_feed(const uint8_t** const src_buffer_ptr,
+                                 const int64_t src_length,
+                                 uint8_t** const dst_buffer_ptr,
+                                 const int64_t dst_length,
+                                 const bool is_end_of_data)
+{
+    return encode_feed(src_buffer_ptr, src_length, dst_buffer_ptr, dst_length, is_end_of_data, false);
+}
+
+safe64_status safe64_encode_feedv(const safe64_iovec* const src_vector,
+                                  const int src_vector_count,
+                                  const safe64_iovec* const dst_vector,
+                                  const int dst_vector_count,
+                                  int64_t* const src_used,
+                                  int64_t* const dst_used,
+                                  const bool is_end_of_data)
+{
+    vector_cursor src;
+    vector_cursor dst;
+    if(init_vector_cursor(&src, src_vector, src_vector_count) != SAFE64_STATUS_OK ||
+       init_vector_cursor(&dst, dst_vector, dst_vector_count) != SAFE64_STATUS_OK)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    safe64_status status = SAFE64_STATUS_OK;
+
+    for(;;)
+    {
+        const int64_t src_length = get_contiguous_length(&src);
+        const int64_t dst_length = get_contiguous_length(&dst);
+        if(src_length > 0 && dst_length > 0)
+        {
+            const uint8_t* const src_start = get_cursor_pointer(&src);
+            uint8_t* const dst_start = get_cursor_pointer(&dst);
+            const uint8_t* src_ptr = src_start;
+            uint8_t* dst_ptr = dst_start;
+            encode_feed(&src_ptr, src_length, &dst_ptr, dst_length, is_end_of_data && is_in_last_buffer(&src), false);
+            advance_cursor(&src, src_ptr - src_start);
+            advance_cursor(&dst, dst_ptr - dst_start);
+            if(src_ptr > src_start)
+            {
+                continue;
+            }
+        }
+
+        // The next group straddles buffers (or is the last one), so gather
+        // its bytes, encode them, and scatter the chars.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        vector_cursor group_end = src;
+        int group_length = 0;
+        while(group_length < g_bytes_per_group && get_contiguous_length(&group_end) > 0)
+        {
+            group[group_length++] = *get_cursor_pointer(&group_end);
+            advance_cursor(&group_end, 1);
+        }
+        if(group_length == 0 || (group_length < g_bytes_per_group && !is_end_of_data))
+        {
+            break;
+        }
+
+        uint8_t chars[STRADDLED_GROUP_SIZE];
+        const uint8_t* group_ptr = group;
+        uint8_t* chars_ptr = chars;
+        encode_feed(&group_ptr, group_length, &chars_ptr, sizeof(chars), true, false);
+        const int64_t char_count = chars_ptr - chars;
+        if(get_remaining_length(&dst, char_count) < char_count)
+        {
+            KSLOG_DEBUG("Error: Need %d chars but only %d available", char_count, get_remaining_length(&dst, char_count));
+            status = SAFE64_STATUS_PARTIALLY_COMPLETE;
+            break;
+        }
+        KSLOG_DEBUG("Encoded a straddling group of %d bytes", group_length);
+        scatter_to_cursor(&dst, chars, char_count);
+        advance_cursor(&src, group_length);
+    }
+
+    *src_used = src.used;
+    *dst_used = dst.used;
+    return status;
+}
+
 int64_t safe64_write_length_field(const int64_t length,
                                   uint8_t* const dst_buffer,
                                   const int64_t dst_buffer_length)
@@ -603,3 +2789,899 @@ int64_t safe64l_encode(const uint8_t* const src_buffer,
     }
     return dst - dst_buffer;
 }
+
+int64_t safe64_required_slack(void)
+{
+    return g_required_slack;
+}
+
+int64_t safe64_encode_with_slack(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe64_status status = encode_feed(&src, src_length, &dst, dst_length, true, true);
+    if(status != SAFE64_STATUS_OK)
+    {
+        if(status == SAFE64_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+        }
+        return status;
+    }
+    return dst - dst_buffer;
+}
+
+int64_t safe64_decode_with_slack(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe64_status status = decode_feed(&src,
+                                             src_length,
+                                             &dst,
+                                             dst_length,
+                                             SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM,
+                                             true);
+    if(status != SAFE64_STATUS_OK)
+    {
+        if(status == SAFE64_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+        }
+        return status;
+    }
+    return dst - dst_buffer;
+}
+
+// Parallel encodes and decodes split the data into shards, with a few for each
+// thread so that threads that finish early can take over some of the work from
+// slower ones. Shards are never smaller than this though, because handing work
+// over has a cost.
+static const int64_t g_min_parallel_shard_size = 1 << 16;
+static const int g_shards_per_thread = 4;
+
+// Gives a shard length that's a multiple of unit_length.
+static int64_t get_parallel_shard_length(const int64_t length, const int thread_count, const int unit_length)
+{
+    int64_t unit_count = length / unit_length / ((int64_t)thread_count * g_shards_per_thread) + 1;
+    if(unit_count < g_min_parallel_shard_size / unit_length)
+    {
+        unit_count = g_min_parallel_shard_size / unit_length;
+    }
+    return unit_count * unit_length;
+}
+
+// Encoding shards are made of whole groups, which encode to known places in
+// dst.
+
+typedef struct
+{
+    const uint8_t* src_buffer;
+    int64_t src_length;
+    uint8_t* dst_buffer;
+    int64_t shard_group_count;
+} parallel_encode;
+
+static void encode_shard(void* const context, const int64_t shard_index)
+{
+    const parallel_encode* const job = (const parallel_encode*)context;
+    const int64_t group_index = shard_index * job->shard_group_count;
+    const int64_t src_offset = group_index * g_bytes_per_group;
+    int64_t src_length = job->shard_group_count * g_bytes_per_group;
+    if(src_length > job->src_length - src_offset)
+    {
+        src_length = job->src_length - src_offset;
+    }
+    const uint8_t* src = job->src_buffer + src_offset;
+    uint8_t* dst = job->dst_buffer + group_index * g_chunks_per_group;
+    // Only the last shard can end in a partial group. The caller has already
+    // made sure that there's room for everything.
+    encode_feed(&src, src_length, &dst, safe64_get_encoded_length(src_length, false), true, false);
+}
+
+int64_t safe64_encode_parallel(const uint8_t* const src_buffer,
+                               const int64_t src_length,
+                               uint8_t* const dst_buffer,
+                               const int64_t dst_length,
+                               int thread_count)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const int64_t encoded_length = safe64_get_encoded_length(src_length, false);
+    if(encoded_length > dst_length)
+    {
+        KSLOG_DEBUG("Error: Need %d chars but only %d available", encoded_length, dst_length);
+        return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+    }
+    if(thread_count <= 0)
+    {
+        thread_count = safe64_get_cpu_count();
+    }
+
+    const int64_t shard_length = get_parallel_shard_length(src_length, thread_count, g_bytes_per_group);
+    const int64_t shard_count = (src_length + shard_length - 1) / shard_length;
+    KSLOG_DEBUG("Encoding %d bytes as %d shards on %d threads", src_length, shard_count, thread_count);
+
+    parallel_encode job =
+    {
+        .src_buffer = src_buffer,
+        .src_length = src_length,
+        .dst_buffer = dst_buffer,
+        .shard_group_count = shard_length / g_bytes_per_group,
+    };
+    safe64_run_parallel(encode_shard, &job, shard_count, thread_count);
+    return encoded_length;
+}
+
+int64_t safe64l_encode_parallel(const uint8_t* const src_buffer,
+                                const int64_t src_length,
+                                uint8_t* const dst_buffer,
+                                const int64_t dst_length,
+                                const int thread_count)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const int64_t bytes_used = safe64_write_length_field(src_length, dst_buffer, dst_length);
+    if(bytes_used < 0)
+    {
+        return bytes_used;
+    }
+    const int64_t encoded_length = safe64_encode_parallel(src_buffer,
+                                                          src_length,
+                                                          dst_buffer + bytes_used,
+                                                          dst_length - bytes_used,
+                                                          thread_count);
+    if(encoded_length < 0)
+    {
+        return encoded_length;
+    }
+    return bytes_used + encoded_length;
+}
+
+// Parallel decodes have to find out where the groups are first, because
+// whitespace moves them around. A first pass counts the chars in each shard
+// (block), which gives the index of the first char of each block, and from
+// that where its groups start and where in dst they decode to. A second pass
+// then decodes the groups that start in each block. Groups that straddle the
+// end of a block are gathered up and decoded on their own.
+
+typedef struct
+{
+    // The number of non-whitespace chars before the block. The first pass
+    // sets this to the number in the block, and the sum is worked out after.
+    int64_t char_index;
+    safe64_status status;
+    int64_t error_offset;
+} parallel_decode_block;
+
+typedef struct
+{
+    const uint8_t* src_buffer;
+    int64_t src_length;
+    uint8_t* dst_buffer;
+    int64_t dst_length;
+    int64_t block_length;
+    int64_t block_count;
+    int64_t char_count;
+    parallel_decode_block* blocks;
+} parallel_decode;
+
+static inline bool is_whitespace(const uint8_t ch)
+{
+    return g_encode_char_to_chunk[ch] == CHUNK_CODE_WHITESPACE;
+}
+
+// Gives one more than the highest whitespace char.
+static uint8_t get_whitespace_limit(void)
+{
+    int limit = 0;
+    for(int ch = 0; ch < 256; ch++)
+    {
+        if(is_whitespace((uint8_t)ch))
+        {
+            limit = ch + 1;
+        }
+    }
+    return (uint8_t)limit;
+}
+
+// Gives the whitespace limit in every byte, for count_word_whitespace().
+static uint64_t get_word_whitespace_limits(void)
+{
+    return 0x0101010101010101 * get_whitespace_limit();
+}
+
+// Whitespace is rare in most data, so chars are checked 8 at a time for any
+// that are below the whitespace limit, and only those are looked up.
+static inline int count_word_whitespace(const uint8_t* const src, const uint64_t limits)
+{
+    const uint64_t top_bits = 0x8080808080808080;
+    uint64_t chars;
+    memcpy(&chars, src, sizeof(chars));
+    // Sets the top bit of each byte that's below the limit. Setting the top
+    // bits first stops borrows from crossing bytes.
+    uint64_t below_limit = ~(((chars | top_bits) - limits) | chars) & top_bits;
+    int whitespace_count = 0;
+    for(; below_limit != 0; below_limit &= below_limit - 1)
+    {
+        const int shift = __builtin_ctzll(below_limit) & ~7;
+        whitespace_count += is_whitespace((uint8_t)(chars >> shift));
+    }
+    return whitespace_count;
+}
+
+static void count_block_chars(void* const context, const int64_t block_index)
+{
+    parallel_decode* const job = (parallel_decode*)context;
+    const int64_t block_offset = block_index * job->block_length;
+    int64_t block_length = job->src_length - block_offset;
+    if(block_length > job->block_length)
+    {
+        block_length = job->block_length;
+    }
+    const uint8_t* const src = job->src_buffer + block_offset;
+    const uint64_t limits = get_word_whitespace_limits();
+    int64_t whitespace_count = 0;
+    int64_t i = 0;
+    for(; i + (int64_t)sizeof(uint64_t) <= block_length; i += sizeof(uint64_t))
+    {
+        whitespace_count += count_word_whitespace(src + i, limits);
+    }
+    for(; i < block_length; i++)
+    {
+        whitespace_count += is_whitespace(src[i]);
+    }
+    job->blocks[block_index].char_index = block_length - whitespace_count;
+}
+
+static void decode_block(void* const context, const int64_t block_index)
+{
+    parallel_decode* const job = (parallel_decode*)context;
+    parallel_decode_block* const block = &job->blocks[block_index];
+    block->status = SAFE64_STATUS_OK;
+    const bool is_last_block = block_index == job->block_count - 1;
+    const uint8_t* const src_end = is_last_block ? job->src_buffer + job->src_length
+                                                 : job->src_buffer + (block_index + 1) * job->block_length;
+    const int64_t end_char_index = is_last_block ? job->char_count : block[1].char_index;
+
+    // Chars before the first group that starts here belong to the previous
+    // block's straddling group.
+    const int64_t first_group_index = (block->char_index + g_chunks_per_group - 1) / g_chunks_per_group;
+    if(first_group_index * g_chunks_per_group >= end_char_index)
+    {
+        KSLOG_DEBUG("Block %d has no groups of its own", block_index);
+        return;
+    }
+    const uint8_t* src = job->src_buffer + block_index * job->block_length;
+    for(int64_t skip_count = first_group_index * g_chunks_per_group - block->char_index; skip_count > 0; src++)
+    {
+        skip_count -= !is_whitespace(*src);
+    }
+
+    // The last block decodes whatever it ends with, the same as the serial
+    // decoder would.
+    const int64_t straddling_char_count = is_last_block ? 0 : (end_char_index - first_group_index * g_chunks_per_group) % g_chunks_per_group;
+    const uint8_t* straddling_src = src_end;
+    for(int64_t skip_count = straddling_char_count; skip_count > 0;)
+    {
+        straddling_src--;
+        skip_count -= !is_whitespace(*straddling_src);
+    }
+    const int64_t straddling_group_index = (end_char_index - straddling_char_count) / g_chunks_per_group;
+
+    const uint8_t* const src_start = src;
+    uint8_t* dst = job->dst_buffer + first_group_index * g_bytes_per_group;
+    uint8_t* const dst_end = is_last_block ? job->dst_buffer + job->dst_length
+                                           : job->dst_buffer + straddling_group_index * g_bytes_per_group;
+    KSLOG_DEBUG("Block %d decodes groups %d to %d", block_index, first_group_index, straddling_group_index);
+    safe64_status status = decode_feed(&src,
+                                       straddling_src - src_start,
+                                       &dst,
+                                       dst_end - dst,
+                                       SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM,
+                                       false);
+    if(status != SAFE64_STATUS_OK)
+    {
+        block->status = status;
+        block->error_offset = src - job->src_buffer;
+        return;
+    }
+    if(straddling_char_count == 0)
+    {
+        return;
+    }
+
+    // The straddling group can run on through any number of blocks that are
+    // all whitespace, and can also be the partial group at the very end.
+    uint8_t group[STRADDLED_GROUP_SIZE];
+    int64_t group_offsets[STRADDLED_GROUP_SIZE];
+    int group_length = 0;
+    const uint8_t* const data_end = job->src_buffer + job->src_length;
+    for(src = straddling_src; src < data_end && group_length < g_chunks_per_group; src++)
+    {
+        if(!is_whitespace(*src))
+        {
+            group_offsets[group_length] = src - job->src_buffer;
+            group[group_length++] = *src;
+        }
+    }
+    const bool is_last_group = straddling_group_index * g_chunks_per_group + group_length >= job->char_count;
+    const uint8_t* group_ptr = group;
+    dst = job->dst_buffer + straddling_group_index * g_bytes_per_group;
+    status = decode_feed(&group_ptr,
+                         group_length,
+                         &dst,
+                         is_last_group ? job->dst_buffer + job->dst_length - dst : g_bytes_per_group,
+                         SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM,
+                         false);
+    if(status != SAFE64_STATUS_OK)
+    {
+        block->status = status;
+        block->error_offset = group_ptr < group + group_length ? group_offsets[group_ptr - group] : src - job->src_buffer;
+    }
+}
+
+int64_t safe64_decode_parallel(const uint8_t* const src_buffer,
+                               const int64_t src_length,
+                               uint8_t* const dst_buffer,
+                               const int64_t dst_length,
+                               int thread_count,
+                               int64_t* const error_offset)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    if(thread_count <= 0)
+    {
+        thread_count = safe64_get_cpu_count();
+    }
+    const int64_t block_length = get_parallel_shard_length(src_length, thread_count, 1);
+    const int64_t block_count = (src_length + block_length - 1) / block_length;
+    if(block_count < 2 || thread_count == 1)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+    parallel_decode_block* const blocks = (parallel_decode_block*)malloc(block_count * sizeof(*blocks));
+    if(blocks == NULL)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+
+    parallel_decode job =
+    {
+        .src_buffer = src_buffer,
+        .src_length = src_length,
+        .dst_buffer = dst_buffer,
+        .dst_length = dst_length,
+        .block_length = block_length,
+        .block_count = block_count,
+        .char_count = 0,
+        .blocks = blocks,
+    };
+    safe64_run_parallel(count_block_chars, &job, block_count, thread_count);
+    for(int64_t i = 0; i < block_count; i++)
+    {
+        const int64_t char_count = blocks[i].char_index;
+        blocks[i].char_index = job.char_count;
+        job.char_count += char_count;
+    }
+
+    const int64_t decoded_length = job.char_count / g_chunks_per_group * g_bytes_per_group +
+                                   g_chunk_to_byte_count[job.char_count % g_chunks_per_group];
+    KSLOG_DEBUG("Decoding %d chars as %d blocks on %d threads", job.char_count, block_count, thread_count);
+    if(decoded_length > dst_length)
+    {
+        // This is going to fail one way or another, and the serial decoder
+        // knows which way.
+        free(blocks);
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+
+    safe64_run_parallel(decode_block, &job, block_count, thread_count);
+
+    // Every char gets checked by exactly one block, so the serial decoder would
+    // stop at the error nearest the start.
+    const parallel_decode_block* first_error = NULL;
+    for(int64_t i = 0; i < block_count; i++)
+    {
+        if(blocks[i].status != SAFE64_STATUS_OK &&
+           (first_error == NULL || blocks[i].error_offset < first_error->error_offset))
+        {
+            first_error = &blocks[i];
+        }
+    }
+    if(first_error == NULL)
+    {
+        free(blocks);
+        return decoded_length;
+    }
+    KSLOG_DEBUG("Error %d at offset %d", first_error->status, first_error->error_offset);
+    const safe64_status status = first_error->status;
+    const int64_t first_error_offset = first_error->error_offset;
+    free(blocks);
+
+    // Invalid chars are counted as well, so dst only fills up before the
+    // first one if it's exactly the length worked out above. In that case the
+    // serial decoder might run out of room first.
+    if(status != SAFE64_ERROR_INVALID_SOURCE_DATA || decoded_length == dst_length)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+    if(error_offset != NULL)
+    {
+        *error_offset = first_error_offset;
+    }
+    return status;
+}
+
+// Groups are a fixed size, so any range of the decoded data comes from a known
+// run of groups. Without whitespace, each group's position follows from its
+// index. With whitespace, the groups are counted off from the nearest
+// checkpoint before the range.
+
+// Skips over *char_count non-whitespace chars, taking off the ones it skipped
+// (which is fewer if it runs out of data first).
+static const uint8_t* skip_chars(const uint8_t* src,
+                                 const uint8_t* const src_end,
+                                 int64_t* const char_count,
+                                 const uint64_t whitespace_limits)
+{
+    while(*char_count >= (int64_t)sizeof(uint64_t) && src_end - src >= (int64_t)sizeof(uint64_t))
+    {
+        *char_count -= sizeof(uint64_t) - count_word_whitespace(src, whitespace_limits);
+        src += sizeof(uint64_t);
+    }
+    for(; *char_count > 0 && src < src_end; src++)
+    {
+        *char_count -= !is_whitespace(*src);
+    }
+    return src;
+}
+
+int64_t safe64_decode_range(const uint8_t* const src_buffer,
+                            const int64_t src_length,
+                            const int64_t byte_offset,
+                            int64_t byte_count,
+                            uint8_t* const dst_buffer,
+                            const safe64_checkpoints* const checkpoints)
+{
+    if(src_length < 0 || byte_offset < 0 || byte_count < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const int64_t decoded_length = checkpoints != NULL ? checkpoints->decoded_length
+                                                       : safe64_get_decoded_length(src_length);
+    if(byte_offset >= decoded_length)
+    {
+        return 0;
+    }
+    if(byte_count > decoded_length - byte_offset)
+    {
+        byte_count = decoded_length - byte_offset;
+    }
+
+    const uint8_t* const src_end = src_buffer + src_length;
+    const int64_t first_group_index = byte_offset / g_bytes_per_group;
+    const uint8_t* src = src_buffer + first_group_index * g_chunks_per_group;
+    safe64_stream_state stream_state = SAFE64_SRC_IS_AT_END_OF_STREAM | SAFE64_DST_IS_AT_END_OF_STREAM;
+    if(checkpoints != NULL)
+    {
+        const int64_t checkpoint_index = first_group_index / checkpoints->group_interval;
+        if(checkpoint_index >= checkpoints->offset_count || checkpoints->offsets[checkpoint_index] > src_length)
+        {
+            KSLOG_DEBUG("Error: Checkpoint %d is past the end of the %d char sequence", checkpoint_index, src_length);
+            return SAFE64_ERROR_TRUNCATED_DATA;
+        }
+        int64_t skip_count = (first_group_index - checkpoint_index * checkpoints->group_interval) * g_chunks_per_group;
+        src = skip_chars(src_buffer + checkpoints->offsets[checkpoint_index],
+                         src_end,
+                         &skip_count,
+                         get_word_whitespace_limits());
+    }
+    else
+    {
+        stream_state |= SAFE64_SRC_HAS_NO_WHITESPACE;
+    }
+    KSLOG_DEBUG("Decoding %d bytes at %d from group %d at offset %d",
+                byte_count, byte_offset, first_group_index, src - src_buffer);
+
+    uint8_t* dst = dst_buffer;
+    uint8_t* const dst_end = dst_buffer + byte_count;
+    int skip_byte_count = byte_offset % g_bytes_per_group;
+    while(dst < dst_end)
+    {
+        const int64_t whole_group_count = (dst_end - dst) / g_bytes_per_group;
+        if(skip_byte_count == 0 && whole_group_count > 0)
+        {
+            // These groups are all inside the range, so none of them can be
+            // the partial group at the end, and they go straight to dst.
+            const safe64_status status = decode_feed(&src,
+                                                     src_end - src,
+                                                     &dst,
+                                                     whole_group_count * g_bytes_per_group,
+                                                     stream_state | SAFE64_EXPECT_DST_STREAM_TO_END,
+                                                     false);
+            if(status != SAFE64_STATUS_OK)
+            {
+                return status;
+            }
+            continue;
+        }
+
+        // A group that's only partly inside the range gets decoded on the side.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        int group_length = 0;
+        for(; src < src_end && group_length < g_chunks_per_group; src++)
+        {
+            if(checkpoints == NULL || !is_whitespace(*src))
+            {
+                group[group_length++] = *src;
+            }
+        }
+        uint8_t bytes[STRADDLED_GROUP_SIZE];
+        const uint8_t* group_ptr = group;
+        uint8_t* bytes_ptr = bytes;
+        const safe64_status status = decode_feed(&group_ptr,
+                                                 group_length,
+                                                 &bytes_ptr,
+                                                 g_bytes_per_group,
+                                                 stream_state,
+                                                 false);
+        if(status != SAFE64_STATUS_OK)
+        {
+            return status;
+        }
+        int64_t copy_length = bytes_ptr - bytes - skip_byte_count;
+        if(copy_length <= 0)
+        {
+            KSLOG_DEBUG("Error: Ran out of data at offset %d", src - src_buffer);
+            return SAFE64_ERROR_TRUNCATED_DATA;
+        }
+        if(copy_length > dst_end - dst)
+        {
+            copy_length = dst_end - dst;
+        }
+        memcpy(dst, bytes + skip_byte_count, copy_length);
+        dst += copy_length;
+        skip_byte_count = 0;
+    }
+    return byte_count;
+}
+
+int64_t safe64_get_checkpoint_count(const int64_t src_length, const int64_t group_interval)
+{
+    if(src_length < 0 || group_interval < 1)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const int64_t group_count = (src_length + g_chunks_per_group - 1) / g_chunks_per_group;
+    return group_count / group_interval + (group_count % group_interval != 0);
+}
+
+safe64_status safe64_build_checkpoints(const uint8_t* const src_buffer,
+                                       const int64_t src_length,
+                                       const int64_t group_interval,
+                                       int64_t* const offsets,
+                                       const int64_t offset_capacity,
+                                       safe64_checkpoints* const checkpoints)
+{
+    if(src_length < 0 || group_interval < 1 || offset_capacity < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    // An interval longer than the data only ever gets the first checkpoint.
+    const int64_t chars_per_checkpoint = group_interval > src_length ? src_length + 1
+                                                                     : group_interval * g_chunks_per_group;
+    const uint8_t* const src_end = src_buffer + src_length;
+    const uint64_t whitespace_limits = get_word_whitespace_limits();
+    const uint8_t* src = src_buffer;
+    int64_t offset_count = 0;
+    int64_t char_count = 0;
+    for(;;)
+    {
+        while(src < src_end && is_whitespace(*src))
+        {
+            src++;
+        }
+        if(src >= src_end)
+        {
+            break;
+        }
+        if(offset_count >= offset_capacity)
+        {
+            KSLOG_DEBUG("Error: No room for checkpoint %d", offset_count);
+            return SAFE64_ERROR_NOT_ENOUGH_ROOM;
+        }
+        offsets[offset_count++] = src - src_buffer;
+        int64_t skip_count = chars_per_checkpoint;
+        src = skip_chars(src, src_end, &skip_count, whitespace_limits);
+        char_count += chars_per_checkpoint - skip_count;
+    }
+
+    checkpoints->group_interval = group_interval;
+    checkpoints->offsets = offsets;
+    checkpoints->offset_count = offset_count;
+    checkpoints->decoded_length = char_count / g_chunks_per_group * g_bytes_per_group +
+                                  g_chunk_to_byte_count[char_count % g_chunks_per_group];
+    KSLOG_DEBUG("Built %d checkpoints for %d chars", offset_count, char_count);
+    return SAFE64_STATUS_OK;
+}
+
+void safe64_encoder_init(safe64_encoder* const encoder,
+                         const safe64_sink sink,
+                         void* const sink_context)
+{
+    encoder->sink = sink;
+    encoder->sink_context = sink_context;
+    encoder->has_length_field = false;
+    encoder->length_field = 0;
+    encoder->partial_group_length = 0;
+}
+
+void safe64l_encoder_init(safe64_encoder* const encoder,
+                          const int64_t length,
+                          const safe64_sink sink,
+                          void* const sink_context)
+{
+    safe64_encoder_init(encoder, sink, sink_context);
+    encoder->has_length_field = true;
+    encoder->length_field = length;
+}
+
+// Encodes as much of src as it can, handing the results to the sink. Anything
+// left at *src_ptr afterwards is a partial group.
+static safe64_status encode_to_sink(safe64_encoder* const encoder,
+                                    const uint8_t** const src_ptr,
+                                    const uint8_t* const src_end,
+                                    const bool is_end_of_data)
+{
+    uint8_t buffer[4096];
+    safe64_status status = SAFE64_STATUS_PARTIALLY_COMPLETE;
+    while(status == SAFE64_STATUS_PARTIALLY_COMPLETE)
+    {
+        uint8_t* dst = buffer;
+        status = encode_feed(src_ptr, src_end - *src_ptr, &dst, sizeof(buffer), is_end_of_data, false);
+        if(dst > buffer && !encoder->sink(encoder->sink_context, buffer, dst - buffer))
+        {
+            KSLOG_DEBUG("Error: Sink refused %d chars", dst - buffer);
+            return SAFE64_ERROR_SINK_FAILED;
+        }
+    }
+    return status;
+}
+
+safe64_status safe64_encoder_feed(safe64_encoder* const encoder,
+                                  const uint8_t* const src_buffer,
+                                  const int64_t src_length,
+                                  const bool is_end_of_data)
+{
+    if(src_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+
+    if(encoder->has_length_field)
+    {
+        uint8_t length_field[32];
+        const int64_t length_field_length = safe64_write_length_field(encoder->length_field,
+                                                                      length_field,
+                                                                      sizeof(length_field));
+        if(length_field_length < 0)
+        {
+            return length_field_length;
+        }
+        if(!encoder->sink(encoder->sink_context, length_field, length_field_length))
+        {
+            KSLOG_DEBUG("Error: Sink refused the length field");
+            return SAFE64_ERROR_SINK_FAILED;
+        }
+        encoder->has_length_field = false;
+    }
+
+    // A partial group left over from the last feed is topped up and encoded
+    // on its own, so that src doesn't have to be copied anywhere.
+    if(encoder->partial_group_length > 0)
+    {
+        while(encoder->partial_group_length < g_bytes_per_group && src < src_end)
+        {
+            encoder->partial_group[encoder->partial_group_length++] = *src++;
+        }
+        if(encoder->partial_group_length < g_bytes_per_group && !is_end_of_data)
+        {
+            return SAFE64_STATUS_OK;
+        }
+        const uint8_t* group = encoder->partial_group;
+        const safe64_status status = encode_to_sink(encoder,
+                                                    &group,
+                                                    encoder->partial_group + encoder->partial_group_length,
+                                                    is_end_of_data);
+        if(status != SAFE64_STATUS_OK)
+        {
+            return status;
+        }
+        encoder->partial_group_length = 0;
+    }
+
+    const safe64_status status = encode_to_sink(encoder, &src, src_end, is_end_of_data);
+    if(status != SAFE64_STATUS_OK)
+    {
+        return status;
+    }
+    encoder->partial_group_length = src_end - src;
+    memcpy(encoder->partial_group, src, encoder->partial_group_length);
+    KSLOG_DEBUG("Keeping %d bytes for the next feed", encoder->partial_group_length);
+    return SAFE64_STATUS_OK;
+}
+
+void safe64_decoder_init(safe64_decoder* const decoder,
+                         const safe64_sink sink,
+                         void* const sink_context)
+{
+    decoder->sink = sink;
+    decoder->sink_context = sink_context;
+    decoder->is_reading_length_field = false;
+    decoder->length_field = 0;
+    decoder->bytes_left = -1;
+    decoder->partial_group_length = 0;
+}
+
+void safe64l_decoder_init(safe64_decoder* const decoder,
+                          const safe64_sink sink,
+                          void* const sink_context)
+{
+    safe64_decoder_init(decoder, sink, sink_context);
+    decoder->is_reading_length_field = true;
+}
+
+// Decodes as much of src as it can, handing the results to the sink. Anything
+// left at *src_ptr afterwards is a partial group, maybe mixed with whitespace.
+static safe64_status decode_to_sink(safe64_decoder* const decoder,
+                                    const uint8_t** const src_ptr,
+                                    const uint8_t* const src_end,
+                                    const bool is_end_of_data)
+{
+    uint8_t buffer[4096];
+    for(;;)
+    {
+        int64_t dst_length = sizeof(buffer);
+        int stream_state = is_end_of_data ? SAFE64_SRC_IS_AT_END_OF_STREAM : SAFE64_STREAM_STATE_NONE;
+        if(decoder->bytes_left >= 0 && decoder->bytes_left <= dst_length)
+        {
+            // The length field says where the data ends.
+            dst_length = decoder->bytes_left;
+            stream_state |= SAFE64_DST_IS_AT_END_OF_STREAM | SAFE64_EXPECT_DST_STREAM_TO_END;
+        }
+        const uint8_t* const src_start = *src_ptr;
+        uint8_t* dst = buffer;
+        const safe64_status status = decode_feed(src_ptr,
+                                                 src_end - *src_ptr,
+                                                 &dst,
+                                                 dst_length,
+                                                 (safe64_stream_state)stream_state,
+                                                 false);
+        if(dst > buffer && !decoder->sink(decoder->sink_context, buffer, dst - buffer))
+        {
+            KSLOG_DEBUG("Error: Sink refused %d bytes", dst - buffer);
+            return SAFE64_ERROR_SINK_FAILED;
+        }
+        if(decoder->bytes_left >= 0)
+        {
+            decoder->bytes_left -= dst - buffer;
+        }
+        // Running out of room in buffer is the only reason to go around again.
+        if(status != SAFE64_STATUS_PARTIALLY_COMPLETE || (*src_ptr == src_start && dst == buffer))
+        {
+            return status;
+        }
+    }
+}
+
+safe64_status safe64_decoder_feed(safe64_decoder* const decoder,
+                                  const uint8_t* const src_buffer,
+                                  const int64_t src_length,
+                                  const bool is_end_of_data)
+{
+    if(src_length < 0)
+    {
+        return SAFE64_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+
+    if(decoder->is_reading_length_field)
+    {
+        bool is_complete = false;
+        const int64_t used_length = continue_length_field(src, src_end - src, &decoder->length_field, &is_complete);
+        if(used_length < 0)
+        {
+            return used_length;
+        }
+        src += used_length;
+        if(!is_complete)
+        {
+            if(is_end_of_data)
+            {
+                KSLOG_DEBUG("Error: Unterminated length field");
+                return SAFE64_ERROR_UNTERMINATED_LENGTH_FIELD;
+            }
+            return SAFE64_STATUS_OK;
+        }
+        KSLOG_DEBUG("Length = %d", decoder->length_field);
+        decoder->is_reading_length_field = false;
+        decoder->bytes_left = decoder->length_field;
+    }
+
+    // A partial group left over from the last feed is topped up and decoded
+    // on its own, so that src doesn't have to be copied anywhere.
+    if(decoder->partial_group_length > 0)
+    {
+        while(decoder->partial_group_length < g_chunks_per_group && src < src_end)
+        {
+            if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+            {
+                decoder->partial_group[decoder->partial_group_length++] = *src;
+            }
+            src++;
+        }
+        if(decoder->partial_group_length < g_chunks_per_group && !is_end_of_data)
+        {
+            return SAFE64_STATUS_OK;
+        }
+        const uint8_t* group = decoder->partial_group;
+        const safe64_status status = decode_to_sink(decoder,
+                                                    &group,
+                                                    decoder->partial_group + decoder->partial_group_length,
+                                                    is_end_of_data && src >= src_end);
+        if(status != SAFE64_STATUS_OK && status != SAFE64_STATUS_PARTIALLY_COMPLETE)
+        {
+            return status;
+        }
+        decoder->partial_group_length = 0;
+    }
+
+    // Data after the end that the length field gives is ignored.
+    if(decoder->bytes_left == 0)
+    {
+        return SAFE64_STATUS_OK;
+    }
+
+    const safe64_status status = decode_to_sink(decoder, &src, src_end, is_end_of_data);
+    if(status != SAFE64_STATUS_OK && status != SAFE64_STATUS_PARTIALLY_COMPLETE)
+    {
+        return status;
+    }
+    if(is_end_of_data && decoder->bytes_left > 0)
+    {
+        KSLOG_DEBUG("Error: Expected %d more bytes", decoder->bytes_left);
+        return SAFE64_ERROR_TRUNCATED_DATA;
+    }
+    for(; src < src_end && decoder->bytes_left != 0; src++)
+    {
+        if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+        {
+            decoder->partial_group[decoder->partial_group_length++] = *src;
+        }
+    }
+    KSLOG_DEBUG("Keeping %d chars for the next feed", decoder->partial_group_length);
+    return SAFE64_STATUS_OK;
+}
@@ -117,6 +117,7 @@ static void error_unexpected_status_exit(const safe80_status status)
         HANDLE_CASE(SAFE80_ERROR_TRUNCATED_DATA);
         HANDLE_CASE(SAFE80_ERROR_INVALID_LENGTH);
         HANDLE_CASE(SAFE80_ERROR_NOT_ENOUGH_ROOM);
+        HANDLE_CASE(SAFE80_ERROR_SINK_FAILED);
 
         // This should not happen
         HANDLE_CASE(SAFE80_STATUS_OK);
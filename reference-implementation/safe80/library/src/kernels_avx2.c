@@ -0,0 +1,200 @@
+#include "kernels.h"
+
+#if SAFE80_HAS_X86_KERNELS
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "kernels_common.h"
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+// Both directions work on two groups at a time, one per 128-bit lane, with
+// one 32-bit lane per limb.
+
+// Encoding: The 120-bit division that splits a group into limbs is done with
+// 64-bit scalar arithmetic. The limbs of both groups are then converted to
+// chunks together using multiply-high reciprocal divisions, and the chunks
+// are mapped onto the alphabet with five 16-entry shuffle tables.
+
+// Exact for any 32-bit value: x / 80 = (x / 16) / 5, and (2^34 / 5) rounded
+// up is exact for any 32-bit value.
+TARGET_AVX2 static inline __m256i divide_by_80(const __m256i values)
+{
+    const __m256i magic = _mm256_set1_epi64x(0xcccccccd);
+    const __m256i sixteenths = _mm256_srli_epi32(values, 4);
+    const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(sixteenths, magic), 34);
+    // Shifting by 2 rather than 34 leaves the odd quotients in the high halves.
+    const __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(sixteenths, 32), magic), 2);
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+TARGET_AVX2 static inline __m256i remainder_of_80(const __m256i values, const __m256i quotients)
+{
+    return _mm256_sub_epi32(values, _mm256_slli_epi32(_mm256_add_epi32(quotients, _mm256_slli_epi32(quotients, 2)), 4));
+}
+
+TARGET_AVX2 static inline __m256i chunks_to_chars(const __m256i chunks)
+{
+    __m256i chars = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)g_chunk_to_char)),
+                                        chunks);
+    for(int i = 1; i < 5; i++)
+    {
+        const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(g_chunk_to_char + i * 16)));
+        chars = _mm256_blendv_epi8(chars,
+                                   _mm256_shuffle_epi8(table, chunks),
+                                   _mm256_cmpgt_epi8(chunks, _mm256_set1_epi8((char)(i * 16 - 1))));
+    }
+    return chars;
+}
+
+TARGET_AVX2 static inline void encode_30_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    uint32_t a[4];
+    uint32_t b[4];
+    split_group(src, a);
+    split_group(src + 15, b);
+    const __m256i values = _mm256_setr_epi32(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]);
+
+    // A limb is below 80^5, so the last quotient is its first chunk.
+    const __m256i q1 = divide_by_80(values);
+    const __m256i q2 = divide_by_80(q1);
+    const __m256i q3 = divide_by_80(q2);
+    const __m256i c0 = divide_by_80(q3);
+    const __m256i c1 = remainder_of_80(q3, c0);
+    const __m256i c2 = remainder_of_80(q2, q3);
+    const __m256i c3 = remainder_of_80(q1, q2);
+    const __m256i c4 = remainder_of_80(values, q1);
+
+    // The first four chunks of each limb fill its 32-bit lane. limb3's first
+    // chunk is always 0 and isn't written.
+    const __m256i c0_to_c3 = _mm256_or_si256(_mm256_or_si256(c0, _mm256_slli_epi32(c1, 8)),
+                                             _mm256_or_si256(_mm256_slli_epi32(c2, 16), _mm256_slli_epi32(c3, 24)));
+
+    // Each group encodes to 19 chars: 16 at the front, and 3 left over.
+    const __m256i front = _mm256_or_si256(
+        _mm256_shuffle_epi8(c0_to_c3, _mm256_setr_epi8(
+            1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13,
+            1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13)),
+        _mm256_shuffle_epi8(c4, _mm256_setr_epi8(
+            -1, -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1, -1,
+            -1, -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1, -1)));
+    const __m256i back = _mm256_or_si256(
+        _mm256_shuffle_epi8(c0_to_c3, _mm256_setr_epi8(
+            14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm256_shuffle_epi8(c4, _mm256_setr_epi8(
+            -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+
+    const __m256i front_chars = chunks_to_chars(front);
+    const __m256i back_chars = chunks_to_chars(back);
+    uint32_t back_0 = (uint32_t)_mm256_extract_epi32(back_chars, 0);
+    uint32_t back_1 = (uint32_t)_mm256_extract_epi32(back_chars, 4);
+    _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(front_chars));
+    memcpy(dst + 16, &back_0, 3);
+    _mm_storeu_si128((__m128i*)(dst + 19), _mm256_extracti128_si256(front_chars, 1));
+    memcpy(dst + 35, &back_1, 3);
+}
+
+TARGET_AVX2 int64_t safe80_avx2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 15 bytes and 19 chars per group
+    const int64_t groups_per_step = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        encode_30_bytes(src + offset * 15, dst + offset * 19);
+    }
+    return offset;
+}
+
+// Decoding: Characters are translated through six 16-entry shuffle tables,
+// one for each high nibble from 2 to 7. Anything that isn't in the alphabet
+// (including whitespace) aborts the block so that the scalar code can deal
+// with it. The limbs of both groups are built with multiply-adds, and then
+// each group is put back together with a single 64x64 -> 128 bit multiply.
+// Like the scalar code, this keeps only the low 120 bits of an overflowing
+// group.
+
+// Characters that aren't in the alphabet translate to 0xff.
+TARGET_AVX2 static inline __m256i chars_to_chunks(const __m256i chars)
+{
+    // Characters >= 0x80 don't match any high nibble, and stay at 0xff.
+    const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi16(chars, 4), _mm256_set1_epi8(0x0f));
+    __m256i chunks = _mm256_set1_epi8((char)0xff);
+    for(int i = 0; i < 6; i++)
+    {
+        const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(g_char_to_chunk + i * 16)));
+        chunks = _mm256_blendv_epi8(chunks,
+                                    _mm256_shuffle_epi8(table, chars),
+                                    _mm256_cmpeq_epi8(hi_nibbles, _mm256_set1_epi8((char)(i + 2))));
+    }
+    return chunks;
+}
+
+TARGET_AVX2 static inline bool decode_38_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    // Each 128-bit lane gets one group: chars 0-15 in front, and 3-18 in back.
+    const __m256i front = chars_to_chunks(_mm256_loadu2_m128i((const __m128i*)(src + 19), (const __m128i*)src));
+    const __m256i back = chars_to_chunks(_mm256_loadu2_m128i((const __m128i*)(src + 22), (const __m128i*)(src + 3)));
+    const __m256i is_invalid = _mm256_or_si256(_mm256_cmpeq_epi8(front, _mm256_set1_epi8((char)0xff)),
+                                               _mm256_cmpeq_epi8(back, _mm256_set1_epi8((char)0xff)));
+    if(_mm256_movemask_epi8(is_invalid) != 0)
+    {
+        return false;
+    }
+
+    // The first four chunks of each limb go in its 32-bit lane (with a
+    // leading 0 for limb3), and the last chunk in a separate register.
+    const __m256i c0_to_c3 = _mm256_or_si256(
+        _mm256_shuffle_epi8(front, _mm256_setr_epi8(
+            -1, 0, 1, 2, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1,
+            -1, 0, 1, 2, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1)),
+        _mm256_shuffle_epi8(back, _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, 14,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, 14)));
+    const __m256i c4 = _mm256_or_si256(
+        _mm256_shuffle_epi8(front, _mm256_setr_epi8(
+            3, -1, -1, -1, 8, -1, -1, -1, 13, -1, -1, -1, -1, -1, -1, -1,
+            3, -1, -1, -1, 8, -1, -1, -1, 13, -1, -1, -1, -1, -1, -1, -1)),
+        _mm256_shuffle_epi8(back, _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 15, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 15, -1, -1, -1)));
+
+    // (c0 * 80 + c1) and (c2 * 80 + c3), then (hi * 80^2 + lo), and finally
+    // the last chunk, which leaves a limb below 80^5 in each 32-bit lane.
+    const __m256i pairs = _mm256_maddubs_epi16(c0_to_c3, _mm256_set1_epi16(0x0150));
+    const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011900));
+    const __m256i limbs = _mm256_add_epi32(_mm256_mullo_epi32(quads, _mm256_set1_epi32(80)), c4);
+
+    // (limb3 * 80^5 + limb2) and (limb1 * 80^5 + limb0) in 64-bit lanes.
+    const __m256i halves = _mm256_add_epi64(_mm256_mul_epu32(limbs, _mm256_set1_epi64x(g_80_pow_5)),
+                                            _mm256_srli_epi64(limbs, 32));
+    uint64_t values[4];
+    _mm256_storeu_si256((__m256i*)values, halves);
+    store_group(dst, values[0], values[1]);
+    store_group(dst + 15, values[2], values[3]);
+    return true;
+}
+
+TARGET_AVX2 int64_t safe80_avx2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 19 chars and 15 bytes per group
+    const int64_t groups_per_step = 2;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_38_chars(src + offset * 19, dst + offset * 15))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE80_HAS_X86_KERNELS
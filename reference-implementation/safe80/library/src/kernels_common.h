@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// Tables and helpers shared by the kernel implementations.
+
+__extension__ typedef unsigned __int128 uint128_ct;
+
+// The kernels handle each group as four limbs below 80^5 (see split_group()
+// in library.c), which gives one 32-bit lane per limb:
+//
+//   group = ((limb3 * 80^5 + limb2) * 80^10) + (limb1 * 80^5 + limb0)
+//
+// limb3 holds the 4 most significant chunks, and the others 5 each.
+
+static const uint64_t g_5_pow_5  = 5ull*5*5*5*5;
+static const uint64_t g_5_pow_10 = 5ull*5*5*5*5*5*5*5*5*5;
+static const uint32_t g_80_pow_5 = 80u*80*80*80*80;
+
+static inline uint64_t load_uint64_big_endian(const uint8_t* const src)
+{
+    uint64_t value;
+    memcpy(&value, src, sizeof(value));
+    return __builtin_bswap64(value);
+}
+
+// g_chunk_to_encode_char from library.c
+static const uint8_t g_chunk_to_char[80] =
+{
+    '!', '$', '(', ')', '+', ',', '-', '0', '1', '2', '3', '4', '5', '6', '7', '8',
+    '9', ';', '=', '@', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L',
+    'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '[', ']',
+    '^', '_', '`', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', '{', '}', '~',
+};
+
+static inline uint64_t low_bits(const uint64_t value, const int bit_count)
+{
+    return value & ((1ull << bit_count) - 1);
+}
+
+static inline void split_into_limbs(const uint64_t value, uint32_t* const hi_limb, uint32_t* const lo_limb)
+{
+    const uint64_t shifted = value >> 20;
+    *hi_limb = (uint32_t)(shifted / g_5_pow_5);
+    *lo_limb = (uint32_t)(((shifted % g_5_pow_5) << 20) | low_bits(value, 20));
+}
+
+// Same as split_group() in library.c, but with the limbs in the order that
+// they are written (limb3 first).
+static inline void split_group(const uint8_t* const src, uint32_t* const limbs)
+{
+    const uint64_t hi = load_uint64_big_endian(src) >> 8;
+    const uint64_t lo = load_uint64_big_endian(src + 7);
+    const uint64_t upper = hi >> 16;
+    const uint64_t lower = (low_bits(hi, 16) << 24) | (lo >> 40);
+    const uint64_t partial = ((upper % g_5_pow_10) << 40) | lower;
+    const uint64_t quotient = ((upper / g_5_pow_10) << 40) | (partial / g_5_pow_10);
+    const uint64_t remainder = ((partial % g_5_pow_10) << 40) | low_bits(lo, 40);
+    split_into_limbs(quotient, &limbs[0], &limbs[1]);
+    split_into_limbs(remainder, &limbs[2], &limbs[3]);
+}
+
+#define ERRR 0xff
+// g_encode_char_to_chunk from library.c, for the characters 0x20 - 0x7f.
+static const uint8_t g_char_to_chunk[96] =
+{
+    ERRR, 0x00, ERRR, ERRR, 0x01, ERRR, ERRR, ERRR, 0x02, 0x03, ERRR, 0x04, 0x05, 0x06, ERRR, ERRR,
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, ERRR, 0x11, ERRR, 0x12, ERRR, ERRR,
+    0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22,
+    0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, ERRR, 0x2f, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x40, 0x41,
+    0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, ERRR, 0x4e, 0x4f, ERRR,
+};
+#undef ERRR
+
+static inline void store_group(uint8_t* const dst, const uint64_t quotient, const uint64_t remainder)
+{
+    // quotient * 80^10 + remainder
+    const uint128_ct group = (((uint128_ct)quotient * g_5_pow_10) << 40) + remainder;
+    const uint64_t hi = __builtin_bswap64((uint64_t)(group >> 64) << 8);
+    const uint64_t lo = __builtin_bswap64((uint64_t)group);
+    memcpy(dst, &hi, 7);
+    memcpy(dst + 7, &lo, 8);
+}
@@ -0,0 +1,178 @@
+#include "kernels.h"
+
+#if SAFE80_HAS_GENERIC_KERNELS
+
+#include <string.h>
+
+#include "kernels_common.h"
+
+// These are the same algorithms as in kernels_sse41.c, written with the
+// compiler's vector extensions rather than intrinsics so that they build for
+// any target. The compiler lowers them to whatever the build's -march allows.
+// 16-byte vectors are native wherever there is SIMD at all (SSE2, NEON, ...),
+// and unlike wider ones they don't change the calling convention.
+
+typedef int8_t   s8x16  __attribute__((vector_size(16)));
+typedef uint8_t  u8x16  __attribute__((vector_size(16)));
+typedef uint16_t u16x8  __attribute__((vector_size(16)));
+typedef uint32_t u32x4  __attribute__((vector_size(16)));
+typedef uint64_t u64x2  __attribute__((vector_size(16)));
+
+// Limb chars are moved in two parts so that they stay in registers.
+static inline uint64_t load_limb_chars(const uint8_t* const src)
+{
+    uint32_t first_4;
+    memcpy(&first_4, src, sizeof(first_4));
+    return first_4 | (uint64_t)src[4] << 32;
+}
+
+static inline void store_limb_chars(uint8_t* const dst, const uint64_t chars)
+{
+    const uint32_t first_4 = (uint32_t)chars;
+    memcpy(dst, &first_4, sizeof(first_4));
+    dst[4] = (uint8_t)(chars >> 32);
+}
+
+// Comparisons give 0 or -1 in each element.
+static inline bool is_all_set(const u8x16 mask)
+{
+    const u64x2 words = (u64x2)mask;
+    return (words[0] & words[1]) == ~(uint64_t)0;
+}
+
+// Gives amount in every element that is greater than threshold, and 0 in the
+// others. The comparison is signed because not every target has unsigned
+// byte comparisons. Elements of 0x80 and up only turn up in invalid data,
+// which is_valid() rejects whatever they map to.
+static inline u8x16 amount_if_greater(const u8x16 values, const int8_t threshold, const uint8_t amount)
+{
+    return (u8x16)((s8x16)values > threshold) & amount;
+}
+
+static inline u8x16 chunks_to_chars(const u8x16 chunks)
+{
+    // '!' = 0 + 33, '$' = 1 + 35, '(' = 2 + 38, '+' = 4 + 39, '0' = 7 + 41,
+    // ';' = 17 + 42, '=' = 18 + 43, '@' = 19 + 45, ']' = 47 + 46,
+    // '}' = 78 + 47
+    return chunks + 33 +
+           amount_if_greater(chunks, 0, 2) +
+           amount_if_greater(chunks, 1, 3) +
+           amount_if_greater(chunks, 3, 1) +
+           amount_if_greater(chunks, 6, 2) +
+           amount_if_greater(chunks, 16, 1) +
+           amount_if_greater(chunks, 17, 1) +
+           amount_if_greater(chunks, 18, 2) +
+           amount_if_greater(chunks, 46, 1) +
+           amount_if_greater(chunks, 77, 1);
+}
+
+static inline u8x16 chars_to_chunks(const u8x16 chars)
+{
+    // The same offsets as in chunks_to_chars, keyed on the character that
+    // each one starts after.
+    return chars - 33 -
+           amount_if_greater(chars, '!', 2) -
+           amount_if_greater(chars, '$', 3) -
+           amount_if_greater(chars, ')', 1) -
+           amount_if_greater(chars, '-', 2) -
+           amount_if_greater(chars, '9', 1) -
+           amount_if_greater(chars, ';', 1) -
+           amount_if_greater(chars, '=', 2) -
+           amount_if_greater(chars, '[', 1) -
+           amount_if_greater(chars, '{', 1);
+}
+
+// Characters in the gaps of the alphabet map to the chunk of a neighbour, so
+// they're caught by encoding the chunks back again.
+static inline u8x16 is_valid(const u8x16 chars, const u8x16 chunks)
+{
+    return (u8x16)(chunks < 80) & (u8x16)(chunks_to_chars(chunks) == chars);
+}
+
+static inline void encode_15_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    uint32_t limbs[4];
+    split_group(src, limbs);
+    const u32x4 values = {limbs[0], limbs[1], limbs[2], limbs[3]};
+
+    const u32x4 q1 = values / 80;
+    const u32x4 q2 = q1 / 80;
+    const u32x4 q3 = q2 / 80;
+    const u32x4 c0 = q3 / 80;
+    const u32x4 c1 = q3 - c0 * 80;
+    const u32x4 c2 = q2 - q3 * 80;
+    const u32x4 c3 = q1 - q2 * 80;
+    const u32x4 c4 = values - q1 * 80;
+
+    // Each 64-bit lane gets the 5 chunks of one limb.
+    const u32x4 c0_to_c3 = c0 | (c1 << 8) | (c2 << 16) | (c3 << 24);
+    const u64x2 front = (u64x2)chunks_to_chars((u8x16)__builtin_shufflevector(c0_to_c3, c4, 0, 4, 1, 5));
+    const u64x2 back = (u64x2)chunks_to_chars((u8x16)__builtin_shufflevector(c0_to_c3, c4, 2, 6, 3, 7));
+
+    // The first limb only has 4 chunks, so its leading zero chunk is dropped.
+    const uint32_t first_chars = (uint32_t)(front[0] >> 8);
+    memcpy(dst, &first_chars, sizeof(first_chars));
+    store_limb_chars(dst + 4, front[1]);
+    store_limb_chars(dst + 9, back[0]);
+    store_limb_chars(dst + 14, back[1]);
+}
+
+int64_t safe80_generic_encode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 15 bytes and 19 chars per group
+    for(int64_t offset = 0; offset < group_count; offset++)
+    {
+        encode_15_bytes(src + offset * 15, dst + offset * 19);
+    }
+    return group_count;
+}
+
+static inline bool decode_19_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    // Each 64-bit lane gets the 5 chars of one limb, with a '!' (chunk 0) in
+    // front of the 4 chars of the first one. The 3 bytes left over in each
+    // lane are ignored.
+    uint32_t first_chars;
+    memcpy(&first_chars, src, sizeof(first_chars));
+    const u8x16 unused = (u8x16)(u64x2){0xffffff0000000000, 0xffffff0000000000};
+    const u8x16 front = (u8x16)(u64x2){(uint64_t)first_chars << 8 | '!', load_limb_chars(src + 4)};
+    const u8x16 back = (u8x16)(u64x2){load_limb_chars(src + 9), load_limb_chars(src + 14)};
+    const u8x16 front_chunks = chars_to_chunks(front);
+    const u8x16 back_chunks = chars_to_chunks(back);
+    if(!is_all_set((is_valid(front, front_chunks) & is_valid(back, back_chunks)) | unused))
+    {
+        return false;
+    }
+
+    const u32x4 c0_to_c3 = __builtin_shufflevector((u32x4)front_chunks, (u32x4)back_chunks, 0, 2, 4, 6);
+    const u32x4 c4 = __builtin_shufflevector((u32x4)front_chunks, (u32x4)back_chunks, 1, 3, 5, 7) & 0xff;
+
+    const u16x8 pairs = (u16x8)c0_to_c3;
+    const u32x4 quads = (u32x4)((pairs & 0xff) * 80 + (pairs >> 8));
+    const u32x4 limbs = ((quads & 0xffff) * (80 * 80) + (quads >> 16)) * 80 + c4;
+
+    store_group(dst,
+                limbs[0] * (uint64_t)g_80_pow_5 + limbs[1],
+                limbs[2] * (uint64_t)g_80_pow_5 + limbs[3]);
+    return true;
+}
+
+int64_t safe80_generic_decode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 19 chars and 15 bytes per group
+    int64_t offset = 0;
+    for(; offset < group_count; offset++)
+    {
+        if(!decode_19_chars(src + offset * 19, dst + offset * 15))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE80_HAS_GENERIC_KERNELS
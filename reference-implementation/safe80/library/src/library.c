@@ -1,8 +1,15 @@
 #include <safe80/safe80.h>
 
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
 // #define KSLogger_LocalLevel DEBUG
 #include "kslogger.h"
 
+#include "kernels.h"
+#include "thread_pool.h"
+
 #define QUOTE(str) #str
 #define EXPAND_AND_QUOTE(str) QUOTE(str)
 
@@ -14,6 +21,7 @@
     #endif
 #endif
 ANSI_EXTENSION typedef __int128 int128_ct;
+ANSI_EXTENSION typedef unsigned __int128 uint128_ct;
 
 static const int g_bytes_per_group       = 15;
 static const int g_chunks_per_group      = 19;
@@ -104,38 +112,178 @@ static inline int extract_byte_from_accumulator(const int128_ct accumulator, con
     return extracted_byte;
 }
 
+// None of the bulk encoders load past the groups that they encode, so they
+// have nothing to gain from slack.
+static const int g_slack_group_count = 0;
+
+// Writes the low byte_count bytes of the accumulator, high byte first, as two
+// 8-byte stores. This writes 16 bytes no matter what byte_count is, so it
+// needs slack after dst.
+static inline void store_accumulator_bytes(uint8_t* const dst, const int128_ct accumulator, const int byte_count)
+{
+    const uint128_ct value = (uint128_ct)accumulator << (128 - byte_count * g_bits_per_byte);
+    const uint64_t high_bytes = __builtin_bswap64((uint64_t)(value >> 64));
+    const uint64_t low_bytes = __builtin_bswap64((uint64_t)value);
+    memcpy(dst, &high_bytes, sizeof(high_bytes));
+    memcpy(dst + 8, &low_bytes, sizeof(low_bytes));
+}
+
+// A group is 120 bits, which is too wide for native arithmetic. Because
+// 80^k = 5^k * 2^4k, a division by a power of 80 is a shift followed by a
+// division by a power of 5, so the group can be split into four limbs of
+// (at most) 5 chunks each using only 64-bit divisions by constants:
+//
+//   group = ((limb3 * 80^5 + limb2) * 80^10) + (limb1 * 80^5 + limb0)
+//
+// limb3 holds the 4 most significant chunks, and limb0 the 5 least.
+
+static const int g_chunks_per_limb = 5;
+
+static const uint64_t g_5_pow_5  = 5ull*5*5*5*5;
+static const uint64_t g_5_pow_10 = 5ull*5*5*5*5*5*5*5*5*5;
+static const uint32_t g_80_pow_5 = 80u*80*80*80*80;
+
+static inline uint64_t low_bits(const uint64_t value, const int bit_count)
+{
+    return value & ((1ull << bit_count) - 1);
+}
+
+// Splits a value below 80^10 into two limbs below 80^5.
+static inline void split_into_limbs(const uint64_t value, uint32_t* const hi_limb, uint32_t* const lo_limb)
+{
+    const uint64_t shifted = value >> 20;
+    *hi_limb = (uint32_t)(shifted / g_5_pow_5);
+    *lo_limb = (uint32_t)(((shifted % g_5_pow_5) << 20) | low_bits(value, 20));
+}
+
+// hi holds the top 56 bits of the group, and lo the bottom 64.
+static inline void split_group(const uint64_t hi, const uint64_t lo, uint32_t* const limbs)
+{
+    // (group >> 40) is 80 bits wide, so divide it by 5^10 in two 40-bit steps.
+    const uint64_t upper = hi >> 16;
+    const uint64_t lower = (low_bits(hi, 16) << 24) | (lo >> 40);
+    const uint64_t upper_remainder = upper % g_5_pow_10;
+    const uint64_t partial = (upper_remainder << 40) | lower;
+    const uint64_t quotient = ((upper / g_5_pow_10) << 40) | (partial / g_5_pow_10);
+    const uint64_t remainder = ((partial % g_5_pow_10) << 40) | low_bits(lo, 40);
+    split_into_limbs(quotient, &limbs[3], &limbs[2]);
+    split_into_limbs(remainder, &limbs[1], &limbs[0]);
+}
+
 static inline int extract_chunk_from_accumulator(const int128_ct accumulator, const int chunk_index_lo_first)
 {
-    static bool is_initialized = false;
-    static int128_ct divide_amounts[19]; // g_chunks_per_group
-    if(!is_initialized)
-    {
-        divide_amounts[0] = 0;
-        int128_ct initializer = g_factor_per_chunk;
-        for(int i = 1; i < g_chunks_per_group; i++)
-        {
-            divide_amounts[i] = initializer;
-            initializer *= g_factor_per_chunk;
-            KSLOG_DEBUG("Init %02d = %016llx %016llx", i, (uint64_t)(divide_amounts[i] >> 64), (uint64_t)divide_amounts[i]);
-        }
-        is_initialized = true;
-    }
-    const int chunk_modulo = g_factor_per_chunk;
-    if(chunk_index_lo_first == 0)
+    // When encoding, the accumulator never holds more than 15 bytes.
+    uint32_t limbs[4];
+    split_group((uint64_t)(accumulator >> 64), (uint64_t)accumulator, limbs);
+    uint32_t value = limbs[chunk_index_lo_first / g_chunks_per_limb];
+    for(int i = chunk_index_lo_first % g_chunks_per_limb; i > 0; i--)
     {
-        const int extracted_chunk = accumulator % chunk_modulo;
-        KSLOG_DEBUG("Extract chunk %d from %016llx %016llx: %02x (%c)", chunk_index_lo_first, (uint64_t)(accumulator>>64), (uint64_t)accumulator, extracted_chunk,
-            g_chunk_to_encode_char[extracted_chunk]);
-        return extracted_chunk;
+        value /= g_factor_per_chunk;
     }
-
-    const int128_ct divide_amount = divide_amounts[chunk_index_lo_first];
-    const int extracted_chunk = (accumulator / divide_amount) % chunk_modulo;
+    const int extracted_chunk = value % g_factor_per_chunk;
     KSLOG_DEBUG("Extract chunk %d from %016llx %016llx: %02x (%c)", chunk_index_lo_first, (uint64_t)(accumulator>>64), (uint64_t)accumulator, extracted_chunk,
         g_chunk_to_encode_char[extracted_chunk]);
     return extracted_chunk;
 }
 
+static inline uint64_t load_big_endian(const uint8_t* const src, const int byte_count)
+{
+    uint64_t value = 0;
+    for(int i = 0; i < byte_count; i++)
+    {
+        value = (value << g_bits_per_byte) | src[i];
+    }
+    return value;
+}
+
+static inline void store_big_endian(uint8_t* const dst, const uint64_t value, const int byte_count)
+{
+    for(int i = 0; i < byte_count; i++)
+    {
+        dst[i] = (uint8_t)(value >> ((byte_count - 1 - i) * g_bits_per_byte));
+    }
+}
+
+// Writes a limb's chunks to dst[0] - dst[chunk_count-1], most significant first.
+static inline void encode_limb(uint32_t limb, uint8_t* const dst, const int chunk_count)
+{
+    for(int i = chunk_count - 1; i >= 0; i--)
+    {
+        dst[i] = g_chunk_to_encode_char[limb % g_factor_per_chunk];
+        limb /= g_factor_per_chunk;
+    }
+}
+
+static inline void encode_group(const uint8_t* const src, uint8_t* const dst)
+{
+    uint32_t limbs[4];
+    split_group(load_big_endian(src, 7), load_big_endian(src + 7, 8), limbs);
+    encode_limb(limbs[3], dst, g_chunks_per_limb - 1);
+    encode_limb(limbs[2], dst + 4, g_chunks_per_limb);
+    encode_limb(limbs[1], dst + 9, g_chunks_per_limb);
+    encode_limb(limbs[0], dst + 14, g_chunks_per_limb);
+}
+
+// Returns false if any of the limb's characters is whitespace or invalid.
+static inline bool decode_limb(const uint8_t* const src, const int chunk_count, uint32_t* const limb)
+{
+    uint32_t value = 0;
+    uint8_t all_chunks = 0;
+    for(int i = 0; i < chunk_count; i++)
+    {
+        const uint8_t chunk = g_encode_char_to_chunk[src[i]];
+        all_chunks |= chunk;
+        value = value * g_factor_per_chunk + chunk;
+    }
+    *limb = value;
+    return all_chunks < CHUNK_CODE_WHITESPACE;
+}
+
+// Returns false if any of the group's characters is whitespace or invalid.
+static inline bool decode_group(const uint8_t* const src, uint8_t* const dst)
+{
+    uint32_t limbs[4];
+    if(!decode_limb(src, g_chunks_per_limb - 1, &limbs[3]) ||
+       !decode_limb(src + 4, g_chunks_per_limb, &limbs[2]) ||
+       !decode_limb(src + 9, g_chunks_per_limb, &limbs[1]) ||
+       !decode_limb(src + 14, g_chunks_per_limb, &limbs[0]))
+    {
+        return false;
+    }
+    const uint64_t quotient = (uint64_t)limbs[3] * g_80_pow_5 + limbs[2];
+    const uint64_t remainder = (uint64_t)limbs[1] * g_80_pow_5 + limbs[0];
+
+    // quotient * 80^10 + remainder, using a single 64x64 -> 128 bit multiply.
+    // Like the accumulator, this keeps only the low 120 bits of an
+    // overflowing group.
+    const uint128_ct group = (((uint128_ct)quotient * g_5_pow_10) << 40) + remainder;
+    store_big_endian(dst, (uint64_t)(group >> 64), 7);
+    store_big_endian(dst + 7, (uint64_t)group, 8);
+    return true;
+}
+
+static int64_t encode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    for(int64_t offset = 0; offset < group_count; offset++)
+    {
+        encode_group(src + offset * g_bytes_per_group, dst + offset * g_chunks_per_group);
+    }
+    return group_count;
+}
+
+static int64_t decode_groups_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    int64_t offset = 0;
+    for(; offset < group_count; offset++)
+    {
+        if(!decode_group(src + offset * g_chunks_per_group, dst + offset * g_bytes_per_group))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
 
 // ===========================================================================
 // Code below this point is the same in all safeXX codecs (with a different
@@ -144,6 +292,212 @@ static inline int extract_chunk_from_accumulator(const int128_ct accumulator, co
 // other codecs.
 // ===========================================================================
 
+// After the bulk decoder stops early (usually because of whitespace), the
+// per-character loop consumes at least this many characters before the bulk
+// decoder is tried again.
+static const int g_bulk_decode_retry_char_count = 32;
+
+// -------
+// Kernels
+// -------
+
+typedef struct
+{
+    const char* name;
+    bool (*is_supported)(void);
+    int64_t (*encode_groups)(const uint8_t* src, uint8_t* dst, int64_t group_count);
+    int64_t (*decode_groups)(const uint8_t* src, uint8_t* dst, int64_t group_count);
+    int64_t (*compact_blocks)(const uint8_t* src, uint8_t* dst, int64_t block_count);
+} bulk_kernel;
+
+static bool is_always_supported(void)
+{
+    return true;
+}
+
+static int64_t no_bulk_kernel(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    (void)src;
+    (void)dst;
+    (void)group_count;
+    return 0;
+}
+
+// Compaction works on blocks of this many chars.
+static const int g_compact_block_size = 16;
+
+static int64_t compact_blocks_scalar(const uint8_t* const src, uint8_t* const dst, const int64_t block_count)
+{
+    // Every char gets written, but only kept ones move the write position on.
+    // This saves a hard to predict branch.
+    uint8_t* next = dst;
+    for(int64_t i = 0; i < block_count * g_compact_block_size; i++)
+    {
+        const uint8_t next_char = src[i];
+        *next = next_char;
+        next += g_encode_char_to_chunk[next_char] != CHUNK_CODE_WHITESPACE;
+    }
+    return next - dst;
+}
+
+#if SAFE80_HAS_X86_KERNELS
+static bool is_avx2_supported(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+static bool is_sse41_supported(void)
+{
+    return __builtin_cpu_supports("sse4.1");
+}
+#endif
+
+#if SAFE80_HAS_BMI2_KERNELS
+// pdep and pext are microcoded on AMD CPUs before Zen 3, but those all support
+// AVX2 anyway, so they never get this far down the list.
+static bool is_bmi2_supported(void)
+{
+    return __builtin_cpu_supports("bmi2");
+}
+#endif
+
+// Fastest first. The scalar kernel leaves everything to encode_groups_scalar()
+// and decode_groups_scalar().
+static const bulk_kernel g_kernels[] =
+{
+#if SAFE80_HAS_X86_KERNELS
+    {"avx2",    is_avx2_supported,   safe80_avx2_encode_groups,     safe80_avx2_decode_groups,    safe80_sse41_compact_blocks},
+    {"sse4.1",  is_sse41_supported,  safe80_sse41_encode_groups,    safe80_sse41_decode_groups,   safe80_sse41_compact_blocks},
+#endif
+#if SAFE80_HAS_BMI2_KERNELS
+    {"bmi2",    is_bmi2_supported,   safe80_bmi2_encode_groups,     safe80_bmi2_decode_groups,    compact_blocks_scalar},
+#endif
+#if SAFE80_HAS_GENERIC_KERNELS
+    {"generic", is_always_supported, safe80_generic_encode_groups,  safe80_generic_decode_groups, compact_blocks_scalar},
+#endif
+    {"scalar",  is_always_supported, no_bulk_kernel,                no_bulk_kernel,               compact_blocks_scalar},
+};
+static const int g_kernel_count = sizeof(g_kernels) / sizeof(*g_kernels);
+
+// Forces a kernel by name (if the CPU supports it).
+static const char* const g_kernel_override_env_var = "SAFE80_KERNEL";
+
+static const bulk_kernel* select_kernel(void)
+{
+    const char* const requested = getenv(g_kernel_override_env_var);
+    if(requested != NULL)
+    {
+        for(int i = 0; i < g_kernel_count; i++)
+        {
+            if(strcmp(g_kernels[i].name, requested) == 0 && g_kernels[i].is_supported())
+            {
+                return &g_kernels[i];
+            }
+        }
+        KSLOG_DEBUG("Kernel %s is unknown or unsupported. Using the default.", requested);
+    }
+
+    for(int i = 0; i < g_kernel_count - 1; i++)
+    {
+        if(g_kernels[i].is_supported())
+        {
+            return &g_kernels[i];
+        }
+    }
+    return &g_kernels[g_kernel_count - 1];
+}
+
+// Selection always gives the same result, so threads that race to initialize
+// this just store the same pointer.
+static _Atomic(const bulk_kernel*) g_active_kernel = NULL;
+
+static inline const bulk_kernel* get_active_kernel(void)
+{
+    const bulk_kernel* kernel = atomic_load_explicit(&g_active_kernel, memory_order_acquire);
+    if(kernel == NULL)
+    {
+        kernel = select_kernel();
+        KSLOG_DEBUG("Selected kernel %s", kernel->name);
+        atomic_store_explicit(&g_active_kernel, kernel, memory_order_release);
+    }
+    return kernel;
+}
+
+// Buffers passed to the *_with_slack() functions can be read and written for
+// this many bytes past their ends, which is enough for g_slack_group_count
+// groups and a store_accumulator_bytes().
+static const int g_required_slack = 64;
+
+// Bulk encoders hold back the last few groups when they load more than they
+// use. extra_group_count tells them how many more groups' worth of src and dst
+// are safe to touch, so that they don't have to.
+static inline int64_t encode_groups(const uint8_t* const src,
+                                    uint8_t* const dst,
+                                    const int64_t group_count,
+                                    const int64_t extra_group_count)
+{
+    int64_t offset = get_active_kernel()->encode_groups(src, dst, group_count + extra_group_count);
+    if(offset > group_count)
+    {
+        offset = group_count;
+    }
+    return offset + encode_groups_scalar(src + offset * g_bytes_per_group,
+                                         dst + offset * g_chunks_per_group,
+                                         group_count - offset);
+}
+
+static inline int64_t decode_groups(const uint8_t* const src, uint8_t* const dst, const int64_t group_count)
+{
+    const int64_t offset = get_active_kernel()->decode_groups(src, dst, group_count);
+    return offset + decode_groups_scalar(src + offset * g_chunks_per_group,
+                                         dst + offset * g_bytes_per_group,
+                                         group_count - offset);
+}
+
+static inline int64_t compact_blocks(const uint8_t* const src, uint8_t* const dst, const int64_t block_count)
+{
+    return get_active_kernel()->compact_blocks(src, dst, block_count);
+}
+
+// Decodes whole groups from source data that has whitespace in it, by
+// compacting as much of it as fits into a scratch buffer first. Moves
+// *src_ptr past the groups that were decoded, and returns how many there were.
+static int64_t decode_compacted_groups(const uint8_t** const src_ptr,
+                                       const uint8_t* const src_end,
+                                       uint8_t* const dst,
+                                       const int64_t max_group_count)
+{
+    uint8_t scratch[1024];
+    const uint8_t* const src = *src_ptr;
+    const int64_t src_length = src_end - src < (int64_t)sizeof(scratch) ? src_end - src : (int64_t)sizeof(scratch);
+    const int64_t block_count = src_length / g_compact_block_size;
+    const int64_t char_count = compact_blocks(src, scratch, block_count);
+    const int64_t src_group_count = char_count / g_chunks_per_group;
+    const int64_t group_count = src_group_count < max_group_count ? src_group_count : max_group_count;
+    const int64_t decoded_group_count = decode_groups(scratch, dst, group_count);
+    KSLOG_DEBUG("Compacted %d chars to %d, and decoded %d of %d groups",
+                block_count * g_compact_block_size, char_count, decoded_group_count, group_count);
+    if(decoded_group_count == 0)
+    {
+        return 0;
+    }
+
+    // Walk back over the chars that weren't decoded (and any whitespace in
+    // front of them) to find where the last decoded one came from.
+    const uint8_t* next = src + block_count * g_compact_block_size;
+    int64_t left_over = char_count - decoded_group_count * g_chunks_per_group;
+    while(left_over > 0 || g_encode_char_to_chunk[next[-1]] == CHUNK_CODE_WHITESPACE)
+    {
+        next--;
+        if(g_encode_char_to_chunk[*next] != CHUNK_CODE_WHITESPACE)
+        {
+            left_over--;
+        }
+    }
+    *src_ptr = next;
+    return decoded_group_count;
+}
+
 static inline int calculate_length_chunk_count(int64_t length)
 {
     int chunk_count = 0;
@@ -164,6 +518,11 @@ const char* safe80_version(void)
     return EXPAND_AND_QUOTE(PROJECT_VERSION);
 }
 
+const char* safe80_get_active_kernel(void)
+{
+    return get_active_kernel()->name;
+}
+
 int64_t safe80_get_decoded_length(const int64_t encoded_length)
 {
     if(encoded_length < 0)
@@ -179,11 +538,12 @@ int64_t safe80_get_decoded_length(const int64_t encoded_length)
     return result;
 }
 
-safe80_status safe80_decode_feed(const uint8_t** const src_buffer_ptr,
+static safe80_status decode_feed(const uint8_t** const src_buffer_ptr,
                                  const int64_t src_length,
                                  uint8_t** const dst_buffer_ptr,
                                  const int64_t dst_length,
-                                 const safe80_stream_state stream_state)
+                                 const safe80_stream_state stream_state,
+                                 const bool has_slack)
 {
     if(src_length < 0 || dst_length < 0)
     {
@@ -202,27 +562,98 @@ safe80_status safe80_decode_feed(const uint8_t** const src_buffer_ptr,
     { \
         const int bytes_to_write = g_chunk_to_byte_count[CHUNK_COUNT]; \
         KSLOG_DEBUG("Writing %d chunks as %d decoded bytes", CHUNK_COUNT, bytes_to_write); \
-        for(int i = bytes_to_write - 1; i >= 0; i--) \
+        if(has_slack && bytes_to_write > 0) \
+        { \
+            store_accumulator_bytes(dst, accumulator, bytes_to_write); \
+            dst += bytes_to_write; \
+        } \
+        else \
         { \
-            *dst++ = extract_byte_from_accumulator(accumulator, i); \
-            KSLOG_DEBUG("Wrote byte %02x to index %d", dst[-1], i); \
+            for(int i = bytes_to_write - 1; i >= 0; i--) \
+            { \
+                *dst++ = extract_byte_from_accumulator(accumulator, i); \
+                KSLOG_DEBUG("Wrote byte %02x to index %d", dst[-1], i); \
+            } \
         } \
     }
 
+    const bool whitespace_is_invalid = stream_state & SAFE80_SRC_HAS_NO_WHITESPACE;
     const uint8_t* last_src = src;
+    const uint8_t* next_bulk_src = src;
     int current_group_chunk_count = 0;
     int128_ct accumulator = 0;
 
     while(src < src_end)
     {
+        if(current_group_chunk_count == 0 && src >= next_bulk_src)
+        {
+            // The per-character loop never fills the last byte of dst by
+            // itself (that's left to the end-of-stream handling), so the bulk
+            // decoder must leave it free as well.
+            const int64_t src_group_count = (src_end - src) / g_chunks_per_group;
+            const int64_t dst_group_count = dst < dst_end ? (dst_end - dst - 1) / g_bytes_per_group : 0;
+            const int64_t group_count = src_group_count < dst_group_count ? src_group_count : dst_group_count;
+            const int64_t decoded_group_count = decode_groups(src, dst, group_count);
+            KSLOG_DEBUG("Bulk decoded %d of %d groups", decoded_group_count, group_count);
+            src += decoded_group_count * g_chunks_per_group;
+            dst += decoded_group_count * g_bytes_per_group;
+            if(decoded_group_count > 0)
+            {
+                last_src = src;
+            }
+            // Without whitespace, a group that the bulk decoder stopped on
+            // holds an error, so there's no point in trying again.
+            next_bulk_src = whitespace_is_invalid ? src_end : src + g_bulk_decode_retry_char_count;
+            if(decoded_group_count < group_count && !whitespace_is_invalid)
+            {
+                // Most likely the bulk decoder stopped on whitespace, so give
+                // it another go without.
+                const int64_t compacted_group_count = decode_compacted_groups(&src,
+                                                                              src_end,
+                                                                              dst,
+                                                                              dst_group_count - decoded_group_count);
+                if(compacted_group_count > 0)
+                {
+                    dst += compacted_group_count * g_bytes_per_group;
+                    last_src = src;
+                    next_bulk_src = src;
+                }
+            }
+            continue;
+        }
+        if(current_group_chunk_count == 0 && src_end - src >= g_chunks_per_group && dst_end - dst > g_bytes_per_group)
+        {
+            // There's room for a whole group, so its chunks can skip the
+            // per-character checks below until whitespace or an error turns
+            // up. That character is left to the checks.
+            while(current_group_chunk_count < g_chunks_per_group)
+            {
+                const uint8_t chunk = g_encode_char_to_chunk[*src];
+                if(chunk >= CHUNK_CODE_WHITESPACE)
+                {
+                    break;
+                }
+                accumulator = accumulate_chunk(accumulator, chunk);
+                current_group_chunk_count++;
+                src++;
+            }
+            if(current_group_chunk_count == g_chunks_per_group)
+            {
+                WRITE_BYTES(current_group_chunk_count);
+                current_group_chunk_count = 0;
+                accumulator = 0;
+                last_src = src;
+                continue;
+            }
+        }
         const uint8_t next_char = *src++;
         const uint8_t next_chunk = g_encode_char_to_chunk[next_char];
-        if(next_chunk == CHUNK_CODE_WHITESPACE)
+        if(next_chunk == CHUNK_CODE_WHITESPACE && !whitespace_is_invalid)
         {
             KSLOG_TRACE("Whitespace");
             continue;
         }
-        if(next_chunk == CHUNK_CODE_ERROR)
+        if(next_chunk >= CHUNK_CODE_WHITESPACE)
         {
             KSLOG_DEBUG("Error: Invalid source data: %02x: [%c]", next_char, next_char);
             *src_buffer_ptr = src - 1;
@@ -245,13 +676,27 @@ safe80_status safe80_decode_feed(const uint8_t** const src_buffer_ptr,
         }
     }
 
-    // Skip over any trailing whitespace
-    for(; src < src_end; src++)
+    if(whitespace_is_invalid)
     {
-        if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+        if(src < src_end && g_encode_char_to_chunk[*src] == CHUNK_CODE_WHITESPACE)
         {
-            last_src = src;
-            break;
+            KSLOG_DEBUG("Error: Whitespace in strict source data");
+            *src_buffer_ptr = src;
+            *dst_buffer_ptr = dst;
+            return SAFE80_ERROR_INVALID_SOURCE_DATA;
+        }
+    }
+    else
+    {
+        // Skip over any trailing whitespace. The loop only stops early part
+        // way through a group, so last_src stays at the start of that group
+        // unless it gets written below.
+        for(; src < src_end; src++)
+        {
+            if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+            {
+                break;
+            }
         }
     }
 
@@ -308,99 +753,370 @@ safe80_status safe80_decode_feed(const uint8_t** const src_buffer_ptr,
     #undef WRITE_BYTES
 }
 
-int64_t safe80_read_length_field(const uint8_t* const buffer,
-                                 const int64_t buffer_length,
-                                 int64_t* const length)
+safe80_status safe80_decode_feed(const uint8_t** const src_buffer_ptr,
+                                 const int64_t src_length,
+                                 uint8_t** const dst_buffer_ptr,
+                                 const int64_t dst_length,
+                                 const safe80_stream_state stream_state)
 {
-    if(buffer_length < 0)
+    return decode_feed(src_buffer_ptr, src_length, dst_buffer_ptr, dst_length, stream_state, false);
+}
+
+// A position in a vector of buffers, as if they were one buffer.
+typedef struct
+{
+    const safe80_iovec* vector;
+    int count;
+    int index;
+    int64_t offset;
+    int64_t used;
+} vector_cursor;
+
+static safe80_status init_vector_cursor(vector_cursor* const cursor,
+                                        const safe80_iovec* const vector,
+                                        const int count)
+{
+    if(count < 0)
     {
         return SAFE80_ERROR_INVALID_LENGTH;
     }
-    const int64_t max_pre_append_value = INT64_MAX >> g_bits_per_length_chunk;
-    const int continuation_bit = 1 << g_bits_per_length_chunk;
-    const int max_chunk_value = continuation_bit - 1;
-    const int chunk_mask = continuation_bit - 1;
-    KSLOG_DEBUG("bits %d, continue %02x, mask %02x",
-                g_bits_per_length_chunk, continuation_bit, chunk_mask);
-
-    const uint8_t* buffer_end = buffer + buffer_length;
-    int64_t value = 0;
-    int next_chunk = 0;
-
-    const uint8_t* src = buffer;
-    while(src < buffer_end)
+    for(int i = 0; i < count; i++)
     {
-        next_chunk = g_encode_char_to_chunk[(int)*src];
-        if(next_chunk == CHUNK_CODE_WHITESPACE)
-        {
-            src++;
-            continue;
-        }
-        const int chunk_value = next_chunk & ~continuation_bit;
-        if(chunk_value > max_chunk_value)
-        {
-            KSLOG_DEBUG("Error: Invalid length character: [%c]", *src);
-            return SAFE80_ERROR_INVALID_SOURCE_DATA;
-        }
-        if(value > max_pre_append_value)
-        {
-            KSLOG_DEBUG("Error: Length field too big");
-            return SAFE80_ERROR_INVALID_SOURCE_DATA;            
-        }
-        value = (value << g_bits_per_length_chunk) | (next_chunk & chunk_mask);
-        KSLOG_DEBUG("Chunk %d: '%c' (%d), continue %d, value portion = %d",
-                    src - buffer, *src, next_chunk, next_chunk & continuation_bit,
-                    (next_chunk & chunk_mask));
-        src++;
-        if(!(next_chunk & continuation_bit))
+        if(vector[i].length < 0)
         {
-            break;
+            return SAFE80_ERROR_INVALID_LENGTH;
         }
     }
-    if(next_chunk & continuation_bit)
+    cursor->vector = vector;
+    cursor->count = count;
+    cursor->index = 0;
+    cursor->offset = 0;
+    cursor->used = 0;
+    return SAFE80_STATUS_OK;
+}
+
+// Gives the length left in the current buffer, after moving past any buffers
+// that are used up.
+static int64_t get_contiguous_length(vector_cursor* const cursor)
+{
+    while(cursor->index < cursor->count && cursor->offset >= cursor->vector[cursor->index].length)
     {
-        KSLOG_DEBUG("Error: Unterminated length field");
-        return SAFE80_ERROR_UNTERMINATED_LENGTH_FIELD;
+        cursor->index++;
+        cursor->offset = 0;
     }
-    *length = value;
-    KSLOG_DEBUG("Length = %d, chunks = %d", value, src - buffer);
-    return src - buffer;
+    return cursor->index < cursor->count ? cursor->vector[cursor->index].length - cursor->offset : 0;
 }
 
-int64_t safe80_decode(const uint8_t* const src_buffer,
-                      const int64_t src_length,
-                      uint8_t* const dst_buffer,
-                      const int64_t dst_length)
+static inline uint8_t* get_cursor_pointer(const vector_cursor* const cursor)
 {
-    if(src_length < 0 || dst_length < 0)
+    return (uint8_t*)cursor->vector[cursor->index].base + cursor->offset;
+}
+
+// Gives the total length left in the vector, or limit if that's less.
+static int64_t get_remaining_length(vector_cursor* const cursor, const int64_t limit)
+{
+    int64_t length = get_contiguous_length(cursor);
+    for(int i = cursor->index + 1; i < cursor->count && length < limit; i++)
     {
-        return SAFE80_ERROR_INVALID_LENGTH;
+        length += cursor->vector[i].length;
     }
-    const uint8_t* src = src_buffer;
-    uint8_t* dst = dst_buffer;
-    const safe80_status status = safe80_decode_feed(
-                                    &src,
-                                    src_length,
-                                    &dst,
-                                    dst_length,
-                                    SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM);
-    if(status != SAFE80_STATUS_OK)
+    return length < limit ? length : limit;
+}
+
+// True if nothing comes after the current buffer.
+static bool is_in_last_buffer(vector_cursor* const cursor)
+{
+    get_contiguous_length(cursor);
+    for(int i = cursor->index + 1; i < cursor->count; i++)
     {
-        if(status == SAFE80_STATUS_PARTIALLY_COMPLETE)
+        if(cursor->vector[i].length > 0)
         {
-            return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+            return false;
         }
-        return status;
     }
-    int64_t decoded_byte_count = dst - dst_buffer;
-    KSLOG_DEBUG("Decoded %d bytes", decoded_byte_count);
-    return decoded_byte_count;
+    return true;
 }
 
-int64_t safe80l_decode(const uint8_t* const src_buffer,
-                       const int64_t src_length,
-                       uint8_t* const dst_buffer,
-                       const int64_t dst_length)
+static void advance_cursor(vector_cursor* const cursor, int64_t length)
+{
+    cursor->used += length;
+    while(length > 0)
+    {
+        const int64_t contiguous_length = get_contiguous_length(cursor);
+        const int64_t step = length < contiguous_length ? length : contiguous_length;
+        cursor->offset += step;
+        length -= step;
+    }
+}
+
+// The caller makes sure that there's room for length bytes.
+static void scatter_to_cursor(vector_cursor* const cursor, const uint8_t* src, int64_t length)
+{
+    while(length > 0)
+    {
+        const int64_t contiguous_length = get_contiguous_length(cursor);
+        const int64_t step = length < contiguous_length ? length : contiguous_length;
+        memcpy(get_cursor_pointer(cursor), src, step);
+        src += step;
+        length -= step;
+        advance_cursor(cursor, step);
+    }
+}
+
+// Groups that straddle buffers go through a buffer on the stack. This is big
+// enough for a group in any of the codecs.
+#define STRADDLED_GROUP_SIZE 32
+
+safe80_status safe80_decode_feedv(const safe80_iovec* const src_vector,
+                                  const int src_vector_count,
+                                  const safe80_iovec* const dst_vector,
+                                  const int dst_vector_count,
+                                  int64_t* const src_used,
+                                  int64_t* const dst_used,
+                                  const safe80_stream_state stream_state)
+{
+    vector_cursor src;
+    vector_cursor dst;
+    if(init_vector_cursor(&src, src_vector, src_vector_count) != SAFE80_STATUS_OK ||
+       init_vector_cursor(&dst, dst_vector, dst_vector_count) != SAFE80_STATUS_OK)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const bool whitespace_is_invalid = stream_state & SAFE80_SRC_HAS_NO_WHITESPACE;
+    const int persistent_state = stream_state & (SAFE80_EXPECT_DST_STREAM_TO_END | SAFE80_SRC_HAS_NO_WHITESPACE);
+    safe80_status status = SAFE80_STATUS_PARTIALLY_COMPLETE;
+
+    for(;;)
+    {
+        const int64_t src_length = get_contiguous_length(&src);
+        const int64_t dst_length = get_contiguous_length(&dst);
+        if(src_length > 0 && dst_length > 0)
+        {
+            // The ends of the streams only come into it once both are in
+            // their last buffers. Before that, the group at the end of one
+            // buffer is left for the code below.
+            int current_state = persistent_state;
+            if(is_in_last_buffer(&src) && is_in_last_buffer(&dst))
+            {
+                current_state |= stream_state & (SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM);
+            }
+            const uint8_t* const src_start = get_cursor_pointer(&src);
+            uint8_t* const dst_start = get_cursor_pointer(&dst);
+            const uint8_t* src_ptr = src_start;
+            uint8_t* dst_ptr = dst_start;
+            status = decode_feed(&src_ptr, src_length, &dst_ptr, dst_length, (safe80_stream_state)current_state, false);
+            advance_cursor(&src, src_ptr - src_start);
+            advance_cursor(&dst, dst_ptr - dst_start);
+            if(status != SAFE80_STATUS_PARTIALLY_COMPLETE)
+            {
+                break;
+            }
+            if(src_ptr > src_start || dst_ptr > dst_start)
+            {
+                continue;
+            }
+        }
+
+        // The next group straddles buffers (or is the last one), so gather
+        // its chars, decode them, and scatter the bytes.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        // Where each char is in the source, counting any whitespace that was
+        // skipped, so that errors can be pinned on the right one.
+        int64_t group_offsets[STRADDLED_GROUP_SIZE];
+        int group_length = 0;
+        vector_cursor group_end = src;
+        while(group_length < g_chunks_per_group && get_contiguous_length(&group_end) > 0)
+        {
+            const uint8_t next_char = *get_cursor_pointer(&group_end);
+            const int64_t next_char_offset = group_end.used;
+            advance_cursor(&group_end, 1);
+            if(g_encode_char_to_chunk[next_char] == CHUNK_CODE_WHITESPACE && !whitespace_is_invalid)
+            {
+                continue;
+            }
+            group_offsets[group_length] = next_char_offset;
+            group[group_length++] = next_char;
+        }
+        // Whitespace after the group goes with it, so that the source is seen
+        // to end with the group if that's all there is.
+        while(!whitespace_is_invalid &&
+              get_contiguous_length(&group_end) > 0 &&
+              g_encode_char_to_chunk[*get_cursor_pointer(&group_end)] == CHUNK_CODE_WHITESPACE)
+        {
+            advance_cursor(&group_end, 1);
+        }
+
+        int current_state = persistent_state;
+        if(get_contiguous_length(&group_end) == 0)
+        {
+            current_state |= stream_state & SAFE80_SRC_IS_AT_END_OF_STREAM;
+        }
+        uint8_t bytes[STRADDLED_GROUP_SIZE];
+        int64_t bytes_length = sizeof(bytes);
+        const int64_t dst_remaining_length = get_remaining_length(&dst, bytes_length + 1);
+        if(dst_remaining_length <= bytes_length)
+        {
+            bytes_length = dst_remaining_length;
+            current_state |= stream_state & SAFE80_DST_IS_AT_END_OF_STREAM;
+        }
+        const uint8_t* group_ptr = group;
+        uint8_t* bytes_ptr = bytes;
+        status = decode_feed(&group_ptr, group_length, &bytes_ptr, bytes_length, (safe80_stream_state)current_state, false);
+        if(status == SAFE80_ERROR_INVALID_SOURCE_DATA)
+        {
+            advance_cursor(&src, group_offsets[group_ptr - group] - src.used);
+            break;
+        }
+        if(status != SAFE80_STATUS_OK && status != SAFE80_STATUS_PARTIALLY_COMPLETE)
+        {
+            break;
+        }
+        if(bytes_ptr == bytes && status == SAFE80_STATUS_PARTIALLY_COMPLETE)
+        {
+            // Not enough data or room for the group yet.
+            break;
+        }
+        KSLOG_DEBUG("Decoded a straddling group of %d chars", group_length);
+        scatter_to_cursor(&dst, bytes, bytes_ptr - bytes);
+        advance_cursor(&src, group_end.used - src.used);
+        if(status == SAFE80_STATUS_OK)
+        {
+            break;
+        }
+    }
+
+    *src_used = src.used;
+    *dst_used = dst.used;
+    return status;
+}
+
+// Reads length field chars on top of *value, which holds the value of any
+// chars read before. *is_complete gets set once the last char has been read.
+// Returns the number of chars used, or a status code.
+static int64_t continue_length_field(const uint8_t* const buffer,
+                                     const int64_t buffer_length,
+                                     int64_t* const value,
+                                     bool* const is_complete)
+{
+    const int64_t max_pre_append_value = INT64_MAX >> g_bits_per_length_chunk;
+    const int continuation_bit = 1 << g_bits_per_length_chunk;
+    const int max_chunk_value = continuation_bit - 1;
+    const int chunk_mask = continuation_bit - 1;
+    KSLOG_DEBUG("bits %d, continue %02x, mask %02x",
+                g_bits_per_length_chunk, continuation_bit, chunk_mask);
+
+    const uint8_t* buffer_end = buffer + buffer_length;
+    *is_complete = false;
+
+    const uint8_t* src = buffer;
+    while(src < buffer_end)
+    {
+        const int next_chunk = g_encode_char_to_chunk[(int)*src];
+        if(next_chunk == CHUNK_CODE_WHITESPACE)
+        {
+            src++;
+            continue;
+        }
+        const int chunk_value = next_chunk & ~continuation_bit;
+        if(chunk_value > max_chunk_value)
+        {
+            KSLOG_DEBUG("Error: Invalid length character: [%c]", *src);
+            return SAFE80_ERROR_INVALID_SOURCE_DATA;
+        }
+        if(*value > max_pre_append_value)
+        {
+            KSLOG_DEBUG("Error: Length field too big");
+            return SAFE80_ERROR_INVALID_SOURCE_DATA;            
+        }
+        *value = (*value << g_bits_per_length_chunk) | (next_chunk & chunk_mask);
+        KSLOG_DEBUG("Chunk %d: '%c' (%d), continue %d, value portion = %d",
+                    src - buffer, *src, next_chunk, next_chunk & continuation_bit,
+                    (next_chunk & chunk_mask));
+        src++;
+        if(!(next_chunk & continuation_bit))
+        {
+            *is_complete = true;
+            break;
+        }
+    }
+    return src - buffer;
+}
+
+int64_t safe80_read_length_field(const uint8_t* const buffer,
+                                 const int64_t buffer_length,
+                                 int64_t* const length)
+{
+    if(buffer_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    int64_t value = 0;
+    bool is_complete = false;
+    const int64_t used_length = continue_length_field(buffer, buffer_length, &value, &is_complete);
+    if(used_length < 0)
+    {
+        return used_length;
+    }
+    // An empty buffer reads as a length of 0.
+    if(!is_complete && buffer_length > 0)
+    {
+        KSLOG_DEBUG("Error: Unterminated length field");
+        return SAFE80_ERROR_UNTERMINATED_LENGTH_FIELD;
+    }
+    *length = value;
+    KSLOG_DEBUG("Length = %d, chunks = %d", value, used_length);
+    return used_length;
+}
+
+// Stores the offset of the offending character in *error_offset (if it isn't
+// NULL) when the data is invalid.
+static int64_t decode_completely(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length,
+                                 int64_t* const error_offset)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe80_status status = decode_feed(&src,
+                                             src_length,
+                                             &dst,
+                                             dst_length,
+                                             SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM,
+                                             false);
+    if(status != SAFE80_STATUS_OK)
+    {
+        if(status == SAFE80_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+        }
+        if(status == SAFE80_ERROR_INVALID_SOURCE_DATA && error_offset != NULL)
+        {
+            *error_offset = src - src_buffer;
+        }
+        return status;
+    }
+    int64_t decoded_byte_count = dst - dst_buffer;
+    KSLOG_DEBUG("Decoded %d bytes", decoded_byte_count);
+    return decoded_byte_count;
+}
+
+int64_t safe80_decode(const uint8_t* const src_buffer,
+                      const int64_t src_length,
+                      uint8_t* const dst_buffer,
+                      const int64_t dst_length)
+{
+    return decode_completely(src_buffer, src_length, dst_buffer, dst_length, NULL);
+}
+
+int64_t safe80l_decode(const uint8_t* const src_buffer,
+                       const int64_t src_length,
+                       uint8_t* const dst_buffer,
+                       const int64_t dst_length)
 {
     if(src_length < 0 || dst_length < 0)
     {
@@ -445,6 +1161,168 @@ int64_t safe80l_decode(const uint8_t* const src_buffer,
     return decoded_byte_count;
 }
 
+static inline bool is_indentation(const uint8_t* const src, const uint8_t* const src_end, const int indent_count)
+{
+    if(src_end - src < indent_count)
+    {
+        return false;
+    }
+    for(int i = 0; i < indent_count; i++)
+    {
+        if(src[i] != ' ')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Decodes the payload chars gathered in scratch, and moves any trailing
+// partial group to the front. Returns the number of chars left in scratch, or
+// a status code.
+static int64_t decode_wrapped_payload(uint8_t* const scratch,
+                                      const int64_t scratch_length,
+                                      uint8_t** const dst_ptr,
+                                      const uint8_t* const dst_end,
+                                      const bool is_end_of_data)
+{
+    const uint8_t* src = scratch;
+    const safe80_stream_state stream_state = is_end_of_data ?
+        (safe80_stream_state)(SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM | SAFE80_SRC_HAS_NO_WHITESPACE) :
+        SAFE80_SRC_HAS_NO_WHITESPACE;
+    const safe80_status status = safe80_decode_feed(&src, scratch_length, dst_ptr, dst_end - *dst_ptr, stream_state);
+    if(status == SAFE80_STATUS_PARTIALLY_COMPLETE)
+    {
+        if(is_end_of_data || src == scratch)
+        {
+            return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+        }
+    }
+    else if(status != SAFE80_STATUS_OK)
+    {
+        return status;
+    }
+    const int64_t left_over = scratch + scratch_length - src;
+    memmove(scratch, src, left_over);
+    return left_over;
+}
+
+int64_t safe80_decode_wrapped(const uint8_t* const src_buffer,
+                              const int64_t src_length,
+                              uint8_t* const dst_buffer,
+                              const int64_t dst_length,
+                              const int line_length,
+                              const int indent_count,
+                              const safe80_line_break line_break)
+{
+    if(src_length < 0 || dst_length < 0 || line_length < 0 || indent_count < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    KSLOG_DEBUG("Decode %d chars in lines of %d, indented by %d", src_length, line_length, indent_count);
+    const char* const line_break_chars = line_break == SAFE80_LINE_BREAK_CRLF ? "\r\n" : "\n";
+    const int line_break_length = strlen(line_break_chars);
+
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+    uint8_t* dst = dst_buffer;
+    const uint8_t* const dst_end = dst_buffer + dst_length;
+
+    // The payload is gathered into scratch one line at a time, so that it can
+    // be decoded without looking for whitespace.
+    uint8_t scratch[4096];
+    int64_t scratch_length = 0;
+
+    if(!is_indentation(src, src_end, indent_count))
+    {
+        KSLOG_DEBUG("Error: Expected %d spaces of indentation at offset %d", indent_count, src - src_buffer);
+        return SAFE80_ERROR_INVALID_SOURCE_DATA;
+    }
+    src += indent_count;
+    int64_t line_chars_left = line_length > 0 ? line_length : src_end - src;
+    while(src < src_end)
+    {
+        if(line_chars_left == 0)
+        {
+            if(src_end - src < line_break_length ||
+               memcmp(src, line_break_chars, line_break_length) != 0 ||
+               !is_indentation(src + line_break_length, src_end, indent_count))
+            {
+                KSLOG_DEBUG("Error: Expected a line break and indentation at offset %d", src - src_buffer);
+                return SAFE80_ERROR_INVALID_SOURCE_DATA;
+            }
+            src += line_break_length + indent_count;
+            line_chars_left = line_length;
+            if(src >= src_end)
+            {
+                break;
+            }
+        }
+
+        int64_t copy_count = line_chars_left;
+        if(copy_count > src_end - src)
+        {
+            copy_count = src_end - src;
+        }
+        if(copy_count > (int64_t)sizeof(scratch) - scratch_length)
+        {
+            copy_count = sizeof(scratch) - scratch_length;
+        }
+        memcpy(scratch + scratch_length, src, copy_count);
+        scratch_length += copy_count;
+        src += copy_count;
+        line_chars_left -= copy_count;
+
+        if(scratch_length == sizeof(scratch))
+        {
+            scratch_length = decode_wrapped_payload(scratch, scratch_length, &dst, dst_end, false);
+            if(scratch_length < 0)
+            {
+                return scratch_length;
+            }
+        }
+    }
+
+    const int64_t status = decode_wrapped_payload(scratch, scratch_length, &dst, dst_end, true);
+    if(status < 0)
+    {
+        return status;
+    }
+    int64_t decoded_byte_count = dst - dst_buffer;
+    KSLOG_DEBUG("Decoded %d bytes", decoded_byte_count);
+    return decoded_byte_count;
+}
+
+int64_t safe80_compact(const uint8_t* const src_buffer,
+                       const int64_t src_length,
+                       uint8_t* const dst_buffer,
+                       const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const int64_t block_count = (src_length < dst_length ? src_length : dst_length) / g_compact_block_size;
+    uint8_t* dst = dst_buffer + compact_blocks(src_buffer, dst_buffer, block_count);
+    const uint8_t* const src_end = src_buffer + src_length;
+    const uint8_t* const dst_end = dst_buffer + dst_length;
+    for(const uint8_t* src = src_buffer + block_count * g_compact_block_size; src < src_end; src++)
+    {
+        if(g_encode_char_to_chunk[*src] == CHUNK_CODE_WHITESPACE)
+        {
+            continue;
+        }
+        if(dst >= dst_end)
+        {
+            KSLOG_DEBUG("Error: Not enough room to compact %d chars", src_length);
+            return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+        }
+        *dst++ = *src;
+    }
+    KSLOG_DEBUG("Compacted %d chars to %d", src_length, dst - dst_buffer);
+    return dst - dst_buffer;
+}
+
 int64_t safe80_get_encoded_length(const int64_t decoded_length,
                                   const bool include_length_field)
 {
@@ -465,11 +1343,12 @@ int64_t safe80_get_encoded_length(const int64_t decoded_length,
     return group_count * g_chunks_per_group + chunk_count + length_chunk_count;
 }
 
-safe80_status safe80_encode_feed(const uint8_t** const src_buffer_ptr,
+static safe80_status encode_feed(const uint8_t** const src_buffer_ptr,
                                  const int64_t src_length,
                                  uint8_t** const dst_buffer_ptr,
                                  const int64_t dst_length,
-                                 const bool is_end_of_data)
+                                 const bool is_end_of_data,
+                                 const bool has_slack)
 {
     if(src_length < 0 || dst_length < 0)
     {
@@ -507,6 +1386,17 @@ safe80_status safe80_encode_feed(const uint8_t** const src_buffer_ptr,
     int current_group_byte_count = 0;
     int128_ct accumulator = 0;
 
+    {
+        const int64_t src_group_count = (src_end - src) / g_bytes_per_group;
+        const int64_t dst_group_count = (dst_end - dst) / g_chunks_per_group;
+        const int64_t group_count = src_group_count < dst_group_count ? src_group_count : dst_group_count;
+        const int64_t encoded_group_count = encode_groups(src, dst, group_count, has_slack ? g_slack_group_count : 0);
+        KSLOG_DEBUG("Bulk encoded %d of %d groups", encoded_group_count, group_count);
+        src += encoded_group_count * g_bytes_per_group;
+        dst += encoded_group_count * g_chunks_per_group;
+        last_src = src;
+    }
+
     while(src < src_end)
     {
         const uint8_t next_byte = *src++;
@@ -544,29 +1434,110 @@ safe80_status safe80_encode_feed(const uint8_t** const src_buffer_ptr,
 #undef WRITE_CHUNKS
 }
 
-int64_t safe80_write_length_field(const int64_t length,
-                                  uint8_t* const dst_buffer,
-                                  const int64_t dst_buffer_length)
+safe80_status safe80_encode_feed(const uint8_t** const src_buffer_ptr,
+                                 const int64_t src_length,
+                                 uint8_t** const dst_buffer_ptr,
+                                 const int64_t dst_length,
+                                 const bool is_end_of_data)
 {
-    if(dst_buffer_length < 0 || length < 0)
-    {
-        return SAFE80_ERROR_INVALID_LENGTH;
-    }
-    const int continuation_bit = 1 << g_bits_per_length_chunk;
-    const int chunk_mask = continuation_bit - 1;
-    KSLOG_DEBUG("bits %d, continue %02x, mask %02x", g_bits_per_length_chunk, continuation_bit, chunk_mask);
+    return encode_feed(src_buffer_ptr, src_length, dst_buffer_ptr, dst_length, is_end_of_data, false);
+}
 
-    int chunk_count = 0;
-    for(uint64_t i = length; i; i >>= g_bits_per_length_chunk, chunk_count++)
-    {
-    }
-    if(chunk_count == 0)
+safe80_status safe80_encode_feedv(const safe80_iovec* const src_vector,
+                                  const int src_vector_count,
+                                  const safe80_iovec* const dst_vector,
+                                  const int dst_vector_count,
+                                  int64_t* const src_used,
+                                  int64_t* const dst_used,
+                                  const bool is_end_of_data)
+{
+    vector_cursor src;
+    vector_cursor dst;
+    if(init_vector_cursor(&src, src_vector, src_vector_count) != SAFE80_STATUS_OK ||
+       init_vector_cursor(&dst, dst_vector, dst_vector_count) != SAFE80_STATUS_OK)
     {
-        chunk_count = 1;
+        return SAFE80_ERROR_INVALID_LENGTH;
     }
-    KSLOG_DEBUG("Value: %lu, chunk count %d", length, chunk_count);
+    safe80_status status = SAFE80_STATUS_OK;
 
-    if(chunk_count > dst_buffer_length)
+    for(;;)
+    {
+        const int64_t src_length = get_contiguous_length(&src);
+        const int64_t dst_length = get_contiguous_length(&dst);
+        if(src_length > 0 && dst_length > 0)
+        {
+            const uint8_t* const src_start = get_cursor_pointer(&src);
+            uint8_t* const dst_start = get_cursor_pointer(&dst);
+            const uint8_t* src_ptr = src_start;
+            uint8_t* dst_ptr = dst_start;
+            encode_feed(&src_ptr, src_length, &dst_ptr, dst_length, is_end_of_data && is_in_last_buffer(&src), false);
+            advance_cursor(&src, src_ptr - src_start);
+            advance_cursor(&dst, dst_ptr - dst_start);
+            if(src_ptr > src_start)
+            {
+                continue;
+            }
+        }
+
+        // The next group straddles buffers (or is the last one), so gather
+        // its bytes, encode them, and scatter the chars.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        vector_cursor group_end = src;
+        int group_length = 0;
+        while(group_length < g_bytes_per_group && get_contiguous_length(&group_end) > 0)
+        {
+            group[group_length++] = *get_cursor_pointer(&group_end);
+            advance_cursor(&group_end, 1);
+        }
+        if(group_length == 0 || (group_length < g_bytes_per_group && !is_end_of_data))
+        {
+            break;
+        }
+
+        uint8_t chars[STRADDLED_GROUP_SIZE];
+        const uint8_t* group_ptr = group;
+        uint8_t* chars_ptr = chars;
+        encode_feed(&group_ptr, group_length, &chars_ptr, sizeof(chars), true, false);
+        const int64_t char_count = chars_ptr - chars;
+        if(get_remaining_length(&dst, char_count) < char_count)
+        {
+            KSLOG_DEBUG("Error: Need %d chars but only %d available", char_count, get_remaining_length(&dst, char_count));
+            status = SAFE80_STATUS_PARTIALLY_COMPLETE;
+            break;
+        }
+        KSLOG_DEBUG("Encoded a straddling group of %d bytes", group_length);
+        scatter_to_cursor(&dst, chars, char_count);
+        advance_cursor(&src, group_length);
+    }
+
+    *src_used = src.used;
+    *dst_used = dst.used;
+    return status;
+}
+
+int64_t safe80_write_length_field(const int64_t length,
+                                  uint8_t* const dst_buffer,
+                                  const int64_t dst_buffer_length)
+{
+    if(dst_buffer_length < 0 || length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const int continuation_bit = 1 << g_bits_per_length_chunk;
+    const int chunk_mask = continuation_bit - 1;
+    KSLOG_DEBUG("bits %d, continue %02x, mask %02x", g_bits_per_length_chunk, continuation_bit, chunk_mask);
+
+    int chunk_count = 0;
+    for(uint64_t i = length; i; i >>= g_bits_per_length_chunk, chunk_count++)
+    {
+    }
+    if(chunk_count == 0)
+    {
+        chunk_count = 1;
+    }
+    KSLOG_DEBUG("Value: %lu, chunk count %d", length, chunk_count);
+
+    if(chunk_count > dst_buffer_length)
     {
         KSLOG_DEBUG("Error: Require %d bytes but only %d available", chunk_count, dst_buffer_length);
         return SAFE80_ERROR_NOT_ENOUGH_ROOM;
@@ -636,3 +1607,899 @@ int64_t safe80l_encode(const uint8_t* const src_buffer,
     }
     return dst - dst_buffer;
 }
+
+int64_t safe80_required_slack(void)
+{
+    return g_required_slack;
+}
+
+int64_t safe80_encode_with_slack(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe80_status status = encode_feed(&src, src_length, &dst, dst_length, true, true);
+    if(status != SAFE80_STATUS_OK)
+    {
+        if(status == SAFE80_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+        }
+        return status;
+    }
+    return dst - dst_buffer;
+}
+
+int64_t safe80_decode_with_slack(const uint8_t* const src_buffer,
+                                 const int64_t src_length,
+                                 uint8_t* const dst_buffer,
+                                 const int64_t dst_length)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const safe80_status status = decode_feed(&src,
+                                             src_length,
+                                             &dst,
+                                             dst_length,
+                                             SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM,
+                                             true);
+    if(status != SAFE80_STATUS_OK)
+    {
+        if(status == SAFE80_STATUS_PARTIALLY_COMPLETE)
+        {
+            return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+        }
+        return status;
+    }
+    return dst - dst_buffer;
+}
+
+// Parallel encodes and decodes split the data into shards, with a few for each
+// thread so that threads that finish early can take over some of the work from
+// slower ones. Shards are never smaller than this though, because handing work
+// over has a cost.
+static const int64_t g_min_parallel_shard_size = 1 << 16;
+static const int g_shards_per_thread = 4;
+
+// Gives a shard length that's a multiple of unit_length.
+static int64_t get_parallel_shard_length(const int64_t length, const int thread_count, const int unit_length)
+{
+    int64_t unit_count = length / unit_length / ((int64_t)thread_count * g_shards_per_thread) + 1;
+    if(unit_count < g_min_parallel_shard_size / unit_length)
+    {
+        unit_count = g_min_parallel_shard_size / unit_length;
+    }
+    return unit_count * unit_length;
+}
+
+// Encoding shards are made of whole groups, which encode to known places in
+// dst.
+
+typedef struct
+{
+    const uint8_t* src_buffer;
+    int64_t src_length;
+    uint8_t* dst_buffer;
+    int64_t shard_group_count;
+} parallel_encode;
+
+static void encode_shard(void* const context, const int64_t shard_index)
+{
+    const parallel_encode* const job = (const parallel_encode*)context;
+    const int64_t group_index = shard_index * job->shard_group_count;
+    const int64_t src_offset = group_index * g_bytes_per_group;
+    int64_t src_length = job->shard_group_count * g_bytes_per_group;
+    if(src_length > job->src_length - src_offset)
+    {
+        src_length = job->src_length - src_offset;
+    }
+    const uint8_t* src = job->src_buffer + src_offset;
+    uint8_t* dst = job->dst_buffer + group_index * g_chunks_per_group;
+    // Only the last shard can end in a partial group. The caller has already
+    // made sure that there's room for everything.
+    encode_feed(&src, src_length, &dst, safe80_get_encoded_length(src_length, false), true, false);
+}
+
+int64_t safe80_encode_parallel(const uint8_t* const src_buffer,
+                               const int64_t src_length,
+                               uint8_t* const dst_buffer,
+                               const int64_t dst_length,
+                               int thread_count)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const int64_t encoded_length = safe80_get_encoded_length(src_length, false);
+    if(encoded_length > dst_length)
+    {
+        KSLOG_DEBUG("Error: Need %d chars but only %d available", encoded_length, dst_length);
+        return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+    }
+    if(thread_count <= 0)
+    {
+        thread_count = safe80_get_cpu_count();
+    }
+
+    const int64_t shard_length = get_parallel_shard_length(src_length, thread_count, g_bytes_per_group);
+    const int64_t shard_count = (src_length + shard_length - 1) / shard_length;
+    KSLOG_DEBUG("Encoding %d bytes as %d shards on %d threads", src_length, shard_count, thread_count);
+
+    parallel_encode job =
+    {
+        .src_buffer = src_buffer,
+        .src_length = src_length,
+        .dst_buffer = dst_buffer,
+        .shard_group_count = shard_length / g_bytes_per_group,
+    };
+    safe80_run_parallel(encode_shard, &job, shard_count, thread_count);
+    return encoded_length;
+}
+
+int64_t safe80l_encode_parallel(const uint8_t* const src_buffer,
+                                const int64_t src_length,
+                                uint8_t* const dst_buffer,
+                                const int64_t dst_length,
+                                const int thread_count)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const int64_t bytes_used = safe80_write_length_field(src_length, dst_buffer, dst_length);
+    if(bytes_used < 0)
+    {
+        return bytes_used;
+    }
+    const int64_t encoded_length = safe80_encode_parallel(src_buffer,
+                                                          src_length,
+                                                          dst_buffer + bytes_used,
+                                                          dst_length - bytes_used,
+                                                          thread_count);
+    if(encoded_length < 0)
+    {
+        return encoded_length;
+    }
+    return bytes_used + encoded_length;
+}
+
+// Parallel decodes have to find out where the groups are first, because
+// whitespace moves them around. A first pass counts the chars in each shard
+// (block), which gives the index of the first char of each block, and from
+// that where its groups start and where in dst they decode to. A second pass
+// then decodes the groups that start in each block. Groups that straddle the
+// end of a block are gathered up and decoded on their own.
+
+typedef struct
+{
+    // The number of non-whitespace chars before the block. The first pass
+    // sets this to the number in the block, and the sum is worked out after.
+    int64_t char_index;
+    safe80_status status;
+    int64_t error_offset;
+} parallel_decode_block;
+
+typedef struct
+{
+    const uint8_t* src_buffer;
+    int64_t src_length;
+    uint8_t* dst_buffer;
+    int64_t dst_length;
+    int64_t block_length;
+    int64_t block_count;
+    int64_t char_count;
+    parallel_decode_block* blocks;
+} parallel_decode;
+
+static inline bool is_whitespace(const uint8_t ch)
+{
+    return g_encode_char_to_chunk[ch] == CHUNK_CODE_WHITESPACE;
+}
+
+// Gives one more than the highest whitespace char.
+static uint8_t get_whitespace_limit(void)
+{
+    int limit = 0;
+    for(int ch = 0; ch < 256; ch++)
+    {
+        if(is_whitespace((uint8_t)ch))
+        {
+            limit = ch + 1;
+        }
+    }
+    return (uint8_t)limit;
+}
+
+// Gives the whitespace limit in every byte, for count_word_whitespace().
+static uint64_t get_word_whitespace_limits(void)
+{
+    return 0x0101010101010101 * get_whitespace_limit();
+}
+
+// Whitespace is rare in most data, so chars are checked 8 at a time for any
+// that are below the whitespace limit, and only those are looked up.
+static inline int count_word_whitespace(const uint8_t* const src, const uint64_t limits)
+{
+    const uint64_t top_bits = 0x8080808080808080;
+    uint64_t chars;
+    memcpy(&chars, src, sizeof(chars));
+    // Sets the top bit of each byte that's below the limit. Setting the top
+    // bits first stops borrows from crossing bytes.
+    uint64_t below_limit = ~(((chars | top_bits) - limits) | chars) & top_bits;
+    int whitespace_count = 0;
+    for(; below_limit != 0; below_limit &= below_limit - 1)
+    {
+        const int shift = __builtin_ctzll(below_limit) & ~7;
+        whitespace_count += is_whitespace((uint8_t)(chars >> shift));
+    }
+    return whitespace_count;
+}
+
+static void count_block_chars(void* const context, const int64_t block_index)
+{
+    parallel_decode* const job = (parallel_decode*)context;
+    const int64_t block_offset = block_index * job->block_length;
+    int64_t block_length = job->src_length - block_offset;
+    if(block_length > job->block_length)
+    {
+        block_length = job->block_length;
+    }
+    const uint8_t* const src = job->src_buffer + block_offset;
+    const uint64_t limits = get_word_whitespace_limits();
+    int64_t whitespace_count = 0;
+    int64_t i = 0;
+    for(; i + (int64_t)sizeof(uint64_t) <= block_length; i += sizeof(uint64_t))
+    {
+        whitespace_count += count_word_whitespace(src + i, limits);
+    }
+    for(; i < block_length; i++)
+    {
+        whitespace_count += is_whitespace(src[i]);
+    }
+    job->blocks[block_index].char_index = block_length - whitespace_count;
+}
+
+static void decode_block(void* const context, const int64_t block_index)
+{
+    parallel_decode* const job = (parallel_decode*)context;
+    parallel_decode_block* const block = &job->blocks[block_index];
+    block->status = SAFE80_STATUS_OK;
+    const bool is_last_block = block_index == job->block_count - 1;
+    const uint8_t* const src_end = is_last_block ? job->src_buffer + job->src_length
+                                                 : job->src_buffer + (block_index + 1) * job->block_length;
+    const int64_t end_char_index = is_last_block ? job->char_count : block[1].char_index;
+
+    // Chars before the first group that starts here belong to the previous
+    // block's straddling group.
+    const int64_t first_group_index = (block->char_index + g_chunks_per_group - 1) / g_chunks_per_group;
+    if(first_group_index * g_chunks_per_group >= end_char_index)
+    {
+        KSLOG_DEBUG("Block %d has no groups of its own", block_index);
+        return;
+    }
+    const uint8_t* src = job->src_buffer + block_index * job->block_length;
+    for(int64_t skip_count = first_group_index * g_chunks_per_group - block->char_index; skip_count > 0; src++)
+    {
+        skip_count -= !is_whitespace(*src);
+    }
+
+    // The last block decodes whatever it ends with, the same as the serial
+    // decoder would.
+    const int64_t straddling_char_count = is_last_block ? 0 : (end_char_index - first_group_index * g_chunks_per_group) % g_chunks_per_group;
+    const uint8_t* straddling_src = src_end;
+    for(int64_t skip_count = straddling_char_count; skip_count > 0;)
+    {
+        straddling_src--;
+        skip_count -= !is_whitespace(*straddling_src);
+    }
+    const int64_t straddling_group_index = (end_char_index - straddling_char_count) / g_chunks_per_group;
+
+    const uint8_t* const src_start = src;
+    uint8_t* dst = job->dst_buffer + first_group_index * g_bytes_per_group;
+    uint8_t* const dst_end = is_last_block ? job->dst_buffer + job->dst_length
+                                           : job->dst_buffer + straddling_group_index * g_bytes_per_group;
+    KSLOG_DEBUG("Block %d decodes groups %d to %d", block_index, first_group_index, straddling_group_index);
+    safe80_status status = decode_feed(&src,
+                                       straddling_src - src_start,
+                                       &dst,
+                                       dst_end - dst,
+                                       SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM,
+                                       false);
+    if(status != SAFE80_STATUS_OK)
+    {
+        block->status = status;
+        block->error_offset = src - job->src_buffer;
+        return;
+    }
+    if(straddling_char_count == 0)
+    {
+        return;
+    }
+
+    // The straddling group can run on through any number of blocks that are
+    // all whitespace, and can also be the partial group at the very end.
+    uint8_t group[STRADDLED_GROUP_SIZE];
+    int64_t group_offsets[STRADDLED_GROUP_SIZE];
+    int group_length = 0;
+    const uint8_t* const data_end = job->src_buffer + job->src_length;
+    for(src = straddling_src; src < data_end && group_length < g_chunks_per_group; src++)
+    {
+        if(!is_whitespace(*src))
+        {
+            group_offsets[group_length] = src - job->src_buffer;
+            group[group_length++] = *src;
+        }
+    }
+    const bool is_last_group = straddling_group_index * g_chunks_per_group + group_length >= job->char_count;
+    const uint8_t* group_ptr = group;
+    dst = job->dst_buffer + straddling_group_index * g_bytes_per_group;
+    status = decode_feed(&group_ptr,
+                         group_length,
+                         &dst,
+                         is_last_group ? job->dst_buffer + job->dst_length - dst : g_bytes_per_group,
+                         SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM,
+                         false);
+    if(status != SAFE80_STATUS_OK)
+    {
+        block->status = status;
+        block->error_offset = group_ptr < group + group_length ? group_offsets[group_ptr - group] : src - job->src_buffer;
+    }
+}
+
+int64_t safe80_decode_parallel(const uint8_t* const src_buffer,
+                               const int64_t src_length,
+                               uint8_t* const dst_buffer,
+                               const int64_t dst_length,
+                               int thread_count,
+                               int64_t* const error_offset)
+{
+    if(src_length < 0 || dst_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    if(thread_count <= 0)
+    {
+        thread_count = safe80_get_cpu_count();
+    }
+    const int64_t block_length = get_parallel_shard_length(src_length, thread_count, 1);
+    const int64_t block_count = (src_length + block_length - 1) / block_length;
+    if(block_count < 2 || thread_count == 1)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+    parallel_decode_block* const blocks = (parallel_decode_block*)malloc(block_count * sizeof(*blocks));
+    if(blocks == NULL)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+
+    parallel_decode job =
+    {
+        .src_buffer = src_buffer,
+        .src_length = src_length,
+        .dst_buffer = dst_buffer,
+        .dst_length = dst_length,
+        .block_length = block_length,
+        .block_count = block_count,
+        .char_count = 0,
+        .blocks = blocks,
+    };
+    safe80_run_parallel(count_block_chars, &job, block_count, thread_count);
+    for(int64_t i = 0; i < block_count; i++)
+    {
+        const int64_t char_count = blocks[i].char_index;
+        blocks[i].char_index = job.char_count;
+        job.char_count += char_count;
+    }
+
+    const int64_t decoded_length = job.char_count / g_chunks_per_group * g_bytes_per_group +
+                                   g_chunk_to_byte_count[job.char_count % g_chunks_per_group];
+    KSLOG_DEBUG("Decoding %d chars as %d blocks on %d threads", job.char_count, block_count, thread_count);
+    if(decoded_length > dst_length)
+    {
+        // This is going to fail one way or another, and the serial decoder
+        // knows which way.
+        free(blocks);
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+
+    safe80_run_parallel(decode_block, &job, block_count, thread_count);
+
+    // Every char gets checked by exactly one block, so the serial decoder would
+    // stop at the error nearest the start.
+    const parallel_decode_block* first_error = NULL;
+    for(int64_t i = 0; i < block_count; i++)
+    {
+        if(blocks[i].status != SAFE80_STATUS_OK &&
+           (first_error == NULL || blocks[i].error_offset < first_error->error_offset))
+        {
+            first_error = &blocks[i];
+        }
+    }
+    if(first_error == NULL)
+    {
+        free(blocks);
+        return decoded_length;
+    }
+    KSLOG_DEBUG("Error %d at offset %d", first_error->status, first_error->error_offset);
+    const safe80_status status = first_error->status;
+    const int64_t first_error_offset = first_error->error_offset;
+    free(blocks);
+
+    // Invalid chars are counted as well, so dst only fills up before the
+    // first one if it's exactly the length worked out above. In that case the
+    // serial decoder might run out of room first.
+    if(status != SAFE80_ERROR_INVALID_SOURCE_DATA || decoded_length == dst_length)
+    {
+        return decode_completely(src_buffer, src_length, dst_buffer, dst_length, error_offset);
+    }
+    if(error_offset != NULL)
+    {
+        *error_offset = first_error_offset;
+    }
+    return status;
+}
+
+// Groups are a fixed size, so any range of the decoded data comes from a known
+// run of groups. Without whitespace, each group's position follows from its
+// index. With whitespace, the groups are counted off from the nearest
+// checkpoint before the range.
+
+// Skips over *char_count non-whitespace chars, taking off the ones it skipped
+// (which is fewer if it runs out of data first).
+static const uint8_t* skip_chars(const uint8_t* src,
+                                 const uint8_t* const src_end,
+                                 int64_t* const char_count,
+                                 const uint64_t whitespace_limits)
+{
+    while(*char_count >= (int64_t)sizeof(uint64_t) && src_end - src >= (int64_t)sizeof(uint64_t))
+    {
+        *char_count -= sizeof(uint64_t) - count_word_whitespace(src, whitespace_limits);
+        src += sizeof(uint64_t);
+    }
+    for(; *char_count > 0 && src < src_end; src++)
+    {
+        *char_count -= !is_whitespace(*src);
+    }
+    return src;
+}
+
+int64_t safe80_decode_range(const uint8_t* const src_buffer,
+                            const int64_t src_length,
+                            const int64_t byte_offset,
+                            int64_t byte_count,
+                            uint8_t* const dst_buffer,
+                            const safe80_checkpoints* const checkpoints)
+{
+    if(src_length < 0 || byte_offset < 0 || byte_count < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const int64_t decoded_length = checkpoints != NULL ? checkpoints->decoded_length
+                                                       : safe80_get_decoded_length(src_length);
+    if(byte_offset >= decoded_length)
+    {
+        return 0;
+    }
+    if(byte_count > decoded_length - byte_offset)
+    {
+        byte_count = decoded_length - byte_offset;
+    }
+
+    const uint8_t* const src_end = src_buffer + src_length;
+    const int64_t first_group_index = byte_offset / g_bytes_per_group;
+    const uint8_t* src = src_buffer + first_group_index * g_chunks_per_group;
+    safe80_stream_state stream_state = SAFE80_SRC_IS_AT_END_OF_STREAM | SAFE80_DST_IS_AT_END_OF_STREAM;
+    if(checkpoints != NULL)
+    {
+        const int64_t checkpoint_index = first_group_index / checkpoints->group_interval;
+        if(checkpoint_index >= checkpoints->offset_count || checkpoints->offsets[checkpoint_index] > src_length)
+        {
+            KSLOG_DEBUG("Error: Checkpoint %d is past the end of the %d char sequence", checkpoint_index, src_length);
+            return SAFE80_ERROR_TRUNCATED_DATA;
+        }
+        int64_t skip_count = (first_group_index - checkpoint_index * checkpoints->group_interval) * g_chunks_per_group;
+        src = skip_chars(src_buffer + checkpoints->offsets[checkpoint_index],
+                         src_end,
+                         &skip_count,
+                         get_word_whitespace_limits());
+    }
+    else
+    {
+        stream_state |= SAFE80_SRC_HAS_NO_WHITESPACE;
+    }
+    KSLOG_DEBUG("Decoding %d bytes at %d from group %d at offset %d",
+                byte_count, byte_offset, first_group_index, src - src_buffer);
+
+    uint8_t* dst = dst_buffer;
+    uint8_t* const dst_end = dst_buffer + byte_count;
+    int skip_byte_count = byte_offset % g_bytes_per_group;
+    while(dst < dst_end)
+    {
+        const int64_t whole_group_count = (dst_end - dst) / g_bytes_per_group;
+        if(skip_byte_count == 0 && whole_group_count > 0)
+        {
+            // These groups are all inside the range, so none of them can be
+            // the partial group at the end, and they go straight to dst.
+            const safe80_status status = decode_feed(&src,
+                                                     src_end - src,
+                                                     &dst,
+                                                     whole_group_count * g_bytes_per_group,
+                                                     stream_state | SAFE80_EXPECT_DST_STREAM_TO_END,
+                                                     false);
+            if(status != SAFE80_STATUS_OK)
+            {
+                return status;
+            }
+            continue;
+        }
+
+        // A group that's only partly inside the range gets decoded on the side.
+        uint8_t group[STRADDLED_GROUP_SIZE];
+        int group_length = 0;
+        for(; src < src_end && group_length < g_chunks_per_group; src++)
+        {
+            if(checkpoints == NULL || !is_whitespace(*src))
+            {
+                group[group_length++] = *src;
+            }
+        }
+        uint8_t bytes[STRADDLED_GROUP_SIZE];
+        const uint8_t* group_ptr = group;
+        uint8_t* bytes_ptr = bytes;
+        const safe80_status status = decode_feed(&group_ptr,
+                                                 group_length,
+                                                 &bytes_ptr,
+                                                 g_bytes_per_group,
+                                                 stream_state,
+                                                 false);
+        if(status != SAFE80_STATUS_OK)
+        {
+            return status;
+        }
+        int64_t copy_length = bytes_ptr - bytes - skip_byte_count;
+        if(copy_length <= 0)
+        {
+            KSLOG_DEBUG("Error: Ran out of data at offset %d", src - src_buffer);
+            return SAFE80_ERROR_TRUNCATED_DATA;
+        }
+        if(copy_length > dst_end - dst)
+        {
+            copy_length = dst_end - dst;
+        }
+        memcpy(dst, bytes + skip_byte_count, copy_length);
+        dst += copy_length;
+        skip_byte_count = 0;
+    }
+    return byte_count;
+}
+
+int64_t safe80_get_checkpoint_count(const int64_t src_length, const int64_t group_interval)
+{
+    if(src_length < 0 || group_interval < 1)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const int64_t group_count = (src_length + g_chunks_per_group - 1) / g_chunks_per_group;
+    return group_count / group_interval + (group_count % group_interval != 0);
+}
+
+safe80_status safe80_build_checkpoints(const uint8_t* const src_buffer,
+                                       const int64_t src_length,
+                                       const int64_t group_interval,
+                                       int64_t* const offsets,
+                                       const int64_t offset_capacity,
+                                       safe80_checkpoints* const checkpoints)
+{
+    if(src_length < 0 || group_interval < 1 || offset_capacity < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    // An interval longer than the data only ever gets the first checkpoint.
+    const int64_t chars_per_checkpoint = group_interval > src_length ? src_length + 1
+                                                                     : group_interval * g_chunks_per_group;
+    const uint8_t* const src_end = src_buffer + src_length;
+    const uint64_t whitespace_limits = get_word_whitespace_limits();
+    const uint8_t* src = src_buffer;
+    int64_t offset_count = 0;
+    int64_t char_count = 0;
+    for(;;)
+    {
+        while(src < src_end && is_whitespace(*src))
+        {
+            src++;
+        }
+        if(src >= src_end)
+        {
+            break;
+        }
+        if(offset_count >= offset_capacity)
+        {
+            KSLOG_DEBUG("Error: No room for checkpoint %d", offset_count);
+            return SAFE80_ERROR_NOT_ENOUGH_ROOM;
+        }
+        offsets[offset_count++] = src - src_buffer;
+        int64_t skip_count = chars_per_checkpoint;
+        src = skip_chars(src, src_end, &skip_count, whitespace_limits);
+        char_count += chars_per_checkpoint - skip_count;
+    }
+
+    checkpoints->group_interval = group_interval;
+    checkpoints->offsets = offsets;
+    checkpoints->offset_count = offset_count;
+    checkpoints->decoded_length = char_count / g_chunks_per_group * g_bytes_per_group +
+                                  g_chunk_to_byte_count[char_count % g_chunks_per_group];
+    KSLOG_DEBUG("Built %d checkpoints for %d chars", offset_count, char_count);
+    return SAFE80_STATUS_OK;
+}
+
+void safe80_encoder_init(safe80_encoder* const encoder,
+                         const safe80_sink sink,
+                         void* const sink_context)
+{
+    encoder->sink = sink;
+    encoder->sink_context = sink_context;
+    encoder->has_length_field = false;
+    encoder->length_field = 0;
+    encoder->partial_group_length = 0;
+}
+
+void safe80l_encoder_init(safe80_encoder* const encoder,
+                          const int64_t length,
+                          const safe80_sink sink,
+                          void* const sink_context)
+{
+    safe80_encoder_init(encoder, sink, sink_context);
+    encoder->has_length_field = true;
+    encoder->length_field = length;
+}
+
+// Encodes as much of src as it can, handing the results to the sink. Anything
+// left at *src_ptr afterwards is a partial group.
+static safe80_status encode_to_sink(safe80_encoder* const encoder,
+                                    const uint8_t** const src_ptr,
+                                    const uint8_t* const src_end,
+                                    const bool is_end_of_data)
+{
+    uint8_t buffer[4096];
+    safe80_status status = SAFE80_STATUS_PARTIALLY_COMPLETE;
+    while(status == SAFE80_STATUS_PARTIALLY_COMPLETE)
+    {
+        uint8_t* dst = buffer;
+        status = encode_feed(src_ptr, src_end - *src_ptr, &dst, sizeof(buffer), is_end_of_data, false);
+        if(dst > buffer && !encoder->sink(encoder->sink_context, buffer, dst - buffer))
+        {
+            KSLOG_DEBUG("Error: Sink refused %d chars", dst - buffer);
+            return SAFE80_ERROR_SINK_FAILED;
+        }
+    }
+    return status;
+}
+
+safe80_status safe80_encoder_feed(safe80_encoder* const encoder,
+                                  const uint8_t* const src_buffer,
+                                  const int64_t src_length,
+                                  const bool is_end_of_data)
+{
+    if(src_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+
+    if(encoder->has_length_field)
+    {
+        uint8_t length_field[32];
+        const int64_t length_field_length = safe80_write_length_field(encoder->length_field,
+                                                                      length_field,
+                                                                      sizeof(length_field));
+        if(length_field_length < 0)
+        {
+            return length_field_length;
+        }
+        if(!encoder->sink(encoder->sink_context, length_field, length_field_length))
+        {
+            KSLOG_DEBUG("Error: Sink refused the length field");
+            return SAFE80_ERROR_SINK_FAILED;
+        }
+        encoder->has_length_field = false;
+    }
+
+    // A partial group left over from the last feed is topped up and encoded
+    // on its own, so that src doesn't have to be copied anywhere.
+    if(encoder->partial_group_length > 0)
+    {
+        while(encoder->partial_group_length < g_bytes_per_group && src < src_end)
+        {
+            encoder->partial_group[encoder->partial_group_length++] = *src++;
+        }
+        if(encoder->partial_group_length < g_bytes_per_group && !is_end_of_data)
+        {
+            return SAFE80_STATUS_OK;
+        }
+        const uint8_t* group = encoder->partial_group;
+        const safe80_status status = encode_to_sink(encoder,
+                                                    &group,
+                                                    encoder->partial_group + encoder->partial_group_length,
+                                                    is_end_of_data);
+        if(status != SAFE80_STATUS_OK)
+        {
+            return status;
+        }
+        encoder->partial_group_length = 0;
+    }
+
+    const safe80_status status = encode_to_sink(encoder, &src, src_end, is_end_of_data);
+    if(status != SAFE80_STATUS_OK)
+    {
+        return status;
+    }
+    encoder->partial_group_length = src_end - src;
+    memcpy(encoder->partial_group, src, encoder->partial_group_length);
+    KSLOG_DEBUG("Keeping %d bytes for the next feed", encoder->partial_group_length);
+    return SAFE80_STATUS_OK;
+}
+
+void safe80_decoder_init(safe80_decoder* const decoder,
+                         const safe80_sink sink,
+                         void* const sink_context)
+{
+    decoder->sink = sink;
+    decoder->sink_context = sink_context;
+    decoder->is_reading_length_field = false;
+    decoder->length_field = 0;
+    decoder->bytes_left = -1;
+    decoder->partial_group_length = 0;
+}
+
+void safe80l_decoder_init(safe80_decoder* const decoder,
+                          const safe80_sink sink,
+                          void* const sink_context)
+{
+    safe80_decoder_init(decoder, sink, sink_context);
+    decoder->is_reading_length_field = true;
+}
+
+// Decodes as much of src as it can, handing the results to the sink. Anything
+// left at *src_ptr afterwards is a partial group, maybe mixed with whitespace.
+static safe80_status decode_to_sink(safe80_decoder* const decoder,
+                                    const uint8_t** const src_ptr,
+                                    const uint8_t* const src_end,
+                                    const bool is_end_of_data)
+{
+    uint8_t buffer[4096];
+    for(;;)
+    {
+        int64_t dst_length = sizeof(buffer);
+        int stream_state = is_end_of_data ? SAFE80_SRC_IS_AT_END_OF_STREAM : SAFE80_STREAM_STATE_NONE;
+        if(decoder->bytes_left >= 0 && decoder->bytes_left <= dst_length)
+        {
+            // The length field says where the data ends.
+            dst_length = decoder->bytes_left;
+            stream_state |= SAFE80_DST_IS_AT_END_OF_STREAM | SAFE80_EXPECT_DST_STREAM_TO_END;
+        }
+        const uint8_t* const src_start = *src_ptr;
+        uint8_t* dst = buffer;
+        const safe80_status status = decode_feed(src_ptr,
+                                                 src_end - *src_ptr,
+                                                 &dst,
+                                                 dst_length,
+                                                 (safe80_stream_state)stream_state,
+                                                 false);
+        if(dst > buffer && !decoder->sink(decoder->sink_context, buffer, dst - buffer))
+        {
+            KSLOG_DEBUG("Error: Sink refused %d bytes", dst - buffer);
+            return SAFE80_ERROR_SINK_FAILED;
+        }
+        if(decoder->bytes_left >= 0)
+        {
+            decoder->bytes_left -= dst - buffer;
+        }
+        // Running out of room in buffer is the only reason to go around again.
+        if(status != SAFE80_STATUS_PARTIALLY_COMPLETE || (*src_ptr == src_start && dst == buffer))
+        {
+            return status;
+        }
+    }
+}
+
+safe80_status safe80_decoder_feed(safe80_decoder* const decoder,
+                                  const uint8_t* const src_buffer,
+                                  const int64_t src_length,
+                                  const bool is_end_of_data)
+{
+    if(src_length < 0)
+    {
+        return SAFE80_ERROR_INVALID_LENGTH;
+    }
+    const uint8_t* src = src_buffer;
+    const uint8_t* const src_end = src_buffer + src_length;
+
+    if(decoder->is_reading_length_field)
+    {
+        bool is_complete = false;
+        const int64_t used_length = continue_length_field(src, src_end - src, &decoder->length_field, &is_complete);
+        if(used_length < 0)
+        {
+            return used_length;
+        }
+        src += used_length;
+        if(!is_complete)
+        {
+            if(is_end_of_data)
+            {
+                KSLOG_DEBUG("Error: Unterminated length field");
+                return SAFE80_ERROR_UNTERMINATED_LENGTH_FIELD;
+            }
+            return SAFE80_STATUS_OK;
+        }
+        KSLOG_DEBUG("Length = %d", decoder->length_field);
+        decoder->is_reading_length_field = false;
+        decoder->bytes_left = decoder->length_field;
+    }
+
+    // A partial group left over from the last feed is topped up and decoded
+    // on its own, so that src doesn't have to be copied anywhere.
+    if(decoder->partial_group_length > 0)
+    {
+        while(decoder->partial_group_length < g_chunks_per_group && src < src_end)
+        {
+            if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+            {
+                decoder->partial_group[decoder->partial_group_length++] = *src;
+            }
+            src++;
+        }
+        if(decoder->partial_group_length < g_chunks_per_group && !is_end_of_data)
+        {
+            return SAFE80_STATUS_OK;
+        }
+        const uint8_t* group = decoder->partial_group;
+        const safe80_status status = decode_to_sink(decoder,
+                                                    &group,
+                                                    decoder->partial_group + decoder->partial_group_length,
+                                                    is_end_of_data && src >= src_end);
+        if(status != SAFE80_STATUS_OK && status != SAFE80_STATUS_PARTIALLY_COMPLETE)
+        {
+            return status;
+        }
+        decoder->partial_group_length = 0;
+    }
+
+    // Data after the end that the length field gives is ignored.
+    if(decoder->bytes_left == 0)
+    {
+        return SAFE80_STATUS_OK;
+    }
+
+    const safe80_status status = decode_to_sink(decoder, &src, src_end, is_end_of_data);
+    if(status != SAFE80_STATUS_OK && status != SAFE80_STATUS_PARTIALLY_COMPLETE)
+    {
+        return status;
+    }
+    if(is_end_of_data && decoder->bytes_left > 0)
+    {
+        KSLOG_DEBUG("Error: Expected %d more bytes", decoder->bytes_left);
+        return SAFE80_ERROR_TRUNCATED_DATA;
+    }
+    for(; src < src_end && decoder->bytes_left != 0; src++)
+    {
+        if(g_encode_char_to_chunk[*src] != CHUNK_CODE_WHITESPACE)
+        {
+            decoder->partial_group[decoder->partial_group_length++] = *src;
+        }
+    }
+    KSLOG_DEBUG("Keeping %d chars for the next feed", decoder->partial_group_length);
+    return SAFE80_STATUS_OK;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Bulk kernels work on complete groups of whitespace-free data only.
+// Each one returns the number of groups it processed, which may be fewer than
+// group_count (for example when a decode block contains whitespace or an
+// invalid character). The per-character loops in library.c take care of
+// whatever is left over, so results are always identical to the scalar code.
+//
+// Compact kernels copy blocks of 16 chars, leaving out whitespace, and return
+// the number of chars written. They always process every block.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SAFE85_HAS_X86_KERNELS 1
+#else
+    #define SAFE85_HAS_X86_KERNELS 0
+#endif
+
+// safe85 chunks aren't bit fields, so there is nothing for pdep and pext to do.
+#define SAFE85_HAS_BMI2_KERNELS 0
+
+// The generic kernels are written with GCC/Clang vector extensions, and assume
+// that vector elements are laid out in memory in little endian order.
+#if defined(__GNUC__) && defined(__has_builtin) && defined(__BYTE_ORDER__)
+    #if __has_builtin(__builtin_shufflevector) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        #define SAFE85_HAS_GENERIC_KERNELS 1
+    #endif
+#endif
+#ifndef SAFE85_HAS_GENERIC_KERNELS
+    #define SAFE85_HAS_GENERIC_KERNELS 0
+#endif
+
+#if SAFE85_HAS_X86_KERNELS
+int64_t safe85_avx2_encode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe85_avx2_decode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe85_sse41_encode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe85_sse41_decode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe85_sse41_compact_blocks(const uint8_t* src, uint8_t* dst, int64_t block_count);
+#endif
+
+#if SAFE85_HAS_GENERIC_KERNELS
+int64_t safe85_generic_encode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+int64_t safe85_generic_decode_groups(const uint8_t* src, uint8_t* dst, int64_t group_count);
+#endif
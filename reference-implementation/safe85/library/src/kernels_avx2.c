@@ -0,0 +1,198 @@
+#include "kernels.h"
+
+#if SAFE85_HAS_X86_KERNELS
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "kernels_common.h"
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+// Encoding: Each 32-bit lane receives one big endian group. The five base-85
+// digits are peeled off with multiply-high reciprocal divisions, packed so
+// that every group's digits are contiguous, and then mapped onto the
+// alphabet by adding an offset that depends on which range the digit is in.
+
+// Same reciprocal as divide_by_85() in library.c: exact for any 32-bit value.
+TARGET_AVX2 static inline __m256i divide_by_85(const __m256i values)
+{
+    const __m256i magic = _mm256_set1_epi64x(0xc0c0c0c1);
+    const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(values, magic), 38);
+    // Shifting by 6 rather than 38 leaves the odd quotients in the high halves.
+    const __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(values, 32), magic), 6);
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+TARGET_AVX2 static inline __m256i remainder_of_85(const __m256i values, const __m256i quotients)
+{
+    // quotients * 85 = (quotients * 5) * 17
+    const __m256i times_5 = _mm256_add_epi32(_mm256_slli_epi32(quotients, 2), quotients);
+    return _mm256_sub_epi32(values, _mm256_add_epi32(_mm256_slli_epi32(times_5, 4), times_5));
+}
+
+TARGET_AVX2 static inline __m256i add_if_greater(const __m256i values, const __m256i chunks, const char threshold, const char amount)
+{
+    return _mm256_add_epi8(values, _mm256_and_si256(_mm256_cmpgt_epi8(chunks, _mm256_set1_epi8(threshold)), _mm256_set1_epi8(amount)));
+}
+
+TARGET_AVX2 static inline __m256i chunks_to_chars(const __m256i chunks)
+{
+    // '!' = 0 + 33, '$' = 1 + 35, '(' = 2 + 38, '0' = 9 + 39, '=' = 21 + 40,
+    // '@' = 23 + 41, ']' = 51 + 42
+    __m256i chars = _mm256_add_epi8(chunks, _mm256_set1_epi8(33));
+    chars = add_if_greater(chars, chunks, 0, 2);
+    chars = add_if_greater(chars, chunks, 1, 3);
+    chars = add_if_greater(chars, chunks, 8, 1);
+    chars = add_if_greater(chars, chunks, 20, 1);
+    chars = add_if_greater(chars, chunks, 22, 1);
+    chars = add_if_greater(chars, chunks, 50, 1);
+    return chars;
+}
+
+TARGET_AVX2 static inline void store_32_bits(uint8_t* const dst, const __m128i value)
+{
+    const uint32_t bits = (uint32_t)_mm_cvtsi128_si32(value);
+    memcpy(dst, &bits, sizeof(bits));
+}
+
+TARGET_AVX2 static inline void encode_32_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    const __m256i groups = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)src), _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+
+    // A 32-bit value is below 85^5, so the last quotient is the first digit.
+    const __m256i q1 = divide_by_85(groups);
+    const __m256i q2 = divide_by_85(q1);
+    const __m256i q3 = divide_by_85(q2);
+    const __m256i d0 = divide_by_85(q3);
+    const __m256i d1 = remainder_of_85(q3, d0);
+    const __m256i d2 = remainder_of_85(q2, q3);
+    const __m256i d3 = remainder_of_85(q1, q2);
+    const __m256i d4 = remainder_of_85(groups, q1);
+
+    // The first four digits of each group fill its 32-bit lane.
+    const __m256i d0_to_d3 = _mm256_or_si256(_mm256_or_si256(d0, _mm256_slli_epi32(d1, 8)),
+                                             _mm256_or_si256(_mm256_slli_epi32(d2, 16), _mm256_slli_epi32(d3, 24)));
+
+    // Each 128-bit lane encodes to 20 chars: 16 at the front, and 4 left over.
+    const __m256i front = _mm256_or_si256(
+        _mm256_shuffle_epi8(d0_to_d3, _mm256_setr_epi8(
+            0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12,
+            0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12)),
+        _mm256_shuffle_epi8(d4, _mm256_setr_epi8(
+            -1, -1, -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1,
+            -1, -1, -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1)));
+    const __m256i back = _mm256_or_si256(
+        _mm256_shuffle_epi8(d0_to_d3, _mm256_setr_epi8(
+            13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm256_shuffle_epi8(d4, _mm256_setr_epi8(
+            -1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+
+    const __m256i front_chars = chunks_to_chars(front);
+    const __m256i back_chars = chunks_to_chars(back);
+    _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(front_chars));
+    store_32_bits(dst + 16, _mm256_castsi256_si128(back_chars));
+    _mm_storeu_si128((__m128i*)(dst + 20), _mm256_extracti128_si256(front_chars, 1));
+    store_32_bits(dst + 36, _mm256_extracti128_si256(back_chars, 1));
+}
+
+TARGET_AVX2 int64_t safe85_avx2_encode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 4 bytes and 5 chars per group
+    const int64_t groups_per_step = 8;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        encode_32_bytes(src + offset * 4, dst + offset * 5);
+    }
+    return offset;
+}
+
+// Decoding: Characters are translated through six 16-entry shuffle tables,
+// one for each high nibble from 2 to 7. Anything that isn't in the alphabet
+// (including whitespace) aborts the block so that the scalar code can deal
+// with it. Groups that overflow 32 bits wrap exactly like they do in the
+// scalar code.
+
+// Characters that aren't in the alphabet translate to 0xff.
+TARGET_AVX2 static inline __m256i chars_to_chunks(const __m256i chars)
+{
+    // Characters >= 0x80 don't match any high nibble, and stay at 0xff.
+    const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi16(chars, 4), _mm256_set1_epi8(0x0f));
+    __m256i chunks = _mm256_set1_epi8((char)0xff);
+    for(int i = 0; i < 6; i++)
+    {
+        const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(g_char_to_chunk + i * 16)));
+        chunks = _mm256_blendv_epi8(chunks,
+                                    _mm256_shuffle_epi8(table, chars),
+                                    _mm256_cmpeq_epi8(hi_nibbles, _mm256_set1_epi8((char)(i + 2))));
+    }
+    return chunks;
+}
+
+TARGET_AVX2 static inline bool decode_40_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    // Each 128-bit lane gets 20 chars (4 groups): the first 16 in front, and
+    // the last 4 at the end of back.
+    const __m256i front = chars_to_chunks(_mm256_loadu2_m128i((const __m128i*)(src + 20), (const __m128i*)src));
+    const __m256i back = chars_to_chunks(_mm256_loadu2_m128i((const __m128i*)(src + 24), (const __m128i*)(src + 4)));
+    const __m256i is_invalid = _mm256_or_si256(_mm256_cmpeq_epi8(front, _mm256_set1_epi8((char)0xff)),
+                                               _mm256_cmpeq_epi8(back, _mm256_set1_epi8((char)0xff)));
+    if(_mm256_movemask_epi8(is_invalid) != 0)
+    {
+        return false;
+    }
+
+    // The first four chunks of each group go in its 32-bit lane, and the
+    // last chunk in a separate register.
+    const __m256i c0_to_c3 = _mm256_or_si256(
+        _mm256_shuffle_epi8(front, _mm256_setr_epi8(
+            0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, 15, -1, -1, -1,
+            0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, 15, -1, -1, -1)),
+        _mm256_shuffle_epi8(back, _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, 14,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, 14)));
+    const __m256i c4 = _mm256_or_si256(
+        _mm256_shuffle_epi8(front, _mm256_setr_epi8(
+            4, -1, -1, -1, 9, -1, -1, -1, 14, -1, -1, -1, -1, -1, -1, -1,
+            4, -1, -1, -1, 9, -1, -1, -1, 14, -1, -1, -1, -1, -1, -1, -1)),
+        _mm256_shuffle_epi8(back, _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 15, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 15, -1, -1, -1)));
+
+    // (c0 * 85 + c1) and (c2 * 85 + c3), then (hi * 85^2 + lo), which is at
+    // most 85^4 - 1. The final multiply-add wraps modulo 2^32.
+    const __m256i pairs = _mm256_maddubs_epi16(c0_to_c3, _mm256_set1_epi16(0x0155));
+    const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011c39));
+    const __m256i groups = _mm256_add_epi32(_mm256_mullo_epi32(quads, _mm256_set1_epi32(85)), c4);
+
+    _mm256_storeu_si256((__m256i*)dst, _mm256_shuffle_epi8(groups, _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)));
+    return true;
+}
+
+TARGET_AVX2 int64_t safe85_avx2_decode_groups(const uint8_t* const src,
+                                              uint8_t* const dst,
+                                              const int64_t group_count)
+{
+    // 5 chars and 4 bytes per group
+    const int64_t groups_per_step = 8;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_40_chars(src + offset * 5, dst + offset * 4))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE85_HAS_X86_KERNELS
@@ -0,0 +1,178 @@
+#include "kernels.h"
+
+#if SAFE85_HAS_GENERIC_KERNELS
+
+#include <string.h>
+
+// These are the same algorithms as in kernels_sse41.c, written with the
+// compiler's vector extensions rather than intrinsics so that they build for
+// any target. The compiler lowers them to whatever the build's -march allows.
+// 16-byte vectors are native wherever there is SIMD at all (SSE2, NEON, ...),
+// and unlike wider ones they don't change the calling convention.
+
+typedef int8_t   s8x16  __attribute__((vector_size(16)));
+typedef uint8_t  u8x16  __attribute__((vector_size(16)));
+typedef uint16_t u16x8  __attribute__((vector_size(16)));
+typedef uint32_t u32x4  __attribute__((vector_size(16)));
+typedef uint64_t u64x2  __attribute__((vector_size(16)));
+
+static inline u32x4 load_u32x4(const uint8_t* const src)
+{
+    u32x4 value;
+    memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+// Group chars are moved in two parts so that they stay in registers.
+static inline uint64_t load_group_chars(const uint8_t* const src)
+{
+    uint32_t first_4;
+    memcpy(&first_4, src, sizeof(first_4));
+    return first_4 | (uint64_t)src[4] << 32;
+}
+
+static inline void store_group_chars(uint8_t* const dst, const uint64_t chars)
+{
+    const uint32_t first_4 = (uint32_t)chars;
+    memcpy(dst, &first_4, sizeof(first_4));
+    dst[4] = (uint8_t)(chars >> 32);
+}
+
+static inline u32x4 byte_swap(const u32x4 values)
+{
+    return (values >> 24) | ((values >> 8) & 0xff00) | ((values & 0xff00) << 8) | (values << 24);
+}
+
+// Comparisons give 0 or -1 in each element.
+static inline bool is_all_set(const u8x16 mask)
+{
+    const u64x2 words = (u64x2)mask;
+    return (words[0] & words[1]) == ~(uint64_t)0;
+}
+
+// Gives amount in every element that is greater than threshold, and 0 in the
+// others. The comparison is signed because not every target has unsigned
+// byte comparisons. Elements of 0x80 and up only turn up in invalid data,
+// which is_valid() rejects whatever they map to.
+static inline u8x16 amount_if_greater(const u8x16 values, const int8_t threshold, const uint8_t amount)
+{
+    return (u8x16)((s8x16)values > threshold) & amount;
+}
+
+static inline u8x16 chunks_to_chars(const u8x16 chunks)
+{
+    // '!' = 0 + 33, '$' = 1 + 35, '(' = 2 + 38, '0' = 9 + 39, '=' = 21 + 40,
+    // '@' = 23 + 41, ']' = 51 + 42
+    return chunks + 33 +
+           amount_if_greater(chunks, 0, 2) +
+           amount_if_greater(chunks, 1, 3) +
+           amount_if_greater(chunks, 8, 1) +
+           amount_if_greater(chunks, 20, 1) +
+           amount_if_greater(chunks, 22, 1) +
+           amount_if_greater(chunks, 50, 1);
+}
+
+static inline u8x16 chars_to_chunks(const u8x16 chars)
+{
+    // The same offsets as in chunks_to_chars, keyed on the character that
+    // each one starts after.
+    return chars - 33 -
+           amount_if_greater(chars, '!', 2) -
+           amount_if_greater(chars, '$', 3) -
+           amount_if_greater(chars, '.', 1) -
+           amount_if_greater(chars, ';', 1) -
+           amount_if_greater(chars, '>', 1) -
+           amount_if_greater(chars, '[', 1);
+}
+
+// Characters in the gaps of the alphabet map to the chunk of a neighbour, so
+// they're caught by encoding the chunks back again.
+static inline u8x16 is_valid(const u8x16 chars, const u8x16 chunks)
+{
+    return (u8x16)(chunks < 85) & (u8x16)(chunks_to_chars(chunks) == chars);
+}
+
+static inline void encode_16_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    const u32x4 groups = byte_swap(load_u32x4(src));
+
+    const u32x4 q1 = groups / 85;
+    const u32x4 q2 = q1 / 85;
+    const u32x4 q3 = q2 / 85;
+    const u32x4 d0 = q3 / 85;
+    const u32x4 d1 = q3 - d0 * 85;
+    const u32x4 d2 = q2 - q3 * 85;
+    const u32x4 d3 = q1 - q2 * 85;
+    const u32x4 d4 = groups - q1 * 85;
+
+    // Each 64-bit lane gets the 5 chunks of one group.
+    const u32x4 d0_to_d3 = d0 | (d1 << 8) | (d2 << 16) | (d3 << 24);
+    const u64x2 front = (u64x2)chunks_to_chars((u8x16)__builtin_shufflevector(d0_to_d3, d4, 0, 4, 1, 5));
+    const u64x2 back = (u64x2)chunks_to_chars((u8x16)__builtin_shufflevector(d0_to_d3, d4, 2, 6, 3, 7));
+
+    store_group_chars(dst, front[0]);
+    store_group_chars(dst + 5, front[1]);
+    store_group_chars(dst + 10, back[0]);
+    store_group_chars(dst + 15, back[1]);
+}
+
+int64_t safe85_generic_encode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 4 bytes and 5 chars per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        encode_16_bytes(src + offset * 4, dst + offset * 5);
+    }
+    return offset;
+}
+
+static inline bool decode_20_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    // Each 64-bit lane gets the 5 chars of one group. The 3 bytes left over
+    // in each lane are ignored.
+    const u8x16 unused = (u8x16)(u64x2){0xffffff0000000000, 0xffffff0000000000};
+    const u8x16 front = (u8x16)(u64x2){load_group_chars(src), load_group_chars(src + 5)};
+    const u8x16 back = (u8x16)(u64x2){load_group_chars(src + 10), load_group_chars(src + 15)};
+    const u8x16 front_chunks = chars_to_chunks(front);
+    const u8x16 back_chunks = chars_to_chunks(back);
+    if(!is_all_set((is_valid(front, front_chunks) & is_valid(back, back_chunks)) | unused))
+    {
+        return false;
+    }
+
+    const u32x4 c0_to_c3 = __builtin_shufflevector((u32x4)front_chunks, (u32x4)back_chunks, 0, 2, 4, 6);
+    const u32x4 c4 = __builtin_shufflevector((u32x4)front_chunks, (u32x4)back_chunks, 1, 3, 5, 7) & 0xff;
+
+    // Like the scalar decoder, this keeps only the low 32 bits of an
+    // overflowing group.
+    const u16x8 pairs = (u16x8)c0_to_c3;
+    const u32x4 quads = (u32x4)((pairs & 0xff) * 85 + (pairs >> 8));
+    const u32x4 groups = ((quads & 0xffff) * (85 * 85) + (quads >> 16)) * 85 + c4;
+
+    const u32x4 bytes = byte_swap(groups);
+    memcpy(dst, &bytes, sizeof(bytes));
+    return true;
+}
+
+int64_t safe85_generic_decode_groups(const uint8_t* const src,
+                                     uint8_t* const dst,
+                                     const int64_t group_count)
+{
+    // 5 chars and 4 bytes per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_20_chars(src + offset * 5, dst + offset * 4))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+#endif // SAFE85_HAS_GENERIC_KERNELS
@@ -0,0 +1,258 @@
+#include "kernels.h"
+
+#if SAFE85_HAS_X86_KERNELS
+
+#include <smmintrin.h>
+#include <string.h>
+
+#include "kernels_common.h"
+
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+
+// These are the same algorithms as in kernels_avx2.c, on 128-bit registers.
+
+TARGET_SSE41 static inline __m128i divide_by_85(const __m128i values)
+{
+    const __m128i magic = _mm_set1_epi64x(0xc0c0c0c1);
+    const __m128i even = _mm_srli_epi64(_mm_mul_epu32(values, magic), 38);
+    const __m128i odd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(values, 32), magic), 6);
+    return _mm_blend_epi16(even, odd, 0xcc);
+}
+
+TARGET_SSE41 static inline __m128i remainder_of_85(const __m128i values, const __m128i quotients)
+{
+    // quotients * 85 = (quotients * 5) * 17
+    const __m128i times_5 = _mm_add_epi32(_mm_slli_epi32(quotients, 2), quotients);
+    return _mm_sub_epi32(values, _mm_add_epi32(_mm_slli_epi32(times_5, 4), times_5));
+}
+
+TARGET_SSE41 static inline __m128i add_if_greater(const __m128i values, const __m128i chunks, const char threshold, const char amount)
+{
+    return _mm_add_epi8(values, _mm_and_si128(_mm_cmpgt_epi8(chunks, _mm_set1_epi8(threshold)), _mm_set1_epi8(amount)));
+}
+
+TARGET_SSE41 static inline __m128i chunks_to_chars(const __m128i chunks)
+{
+    // '!' = 0 + 33, '$' = 1 + 35, '(' = 2 + 38, '0' = 9 + 39, '=' = 21 + 40,
+    // '@' = 23 + 41, ']' = 51 + 42
+    __m128i chars = _mm_add_epi8(chunks, _mm_set1_epi8(33));
+    chars = add_if_greater(chars, chunks, 0, 2);
+    chars = add_if_greater(chars, chunks, 1, 3);
+    chars = add_if_greater(chars, chunks, 8, 1);
+    chars = add_if_greater(chars, chunks, 20, 1);
+    chars = add_if_greater(chars, chunks, 22, 1);
+    chars = add_if_greater(chars, chunks, 50, 1);
+    return chars;
+}
+
+TARGET_SSE41 static inline void encode_16_bytes(const uint8_t* const src, uint8_t* const dst)
+{
+    const __m128i groups = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), _mm_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+
+    const __m128i q1 = divide_by_85(groups);
+    const __m128i q2 = divide_by_85(q1);
+    const __m128i q3 = divide_by_85(q2);
+    const __m128i d0 = divide_by_85(q3);
+    const __m128i d1 = remainder_of_85(q3, d0);
+    const __m128i d2 = remainder_of_85(q2, q3);
+    const __m128i d3 = remainder_of_85(q1, q2);
+    const __m128i d4 = remainder_of_85(groups, q1);
+
+    const __m128i d0_to_d3 = _mm_or_si128(_mm_or_si128(d0, _mm_slli_epi32(d1, 8)),
+                                          _mm_or_si128(_mm_slli_epi32(d2, 16), _mm_slli_epi32(d3, 24)));
+
+    const __m128i front = _mm_or_si128(
+        _mm_shuffle_epi8(d0_to_d3, _mm_setr_epi8(0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12)),
+        _mm_shuffle_epi8(d4, _mm_setr_epi8(-1, -1, -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1)));
+    const __m128i back = _mm_or_si128(
+        _mm_shuffle_epi8(d0_to_d3, _mm_setr_epi8(13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(d4, _mm_setr_epi8(-1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+
+    _mm_storeu_si128((__m128i*)dst, chunks_to_chars(front));
+    const uint32_t back_chars = (uint32_t)_mm_cvtsi128_si32(chunks_to_chars(back));
+    memcpy(dst + 16, &back_chars, sizeof(back_chars));
+}
+
+TARGET_SSE41 int64_t safe85_sse41_encode_groups(const uint8_t* const src,
+                                                uint8_t* const dst,
+                                                const int64_t group_count)
+{
+    // 4 bytes and 5 chars per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        encode_16_bytes(src + offset * 4, dst + offset * 5);
+    }
+    return offset;
+}
+
+TARGET_SSE41 static inline __m128i chars_to_chunks(const __m128i chars)
+{
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi16(chars, 4), _mm_set1_epi8(0x0f));
+    __m128i chunks = _mm_set1_epi8((char)0xff);
+    for(int i = 0; i < 6; i++)
+    {
+        const __m128i table = _mm_loadu_si128((const __m128i*)(g_char_to_chunk + i * 16));
+        chunks = _mm_blendv_epi8(chunks,
+                                 _mm_shuffle_epi8(table, chars),
+                                 _mm_cmpeq_epi8(hi_nibbles, _mm_set1_epi8((char)(i + 2))));
+    }
+    return chunks;
+}
+
+TARGET_SSE41 static inline bool decode_20_chars(const uint8_t* const src, uint8_t* const dst)
+{
+    const __m128i front = chars_to_chunks(_mm_loadu_si128((const __m128i*)src));
+    const __m128i back = chars_to_chunks(_mm_loadu_si128((const __m128i*)(src + 4)));
+    const __m128i is_invalid = _mm_or_si128(_mm_cmpeq_epi8(front, _mm_set1_epi8((char)0xff)),
+                                            _mm_cmpeq_epi8(back, _mm_set1_epi8((char)0xff)));
+    if(_mm_movemask_epi8(is_invalid) != 0)
+    {
+        return false;
+    }
+
+    const __m128i c0_to_c3 = _mm_or_si128(
+        _mm_shuffle_epi8(front, _mm_setr_epi8(0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, 15, -1, -1, -1)),
+        _mm_shuffle_epi8(back, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, 14)));
+    const __m128i c4 = _mm_or_si128(
+        _mm_shuffle_epi8(front, _mm_setr_epi8(4, -1, -1, -1, 9, -1, -1, -1, 14, -1, -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(back, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 15, -1, -1, -1)));
+
+    const __m128i pairs = _mm_maddubs_epi16(c0_to_c3, _mm_set1_epi16(0x0155));
+    const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011c39));
+    const __m128i groups = _mm_add_epi32(_mm_mullo_epi32(quads, _mm_set1_epi32(85)), c4);
+
+    _mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi8(groups, _mm_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)));
+    return true;
+}
+
+TARGET_SSE41 int64_t safe85_sse41_decode_groups(const uint8_t* const src,
+                                                uint8_t* const dst,
+                                                const int64_t group_count)
+{
+    // 5 chars and 4 bytes per group
+    const int64_t groups_per_step = 4;
+    int64_t offset = 0;
+    for(; offset + groups_per_step <= group_count; offset += groups_per_step)
+    {
+        if(!decode_20_chars(src + offset * 5, dst + offset * 4))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+// Entry n holds the indices of the set bits in n, lowest first, as a pshufb
+// mask. Generated by print_left_pack_shuffle_table() in dev-tools.
+static const uint64_t g_left_pack_shuffles[256] =
+{
+    0x8080808080808080, 0x8080808080808000, 0x8080808080808001, 0x8080808080800100,
+    0x8080808080808002, 0x8080808080800200, 0x8080808080800201, 0x8080808080020100,
+    0x8080808080808003, 0x8080808080800300, 0x8080808080800301, 0x8080808080030100,
+    0x8080808080800302, 0x8080808080030200, 0x8080808080030201, 0x8080808003020100,
+    0x8080808080808004, 0x8080808080800400, 0x8080808080800401, 0x8080808080040100,
+    0x8080808080800402, 0x8080808080040200, 0x8080808080040201, 0x8080808004020100,
+    0x8080808080800403, 0x8080808080040300, 0x8080808080040301, 0x8080808004030100,
+    0x8080808080040302, 0x8080808004030200, 0x8080808004030201, 0x8080800403020100,
+    0x8080808080808005, 0x8080808080800500, 0x8080808080800501, 0x8080808080050100,
+    0x8080808080800502, 0x8080808080050200, 0x8080808080050201, 0x8080808005020100,
+    0x8080808080800503, 0x8080808080050300, 0x8080808080050301, 0x8080808005030100,
+    0x8080808080050302, 0x8080808005030200, 0x8080808005030201, 0x8080800503020100,
+    0x8080808080800504, 0x8080808080050400, 0x8080808080050401, 0x8080808005040100,
+    0x8080808080050402, 0x8080808005040200, 0x8080808005040201, 0x8080800504020100,
+    0x8080808080050403, 0x8080808005040300, 0x8080808005040301, 0x8080800504030100,
+    0x8080808005040302, 0x8080800504030200, 0x8080800504030201, 0x8080050403020100,
+    0x8080808080808006, 0x8080808080800600, 0x8080808080800601, 0x8080808080060100,
+    0x8080808080800602, 0x8080808080060200, 0x8080808080060201, 0x8080808006020100,
+    0x8080808080800603, 0x8080808080060300, 0x8080808080060301, 0x8080808006030100,
+    0x8080808080060302, 0x8080808006030200, 0x8080808006030201, 0x8080800603020100,
+    0x8080808080800604, 0x8080808080060400, 0x8080808080060401, 0x8080808006040100,
+    0x8080808080060402, 0x8080808006040200, 0x8080808006040201, 0x8080800604020100,
+    0x8080808080060403, 0x8080808006040300, 0x8080808006040301, 0x8080800604030100,
+    0x8080808006040302, 0x8080800604030200, 0x8080800604030201, 0x8080060403020100,
+    0x8080808080800605, 0x8080808080060500, 0x8080808080060501, 0x8080808006050100,
+    0x8080808080060502, 0x8080808006050200, 0x8080808006050201, 0x8080800605020100,
+    0x8080808080060503, 0x8080808006050300, 0x8080808006050301, 0x8080800605030100,
+    0x8080808006050302, 0x8080800605030200, 0x8080800605030201, 0x8080060503020100,
+    0x8080808080060504, 0x8080808006050400, 0x8080808006050401, 0x8080800605040100,
+    0x8080808006050402, 0x8080800605040200, 0x8080800605040201, 0x8080060504020100,
+    0x8080808006050403, 0x8080800605040300, 0x8080800605040301, 0x8080060504030100,
+    0x8080800605040302, 0x8080060504030200, 0x8080060504030201, 0x8006050403020100,
+    0x8080808080808007, 0x8080808080800700, 0x8080808080800701, 0x8080808080070100,
+    0x8080808080800702, 0x8080808080070200, 0x8080808080070201, 0x8080808007020100,
+    0x8080808080800703, 0x8080808080070300, 0x8080808080070301, 0x8080808007030100,
+    0x8080808080070302, 0x8080808007030200, 0x8080808007030201, 0x8080800703020100,
+    0x8080808080800704, 0x8080808080070400, 0x8080808080070401, 0x8080808007040100,
+    0x8080808080070402, 0x8080808007040200, 0x8080808007040201, 0x8080800704020100,
+    0x8080808080070403, 0x8080808007040300, 0x8080808007040301, 0x8080800704030100,
+    0x8080808007040302, 0x8080800704030200, 0x8080800704030201, 0x8080070403020100,
+    0x8080808080800705, 0x8080808080070500, 0x8080808080070501, 0x8080808007050100,
+    0x8080808080070502, 0x8080808007050200, 0x8080808007050201, 0x8080800705020100,
+    0x8080808080070503, 0x8080808007050300, 0x8080808007050301, 0x8080800705030100,
+    0x8080808007050302, 0x8080800705030200, 0x8080800705030201, 0x8080070503020100,
+    0x8080808080070504, 0x8080808007050400, 0x8080808007050401, 0x8080800705040100,
+    0x8080808007050402, 0x8080800705040200, 0x8080800705040201, 0x8080070504020100,
+    0x8080808007050403, 0x8080800705040300, 0x8080800705040301, 0x8080070504030100,
+    0x8080800705040302, 0x8080070504030200, 0x8080070504030201, 0x8007050403020100,
+    0x8080808080800706, 0x8080808080070600, 0x8080808080070601, 0x8080808007060100,
+    0x8080808080070602, 0x8080808007060200, 0x8080808007060201, 0x8080800706020100,
+    0x8080808080070603, 0x8080808007060300, 0x8080808007060301, 0x8080800706030100,
+    0x8080808007060302, 0x8080800706030200, 0x8080800706030201, 0x8080070603020100,
+    0x8080808080070604, 0x8080808007060400, 0x8080808007060401, 0x8080800706040100,
+    0x8080808007060402, 0x8080800706040200, 0x8080800706040201, 0x8080070604020100,
+    0x8080808007060403, 0x8080800706040300, 0x8080800706040301, 0x8080070604030100,
+    0x8080800706040302, 0x8080070604030200, 0x8080070604030201, 0x8007060403020100,
+    0x8080808080070605, 0x8080808007060500, 0x8080808007060501, 0x8080800706050100,
+    0x8080808007060502, 0x8080800706050200, 0x8080800706050201, 0x8080070605020100,
+    0x8080808007060503, 0x8080800706050300, 0x8080800706050301, 0x8080070605030100,
+    0x8080800706050302, 0x8080070605030200, 0x8080070605030201, 0x8007060503020100,
+    0x8080808007060504, 0x8080800706050400, 0x8080800706050401, 0x8080070605040100,
+    0x8080800706050402, 0x8080070605040200, 0x8080070605040201, 0x8007060504020100,
+    0x8080800706050403, 0x8080070605040300, 0x8080070605040301, 0x8007060504030100,
+    0x8080070605040302, 0x8007060504030200, 0x8007060504030201, 0x0706050403020100,
+};
+
+// Whitespace is everything that the decoder skips: tab, LF, CR and space.
+TARGET_SSE41 static inline __m128i is_whitespace(const __m128i chars)
+{
+    const __m128i is_space_or_tab = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+                                                 _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')));
+    const __m128i is_line_break = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')),
+                                               _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+    return _mm_or_si128(is_space_or_tab, is_line_break);
+}
+
+// AVX2 has no cross-lane byte shuffle, so this is shared with the avx2 kernel.
+TARGET_SSE41 int64_t safe85_sse41_compact_blocks(const uint8_t* const src,
+                                                 uint8_t* const dst,
+                                                 const int64_t block_count)
+{
+    // 16 chars per block. Each block is read before anything is written over
+    // it, so src and dst may be the same.
+    const __m128i high_half_offsets = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8);
+    uint8_t* next = dst;
+    for(int64_t offset = 0; offset < block_count * 16; offset += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(src + offset));
+        const int keep = ~_mm_movemask_epi8(is_whitespace(chars)) & 0xffff;
+        if(keep == 0xffff)
+        {
+            _mm_storeu_si128((__m128i*)next, chars);
+            next += 16;
+            continue;
+        }
+        const __m128i shuffle = _mm_set_epi64x((long long)g_left_pack_shuffles[keep >> 8],
+                                               (long long)g_left_pack_shuffles[keep & 0xff]);
+        const __m128i packed = _mm_shuffle_epi8(chars, _mm_add_epi8(shuffle, high_half_offsets));
+        _mm_storel_epi64((__m128i*)next, packed);
+        _mm_storel_epi64((__m128i*)(next + __builtin_popcount(keep & 0xff)), _mm_unpackhi_epi64(packed, packed));
+        next += __builtin_popcount(keep);
+    }
+    return next - dst;
+}
+
+#endif // SAFE85_HAS_X86_KERNELS
@@ -0,0 +1,243 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "thread_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+// #define KSLogger_LocalLevel DEBUG
+#include "kslogger.h"
+
+// No more than this many threads take part in a loop.
+#define MAX_THREAD_COUNT 64
+
+// The indexes that one thread has left to run, as the first index in the low
+// half and the end in the high half, so that both can change in one step.
+// Each one gets a cache line to itself.
+typedef struct
+{
+    _Alignas(64) _Atomic uint64_t indexes;
+} task_range;
+
+typedef struct
+{
+    safe85_parallel_task task;
+    void* context;
+    int thread_count;
+    // These are protected by g_pool_mutex.
+    int joined_thread_count;
+    int running_worker_count;
+    task_range ranges[MAX_THREAD_COUNT];
+} parallel_loop;
+
+static pthread_mutex_t g_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_loop_started = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_workers_finished = PTHREAD_COND_INITIALIZER;
+// The loop that workers can join, if any.
+static parallel_loop* g_current_loop = NULL;
+static int g_worker_count = 0;
+
+static inline uint64_t make_range(const uint32_t first, const uint32_t end)
+{
+    return (uint64_t)end << 32 | first;
+}
+
+// The owner of a range takes indexes from the front.
+static bool take_first_index(task_range* const range, int64_t* const index)
+{
+    uint64_t indexes = atomic_load(&range->indexes);
+    for(;;)
+    {
+        const uint32_t first = (uint32_t)indexes;
+        const uint32_t end = (uint32_t)(indexes >> 32);
+        if(first >= end)
+        {
+            return false;
+        }
+        if(atomic_compare_exchange_weak(&range->indexes, &indexes, make_range(first + 1, end)))
+        {
+            *index = first;
+            return true;
+        }
+    }
+}
+
+// Other threads take the back half, so that they rarely get in the owner's
+// way. Taking the only index left counts as the back half.
+static bool take_back_half(task_range* const range, uint64_t* const taken)
+{
+    uint64_t indexes = atomic_load(&range->indexes);
+    for(;;)
+    {
+        const uint32_t first = (uint32_t)indexes;
+        const uint32_t end = (uint32_t)(indexes >> 32);
+        if(first >= end)
+        {
+            return false;
+        }
+        const uint32_t middle = first + (end - first) / 2;
+        if(atomic_compare_exchange_weak(&range->indexes, &indexes, make_range(first, middle)))
+        {
+            *taken = make_range(middle, end);
+            return true;
+        }
+    }
+}
+
+// Only called when the thief's own range is empty, at which point nobody else
+// writes to it.
+static bool steal_indexes(parallel_loop* const loop, const int thief)
+{
+    for(int i = 1; i < loop->thread_count; i++)
+    {
+        const int victim = (thief + i) % loop->thread_count;
+        uint64_t taken;
+        if(take_back_half(&loop->ranges[victim], &taken))
+        {
+            KSLOG_DEBUG("Thread %d stole indexes %d to %d from thread %d",
+                        thief, (uint32_t)taken, (uint32_t)(taken >> 32), victim);
+            atomic_store(&loop->ranges[thief].indexes, taken);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Indexes that have been stolen but not yet stored in the thief's range are
+// invisible to everyone else. The thief is still running at that point though,
+// so nothing is lost by returning as soon as there's nothing left to steal.
+static void run_loop_share(parallel_loop* const loop, const int thread_index)
+{
+    task_range* const range = &loop->ranges[thread_index];
+    do
+    {
+        int64_t index;
+        while(take_first_index(range, &index))
+        {
+            loop->task(loop->context, index);
+        }
+    }
+    while(steal_indexes(loop, thread_index));
+}
+
+static void* run_worker(void* const unused)
+{
+    (void)unused;
+    pthread_mutex_lock(&g_pool_mutex);
+    for(;;)
+    {
+        while(g_current_loop == NULL || g_current_loop->joined_thread_count >= g_current_loop->thread_count)
+        {
+            pthread_cond_wait(&g_loop_started, &g_pool_mutex);
+        }
+        parallel_loop* const loop = g_current_loop;
+        const int thread_index = loop->joined_thread_count++;
+        loop->running_worker_count++;
+        pthread_mutex_unlock(&g_pool_mutex);
+
+        run_loop_share(loop, thread_index);
+
+        pthread_mutex_lock(&g_pool_mutex);
+        // Another caller could be waiting for the workers of a different
+        // loop, so everyone has to be woken.
+        if(--loop->running_worker_count == 0)
+        {
+            pthread_cond_broadcast(&g_workers_finished);
+        }
+    }
+    return NULL;
+}
+
+// Called with g_pool_mutex held. Not being able to start a worker isn't an
+// error: its share of the loop just gets stolen by the others.
+static void start_workers(const int worker_count)
+{
+    while(g_worker_count < worker_count)
+    {
+        pthread_attr_t attributes;
+        pthread_attr_init(&attributes);
+        pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+        pthread_t thread;
+        const int result = pthread_create(&thread, &attributes, run_worker, NULL);
+        pthread_attr_destroy(&attributes);
+        if(result != 0)
+        {
+            KSLOG_DEBUG("Error: Could not start worker %d (error %d)", g_worker_count, result);
+            return;
+        }
+        g_worker_count++;
+    }
+}
+
+void safe85_run_parallel(const safe85_parallel_task task,
+                         void* const context,
+                         const int64_t task_count,
+                         int thread_count)
+{
+    if(thread_count > MAX_THREAD_COUNT)
+    {
+        thread_count = MAX_THREAD_COUNT;
+    }
+    if(thread_count > task_count)
+    {
+        thread_count = (int)task_count;
+    }
+
+    parallel_loop loop =
+    {
+        .task = task,
+        .context = context,
+        .thread_count = thread_count,
+        .joined_thread_count = 1,
+        .running_worker_count = 0,
+    };
+
+    pthread_mutex_lock(&g_pool_mutex);
+    if(thread_count <= 1 || g_current_loop != NULL)
+    {
+        pthread_mutex_unlock(&g_pool_mutex);
+        KSLOG_DEBUG("Running %d tasks on the calling thread", task_count);
+        for(int64_t index = 0; index < task_count; index++)
+        {
+            task(context, index);
+        }
+        return;
+    }
+
+    for(int i = 0; i < thread_count; i++)
+    {
+        const uint32_t first = (uint32_t)(task_count * i / thread_count);
+        const uint32_t end = (uint32_t)(task_count * (i + 1) / thread_count);
+        atomic_init(&loop.ranges[i].indexes, make_range(first, end));
+    }
+    start_workers(thread_count - 1);
+    g_current_loop = &loop;
+    pthread_cond_broadcast(&g_loop_started);
+    pthread_mutex_unlock(&g_pool_mutex);
+
+    run_loop_share(&loop, 0);
+
+    pthread_mutex_lock(&g_pool_mutex);
+    g_current_loop = NULL;
+    while(loop.running_worker_count > 0)
+    {
+        pthread_cond_wait(&g_workers_finished, &g_pool_mutex);
+    }
+    pthread_mutex_unlock(&g_pool_mutex);
+}
+
+int safe85_get_cpu_count(void)
+{
+    const long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if(cpu_count < 1)
+    {
+        return 1;
+    }
+    if(cpu_count > MAX_THREAD_COUNT)
+    {
+        return MAX_THREAD_COUNT;
+    }
+    return (int)cpu_count;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdint.h>
+
+// A pool of worker threads for running parallel loops. Each thread taking
+// part in a loop starts with its own share of the indexes, and steals half of
+// what another one has left whenever it runs out, so that uneven tasks still
+// keep every thread busy. Workers are started on first use, and then wait
+// around for the next loop.
+
+typedef void (*safe85_parallel_task)(void* context, int64_t index);
+
+// Calls task(context, index) for every index from 0 up to task_count (which
+// must fit in 32 bits), on up to thread_count threads including the calling
+// one. Returns once all of the calls have finished.
+// The pool runs one loop at a time. If it's busy with a loop from another
+// thread, this one runs on the calling thread alone.
+void safe85_run_parallel(safe85_parallel_task task, void* context, int64_t task_count, int thread_count);
+
+// Gives the number of CPUs that are online, or 1 if that can't be found.
+int safe85_get_cpu_count(void);
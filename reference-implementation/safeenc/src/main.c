@@ -144,6 +144,7 @@ static void error_unexpected_status_exit(const safe16_status status)
         HANDLE_CASE(ERROR_TRUNCATED_DATA);
         HANDLE_CASE(ERROR_INVALID_LENGTH);
         HANDLE_CASE(ERROR_NOT_ENOUGH_ROOM);
+        HANDLE_CASE(ERROR_SINK_FAILED);
 
         // This should not happen
         HANDLE_CASE(STATUS_OK);